@@ -7,6 +7,7 @@
 /// All rights reserved.
 
 #include "ym/BitVector.h"
+#include <cstring>
 
 
 BEGIN_NAMESPACE_YM_VERILOG
@@ -47,6 +48,256 @@ mask(SizeType size)
   return ALL1 >> (BLOCK_SIZE - shift(size));
 }
 
+// @brief 各バイトが同じ値 b の定数を作る．
+constexpr
+uword
+bytes(uword b)
+{
+  return b * 0x0101010101010101;
+}
+
+// @brief 8文字を1ワードに読み込む．
+//
+// 先頭の文字が最上位のバイトになる．
+inline
+uword
+load8(const char* p)
+{
+  uword v = 0;
+  for ( SizeType i = 0; i < 8; ++ i ) {
+    v = (v << 8) | static_cast<unsigned char>(p[i]);
+  }
+  return v;
+}
+
+// @brief 値が c のバイトの最上位ビットを1にする．
+inline
+uword
+equal(uword v,
+      char c)
+{
+  uword b = v ^ bytes(static_cast<unsigned char>(c));
+  return ~(((b & bytes(0x7F)) + bytes(0x7F)) | b) & bytes(0x80);
+}
+
+// @brief 各バイトの最上位ビットを集めて8ビットの値にする．
+//
+// 最下位のバイトが最下位ビットになる．
+inline
+uword
+gather8(uword flags)
+{
+  return ((flags >> 7) * 0x0102040810204080) >> 56;
+}
+
+// @brief 2進数の8文字を8ビット分の val0/val1 に変換する．
+// @retval true 変換できた．
+// @retval false 不正な文字を含んでいた．
+inline
+bool
+bin8(const char* p,
+     uword& val0,
+     uword& val1)
+{
+  uword v = load8(p);
+  uword lv = v | bytes(0x20);
+  uword is0 = equal(v, '0');
+  uword is1 = equal(v, '1');
+  uword isx = equal(lv, 'x');
+  uword isz = equal(lv, 'z') | equal(v, '?');
+  if ( (is0 | is1 | isx | isz) != bytes(0x80) ) {
+    return false;
+  }
+  val0 = gather8(is0 | isx);
+  val1 = gather8(is1 | isx);
+  return true;
+}
+
+// 数字の表の不正な文字を表すビット
+const std::uint16_t ILLEGAL_DIGIT = 0x100;
+
+// @brief 1文字分のビットパタンの表
+//
+// 下位4ビットが val1 の，その上の4ビットが val0 のパタンを表す．
+// 不正な文字には ILLEGAL_DIGIT を入れておく．
+struct DigitTable
+{
+  // コンストラクタ
+  DigitTable(
+    SizeType nb ///< [in] 1文字あたりのビット数(1, 3, 4)
+  )
+  {
+    std::uint16_t m = (1U << nb) - 1;
+    for ( SizeType c = 0; c < 256; ++ c ) {
+      mPat[c] = ILLEGAL_DIGIT;
+    }
+    for ( std::uint16_t d = 0; d <= m; ++ d ) {
+      std::uint16_t pat = d | ((~d & m) << 4);
+      if ( d < 10 ) {
+	mPat['0' + d] = pat;
+      }
+      else {
+	mPat['a' + d - 10] = pat;
+	mPat['A' + d - 10] = pat;
+      }
+    }
+    mPat['x'] = mPat['X'] = m | (m << 4);
+    mPat['z'] = mPat['Z'] = mPat['?'] = 0;
+  }
+
+  // パタンの配列
+  std::uint16_t mPat[256];
+};
+
+// @brief 1文字分のビットパタンの表を返す．
+const std::uint16_t*
+digit_table(SizeType nb)
+{
+  static const DigitTable bin_table{1};
+  static const DigitTable oct_table{3};
+  static const DigitTable hex_table{4};
+  switch ( nb ) {
+  case 1: return bin_table.mPat;
+  case 3: return oct_table.mPat;
+  default: break;
+  }
+  return hex_table.mPat;
+}
+
+// 不正な文字を含んでいた時のエラーメッセージを出力する．
+void
+illegal_char(char c,
+	     const char* str,
+	     SizeType len)
+{
+  // 本当は例外を投げるのがいいな．
+  cerr << "illegal character (" << c << ") in string "
+       << string(str, len) << endl;
+}
+
+// @brief 2のべき乗の基数の数字の文字列を val0/val1 に変換する．
+// @retval true 変換できた．
+// @retval false 不正な文字を含んでいた．
+//
+// 不正な文字を含んでいた場合にはエラーメッセージを出力する．
+// 文字列の末尾(最下位)から順に nb ビットずつ詰めていく．
+// 2進数と16進数の場合，ワードの境界に揃っている部分は1ワード分の
+// 文字をレジスタ上でまとめて変換してから書き込む．
+// 2進数は8文字ずつ，16進数は表を引いて1文字ずつ変換する．
+// val0/val1 は block(len * nb) ワードの大きさを持つこと．
+bool
+parse_pow2(const char* str,
+	   SizeType len,
+	   SizeType nb,
+	   uword* val0,
+	   uword* val1)
+{
+  const std::uint16_t* tbl = digit_table(nb);
+  // 1ワード分の文字数(まとめて変換しない場合は 0)
+  SizeType wlen = 0;
+  if ( nb == 1 || nb == 4 ) {
+    wlen = BLOCK_SIZE / nb;
+  }
+  SizeType wpos = 0;
+  SizeType bpos = 0;
+  uword acc0 = 0;
+  uword acc1 = 0;
+  SizeType end = len;
+  while ( end > 0 ) {
+    if ( bpos == 0 && wlen > 0 && end >= wlen ) {
+      const char* p = str + end - wlen;
+      uword w0 = 0;
+      uword w1 = 0;
+      bool ok = true;
+      if ( nb == 1 ) {
+	for ( SizeType k = 0; k < wlen && ok; k += 8 ) {
+	  uword v0;
+	  uword v1;
+	  ok = bin8(p + k, v0, v1);
+	  w0 = (w0 << 8) | v0;
+	  w1 = (w1 << 8) | v1;
+	}
+      }
+      else {
+	std::uint16_t bad = 0;
+	for ( SizeType k = 0; k < wlen; ++ k ) {
+	  std::uint16_t pat = tbl[static_cast<unsigned char>(p[k])];
+	  bad |= pat;
+	  w0 = (w0 << 4) | ((pat >> 4) & 0xF);
+	  w1 = (w1 << 4) | (pat & 0xF);
+	}
+	ok = (bad & ILLEGAL_DIGIT) == 0;
+      }
+      if ( ok ) {
+	val0[wpos] = w0;
+	val1[wpos] = w1;
+	++ wpos;
+	end -= wlen;
+	continue;
+      }
+      // 不正な文字を含んでいたら1文字ずつ処理してエラーを出す．
+    }
+
+    char c = str[end - 1];
+    std::uint16_t pat = tbl[static_cast<unsigned char>(c)];
+    if ( pat & ILLEGAL_DIGIT ) {
+      illegal_char(c, str, len);
+      return false;
+    }
+    uword pat0 = (pat >> 4) & 0xF;
+    uword pat1 = pat & 0xF;
+    acc0 |= pat0 << bpos;
+    acc1 |= pat1 << bpos;
+    bpos += nb;
+    if ( bpos >= BLOCK_SIZE ) {
+      val0[wpos] = acc0;
+      val1[wpos] = acc1;
+      ++ wpos;
+      bpos -= BLOCK_SIZE;
+      // ワードの境界をまたいだ部分
+      SizeType r = nb - bpos;
+      acc0 = (bpos > 0) ? pat0 >> r : 0;
+      acc1 = (bpos > 0) ? pat1 >> r : 0;
+    }
+    -- end;
+  }
+  if ( bpos > 0 ) {
+    val0[wpos] = acc0;
+    val1[wpos] = acc1;
+  }
+  return true;
+}
+
+// 1ワードに収まる10進数の最大の桁数
+const SizeType DEC_DIGITS = 19;
+
+// 10 のべき乗の表
+const uword POW10[DEC_DIGITS + 1] = {
+  1ULL,
+  10ULL,
+  100ULL,
+  1000ULL,
+  10000ULL,
+  100000ULL,
+  1000000ULL,
+  10000000ULL,
+  100000000ULL,
+  1000000000ULL,
+  10000000000ULL,
+  100000000000ULL,
+  1000000000000ULL,
+  10000000000000ULL,
+  100000000000000ULL,
+  1000000000000000ULL,
+  10000000000000000ULL,
+  100000000000000000ULL,
+  1000000000000000000ULL,
+  10000000000000000000ULL
+};
+
+// 2ワード分の符号なし整数
+using dword = unsigned __int128;
+
 END_NONAMESPACE
 
 // unsigned int からの変換コンストラクタ
@@ -132,8 +383,7 @@ BitVector::BitVector(
   set_type(true, false, 10);
   mVal1.get()[0] = time.low();
   mVal1.get()[1] = time.high();
-  mVal0.get()[0] = ~mVal1.get()[0];
-  mVal0.get()[1] = ~mVal1.get()[1];
+  set_2state();
 }
 
 // @brief time 型からの代入演算子
@@ -147,8 +397,7 @@ BitVector::operator=(
   set_type(true, false, 10);
   mVal1.get()[0] = time.low();
   mVal1.get()[1] = time.high();
-  mVal0.get()[0] = ~mVal1.get()[0];
-  mVal0.get()[1] = ~mVal1.get()[1];
+  set_2state();
   return *this;
 }
 
@@ -191,6 +440,7 @@ BitVector::BitVector(
   uword m = mask(size);
   mVal0.get()[n - 1] = val0 | (~m);
   mVal1.get()[n - 1] = val1 & m;
+  mFlags[4] = value.is_zero() || value.is_one();
 }
 
 // brief C文字列からの変換用コンストラクタ
@@ -251,19 +501,17 @@ BitVector::operator=(
       char c = str[i];
       tmp += (static_cast<uword>(c) << (k * 8));
       ++ k;
-      if ( k == 4 ) {
-	mVal0.get()[j] = ~tmp;
-	mVal1.get()[j] =  tmp;
+      if ( k == sizeof(uword) ) {
+	mVal1.get()[j] = tmp;
 	++ j;
 	k = 0;
 	tmp = 0;
       }
     }
     if ( k != 0 ) {
-      uword mask = ALL1 << (k * 8);
-      mVal0.get()[j] = ~tmp | mask;
-      mVal1.get()[j] =  tmp;
+      mVal1.get()[j] = tmp;
     }
+    set_2state();
   }
   return *this;
 }
@@ -303,13 +551,23 @@ BitVector::BitVector(
     size = BLOCK_SIZE;
     is_sized = false;
   }
-  switch ( base ) {
-  case  2: set_from_binstring(size, is_sized, is_signed, str, 0); break;
-  case  8: set_from_octstring(size, is_sized, is_signed, str, 0); break;
-  case 10: set_from_decstring(size, is_sized, is_signed, str, 0); break;
-  case 16: set_from_hexstring(size, is_sized, is_signed, str, 0); break;
-  default: cerr << "illegal base : " << base << endl;
+  set_from_digits(size, is_sized, is_signed, base, str.c_str(), str.size());
+}
+
+// Verilog-HDL 形式の文字列からの変換コンストラクタ (C文字列版)
+BitVector::BitVector(
+  SizeType size,
+  bool is_signed,
+  SizeType base,
+  const char* str
+)
+{
+  bool is_sized = true;
+  if ( size == 0 ) {
+    size = BLOCK_SIZE;
+    is_sized = false;
   }
+  set_from_digits(size, is_sized, is_signed, base, str, strlen(str));
 }
 
 // @brief 連結演算用のコンストラクタ
@@ -327,7 +585,11 @@ BitVector::BitVector(
 
   SizeType blk = 0;
   SizeType pos = 0;
+  bool all_2state = true;
   for ( const auto& bv: src_list ) {
+    if ( !bv.is_2state() ) {
+      all_2state = false;
+    }
     SizeType l = bv.size();
     SizeType b = block(l);
     SizeType s = shift(l);
@@ -370,17 +632,21 @@ BitVector::BitVector(
       }
     }
   }
+  if ( all_2state && tl > 0 ) {
+    // 1 の面から 0 の面を作り直せばよい．
+    set_2state();
+  }
 }
 
 // コピーコンストラクタ
 BitVector::BitVector(
   const BitVector& src
 ) : mSize{src.mSize},
-    mFlags{src.mFlags},
-    mVal0{unique_ptr<uword>{new uword[block(mSize)]}},
-    mVal1{unique_ptr<uword>{new uword[block(mSize)]}}
+    mFlags{src.mFlags}
 {
   int n = block(mSize);
+  mVal0.alloc(n);
+  mVal1.alloc(n);
   for ( int i = 0; i < n; ++ i ) {
     mVal0.get()[i] = src.mVal0.get()[i];
     mVal1.get()[i] = src.mVal1.get()[i];
@@ -407,8 +673,8 @@ BitVector::operator=(
     mSize = src.mSize;
     mFlags = src.mFlags;
     SizeType n = block(mSize);
-    mVal0 = unique_ptr<uword>{new uword[n]};
-    mVal1 = unique_ptr<uword>{new uword[n]};
+    mVal0.alloc(n);
+    mVal1.alloc(n);
     for ( int i = 0; i < n; ++ i ) {
       mVal0.get()[i] = src.mVal0.get()[i];
       mVal1.get()[i] = src.mVal1.get()[i];
@@ -480,6 +746,7 @@ BitVector::operator=(
   else {
     ASSERT_NOT_REACHED;
   }
+  mFlags[4] = value.is_zero() || value.is_one();
   return *this;
 }
 
@@ -512,8 +779,8 @@ BitVector::set_from_verilog_string(
   if ( pos != string::npos ) {
     if ( pos != 0 ) {
       // ' よりも前の部分はビット長を表す文字列
-      string lenstr = str.substr(0, pos);
-      size = atoi(lenstr.c_str()); // 手抜き
+      // atoi() は ' の位置で止まる．
+      size = atoi(str.c_str()); // 手抜き
       is_sized = true;
     }
     pos ++; // ' の次の位置を指す．
@@ -562,13 +829,8 @@ BitVector::set_from_verilog_string(
     pos = 0;
   }
 
-  switch ( base ) {
-  case  2: set_from_binstring(size, is_sized, is_signed, str, 0); break;
-  case  8: set_from_octstring(size, is_sized, is_signed, str, 0); break;
-  case 10: set_from_decstring(size, is_sized, is_signed, str, 0); break;
-  case 16: set_from_hexstring(size, is_sized, is_signed, str, 0); break;
-  default: cerr << "illegal base : " << base << endl;
-  }
+  set_from_digits(size, is_sized, is_signed, base,
+		  str.c_str() + pos, str.size() - pos);
 
   return true;
 }
@@ -631,56 +893,49 @@ BitVector::z(
   return BitVector{VlScalarVal::z(), size};
 }
 
+// 基数に応じて Verilog 形式の数字の文字列から変換する共通ルーティン
+void
+BitVector::set_from_digits(
+  SizeType size,
+  bool is_sized,
+  bool is_signed,
+  SizeType base,
+  const char* str,
+  SizeType len
+)
+{
+  if ( len == 0 ) {
+    // 空の文字列は 0 とみなす．
+    str = "0";
+    len = 1;
+  }
+  switch ( base ) {
+  case  2: set_from_binstring(size, is_sized, is_signed, str, len); break;
+  case  8: set_from_octstring(size, is_sized, is_signed, str, len); break;
+  case 10: set_from_decstring(size, is_sized, is_signed, str, len); break;
+  case 16: set_from_hexstring(size, is_sized, is_signed, str, len); break;
+  default: cerr << "illegal base : " << base << endl;
+  }
+}
+
 // Verilog 形式の2進数から変換するための共通ルーティン
 void
 BitVector::set_from_binstring(
   SizeType size,
   bool is_sized,
   bool is_signed,
-  const string& str,
-  int pos
+  const char* str,
+  SizeType len
 )
 {
   // 文字列の表している値を求める．
   // 実際に格納するものはサイズなどの属性が異なるので set() を用いる．
-  string::size_type end = str.size();
-  SizeType src_size = end - pos;
+  SizeType src_size = len;
   SizeType src_n = block(src_size);
   uword val0[src_n];
   uword val1[src_n];
-  for ( SizeType i = 0; i < src_n; ++ i ) {
-    val0[i] = ALL1;
-    val1[i] = ALL0;
-  }
-  SizeType vpos = src_size - 1;
-  for ( ; pos < end; pos ++, vpos -- ) {
-    SizeType blk = vpos / BLOCK_SIZE;
-    SizeType sft = vpos - blk * BLOCK_SIZE;
-    uword ppat = 1 << sft;
-    uword npat = ~ppat;
-    char c = str[pos];
-    if ( c == '0' ) {
-      val0[blk] |= ppat;
-      val1[blk] &= npat;
-    }
-    else if ( c == '1' ) {
-      val0[blk] &= npat;
-      val1[blk] |= ppat;
-    }
-    else if ( c == 'x' || c == 'X' ) {
-      val0[blk] |= ppat;
-      val1[blk] |= ppat;
-    }
-    else if ( c == 'z' || c == 'Z' || c == '?' ) {
-      val0[blk] &= npat;
-      val1[blk] &= npat;
-    }
-    else {
-      // 本当は例外を投げるのがいいな．
-      cerr << "illegal character (" << c << ") in string "
-	   << str << endl;
-      return;
-    }
+  if ( !parse_pow2(str, len, 1, val0, val1) ) {
+    return;
   }
 
   // この文字列の先頭に - はつかないので結果は必ず非負の数だが，
@@ -698,65 +953,18 @@ BitVector::set_from_octstring(
   SizeType size,
   bool is_sized,
   bool is_signed,
-  const string& str,
-  int pos
+  const char* str,
+  SizeType len
 )
 {
   // 文字列の表している値を求める．
   // 実際に格納するものはサイズなどの属性が異なるので set() を用いる．
-  string::size_type end = str.size();
-  SizeType src_size = (end - pos) * 3;
+  SizeType src_size = len * 3;
   SizeType src_n = block(src_size);
   uword val0[src_n];
   uword val1[src_n];
-  for ( SizeType i = 0; i < src_n; ++ i ) {
-    val0[i] = ALL1;
-    val1[i] = ALL0;
-  }
-  SizeType vpos = src_size - 3;
-  for ( ; pos < end; pos ++, vpos -= 3 ) {
-    SizeType blk = vpos / BLOCK_SIZE;
-    SizeType sft = vpos - blk * BLOCK_SIZE;
-    char c = str[pos];
-    if ( '0' <= c && c <= '7' ) {
-      int val = c - '0';
-      uword lppat = val << sft;
-      uword rppat = val >> (BLOCK_SIZE - sft);
-      uword lnpat = ~lppat;
-      uword rnpat = ~rppat;
-      val0[blk] &= lnpat;
-      val1[blk] |= lppat;
-      if ( rppat ) {
-	val0[blk + 1] &= rnpat;
-	val1[blk + 1] |= rppat;
-      }
-    }
-    else if ( c == 'x' || c == 'X' ) {
-      uword lppat = 7 << sft;
-      uword rppat = 7 >> (BLOCK_SIZE - sft);
-      val0[blk] |= lppat;
-      val1[blk] |= lppat;
-      if ( rppat ) {
-	val0[blk + 1] |= rppat;
-	val1[blk + 1] |= rppat;
-      }
-    }
-    else if ( c == 'z' || c == 'Z' || c == '?' ) {
-      uword lnpat = ~(7 << sft);
-      uword rnpat = ~(7 >> (BLOCK_SIZE - sft));
-      val0[blk] &= lnpat;
-      val1[blk] &= lnpat;
-      if ( rnpat != ALL1 ) {
-	val0[blk + 1] &= rnpat;
-	val1[blk + 1] &= rnpat;
-      }
-    }
-    else {
-      // 本当は例外を投げるのがいいな．
-      cerr << "illegal character (" << c << ") in string "
-	   << str << endl;
-      return;
-    }
+  if ( !parse_pow2(str, len, 3, val0, val1) ) {
+    return;
   }
 
   // この文字列の先頭に - はつかないので結果は必ず非負の数だが，
@@ -774,60 +982,67 @@ BitVector::set_from_decstring(
   SizeType size,
   bool is_sized,
   bool is_signed,
-  const string& str,
-  int pos
+  const char* str,
+  SizeType len
 )
 {
+  if ( len == 1 ) {
+    // 'dx, 'dz の形は全ビットが x か z となる．
+    char c = str[0];
+    bool is_x = (c == 'x' || c == 'X');
+    bool is_z = (c == 'z' || c == 'Z' || c == '?');
+    if ( is_x || is_z ) {
+      operator=(BitVector{is_x ? VlScalarVal::x() : VlScalarVal::z(), size});
+      set_type(is_sized, is_signed, 10);
+      return;
+    }
+  }
+
   // 文字列の表している値を求める．
   // 実際に格納するものはサイズなどの属性が異なるので set() を用いる．
-  vector<uword> val0;
+  // 先頭から DEC_DIGITS 桁ずつ1ワードの整数に変換して
+  // 10^DEC_DIGITS 倍しながら足していく．
   vector<uword> val1;
-  SizeType src_size = 0;
-  string::size_type end = str.size();
-  const SizeType sft = BLOCK_SIZE - 4;
-  for ( ; pos < end; ++ pos ) {
-    char c = str[pos];
-    if ( c < '0' || '9' < c ) {
-      // 本当は例外を投げるのがいいな．
-      cerr << "illegal character (" << c << ") in string "
-	   << str << endl;
-      return;
-    }
-    else {
-      SizeType n = val1.size();
-      uword carry = c - '0';
-      for ( SizeType i = 0; i < n; ++ i ) {
-	uword tmp = val1[i];
-	uword u = tmp >> sft;
-	uword l = tmp - (u << sft);
-	uword u10 = u * 10;
-	uword l10 = l * 10;
-	val1[i] = carry + l10 + ((u10 % 16) << sft);
-	val0[i] = ~val1[i];
-	carry = u10 / 16;
-      }
-      if ( carry ) {
-	val1.push_back(carry);
-	val0.push_back(~carry);
+  val1.reserve(block(len * 4));
+  SizeType pos = 0;
+  while ( pos < len ) {
+    // 最初のかたまりで桁数の端数を処理する．
+    SizeType nd = (pos == 0) ? len - ((len - 1) / DEC_DIGITS) * DEC_DIGITS : DEC_DIGITS;
+    uword chunk = 0;
+    for ( SizeType i = 0; i < nd; ++ i, ++ pos ) {
+      char c = str[pos];
+      if ( c < '0' || '9' < c ) {
+	illegal_char(c, str, len);
+	return;
       }
+      chunk = chunk * 10 + (c - '0');
     }
-  }
-  SizeType last = val1.size();
-  if ( last ) {
-    last --;
-    for ( int vpos = BLOCK_SIZE; vpos -- > 0; ) {
-      if ( val1[last] & (1 << vpos) ) {
-	src_size = vpos + last * BLOCK_SIZE + 1;
-	break;
-      }
+    uword carry = chunk;
+    for ( auto& w: val1 ) {
+      dword tmp = static_cast<dword>(w) * POW10[nd] + carry;
+      w = static_cast<uword>(tmp);
+      carry = static_cast<uword>(tmp >> BLOCK_SIZE);
+    }
+    if ( carry ) {
+      val1.push_back(carry);
     }
   }
+
+  SizeType src_size = 0;
+  SizeType n = val1.size();
+  if ( n > 0 ) {
+    uword last = val1[n - 1];
+    src_size = (n - 1) * BLOCK_SIZE + BLOCK_SIZE - __builtin_clzll(last);
+  }
   else {
     // 1ビットの0を入れておく
     val1.push_back(0);
-    val0.push_back(1);
     src_size = 1;
   }
+  vector<uword> val0(val1.size());
+  for ( SizeType i = 0; i < val1.size(); ++ i ) {
+    val0[i] = ~val1[i];
+  }
 
   // この文字列の先頭に - はつかないので結果は必ず非負の数だが，
   // MSBが1の場合にこれをそのまま符号つき数とみなすと符号拡張して
@@ -844,63 +1059,18 @@ BitVector::set_from_hexstring(
   SizeType size,
   bool is_sized,
   bool is_signed,
-  const string& str,
-  int pos
+  const char* str,
+  SizeType len
 )
 {
   // 文字列の表している値を求める．
   // 実際に格納するものはサイズなどの属性が異なるので set() を用いる．
-  string::size_type end = str.size();
-  SizeType src_size = (end - pos) * 4;
+  SizeType src_size = len * 4;
   SizeType src_n = block(src_size);
   uword val0[src_n];
   uword val1[src_n];
-  for ( SizeType i = 0; i < src_n; ++ i ) {
-    val0[i] = ALL1;
-    val1[i] = ALL0;
-  }
-  SizeType vpos = src_size - 4;
-  for ( ; pos < end; pos ++, vpos -= 4) {
-    SizeType blk = vpos / BLOCK_SIZE;
-    SizeType sft = vpos - blk * BLOCK_SIZE;
-    char c = str[pos];
-    if ( '0' <= c && c <= '9' ) {
-      uword val = c - '0';
-      uword ppat = val << sft;
-      uword npat = ~ppat;
-      val0[blk] &= npat;
-      val1[blk] |= ppat;
-    }
-    else if ( 'a' <= c && c <= 'f' ) {
-      uword val = c - 'a' + 10;
-      uword ppat = val << sft;
-      uword npat = ~ppat;
-      val0[blk] &= npat;
-      val1[blk] |= ppat;
-    }
-    else if ( 'A' <= c && c <= 'F' ) {
-      uword val = c - 'A' + 10;
-      uword ppat = val << sft;
-      uword npat = ~ppat;
-      val0[blk] &= npat;
-      val1[blk] |= ppat;
-    }
-    else if ( c == 'x' || c == 'X' ) {
-      uword ppat = 15 << sft;
-      val0[blk] |= ppat;
-      val1[blk] |= ppat;
-    }
-    else if ( c == 'z' || c == 'Z' || c == '?' ) {
-      uword npat = ~(15 << sft);
-      val0[blk] &= npat;
-      val1[blk] &= npat;
-    }
-    else {
-      // 本当は例外を投げるのがいいな．
-      cerr << "illegal character (" << c << ") in string "
-	   << str << endl;
-      return;
-    }
+  if ( !parse_pow2(str, len, 4, val0, val1) ) {
+    return;
   }
 
   // この文字列の先頭に - はつかないので結果は必ず非負の数だが，
@@ -931,19 +1101,17 @@ BitVector::set_from_string(
     char c = str[i];
     tmp += (static_cast<uword>(c) << (k * 8));
     ++ k;
-    if ( k == 4 ) {
-      mVal0.get()[j] = ~tmp;
-      mVal1.get()[j] =  tmp;
+    if ( k == sizeof(uword) ) {
+      mVal1.get()[j] = tmp;
       ++ j;
       k = 0;
       tmp = 0;
     }
   }
   if ( k != 0 ) {
-    uword mask = ALL1 << (k * 8);
-    mVal0.get()[j] = ~tmp | mask;
     mVal1.get()[j] = tmp;
   }
+  set_2state();
 }
 
 END_NAMESPACE_YM_VERILOG
@@ -7,6 +7,8 @@
 /// All rights reserved.
 
 #include "ym/BitVector.h"
+#include "BvKernel.h"
+#include <cmath>
 
 
 BEGIN_NAMESPACE_YM_VERILOG
@@ -80,54 +82,50 @@ size_to_dec_str(int val)
 END_NONAMESPACE
 
 
-// @brief src を 10 で割る．
-// @param[in] src 元の値
-// @param[out] q 求まった商を格納する変数
-// @return 余りを返す．
-int
-BitVector::div10(const uword* src,
-		 int n,
-		 uword* q)
-{
-  int l = n * BLOCK_SIZE;
-  int r = 0;
-  for ( int i = l; i -- > 0; ) {
-    r <<= 1;
-    int blk = i / BLOCK_SIZE;
-    int pos = i % BLOCK_SIZE;
-    if ( (src[blk] >> pos) & 1 ) {
-      r |= 1;
-    }
-    if ( r >= 10 ) {
-      r -= 10;
-      q[blk] |= 1 << pos;
-    }
-  }
-  return r;
-}
-
 // @brief val を10進数で表した文字列を返す．
+//
+// 10^18 で割った余りを求めることを繰り返して 18 桁ずつ変換する．
 string
-BitVector::dec_str_sub(const uword* val,
-		       int n)
+BitVector::dec_str_sub(
+  const uword* val,
+  SizeType n
+)
 {
-  uword val1[n];
-  for ( int i = 0; i < n; ++ i ) {
-    val1[i] = 0;
-  }
-  int r = div10(val, n, val1);
-  bool zero = true;
-  for ( int i = 0; i < n; ++ i ) {
-    if ( val1[i] ) {
-      zero = false;
-      break;
+  // 1ワードに収まる最大の 10 のべき乗
+  const uword CHUNK = 1000000000000000000ULL;
+  const SizeType CHUNK_DIGITS = 18;
+
+  vector<uword> q(val, val + n);
+  // 上位の0のワードは除いておく．
+  while ( n > 0 && q[n - 1] == 0 ) {
+    -- n;
+  }
+  if ( n == 0 ) {
+    return "0";
+  }
+
+  // 下位の桁から順に求まる．
+  vector<uword> chunk_list;
+  while ( n > 0 ) {
+    // q を CHUNK で割る．
+    unsigned __int128 r = 0;
+    for ( SizeType i = n; i -- > 0; ) {
+      unsigned __int128 cur = (r << BLOCK_SIZE) | q[i];
+      q[i] = static_cast<uword>(cur / CHUNK);
+      r = cur % CHUNK;
+    }
+    chunk_list.push_back(static_cast<uword>(r));
+    while ( n > 0 && q[n - 1] == 0 ) {
+      -- n;
     }
   }
-  string ans;
-  if ( !zero ) {
-    ans = dec_str_sub(val1, n);
+
+  string ans = std::to_string(chunk_list.back());
+  for ( SizeType i = chunk_list.size() - 1; i -- > 0; ) {
+    auto str = std::to_string(chunk_list[i]);
+    ans.append(CHUNK_DIGITS - str.size(), '0');
+    ans += str;
   }
-  ans += hexchar(r);
   return ans;
 }
 
@@ -147,7 +145,7 @@ BitVector::value(int pos) const
 
   SizeType blk = pos / BLOCK_SIZE;
   SizeType sft = pos - blk * BLOCK_SIZE;
-  uword msk = 1 << sft;
+  uword msk = static_cast<uword>(1) << sft;
   if ( mVal1.get()[blk] & msk ) {
     if ( mVal0.get()[blk] & msk ) {
       return VlScalarVal::x();
@@ -170,52 +168,56 @@ BitVector::value(int pos) const
 bool
 BitVector::has_x() const
 {
-  SizeType n = block(size());
-  for ( SizeType i = 0; i < n - 1; ++ i ) {
-    uword tmp = mVal0.get()[i] & mVal1.get()[i];
-    if ( tmp ) {
-      return true;
-    }
+  if ( is_2state() ) {
+    return false;
   }
-
-  uword m = mask(size());
-  if ( mVal0.get()[n - 1] & mVal1.get()[n - 1] & m ) {
-    return true;
-  }
-  return false;
+  return has_pat(ALL0, ALL0);
 }
 
 // z 値を含んでいたら true を返す
 bool
 BitVector::has_z() const
 {
+  if ( is_2state() ) {
+    return false;
+  }
+  return has_pat(ALL1, ALL1);
+}
+
+// x か z を含んでいたら true を返す
+bool
+BitVector::has_xz() const
+{
+  if ( is_2state() ) {
+    return false;
+  }
+
   SizeType n = block(size());
-  for ( SizeType i = 0; i < n - 1; ++ i ) {
-    if ( (mVal0.get()[i] | mVal1.get()[i]) != ALL1 ) {
-      return true;
-    }
+  if ( BvKernel::get().mAnyXZ(mVal0.get(), mVal1.get(), n - 1) ) {
+    return true;
   }
 
   uword m = mask(size());
-  if ( (mVal0.get()[n - 1] | mVal1.get()[n - 1] | ~m) != ALL1 ) {
+  if ( ((mVal0.get()[n - 1] ^ mVal1.get()[n - 1]) | ~m) != ALL1 ) {
     return true;
   }
   return false;
 }
 
-// x か z を含んでいたら true を返す
+// @brief 指定されたパタンのビットを含んでいたら true を返す．
 bool
-BitVector::has_xz() const
+BitVector::has_pat(
+  uword inv0,
+  uword inv1
+) const
 {
   SizeType n = block(size());
-  for ( SizeType i = 0; i < n - 1; ++ i ) {
-    if ( (mVal0.get()[i] ^ mVal1.get()[i]) != ALL1 ) {
-      return true;
-    }
+  if ( BvKernel::get().mAny(mVal0.get(), mVal1.get(), inv0, inv1, n - 1) ) {
+    return true;
   }
 
   uword m = mask(size());
-  if ( ((mVal0.get()[n - 1] ^ mVal1.get()[n - 1]) | ~m) != ALL1 ) {
+  if ( (mVal0.get()[n - 1] ^ inv0) & (mVal1.get()[n - 1] ^ inv1) & m ) {
     return true;
   }
   return false;
@@ -243,18 +245,15 @@ BitVector::z_to_x()
 void
 BitVector::xz_to_0()
 {
+  if ( is_2state() ) {
+    return;
+  }
+  // 1 のビットだけを残す．
   SizeType n = block(size());
-  for ( SizeType i = 0; i < n - 1; ++ i ) {
-    uword pat = ~mVal0.get()[i] & mVal1.get()[i];
-    mVal0.get()[i] = ~pat;
-    mVal1.get()[i] = pat;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    mVal1.get()[i] &= ~mVal0.get()[i];
   }
-  uword m = mask(size());
-  uword pat = ~mVal0.get()[n - 1] & mVal1.get()[n - 1];
-  uword andpat = ~pat | ~m;
-  uword orpat = pat & m;
-  mVal0.get()[n - 1] = (mVal0.get()[n - 1] | orpat) & andpat;
-  mVal1.get()[n - 1] = (mVal1.get()[n - 1] | orpat) & andpat;
+  set_2state();
 }
 
 // 値を近い double 型に変換する．
@@ -267,41 +266,26 @@ BitVector::to_real() const
   SizeType n = block(size());
   double ans = 0.0;
   for ( SizeType i = 0; i < n; ++ i ) {
-    const double mag = static_cast<double>(1 << (i * BLOCK_SIZE));
-    ans += static_cast<double>(mVal1.get()[i]) * mag;
+    ans += ldexp(static_cast<double>(tmp.mVal1.get()[i]), i * BLOCK_SIZE);
   }
   return ans;
 }
 
 // @brief 論理値として評価する．
 // @retval VlScalarVal::zero() 0 の時
-// @retval VlScalarVal::one() 0 以外の確定値の時
-// @retval VlScalarVal::x() 不定値を1ビットでも含む場合
+// @retval VlScalarVal::one() 1 のビットを1つでも含む時
+// @retval VlScalarVal::x() 上記以外で不定値を1ビットでも含む場合
 VlScalarVal
 BitVector::to_logic() const
 {
-  SizeType n = block(size());
-  for ( SizeType i = 0; i < n - 1; ++ i ) {
-    uword pat0 = mVal0.get()[i];
-    uword pat_xor = pat0 ^ mVal1.get()[i];
-    if ( pat_xor != ALL1 ) {
-      // X/Z のパタンがあった
-      return VlScalarVal::x();
-    }
-    if ( pat0 != ALL0 ) {
-      return VlScalarVal::one();
-    }
+  // 1 ビットでも 1 のビットがあれば 1
+  if ( has_pat(ALL1, ALL0) ) {
+    return VlScalarVal::one();
   }
-  uword m = mask(size());
-  uword pat0 = mVal0.get()[n - 1];
-  uword pat_xor = (pat0 ^ mVal1.get()[n - 1]) | ~m;
-  if ( pat_xor != ALL1 ) {
-    // X/Z のパタンがあった
+  // そうでなくて x/z のビットがあれば x
+  if ( has_xz() ) {
     return VlScalarVal::x();
   }
-  if ( pat0 != ALL0 ) {
-    return VlScalarVal::one();
-  }
   return VlScalarVal::zero();
 }
 
@@ -588,6 +572,35 @@ BitVector::hex_str(bool skip_zeros) const
   return ans;
 }
 
+// @brief ハッシュ値を返す．
+SizeType
+BitVector::hash() const
+{
+  // 2値のフラグは値から決まるので含めない．
+  SizeType h = (mSize << 4) | (mFlags.to_ulong() & 0xF);
+  SizeType n = block(size());
+  for ( SizeType i = 0; i < n; ++ i ) {
+    h = h * 1048573 + mVal0.get()[i];
+    h = h * 1048573 + mVal1.get()[i];
+  }
+  return h;
+}
+
+// @brief ビット長，属性，値が全て等しい時に true を返す．
+bool
+BitVector::is_identical(
+  const BitVector& right
+) const
+{
+  if ( mSize != right.mSize ||
+       is_sized() != right.is_sized() ||
+       is_signed() != right.is_signed() ||
+       base() != right.base() ) {
+    return false;
+  }
+  return eq_base(*this, right, 1);
+}
+
 // 値をセットする関数
 // これは1語に収まる時に用いる．
 void
@@ -607,6 +620,7 @@ BitVector::set(
   uword m = mask(size);
   mVal0.get()[0] = val0 | ~m;
   mVal1.get()[0] = val1 & m;
+  mFlags[4] = (mVal0.get()[0] ^ mVal1.get()[0]) == ALL1;
 }
 
 // 値をセットする関数
@@ -621,6 +635,16 @@ BitVector::set(
   SizeType base
 )
 {
+  if ( val0 == mVal0.get() ) {
+    // 自分自身の値を元にする場合には resize() で元の値が
+    // 壊れることがあるので先にコピーしておく．
+    SizeType src_n = block(src_size);
+    vector<uword> tmp0(val0, val0 + src_n);
+    vector<uword> tmp1(val1, val1 + src_n);
+    set(tmp0, tmp1, src_size, size, has_size, has_sign, base);
+    return;
+  }
+
   resize(size);
   set_type(has_size, has_sign, base);
 
@@ -668,6 +692,9 @@ BitVector::set(
   uword m = mask(size);
   mVal0.get()[n - 1] |= ~m;
   mVal1.get()[n - 1] &= m;
+
+  // トリミング後なら全ワードを調べればよい．
+  mFlags[4] = !BvKernel::get().mAnyXZ(mVal0.get(), mVal1.get(), n);
 }
 
 // 値をセットする関数
@@ -729,19 +756,36 @@ BitVector::set(
   uword m = mask(size);
   mVal0.get()[n - 1] |= ~m;
   mVal1.get()[n - 1] &= m;
+
+  // トリミング後なら全ワードを調べればよい．
+  mFlags[4] = !BvKernel::get().mAnyXZ(mVal0.get(), mVal1.get(), n);
 }
 
 // mVal0, mVal1 のリサイズをする．
 void
 BitVector::resize(SizeType size)
 {
-  SizeType old_bsize = block(mSize);
   mSize = size;
+  mFlags[4] = false;
   SizeType new_bsize = block(mSize);
-  if ( new_bsize > old_bsize ) {
-    mVal0 = unique_ptr<uword>{new uword[new_bsize]};
-    mVal1 = unique_ptr<uword>{new uword[new_bsize]};
+  mVal0.alloc(new_bsize);
+  mVal1.alloc(new_bsize);
+}
+
+// mVal1 から mVal0 を作り，2値のフラグを立てる．
+void
+BitVector::set_2state()
+{
+  SizeType n = block(size());
+  uword* val0 = mVal0.get();
+  uword* val1 = mVal1.get();
+  for ( SizeType i = 0; i < n; ++ i ) {
+    val0[i] = ~val1[i];
   }
+  uword m = mask(size());
+  val0[n - 1] |= ~m;
+  val1[n - 1] &= m;
+  mFlags[4] = true;
 }
 
 END_NAMESPACE_YM_VERILOG
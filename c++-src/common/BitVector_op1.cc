@@ -47,45 +47,302 @@ mask(SizeType size)
   return ALL1 >> (BLOCK_SIZE - shift(size));
 }
 
-// @brief a * b の結果を2ワードで返す．
-// - <ret-val>.first が high-word
-// - <ret-val>.second が low-word
-pair<uword, uword>
-mult32(uword a,
-       uword b)
+// 2ワード分の符号なし整数
+using dword = unsigned __int128;
+
+// Karatsuba 法を用いる最小のワード数
+const SizeType KARATSUBA_THRESHOLD = 32;
+
+// @brief 上位の0のワードを除いたワード数を返す．
+inline
+SizeType
+word_num(const uword* a,
+	 SizeType n)
+{
+  while ( n > 0 && a[n - 1] == 0 ) {
+    -- n;
+  }
+  return n;
+}
+
+// @brief r = a + b を計算する．
+// @return 桁上がりを返す．
+//
+// a, b, r はともに n ワードで，r は a または b と同じでもよい．
+inline
+uword
+add_words(uword* r,
+	  const uword* a,
+	  const uword* b,
+	  SizeType n)
+{
+  uword carry = 0;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    uword s;
+    uword c1 = __builtin_add_overflow(a[i], b[i], &s);
+    uword c2 = __builtin_add_overflow(s, carry, &r[i]);
+    carry = c1 | c2;
+  }
+  return carry;
+}
+
+// @brief r = a - b を計算する．
+// @return 桁借りを返す．
+//
+// a, b, r はともに n ワードで，r は a または b と同じでもよい．
+inline
+uword
+sub_words(uword* r,
+	  const uword* a,
+	  const uword* b,
+	  SizeType n)
+{
+  uword borrow = 0;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    uword s;
+    uword b1 = __builtin_sub_overflow(a[i], b[i], &s);
+    uword b2 = __builtin_sub_overflow(s, borrow, &r[i]);
+    borrow = b1 | b2;
+  }
+  return borrow;
+}
+
+// @brief r の先頭 rn ワードに a (an ワード)を加える．
+//
+// r を越える桁上がりは捨てる．
+void
+add_into(uword* r,
+	 SizeType rn,
+	 const uword* a,
+	 SizeType an)
+{
+  uword carry = 0;
+  SizeType i = 0;
+  for ( ; i < an && i < rn; ++ i ) {
+    uword s;
+    uword c1 = __builtin_add_overflow(r[i], a[i], &s);
+    uword c2 = __builtin_add_overflow(s, carry, &r[i]);
+    carry = c1 | c2;
+  }
+  for ( ; carry && i < rn; ++ i ) {
+    carry = __builtin_add_overflow(r[i], carry, &r[i]);
+  }
+}
+
+// @brief r の先頭 rn ワードから a (an ワード)を引く．
+//
+// r を越える桁借りは捨てる．
+void
+sub_from(uword* r,
+	 SizeType rn,
+	 const uword* a,
+	 SizeType an)
+{
+  uword borrow = 0;
+  SizeType i = 0;
+  for ( ; i < an && i < rn; ++ i ) {
+    uword s;
+    uword b1 = __builtin_sub_overflow(r[i], a[i], &s);
+    uword b2 = __builtin_sub_overflow(s, borrow, &r[i]);
+    borrow = b1 | b2;
+  }
+  for ( ; borrow && i < rn; ++ i ) {
+    borrow = __builtin_sub_overflow(r[i], borrow, &r[i]);
+  }
+}
+
+// @brief 筆算法で r = a * b の下位 rn ワードを計算する．
+//
+// r は0で初期化されており，a, b とは異なる領域でなければならない．
+void
+mul_school(uword* r,
+	   SizeType rn,
+	   const uword* a,
+	   SizeType an,
+	   const uword* b,
+	   SizeType bn)
+{
+  for ( SizeType i = 0; i < an && i < rn; ++ i ) {
+    uword ai = a[i];
+    if ( ai == 0 ) {
+      continue;
+    }
+    uword carry = 0;
+    SizeType j = 0;
+    for ( ; j < bn && i + j < rn; ++ j ) {
+      dword t = static_cast<dword>(ai) * b[j] + r[i + j] + carry;
+      r[i + j] = static_cast<uword>(t);
+      carry = static_cast<uword>(t >> BLOCK_SIZE);
+    }
+    if ( i + j < rn ) {
+      // r[i + bn] はまだ書き込まれていない．
+      r[i + j] = carry;
+    }
+  }
+}
+
+// @brief Karatsuba 法で r = a * b を計算する．
+//
+// a, b はともに n ワード，r は 2n ワードで a, b とは異なる領域
+// でなければならない．
+void
+mul_karatsuba(uword* r,
+	      const uword* a,
+	      const uword* b,
+	      SizeType n)
+{
+  if ( n < KARATSUBA_THRESHOLD ) {
+    fill(r, r + n * 2, ALL0);
+    mul_school(r, n * 2, a, n, b, n);
+    return;
+  }
+
+  // a = a1 * W^h + a0, b = b1 * W^h + b0 と分割する．
+  // 計算を簡単にするために a0, b0 も m ワードに拡張する．
+  SizeType h = n / 2;
+  SizeType m = n - h;
+  vector<uword> a0(m, ALL0);
+  vector<uword> b0(m, ALL0);
+  copy(a, a + h, a0.begin());
+  copy(b, b + h, b0.begin());
+  const uword* a1 = a + h;
+  const uword* b1 = b + h;
+
+  // z0 = a0 * b0, z2 = a1 * b1
+  vector<uword> z0(m * 2);
+  vector<uword> z2(m * 2);
+  mul_karatsuba(z0.data(), a0.data(), b0.data(), m);
+  mul_karatsuba(z2.data(), a1, b1, m);
+
+  // z1 = (a0 + a1) * (b0 + b1) - z0 - z2
+  vector<uword> sa(m + 1);
+  vector<uword> sb(m + 1);
+  sa[m] = add_words(sa.data(), a0.data(), a1, m);
+  sb[m] = add_words(sb.data(), b0.data(), b1, m);
+  vector<uword> z1((m + 1) * 2);
+  mul_karatsuba(z1.data(), sa.data(), sb.data(), m + 1);
+  sub_from(z1.data(), z1.size(), z0.data(), z0.size());
+  sub_from(z1.data(), z1.size(), z2.data(), z2.size());
+
+  // r = z2 * W^2h + z1 * W^h + z0
+  fill(r, r + n * 2, ALL0);
+  add_into(r, n * 2, z0.data(), z0.size());
+  add_into(r + h * 2, n * 2 - h * 2, z2.data(), z2.size());
+  add_into(r + h, n * 2 - h, z1.data(), z1.size());
+}
+
+// @brief r = a * b の下位 n ワードを計算する．
+//
+// a, b, r はともに n ワードで，r は a または b と同じでもよい．
+void
+mul_words(uword* r,
+	  const uword* a,
+	  const uword* b,
+	  SizeType n)
+{
+  SizeType an = word_num(a, n);
+  SizeType bn = word_num(b, n);
+  if ( an >= KARATSUBA_THRESHOLD && bn >= KARATSUBA_THRESHOLD ) {
+    vector<uword> tmp(n * 2);
+    mul_karatsuba(tmp.data(), a, b, n);
+    copy(tmp.begin(), tmp.begin() + n, r);
+  }
+  else {
+    vector<uword> tmp(n, ALL0);
+    mul_school(tmp.data(), n, a, an, b, bn);
+    copy(tmp.begin(), tmp.end(), r);
+  }
+}
+
+// @brief q = u / v, r = u % v を計算する．
+//
+// u, q, r はともに n ワード，v は n ワード以下で最上位のワードは
+// 0 であってはならない．
+// Knuth の Algorithm D (TAOCP 4.3.1) を用いる．
+void
+divmod_words(uword* q,
+	     uword* r,
+	     const uword* u,
+	     SizeType n,
+	     const uword* v,
+	     SizeType vn)
 {
-  uword al = a & 0xffff;
-  uword ah = a >> 16;
-  uword bl = b & 0xffff;
-  uword bh = b >> 16;
-
-  uword tmp_ll = al * bl;
-  uword tmp_lh = al * bh;
-  uword tmp_hl = ah * bl;
-  uword tmp_hh = ah * bh;
-
-  uword tmp_lll = tmp_ll & 0xffff;
-  uword tmp_llh = tmp_ll >> 16;
-  uword tmp_lhl = tmp_lh & 0xffff;
-  uword tmp_lhh = tmp_lh >> 16;
-  uword tmp_hll = tmp_hl & 0xffff;
-  uword tmp_hlh = tmp_hl >> 16;
-  uword tmp_hhl = tmp_hh & 0xffff;
-  uword tmp_hhh = tmp_hh >> 16;
-
-  uword c0 = tmp_lll;
-  uword c1 = tmp_llh + tmp_hll + tmp_lhl;
-  uword c1h = c1 >> 16;
-  c1 &= 0xffff;
-  uword c2 = c1h + tmp_hlh + tmp_lhh + tmp_hhl;
-  uword c2h = c2 >> 16;
-  c2 &= 0xffff;
-  uword c3 = c2h + tmp_hhh;
-
-  uword cl = (c1 << 16) + c0;
-  uword ch = (c3 << 16) + c2;
-
-  return make_pair(ch, cl);
+  fill(q, q + n, ALL0);
+  fill(r, r + n, ALL0);
+  SizeType un = word_num(u, n);
+  if ( un < vn ) {
+    copy(u, u + un, r);
+    return;
+  }
+
+  if ( vn == 1 ) {
+    // 1ワードで割る場合
+    dword rem = 0;
+    for ( SizeType i = un; i -- > 0; ) {
+      dword cur = (rem << BLOCK_SIZE) | u[i];
+      q[i] = static_cast<uword>(cur / v[0]);
+      rem = cur % v[0];
+    }
+    r[0] = static_cast<uword>(rem);
+    return;
+  }
+
+  // v の最上位ビットが1になるように正規化する．
+  int s = __builtin_clzll(v[vn - 1]);
+  vector<uword> nv(vn);
+  vector<uword> nu(un + 1);
+  for ( SizeType i = vn; i -- > 1; ) {
+    nv[i] = s ? (v[i] << s) | (v[i - 1] >> (BLOCK_SIZE - s)) : v[i];
+  }
+  nv[0] = v[0] << s;
+  nu[un] = s ? u[un - 1] >> (BLOCK_SIZE - s) : 0;
+  for ( SizeType i = un; i -- > 1; ) {
+    nu[i] = s ? (u[i] << s) | (u[i - 1] >> (BLOCK_SIZE - s)) : u[i];
+  }
+  nu[0] = u[0] << s;
+
+  for ( SizeType j = un - vn + 1; j -- > 0; ) {
+    // 商の1ワードを見積もる．
+    dword num = (static_cast<dword>(nu[j + vn]) << BLOCK_SIZE) | nu[j + vn - 1];
+    dword qhat = num / nv[vn - 1];
+    dword rhat = num % nv[vn - 1];
+    while ( (qhat >> BLOCK_SIZE) != 0 ||
+	    qhat * nv[vn - 2] > ((rhat << BLOCK_SIZE) | nu[j + vn - 2]) ) {
+      -- qhat;
+      rhat += nv[vn - 1];
+      if ( (rhat >> BLOCK_SIZE) != 0 ) {
+	break;
+      }
+    }
+
+    // nu[j..j+vn] から qhat * nv を引く．
+    uword borrow = 0;
+    uword carry = 0;
+    for ( SizeType i = 0; i < vn; ++ i ) {
+      dword p = qhat * nv[i] + carry;
+      carry = static_cast<uword>(p >> BLOCK_SIZE);
+      uword s1;
+      uword b1 = __builtin_sub_overflow(nu[i + j], static_cast<uword>(p), &s1);
+      uword b2 = __builtin_sub_overflow(s1, borrow, &nu[i + j]);
+      borrow = b1 | b2;
+    }
+    uword s1;
+    uword b1 = __builtin_sub_overflow(nu[j + vn], carry, &s1);
+    uword b2 = __builtin_sub_overflow(s1, borrow, &nu[j + vn]);
+
+    if ( b1 | b2 ) {
+      // 引きすぎたので戻す．
+      -- qhat;
+      uword c = add_words(&nu[j], &nu[j], nv.data(), vn);
+      nu[j + vn] += c;
+    }
+    q[j] = static_cast<uword>(qhat);
+  }
+
+  // 余りは正規化を元に戻す．
+  for ( SizeType i = 0; i < vn; ++ i ) {
+    r[i] = s ? (nu[i] >> s) | (nu[i + 1] << (BLOCK_SIZE - s)) : nu[i];
+  }
 }
 
 END_NONAMESPACE
@@ -114,7 +371,6 @@ BitVector::complement()
   // 全ビットを反転して1を足す
   SizeType n = block(size());
   bool carry = true;
-  uword m = mask(size());
   for ( SizeType i = 0; i < n; ++ i ) {
     mVal1.get()[i] = mVal0.get()[i];
     if ( carry ) {
@@ -127,12 +383,8 @@ BitVector::complement()
 	carry = false;
       }
     }
-    mVal0.get()[i] = ~mVal1.get()[i];
-    if ( i == n - 1) {
-      mVal0.get()[i] |= ~m;
-      mVal1.get()[i] &= m;
-    }
   }
+  set_2state();
 
   return *this;
 }
@@ -168,20 +420,14 @@ BitVector::operator+=(const BitVector& src)
   set_type(ans_sized, ans_signed, ans_base);
 
   SizeType n = block(size());
-  uword carry = 0;
-  for ( SizeType i = 0; i < n; ++ i ) {
-    uword old_val = mVal1.get()[i];
-    mVal1.get()[i] += src.mVal1.get()[i] + carry;
-    mVal0.get()[i] = ~mVal1.get()[i];
-    // carry 条件ってなに？
-    // ans のほうが見掛け上小さくなったとき
-    if ( mVal1.get()[i] < old_val ) {
-      carry = 1;
-    }
-    else {
-      carry = 0;
-    }
+  if ( n == 1 ) {
+    // 1ワードの場合
+    mVal1.get()[0] += src.mVal1.get()[0];
   }
+  else {
+    add_words(mVal1.get(), mVal1.get(), src.mVal1.get(), n);
+  }
+  set_2state();
 
   return *this;
 }
@@ -217,25 +463,22 @@ BitVector::operator-=(const BitVector& src)
   set_type(ans_sized, ans_signed, ans_base);
 
   SizeType n = block(size());
-  uword carry = 1;
-  for ( SizeType i = 0; i < n; ++ i ) {
-    uword old_val = mVal1.get()[i];
-    mVal1.get()[i] += ~src.mVal1.get()[i] + carry;
-    mVal0.get()[i] = ~mVal1.get()[i];
-    // carry 条件ってなに？
-    // ans のほうが見掛け上小さくなったとき
-    if ( mVal1.get()[i] < old_val ) {
-      carry = 1;
-    }
-    else {
-      carry = 0;
-    }
+  if ( n == 1 ) {
+    // 1ワードの場合
+    mVal1.get()[0] -= src.mVal1.get()[0];
+  }
+  else {
+    sub_words(mVal1.get(), mVal1.get(), src.mVal1.get(), n);
   }
+  set_2state();
 
   return *this;
 }
 
 // 乗算つき代入
+//
+// 結果のビット長で切り詰めた値は2の補数表現で符号付きでも
+// 符号なしでも同じなので符号を考慮する必要はない．
 const BitVector&
 BitVector::operator*=(const BitVector& src)
 {
@@ -260,49 +503,70 @@ BitVector::operator*=(const BitVector& src)
     return *this = BitVector::x(ans_size);
   }
 
-  // 符号あわせをしておく．
-  BitVector tmp1 = ans_signed && is_negative() ? - *this : *this;
-  BitVector tmp2 = ans_signed && src.is_negative() ? - src : src;
-  bool invert = ans_signed ? is_negative() ^ src.is_negative() : false;
-
   set_type(ans_sized, ans_signed, ans_base);
 
   SizeType n = block(size());
-  uword carry = 0;
-  for ( SizeType i = 0; i < n; ++ i ) {
-    uword v = carry;
-    carry = 0;
-    for ( SizeType j = 0; j <= i; ++ j ) {
-      uword old_v = v;
-      pair<uword, uword> tmp = mult32(tmp1.mVal1.get()[j], tmp2.mVal1.get()[i - j]);
-      v += tmp.second;
-      if ( v < old_v ) {
-	++ carry;
-      }
-    }
-    for ( SizeType j = 0; j < i; ++ j ) {
-      uword old_v = v;
-      pair<uword, uword> tmp = mult32(tmp1.mVal1.get()[j], tmp2.mVal1.get()[i - j - 1]);
-      v += tmp.first;
-      if ( v < old_v ) {
-	++ carry;
-      }
-    }
-    mVal1.get()[i] = v;
-    mVal0.get()[i] = ~v;
+  if ( n == 1 ) {
+    // 1ワードの場合
+    mVal1.get()[0] *= src.mVal1.get()[0];
   }
-  // 上位ビットをマスクしておく
-  uword m = mask(ans_size);
-  mVal0.get()[n - 1] |= ~m;
-  mVal1.get()[n - 1] &= m;
-
-  if ( invert ) {
-    complement();
+  else {
+    mul_words(mVal1.get(), mVal1.get(), src.mVal1.get(), n);
   }
+  set_2state();
 
   return *this;
 }
 
+// @brief 除算と剰余算の共通部分
+//
+// 両方のオペランドは同じビット長で X/Z を含まないものとする．
+// 符号付きの場合は絶対値で計算してから符号を合わせる．
+// 商は0方向に丸められ，余りの符号は被除数と同じになる．
+// 除数が0の時は false を返す．
+bool
+BitVector::divmod_base(
+  const BitVector& src1,
+  const BitVector& src2,
+  BitVector& q,
+  BitVector& r
+)
+{
+  bool ans_signed = src1.is_signed() && src2.is_signed();
+  bool neg1 = ans_signed && src1.is_negative();
+  bool neg2 = ans_signed && src2.is_negative();
+  BitVector tmp1 = neg1 ? - src1 : src1;
+  BitVector tmp2 = neg2 ? - src2 : src2;
+
+  SizeType size = src1.size();
+  SizeType n = block(size);
+  SizeType vn = word_num(tmp2.mVal1.get(), n);
+  if ( vn == 0 ) {
+    return false;
+  }
+
+  q = BitVector(VlScalarVal::zero(), size);
+  r = BitVector(VlScalarVal::zero(), size);
+  if ( n == 1 ) {
+    // 1ワードの場合
+    q.mVal1.get()[0] = tmp1.mVal1.get()[0] / tmp2.mVal1.get()[0];
+    r.mVal1.get()[0] = tmp1.mVal1.get()[0] % tmp2.mVal1.get()[0];
+  }
+  else {
+    divmod_words(q.mVal1.get(), r.mVal1.get(),
+		 tmp1.mVal1.get(), n, tmp2.mVal1.get(), vn);
+  }
+  q.set_2state();
+  r.set_2state();
+  if ( neg1 ^ neg2 ) {
+    q.complement();
+  }
+  if ( neg1 ) {
+    r.complement();
+  }
+  return true;
+}
+
 // 除算つき代入
 const BitVector&
 BitVector::operator/=(const BitVector& src)
@@ -328,33 +592,14 @@ BitVector::operator/=(const BitVector& src)
     return *this = BitVector::x(ans_size);
   }
 
-  // 符号あわせをしておく．
-  BitVector tmp1 = ans_signed && is_negative() ? - *this : *this;
-  BitVector tmp2 = ans_signed && src.is_negative() ? - src : src;
-  bool invert = ans_signed ? is_negative() ^ src.is_negative() : false;
-
-  set_type(ans_sized, ans_signed, ans_base);
-
-  tmp1.set_type(tmp1.is_sized(), false, tmp1.base());
-  tmp2.set_type(tmp2.is_sized(), false, tmp2.base());
-
-  BitVector p(VlScalarVal::zero(), ans_size);
-  for ( SizeType i = ans_size; i -- > 0; ) {
-    p <<= 1;
-    if ( tmp1.value(i).is_one() ) {
-      p.mVal0.get()[0] &= ~1U;
-      p.mVal1.get()[0] |= 1U;
-    }
-    if ( p >= tmp2 ) {
-      p -= tmp2;
-      mVal0.get()[i] &= ~1U;
-      mVal1.get()[i] |= 1U;
-    }
-  }
-
-  if ( invert ) {
-    complement();
+  BitVector q;
+  BitVector r;
+  if ( !divmod_base(*this, src, q, r) ) {
+    // 0 除算の結果は X
+    return *this = BitVector::x(ans_size);
   }
+  *this = q;
+  set_type(ans_sized, ans_signed, ans_base);
 
   return *this;
 }
@@ -369,7 +614,7 @@ BitVector::operator%=(const BitVector& src)
   }
   bool ans_sized = is_sized() || src.is_sized();
   bool ans_signed = is_signed() && src.is_signed();
-  int ans_base = src.base();
+  int ans_base = base();
   if ( ans_base != src.base() ) {
     ans_base = 10;
   }
@@ -384,35 +629,26 @@ BitVector::operator%=(const BitVector& src)
     return *this = BitVector::x(ans_size);
   }
 
-  // 符号あわせをしておく．
-  BitVector tmp1 = ans_signed && is_negative() ? - *this : *this;
-  BitVector tmp2 = ans_signed && src.is_negative() ? - src : src;
-  bool invert = ans_signed ? is_negative() : false;
-
-  tmp2.set_type(tmp2.is_sized(), false, tmp2.base());
-
-  set_type(ans_sized, ans_signed, ans_base);
-  *this = BitVector(VlScalarVal::zero(), ans_size);
-
-  for ( SizeType i = ans_size; i -- > 0; ) {
-    operator<<=(1);
-    if ( tmp1.value(i).is_one() ) {
-      mVal0.get()[0] &= ~1U;
-      mVal1.get()[0] |= 1U;
-    }
-    if ( *this >= tmp2 ) {
-      operator-=(tmp2);
-    }
-  }
-
-  if ( invert ) {
-    complement();
+  BitVector q;
+  BitVector r;
+  if ( !divmod_base(*this, src, q, r) ) {
+    // 0 除算の結果は X
+    return *this = BitVector::x(ans_size);
   }
+  *this = r;
+  set_type(ans_sized, ans_signed, ans_base);
 
   return *this;
 }
 
 // 巾乗
+//
+// IEEE1364-2005 5.1.5 の規則に従う．
+// 指数が負の数の時は以下のようになる．
+// - 底が0の時は X
+// - 底が1の時は1
+// - 底が-1の時は指数が偶数なら1, 奇数なら-1
+// - それ以外は0
 const BitVector&
 BitVector::power(const BitVector& src)
 {
@@ -437,20 +673,51 @@ BitVector::power(const BitVector& src)
     return *this = BitVector::x(ans_size);
   }
 
-  // 特殊な例: 自分が2ならシフトで代用できる．
-  if ( *this == BitVector(2) ) {
-    *this = 1;
-    return alshift(src);
-  }
+  set_type(ans_sized, ans_signed, ans_base);
 
-  // 馬鹿げた実装
-  BitVector ans(*this);
-  BitVector i(src);
-  BitVector c1(1);
-  BitVector c0(0);
-  for ( i = i - c1; i > c0; i = i - c1 ) {
-    ans *= *this;
+  SizeType n = block(ans_size);
+  BitVector ans(VlScalarVal::zero(), ans_size);
+  ans.set_type(ans_sized, ans_signed, ans_base);
+  if ( src.is_negative() ) {
+    // 負の指数
+    SizeType bn = word_num(mVal1.get(), n);
+    if ( bn == 0 ) {
+      // 底が0
+      return *this = BitVector::x(ans_size);
+    }
+    if ( bn == 1 && mVal1.get()[0] == 1 ) {
+      // 底が1
+      return *this;
+    }
+    if ( is_negative() && (- *this) == BitVector(VlScalarVal::one(), 1) ) {
+      // 底が-1
+      if ( src.value(0).is_zero() ) {
+	*this = - *this;
+      }
+      return *this;
+    }
+    return *this = ans;
+  }
+
+  // 二乗と乗算を繰り返す．
+  BitVector sq(*this);
+  ans.mVal1.get()[0] = 1;
+  const uword* exp_val = src.mVal1.get();
+  SizeType exp_n = word_num(exp_val, n);
+  for ( SizeType i = 0; i < exp_n; ++ i ) {
+    uword e = exp_val[i];
+    for ( SizeType b = 0; b < BLOCK_SIZE; ++ b, e >>= 1 ) {
+      if ( e & 1 ) {
+	mul_words(ans.mVal1.get(), ans.mVal1.get(), sq.mVal1.get(), n);
+      }
+      if ( e == 1 && i == exp_n - 1 ) {
+	// もう1のビットはない．
+	break;
+      }
+      mul_words(sq.mVal1.get(), sq.mVal1.get(), sq.mVal1.get(), n);
+    }
   }
+  ans.set_2state();
   return *this = ans;
 }
 
@@ -569,7 +836,15 @@ BitVector::eq_base(const BitVector& src1,
 {
   if ( mode == 1 ) {
     // 通常の等価比較
-    return src1.mVal0 == src2.mVal0;
+    // 上位ビットはトリミングされているのでワードごとに比較すればよい．
+    SizeType n = block(src1.size());
+    for ( SizeType i = 0; i < n; ++ i ) {
+      if ( src1.mVal0.get()[i] != src2.mVal0.get()[i] ||
+	   src1.mVal1.get()[i] != src2.mVal1.get()[i] ) {
+	return false;
+      }
+    }
+    return true;
   }
 
   if ( mode == 2 ) {
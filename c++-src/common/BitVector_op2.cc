@@ -7,6 +7,7 @@
 /// All rights reserved.
 
 #include "ym/BitVector.h"
+#include "BvKernel.h"
 
 
 BEGIN_NAMESPACE_YM_VERILOG
@@ -110,13 +111,11 @@ BitVector::negate()
   // z を含んでいたときが例外となる．
   // z のビットは x にするのでともに1と立てる
   SizeType n = block(size());
-  for ( SizeType i = 0; i < n; ++ i ) {
-    uword pat0 = mVal0.get()[i];
-    uword pat1 = mVal1.get()[i];
-    uword zpat = ~pat0 & ~pat1; // 1 なら Z
-    mVal0.get()[i] = pat1 | zpat;
-    mVal1.get()[i] = pat0 | zpat;
-  }
+  BvKernel::get().mNegate(mVal0.get(), mVal1.get(), n);
+  // 範囲外のビットを0に戻しておく．
+  uword m = mask(size());
+  mVal0.get()[n - 1] |= ~m;
+  mVal1.get()[n - 1] &= m;
   return *this;
 }
 
@@ -146,28 +145,22 @@ BitVector::operator&=(const BitVector& src)
 
   set_type(ans_sized, ans_signed, ans_base);
 
-  // 基本的には val0 を or して val1 を and すればよいが，
-  // z を含んでいたときが例外となる．
   SizeType n = block(size());
-  for ( SizeType i = 0; i < n; ++ i ) {
-    uword val1_0 = mVal0.get()[i];
-    uword val1_1 = mVal1.get()[i];
-    uword zpat;
-    // z のパタンを x に直しておく．
-    zpat = ~val1_0 & ~val1_1;
-    val1_0 |= zpat;
-    val1_1 |= zpat;
-    uword val2_0 = src.mVal0.get()[i];
-    uword val2_1 = src.mVal1.get()[i];
-    // z のパタンを x に直しておく．
-    zpat = ~val2_0 & ~val2_1;
-    val2_0 |= zpat;
-    val2_1 |= zpat;
-
-    mVal0.get()[i] = val1_0 | val2_0;
-    mVal1.get()[i] = val1_1 & val2_1;
+  if ( is_2state() && src.is_2state() ) {
+    // 2値の場合は 1 の面だけ計算すればよい．
+    for ( SizeType i = 0; i < n; ++ i ) {
+      mVal1.get()[i] &= src.mVal1.get()[i];
+    }
+    set_2state();
+    return *this;
   }
 
+  // 基本的には val0 を or して val1 を and すればよいが，
+  // z を含んでいたときが例外となる．
+  BvKernel::get().mAnd(mVal0.get(), mVal1.get(),
+		       src.mVal0.get(), src.mVal1.get(), n);
+  mFlags[4] = false;
+
   return *this;
 }
 
@@ -197,28 +190,22 @@ BitVector::operator|=(const BitVector& src)
 
   set_type(ans_sized, ans_signed, ans_base);
 
-  // 基本的には val0 を and して val1 を or すればよいが，
-  // z を含んでいたときが例外となる．
   SizeType n = block(size());
-  for ( SizeType i = 0; i < n; ++ i ) {
-    uword val1_0 = mVal0.get()[i];
-    uword val1_1 = mVal1.get()[i];
-    uword zpat;
-    // z のパタンを x に直しておく．
-    zpat = ~val1_0 & ~val1_1;
-    val1_0 |= zpat;
-    val1_1 |= zpat;
-    uword val2_0 = src.mVal0.get()[i];
-    uword val2_1 = src.mVal1.get()[i];
-    // z のパタンを x に直しておく．
-    zpat = ~val2_0 & ~val2_1;
-    val2_0 |= zpat;
-    val2_1 |= zpat;
-
-    mVal0.get()[i] = val1_0 & val2_0;
-    mVal1.get()[i] = val1_1 | val2_1;
+  if ( is_2state() && src.is_2state() ) {
+    // 2値の場合は 1 の面だけ計算すればよい．
+    for ( SizeType i = 0; i < n; ++ i ) {
+      mVal1.get()[i] |= src.mVal1.get()[i];
+    }
+    set_2state();
+    return *this;
   }
 
+  // 基本的には val0 を and して val1 を or すればよいが，
+  // z を含んでいたときが例外となる．
+  BvKernel::get().mOr(mVal0.get(), mVal1.get(),
+		      src.mVal0.get(), src.mVal1.get(), n);
+  mFlags[4] = false;
+
   return *this;
 }
 
@@ -248,27 +235,21 @@ BitVector::operator^=(const BitVector& src)
 
   set_type(ans_sized, ans_signed, ans_base);
 
-  // 計算の仕方は否定とANDとORを組み合わせたもの
   SizeType n = block(size());
-  for ( SizeType i = 0; i < n; ++ i ) {
-    uword val1_0 = mVal0.get()[i];
-    uword val1_1 = mVal1.get()[i];
-    uword zpat;
-    // z のパタンを x に直しておく．
-    zpat = ~val1_0 & ~val1_1;
-    val1_0 |= zpat;
-    val1_1 |= zpat;
-    uword val2_0 = mVal0.get()[i];
-    uword val2_1 = mVal1.get()[i];
-    // z のパタンを x に直しておく．
-    zpat = ~val2_0 & ~val2_1;
-    val2_0 |= zpat;
-    val2_1 |= zpat;
-
-    mVal0.get()[i] = (val1_0 | val2_1) & (val1_1 | val2_0);
-    mVal1.get()[i] = (val1_1 & val2_0) | (val1_0 & val2_1);
+  if ( is_2state() && src.is_2state() ) {
+    // 2値の場合は 1 の面だけ計算すればよい．
+    for ( SizeType i = 0; i < n; ++ i ) {
+      mVal1.get()[i] ^= src.mVal1.get()[i];
+    }
+    set_2state();
+    return *this;
   }
 
+  // 計算の仕方は否定とANDとORを組み合わせたもの
+  BvKernel::get().mXor(mVal0.get(), mVal1.get(),
+		       src.mVal0.get(), src.mVal1.get(), n);
+  mFlags[4] = false;
+
   return *this;
 }
 
@@ -285,22 +266,13 @@ BitVector::operator^=(const BitVector& src)
 VlScalarVal
 BitVector::reduction_and() const
 {
+  // 1 ビットでも 0 のビットがあれば結果は0
+  if ( has_pat(ALL0, ALL1) ) {
+    return VlScalarVal::zero();
+  }
   if ( has_xz() ) {
     return VlScalarVal::x();
   }
-
-  SizeType n = block(size());
-  uword m = mask(size());
-  for ( SizeType i = 0; i < n - 1; ++ i ) {
-    if ( mVal0.get()[i] ) {
-      // 1 ビットでも 0 のビットがあれば結果は0
-      return VlScalarVal::zero();
-    }
-  }
-  if ( mVal0.get()[n - 1] & m ) {
-    // 1 ビットでも 0 のビットがあれば結果は0
-    return VlScalarVal::zero();
-  }
   return VlScalarVal::one();
 }
 
@@ -308,44 +280,20 @@ BitVector::reduction_and() const
 VlScalarVal
 BitVector::reduction_nand() const
 {
-  if ( has_xz() ) {
-    return VlScalarVal::x();
-  }
-
-  SizeType n = block(size());
-  uword m = mask(size());
-  for ( SizeType i = 0; i < n - 1; ++ i ) {
-    if ( mVal0.get()[i] ) {
-      // 1 ビットでも 0 のビットがあれば結果は1
-      return VlScalarVal::one();
-    }
-  }
-  if ( mVal0.get()[n - 1] & m ) {
-    // 1 ビットでも 0 のビットがあれば結果は1
-    return VlScalarVal::one();
-  }
-  return VlScalarVal::zero();
+  return !reduction_and();
 }
 
 // リダクションOR
 VlScalarVal
 BitVector::reduction_or() const
 {
+  // 1 ビットでも 1 のビットがあれば結果は1
+  if ( has_pat(ALL1, ALL0) ) {
+    return VlScalarVal::one();
+  }
   if ( has_xz() ) {
     return VlScalarVal::x();
   }
-  SizeType n = block(size());
-  uword m = mask(size());
-  for ( SizeType i = 0; i < n - 1; ++ i ) {
-    if ( mVal1.get()[i] ) {
-      // 1 ビットでも 1 のビットがあれば結果は1
-      return VlScalarVal::one();
-    }
-  }
-  if ( mVal1.get()[n - 1] & m ) {
-    // 1 ビットでも 1 のビットがあれば結果は1
-    return VlScalarVal::one();
-  }
   return VlScalarVal::zero();
 }
 
@@ -353,22 +301,7 @@ BitVector::reduction_or() const
 VlScalarVal
 BitVector::reduction_nor() const
 {
-  if ( has_xz() ) {
-    return VlScalarVal::x();
-  }
-  SizeType n = block(size());
-  uword m = mask(size());
-  for ( SizeType i = 0; i < n - 1; ++ i ) {
-    if ( mVal1.get()[i] ) {
-      // 1 ビットでも 1 のビットがあれば結果は0
-      return VlScalarVal::zero();
-    }
-  }
-  if ( mVal1.get()[n - 1] & m ) {
-    // 1 ビットでも 1 のビットがあれば結果は0
-    return VlScalarVal::zero();
-  }
-  return VlScalarVal::one();
+  return !reduction_or();
 }
 
 // リダクションXOR
@@ -378,22 +311,13 @@ BitVector::reduction_xor() const
   if ( has_xz() ) {
     return VlScalarVal::x();
   }
+  // 1 の面の1のビット数の偶奇を数えればよい．
   SizeType n = block(size());
-  // xor は地道に数えるしかない
-  // 高速に行うには8ビット単位ぐらいで表引きをすればよい．
-  uword v = 0;
-  for ( SizeType i = 0; i < n - 1; ++ i ) {
-    for ( int b = 0; b < BLOCK_SIZE; b ++ ) {
-      if ( (mVal1.get()[i] >> b) & 1 ) {
-	v ^= 1;
-      }
-    }
-  }
-  SizeType s = shift(size());
-  for ( SizeType b = 0; b < s; b ++ ) {
-    if ( (mVal1.get()[n - 1] >> b) & 1 ) {
-      v ^= 1;
-    }
+  uword m = mask(size());
+  auto& kernel = BvKernel::get();
+  bool v = kernel.mParity(mVal1.get(), n - 1);
+  if ( __builtin_parityll(mVal1.get()[n - 1] & m) ) {
+    v = !v;
   }
   if ( v ) {
     return VlScalarVal::one();
@@ -407,32 +331,7 @@ BitVector::reduction_xor() const
 VlScalarVal
 BitVector::reduction_xnor() const
 {
-  if ( has_xz() ) {
-    return VlScalarVal::x();
-  }
-  SizeType n = block(size());
-  // xor は地道に数えるしかない
-  // 高速に行うには8ビット単位ぐらいで表引きをすればよい．
-  uword v = 0;
-  for ( SizeType i = 0; i < n - 1; ++ i ) {
-    for ( SizeType b = 0; b < BLOCK_SIZE; b ++ ) {
-      if ( (mVal1.get()[i] >> b) & 1 ) {
-	v ^= 1;
-      }
-    }
-  }
-  SizeType s = shift(size());
-  for ( SizeType b = 0; b < s; ++ b ) {
-    if ( (mVal1.get()[n - 1] >> b) & 1 ) {
-      v ^= 1;
-    }
-  }
-  if ( v ) {
-    return VlScalarVal::zero();
-  }
-  else {
-    return VlScalarVal::one();
-  }
+  return !reduction_xor();
 }
 
 
@@ -753,6 +652,10 @@ BitVector::part_select_op(int msb,
     return;
   }
 
+  if ( !val.is_2state() ) {
+    mFlags[4] = false;
+  }
+
   SizeType l = msb - lsb + 1;
   SizeType src_blk = block(l);
   uword src_mask = mask(l);
@@ -838,7 +741,7 @@ BitVector::bit_select_op(int bpos,
 
   SizeType blk = bpos / BLOCK_SIZE;
   SizeType sft = bpos - blk * BLOCK_SIZE;
-  uword msk = 1 << sft;
+  uword msk = static_cast<uword>(1) << sft;
   if ( val.is_zero() ) {
     mVal0.get()[blk] |= msk;
     mVal1.get()[blk] &= ~msk;
@@ -850,10 +753,12 @@ BitVector::bit_select_op(int bpos,
   else if ( val.is_x() ) {
     mVal0.get()[blk] |= msk;
     mVal1.get()[blk] |= msk;
+    mFlags[4] = false;
   }
   else if ( val.is_z() ) {
     mVal0.get()[blk] &= ~msk;
     mVal1.get()[blk] &= ~msk;
+    mFlags[4] = false;
   }
   else {
     ASSERT_NOT_REACHED;
@@ -905,6 +810,8 @@ BitVector::merge(const BitVector& src)
     mVal0.get()[i] = val1_0 | val2_0;
     mVal1.get()[i] = val1_1 | val2_1;
   }
+  // 異なるビットは x になる．
+  mFlags[4] = false;
 
   return *this;
 }
@@ -0,0 +1,620 @@
+
+/// @file BvKernel.cc
+/// @brief BvKernel の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BvKernel.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define BVKERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+BEGIN_NONAMESPACE
+
+using uword = BvKernel::uword;
+
+/// @brief すべてが1のパタン
+const uword ALL1 = 0xFFFFFFFFFFFFFFFF;
+
+
+//////////////////////////////////////////////////////////////////////
+// スカラー版
+// AVX2/AVX-512 版の端数の処理にも用いる．
+//////////////////////////////////////////////////////////////////////
+
+void
+negate_scalar(
+  uword* val0,
+  uword* val1,
+  SizeType n
+)
+{
+  // 基本的には val0 と val1 を交換すればよいが，
+  // z のビットは x にするのでともに1と立てる
+  for ( SizeType i = 0; i < n; ++ i ) {
+    uword pat0 = val0[i];
+    uword pat1 = val1[i];
+    uword zpat = ~(pat0 | pat1);
+    val0[i] = pat1 | zpat;
+    val1[i] = pat0 | zpat;
+  }
+}
+
+void
+and_scalar(
+  uword* dst0,
+  uword* dst1,
+  const uword* src0,
+  const uword* src1,
+  SizeType n
+)
+{
+  // z を x に直してから val0 を or して val1 を and する．
+  for ( SizeType i = 0; i < n; ++ i ) {
+    uword zpat1 = ~(dst0[i] | dst1[i]);
+    uword zpat2 = ~(src0[i] | src1[i]);
+    uword val1_1 = dst1[i] | zpat1;
+    uword val2_1 = src1[i] | zpat2;
+    dst0[i] = dst0[i] | zpat1 | src0[i] | zpat2;
+    dst1[i] = val1_1 & val2_1;
+  }
+}
+
+void
+or_scalar(
+  uword* dst0,
+  uword* dst1,
+  const uword* src0,
+  const uword* src1,
+  SizeType n
+)
+{
+  // z を x に直してから val0 を and して val1 を or する．
+  for ( SizeType i = 0; i < n; ++ i ) {
+    uword zpat1 = ~(dst0[i] | dst1[i]);
+    uword zpat2 = ~(src0[i] | src1[i]);
+    uword val1_0 = dst0[i] | zpat1;
+    uword val2_0 = src0[i] | zpat2;
+    dst0[i] = val1_0 & val2_0;
+    dst1[i] = dst1[i] | zpat1 | src1[i] | zpat2;
+  }
+}
+
+void
+xor_scalar(
+  uword* dst0,
+  uword* dst1,
+  const uword* src0,
+  const uword* src1,
+  SizeType n
+)
+{
+  // 計算の仕方は否定とANDとORを組み合わせたもの
+  for ( SizeType i = 0; i < n; ++ i ) {
+    uword zpat1 = ~(dst0[i] | dst1[i]);
+    uword zpat2 = ~(src0[i] | src1[i]);
+    uword val1_0 = dst0[i] | zpat1;
+    uword val1_1 = dst1[i] | zpat1;
+    uword val2_0 = src0[i] | zpat2;
+    uword val2_1 = src1[i] | zpat2;
+    dst0[i] = (val1_0 | val2_1) & (val1_1 | val2_0);
+    dst1[i] = (val1_1 & val2_0) | (val1_0 & val2_1);
+  }
+}
+
+bool
+any_scalar(
+  const uword* val0,
+  const uword* val1,
+  uword inv0,
+  uword inv1,
+  SizeType n
+)
+{
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( (val0[i] ^ inv0) & (val1[i] ^ inv1) ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+any_xz_scalar(
+  const uword* val0,
+  const uword* val1,
+  SizeType n
+)
+{
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( (val0[i] ^ val1[i]) != ALL1 ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+parity_scalar(
+  const uword* val,
+  SizeType n
+)
+{
+  // 全ワードの xor をとってから数える．
+  uword acc = 0;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    acc ^= val[i];
+  }
+  return __builtin_parityll(acc);
+}
+
+const BvKernel kernel_scalar{
+  "scalar",
+  negate_scalar,
+  and_scalar,
+  or_scalar,
+  xor_scalar,
+  any_scalar,
+  any_xz_scalar,
+  parity_scalar
+};
+
+
+#if defined(BVKERNEL_X86)
+
+//////////////////////////////////////////////////////////////////////
+// AVX2 版
+// 256ビット(4ワード)単位で処理する．
+//////////////////////////////////////////////////////////////////////
+
+const SizeType AVX2_NW = 4;
+
+__attribute__((target("avx2")))
+void
+negate_avx2(
+  uword* val0,
+  uword* val1,
+  SizeType n
+)
+{
+  SizeType n1 = n - n % AVX2_NW;
+  for ( SizeType i = 0; i < n1; i += AVX2_NW ) {
+    auto p0 = reinterpret_cast<__m256i*>(val0 + i);
+    auto p1 = reinterpret_cast<__m256i*>(val1 + i);
+    auto pat0 = _mm256_loadu_si256(p0);
+    auto pat1 = _mm256_loadu_si256(p1);
+    // zpat = ~(pat0 | pat1) なので pat1 | zpat = pat1 | ~pat0
+    auto all1 = _mm256_set1_epi64x(-1);
+    auto not0 = _mm256_xor_si256(pat0, all1);
+    auto not1 = _mm256_xor_si256(pat1, all1);
+    _mm256_storeu_si256(p0, _mm256_or_si256(pat1, not0));
+    _mm256_storeu_si256(p1, _mm256_or_si256(pat0, not1));
+  }
+  negate_scalar(val0 + n1, val1 + n1, n - n1);
+}
+
+// z を x に直した 0 の面と 1 の面を作る．
+__attribute__((target("avx2")))
+inline
+void
+z_to_x_avx2(
+  __m256i& val0,
+  __m256i& val1
+)
+{
+  auto zpat = _mm256_andnot_si256(_mm256_or_si256(val0, val1),
+				  _mm256_set1_epi64x(-1));
+  val0 = _mm256_or_si256(val0, zpat);
+  val1 = _mm256_or_si256(val1, zpat);
+}
+
+__attribute__((target("avx2")))
+void
+and_avx2(
+  uword* dst0,
+  uword* dst1,
+  const uword* src0,
+  const uword* src1,
+  SizeType n
+)
+{
+  SizeType n1 = n - n % AVX2_NW;
+  for ( SizeType i = 0; i < n1; i += AVX2_NW ) {
+    auto p0 = reinterpret_cast<__m256i*>(dst0 + i);
+    auto p1 = reinterpret_cast<__m256i*>(dst1 + i);
+    auto val1_0 = _mm256_loadu_si256(p0);
+    auto val1_1 = _mm256_loadu_si256(p1);
+    auto val2_0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src0 + i));
+    auto val2_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src1 + i));
+    z_to_x_avx2(val1_0, val1_1);
+    z_to_x_avx2(val2_0, val2_1);
+    _mm256_storeu_si256(p0, _mm256_or_si256(val1_0, val2_0));
+    _mm256_storeu_si256(p1, _mm256_and_si256(val1_1, val2_1));
+  }
+  and_scalar(dst0 + n1, dst1 + n1, src0 + n1, src1 + n1, n - n1);
+}
+
+__attribute__((target("avx2")))
+void
+or_avx2(
+  uword* dst0,
+  uword* dst1,
+  const uword* src0,
+  const uword* src1,
+  SizeType n
+)
+{
+  SizeType n1 = n - n % AVX2_NW;
+  for ( SizeType i = 0; i < n1; i += AVX2_NW ) {
+    auto p0 = reinterpret_cast<__m256i*>(dst0 + i);
+    auto p1 = reinterpret_cast<__m256i*>(dst1 + i);
+    auto val1_0 = _mm256_loadu_si256(p0);
+    auto val1_1 = _mm256_loadu_si256(p1);
+    auto val2_0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src0 + i));
+    auto val2_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src1 + i));
+    z_to_x_avx2(val1_0, val1_1);
+    z_to_x_avx2(val2_0, val2_1);
+    _mm256_storeu_si256(p0, _mm256_and_si256(val1_0, val2_0));
+    _mm256_storeu_si256(p1, _mm256_or_si256(val1_1, val2_1));
+  }
+  or_scalar(dst0 + n1, dst1 + n1, src0 + n1, src1 + n1, n - n1);
+}
+
+__attribute__((target("avx2")))
+void
+xor_avx2(
+  uword* dst0,
+  uword* dst1,
+  const uword* src0,
+  const uword* src1,
+  SizeType n
+)
+{
+  SizeType n1 = n - n % AVX2_NW;
+  for ( SizeType i = 0; i < n1; i += AVX2_NW ) {
+    auto p0 = reinterpret_cast<__m256i*>(dst0 + i);
+    auto p1 = reinterpret_cast<__m256i*>(dst1 + i);
+    auto val1_0 = _mm256_loadu_si256(p0);
+    auto val1_1 = _mm256_loadu_si256(p1);
+    auto val2_0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src0 + i));
+    auto val2_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src1 + i));
+    z_to_x_avx2(val1_0, val1_1);
+    z_to_x_avx2(val2_0, val2_1);
+    auto ans0 = _mm256_and_si256(_mm256_or_si256(val1_0, val2_1),
+				 _mm256_or_si256(val1_1, val2_0));
+    auto ans1 = _mm256_or_si256(_mm256_and_si256(val1_1, val2_0),
+				_mm256_and_si256(val1_0, val2_1));
+    _mm256_storeu_si256(p0, ans0);
+    _mm256_storeu_si256(p1, ans1);
+  }
+  xor_scalar(dst0 + n1, dst1 + n1, src0 + n1, src1 + n1, n - n1);
+}
+
+__attribute__((target("avx2")))
+bool
+any_avx2(
+  const uword* val0,
+  const uword* val1,
+  uword inv0,
+  uword inv1,
+  SizeType n
+)
+{
+  SizeType n1 = n - n % AVX2_NW;
+  auto vinv0 = _mm256_set1_epi64x(static_cast<long long>(inv0));
+  auto vinv1 = _mm256_set1_epi64x(static_cast<long long>(inv1));
+  for ( SizeType i = 0; i < n1; i += AVX2_NW ) {
+    auto pat0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(val0 + i));
+    auto pat1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(val1 + i));
+    pat0 = _mm256_xor_si256(pat0, vinv0);
+    pat1 = _mm256_xor_si256(pat1, vinv1);
+    if ( !_mm256_testz_si256(pat0, pat1) ) {
+      return true;
+    }
+  }
+  return any_scalar(val0 + n1, val1 + n1, inv0, inv1, n - n1);
+}
+
+__attribute__((target("avx2")))
+bool
+any_xz_avx2(
+  const uword* val0,
+  const uword* val1,
+  SizeType n
+)
+{
+  SizeType n1 = n - n % AVX2_NW;
+  auto all1 = _mm256_set1_epi64x(-1);
+  for ( SizeType i = 0; i < n1; i += AVX2_NW ) {
+    auto pat0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(val0 + i));
+    auto pat1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(val1 + i));
+    // (pat0 ^ pat1) がすべて1でなければ x か z がある．
+    if ( !_mm256_testc_si256(_mm256_xor_si256(pat0, pat1), all1) ) {
+      return true;
+    }
+  }
+  return any_xz_scalar(val0 + n1, val1 + n1, n - n1);
+}
+
+__attribute__((target("avx2")))
+bool
+parity_avx2(
+  const uword* val,
+  SizeType n
+)
+{
+  SizeType n1 = n - n % AVX2_NW;
+  auto acc = _mm256_setzero_si256();
+  for ( SizeType i = 0; i < n1; i += AVX2_NW ) {
+    auto pat = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(val + i));
+    acc = _mm256_xor_si256(acc, pat);
+  }
+  uword tmp[AVX2_NW];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(tmp), acc);
+  uword acc1 = tmp[0] ^ tmp[1] ^ tmp[2] ^ tmp[3];
+  for ( SizeType i = n1; i < n; ++ i ) {
+    acc1 ^= val[i];
+  }
+  return __builtin_parityll(acc1);
+}
+
+const BvKernel kernel_avx2{
+  "avx2",
+  negate_avx2,
+  and_avx2,
+  or_avx2,
+  xor_avx2,
+  any_avx2,
+  any_xz_avx2,
+  parity_avx2
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// AVX-512 版
+// 512ビット(8ワード)単位で処理する．
+// 4値の論理は vpternlogq で1命令にまとめる．
+// 即値は第1オペランドを 0xF0, 第2オペランドを 0xCC とした真理値表
+//////////////////////////////////////////////////////////////////////
+
+const SizeType AVX512_NW = 8;
+
+__attribute__((target("avx512f")))
+void
+negate_avx512(
+  uword* val0,
+  uword* val1,
+  SizeType n
+)
+{
+  SizeType n1 = n - n % AVX512_NW;
+  for ( SizeType i = 0; i < n1; i += AVX512_NW ) {
+    auto pat0 = _mm512_loadu_si512(val0 + i);
+    auto pat1 = _mm512_loadu_si512(val1 + i);
+    // pat1 | ~pat0 と pat0 | ~pat1
+    _mm512_storeu_si512(val0 + i, _mm512_ternarylogic_epi64(pat0, pat1, pat1, 0xCF));
+    _mm512_storeu_si512(val1 + i, _mm512_ternarylogic_epi64(pat0, pat1, pat1, 0xF3));
+  }
+  negate_scalar(val0 + n1, val1 + n1, n - n1);
+}
+
+// z を x に直した 0 の面と 1 の面を作る．
+__attribute__((target("avx512f")))
+inline
+void
+z_to_x_avx512(
+  __m512i& val0,
+  __m512i& val1
+)
+{
+  // val0 | ~val1 と val1 | ~val0
+  auto tmp0 = _mm512_ternarylogic_epi64(val0, val1, val1, 0xF3);
+  auto tmp1 = _mm512_ternarylogic_epi64(val0, val1, val1, 0xCF);
+  val0 = tmp0;
+  val1 = tmp1;
+}
+
+__attribute__((target("avx512f")))
+void
+and_avx512(
+  uword* dst0,
+  uword* dst1,
+  const uword* src0,
+  const uword* src1,
+  SizeType n
+)
+{
+  SizeType n1 = n - n % AVX512_NW;
+  for ( SizeType i = 0; i < n1; i += AVX512_NW ) {
+    auto val1_0 = _mm512_loadu_si512(dst0 + i);
+    auto val1_1 = _mm512_loadu_si512(dst1 + i);
+    auto val2_0 = _mm512_loadu_si512(src0 + i);
+    auto val2_1 = _mm512_loadu_si512(src1 + i);
+    z_to_x_avx512(val1_0, val1_1);
+    z_to_x_avx512(val2_0, val2_1);
+    _mm512_storeu_si512(dst0 + i, _mm512_or_si512(val1_0, val2_0));
+    _mm512_storeu_si512(dst1 + i, _mm512_and_si512(val1_1, val2_1));
+  }
+  and_scalar(dst0 + n1, dst1 + n1, src0 + n1, src1 + n1, n - n1);
+}
+
+__attribute__((target("avx512f")))
+void
+or_avx512(
+  uword* dst0,
+  uword* dst1,
+  const uword* src0,
+  const uword* src1,
+  SizeType n
+)
+{
+  SizeType n1 = n - n % AVX512_NW;
+  for ( SizeType i = 0; i < n1; i += AVX512_NW ) {
+    auto val1_0 = _mm512_loadu_si512(dst0 + i);
+    auto val1_1 = _mm512_loadu_si512(dst1 + i);
+    auto val2_0 = _mm512_loadu_si512(src0 + i);
+    auto val2_1 = _mm512_loadu_si512(src1 + i);
+    z_to_x_avx512(val1_0, val1_1);
+    z_to_x_avx512(val2_0, val2_1);
+    _mm512_storeu_si512(dst0 + i, _mm512_and_si512(val1_0, val2_0));
+    _mm512_storeu_si512(dst1 + i, _mm512_or_si512(val1_1, val2_1));
+  }
+  or_scalar(dst0 + n1, dst1 + n1, src0 + n1, src1 + n1, n - n1);
+}
+
+__attribute__((target("avx512f")))
+void
+xor_avx512(
+  uword* dst0,
+  uword* dst1,
+  const uword* src0,
+  const uword* src1,
+  SizeType n
+)
+{
+  SizeType n1 = n - n % AVX512_NW;
+  for ( SizeType i = 0; i < n1; i += AVX512_NW ) {
+    auto val1_0 = _mm512_loadu_si512(dst0 + i);
+    auto val1_1 = _mm512_loadu_si512(dst1 + i);
+    auto val2_0 = _mm512_loadu_si512(src0 + i);
+    auto val2_1 = _mm512_loadu_si512(src1 + i);
+    z_to_x_avx512(val1_0, val1_1);
+    z_to_x_avx512(val2_0, val2_1);
+    auto ans0 = _mm512_and_si512(_mm512_or_si512(val1_0, val2_1),
+				 _mm512_or_si512(val1_1, val2_0));
+    auto ans1 = _mm512_or_si512(_mm512_and_si512(val1_1, val2_0),
+				_mm512_and_si512(val1_0, val2_1));
+    _mm512_storeu_si512(dst0 + i, ans0);
+    _mm512_storeu_si512(dst1 + i, ans1);
+  }
+  xor_scalar(dst0 + n1, dst1 + n1, src0 + n1, src1 + n1, n - n1);
+}
+
+__attribute__((target("avx512f")))
+bool
+any_avx512(
+  const uword* val0,
+  const uword* val1,
+  uword inv0,
+  uword inv1,
+  SizeType n
+)
+{
+  SizeType n1 = n - n % AVX512_NW;
+  auto vinv0 = _mm512_set1_epi64(static_cast<long long>(inv0));
+  auto vinv1 = _mm512_set1_epi64(static_cast<long long>(inv1));
+  for ( SizeType i = 0; i < n1; i += AVX512_NW ) {
+    auto pat0 = _mm512_xor_si512(_mm512_loadu_si512(val0 + i), vinv0);
+    auto pat1 = _mm512_xor_si512(_mm512_loadu_si512(val1 + i), vinv1);
+    if ( _mm512_test_epi64_mask(pat0, pat1) ) {
+      return true;
+    }
+  }
+  return any_scalar(val0 + n1, val1 + n1, inv0, inv1, n - n1);
+}
+
+__attribute__((target("avx512f")))
+bool
+any_xz_avx512(
+  const uword* val0,
+  const uword* val1,
+  SizeType n
+)
+{
+  SizeType n1 = n - n % AVX512_NW;
+  for ( SizeType i = 0; i < n1; i += AVX512_NW ) {
+    auto pat0 = _mm512_loadu_si512(val0 + i);
+    auto pat1 = _mm512_loadu_si512(val1 + i);
+    // ~(pat0 ^ pat1) が 0 でなければ x か z がある．
+    auto pat = _mm512_ternarylogic_epi64(pat0, pat1, pat1, 0xC3);
+    if ( _mm512_test_epi64_mask(pat, pat) ) {
+      return true;
+    }
+  }
+  return any_xz_scalar(val0 + n1, val1 + n1, n - n1);
+}
+
+__attribute__((target("avx512f")))
+bool
+parity_avx512(
+  const uword* val,
+  SizeType n
+)
+{
+  SizeType n1 = n - n % AVX512_NW;
+  auto acc = _mm512_setzero_si512();
+  for ( SizeType i = 0; i < n1; i += AVX512_NW ) {
+    acc = _mm512_xor_si512(acc, _mm512_loadu_si512(val + i));
+  }
+  uword tmp[AVX512_NW];
+  _mm512_storeu_si512(tmp, acc);
+  uword acc1 = 0;
+  for ( SizeType i = 0; i < AVX512_NW; ++ i ) {
+    acc1 ^= tmp[i];
+  }
+  for ( SizeType i = n1; i < n; ++ i ) {
+    acc1 ^= val[i];
+  }
+  return __builtin_parityll(acc1);
+}
+
+const BvKernel kernel_avx512{
+  "avx512",
+  negate_avx512,
+  and_avx512,
+  or_avx512,
+  xor_avx512,
+  any_avx512,
+  any_xz_avx512,
+  parity_avx512
+};
+
+#endif
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BvKernel
+//////////////////////////////////////////////////////////////////////
+
+// @brief 実行環境で使える最速のカーネルを返す．
+const BvKernel&
+BvKernel::get()
+{
+  static const BvKernel& kernel = *available_list().back();
+  return kernel;
+}
+
+// @brief スカラー版のカーネルを返す．
+const BvKernel&
+BvKernel::scalar()
+{
+  return kernel_scalar;
+}
+
+// @brief 実行環境で使えるカーネルのリストを返す．
+vector<const BvKernel*>
+BvKernel::available_list()
+{
+  vector<const BvKernel*> kernel_list{&kernel_scalar};
+#if defined(BVKERNEL_X86)
+  __builtin_cpu_init();
+  if ( __builtin_cpu_supports("avx2") ) {
+    kernel_list.push_back(&kernel_avx2);
+  }
+  if ( __builtin_cpu_supports("avx512f") ) {
+    kernel_list.push_back(&kernel_avx512);
+  }
+#endif
+  return kernel_list;
+}
+
+END_NAMESPACE_YM_VERILOG
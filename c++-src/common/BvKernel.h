@@ -0,0 +1,137 @@
+#ifndef BVKERNEL_H
+#define BVKERNEL_H
+
+/// @file BvKernel.h
+/// @brief BvKernel のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/verilog.h"
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+/// @class BvKernel BvKernel.h "BvKernel.h"
+/// @brief BitVector の4値のビット演算を行うカーネル関数の表
+///
+/// BitVector は値を val0(0 の面)と val1(1 の面)の2つのワード配列で
+/// 表している．ここの関数はその配列をワード単位で一括処理する．
+/// 実行環境の CPU が AVX2/AVX-512 を持っている場合にはそれを用いた
+/// 実装を選ぶ．
+///
+/// どの関数も n 個のワードをすべて処理する．
+/// 最後のワードの余分なビットのマスクは呼び出し側で行うこと．
+//////////////////////////////////////////////////////////////////////
+struct BvKernel
+{
+  using uword = std::uint64_t;
+
+  /// @brief 名前
+  const char* mName;
+
+  /// @brief ビットごとの否定を行う．
+  ///
+  /// z は x になる．
+  void
+  (*mNegate)(
+    uword* val0,   ///< [inout] 0 の面
+    uword* val1,   ///< [inout] 1 の面
+    SizeType n     ///< [in] ワード数
+  );
+
+  /// @brief ビットごとの論理積を行う．
+  ///
+  /// z は x と見なす．
+  void
+  (*mAnd)(
+    uword* dst0,       ///< [inout] 0 の面
+    uword* dst1,       ///< [inout] 1 の面
+    const uword* src0, ///< [in] もう一方のオペランドの 0 の面
+    const uword* src1, ///< [in] もう一方のオペランドの 1 の面
+    SizeType n         ///< [in] ワード数
+  );
+
+  /// @brief ビットごとの論理和を行う．
+  ///
+  /// z は x と見なす．
+  void
+  (*mOr)(
+    uword* dst0,       ///< [inout] 0 の面
+    uword* dst1,       ///< [inout] 1 の面
+    const uword* src0, ///< [in] もう一方のオペランドの 0 の面
+    const uword* src1, ///< [in] もう一方のオペランドの 1 の面
+    SizeType n         ///< [in] ワード数
+  );
+
+  /// @brief ビットごとの排他的論理和を行う．
+  ///
+  /// z は x と見なす．
+  void
+  (*mXor)(
+    uword* dst0,       ///< [inout] 0 の面
+    uword* dst1,       ///< [inout] 1 の面
+    const uword* src0, ///< [in] もう一方のオペランドの 0 の面
+    const uword* src1, ///< [in] もう一方のオペランドの 1 の面
+    SizeType n         ///< [in] ワード数
+  );
+
+  /// @brief 指定されたパタンのビットを含んでいたら true を返す．
+  ///
+  /// (val0 ^ inv0) & (val1 ^ inv1) が 0 でないワードを探す．
+  /// - x を探す時は inv0 = 0,    inv1 = 0
+  /// - z を探す時は inv0 = ALL1, inv1 = ALL1
+  /// - 1 を探す時は inv0 = ALL1, inv1 = 0
+  /// - 0 を探す時は inv0 = 0,    inv1 = ALL1
+  bool
+  (*mAny)(
+    const uword* val0, ///< [in] 0 の面
+    const uword* val1, ///< [in] 1 の面
+    uword inv0,        ///< [in] val0 を反転させるパタン
+    uword inv1,        ///< [in] val1 を反転させるパタン
+    SizeType n         ///< [in] ワード数
+  );
+
+  /// @brief x か z を含んでいたら true を返す．
+  bool
+  (*mAnyXZ)(
+    const uword* val0, ///< [in] 0 の面
+    const uword* val1, ///< [in] 1 の面
+    SizeType n         ///< [in] ワード数
+  );
+
+  /// @brief 1 のビット数の偶奇を返す．
+  /// @retval true 奇数
+  /// @retval false 偶数
+  bool
+  (*mParity)(
+    const uword* val, ///< [in] ワードの配列
+    SizeType n        ///< [in] ワード数
+  );
+
+  /// @brief 実行環境で使える最速のカーネルを返す．
+  ///
+  /// 最初に呼ばれた時に CPU の機能を調べて決める．
+  static
+  const BvKernel&
+  get();
+
+  /// @brief スカラー版のカーネルを返す．
+  static
+  const BvKernel&
+  scalar();
+
+  /// @brief 実行環境で使えるカーネルのリストを返す．
+  ///
+  /// ベンチマーク用．先頭はスカラー版となる．
+  static
+  vector<const BvKernel*>
+  available_list();
+
+};
+
+END_NAMESPACE_YM_VERILOG
+
+#endif // BVKERNEL_H
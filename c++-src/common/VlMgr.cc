@@ -16,9 +16,50 @@
 #include "elaborator/ElbMgr.h"
 #include "elaborator/ElbFactory.h"
 
+#include "ym/pt/PtModule.h"
+#include "ym/vl/VlModule.h"
+#include "ym/MsgMgr.h"
+
 
 BEGIN_NAMESPACE_YM_VERILOG
 
+BEGIN_NONAMESPACE
+
+// 読み込んだファイルとその内容のハッシュ値のリストを作る．
+//
+// 先頭は filename 自身で，hash は読み込む直前に求めたもの．
+// opened_file_list の先頭は filename 自身なので残りを加える．
+vector<pair<string, std::uint64_t>>
+make_dep_list(
+  const string& filename,
+  std::uint64_t hash,
+  const vector<string>& opened_file_list
+)
+{
+  vector<pair<string, std::uint64_t>> dep_list{{filename, hash}};
+  for ( SizeType i = 1; i < opened_file_list.size(); ++ i ) {
+    auto& path = opened_file_list[i];
+    dep_list.push_back({path, VlSnapshot::file_hash(path)});
+  }
+  return dep_list;
+}
+
+// 全てのファイルの内容が変わっていない時 true を返す．
+bool
+is_unchanged(
+  const vector<pair<string, std::uint64_t>>& dep_list
+)
+{
+  for ( auto& p: dep_list ) {
+    if ( VlSnapshot::file_hash(p.first) != p.second ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+END_NONAMESPACE
+
 // @brief コンストラクタ
 VlMgr::VlMgr() :
   mPtMgr{new PtMgr},
@@ -35,8 +76,16 @@ VlMgr::~VlMgr()
 void
 VlMgr::clear()
 {
+  // 遅延エラボレーションの処理は構文木を参照している．
+  mElaborator.reset();
   mPtMgr->clear();
   mElbMgr->clear();
+  mFileList.clear();
+  mFileDepDict.clear();
+  mCellLibrary = ClibCellLibrary{};
+  mElaborated = false;
+  mElabErrorNum = 0;
+  mElabClean = false;
 }
 
 // @brief ファイルを読み込む．
@@ -52,7 +101,177 @@ VlMgr::read_file(const string& filename,
 {
   Parser parser(*mPtMgr);
 
-  return parser.read_file(filename, searchpath, watcher_list);
+  mFileList.push_back(filename);
+  auto hash = VlSnapshot::file_hash(filename);
+  bool stat = parser.read_file(filename, searchpath, watcher_list);
+  if ( stat ) {
+    mFileDepDict[filename] = make_dep_list(filename, hash,
+					   parser.opened_file_list());
+  }
+  else {
+    // 内容が変わらなくても update_file() で読み直すように記録しない．
+    mFileDepDict.erase(filename);
+  }
+  return stat;
+}
+
+// @brief 編集されたファイルを読み直す．
+bool
+VlMgr::update_file(
+  const string& filename,
+  const SearchPathList& searchpath,
+  const vector<VlLineWatcher*> watcher_list
+)
+{
+  // 前回の読み込みに失敗したファイルは記録されていないので
+  // 必ず読み直される．
+  if ( mFileDepDict.count(filename) > 0 &&
+       is_unchanged(mFileDepDict.at(filename)) ) {
+    // インクルードファイルも含めて内容は変わっていない．
+    return true;
+  }
+  bool known = std::find(mFileList.begin(), mFileList.end(), filename)
+    != mFileList.end();
+
+  // 古い内容で定義されていたモジュール
+  unordered_set<const PtModule*> old_module_set;
+  unordered_set<string> module_name_set;
+  for ( auto pt_module: mPtMgr->file_module_list(filename) ) {
+    old_module_set.insert(pt_module);
+    module_name_set.insert(pt_module->name());
+  }
+  auto old_module_name_set = module_name_set;
+
+  // エラボレーション結果のトップモジュールの名前
+  unordered_set<string> old_top_name_set;
+  if ( mElaborated ) {
+    for ( auto module: mElbMgr->topmodule_list() ) {
+      old_top_name_set.insert(module->def_name());
+    }
+  }
+  bool has_udp = !mPtMgr->file_udp_list(filename).empty();
+  auto old_defname_list = mPtMgr->file_defname_list(filename);
+
+  mPtMgr->remove_file(filename);
+  if ( !known ) {
+    mFileList.push_back(filename);
+  }
+  auto hash = VlSnapshot::file_hash(filename);
+  Parser parser(*mPtMgr);
+  bool stat = parser.read_file(filename, searchpath, watcher_list);
+  if ( !stat ) {
+    // 内容のハッシュ値は読み込みに成功した時のみ記録する．
+    mFileDepDict.erase(filename);
+    if ( mElaborated ) {
+      // 構文木と一致しないので破棄する．
+      // 次に読み直した時に必ずエラボレーションを行うように
+      // エラーがあったことにしておく．
+      mElaborator.reset();
+      mElbMgr->clear();
+      mElabErrorNum = 1;
+      mElabClean = false;
+    }
+    mPtMgr->release_removed();
+    return false;
+  }
+  mFileDepDict[filename] = make_dep_list(filename, hash,
+					 parser.opened_file_list());
+
+  if ( !mElaborated ) {
+    mPtMgr->release_removed();
+    return true;
+  }
+
+  // 新しい内容を加えた上で影響があるか調べる．
+  // 影響のあるインスタンスだけを作り直せない場合は
+  // full を true にする．
+  bool full = !mElabClean || has_udp ||
+    !mPtMgr->file_udp_list(filename).empty();
+  bool affected = full;
+  unordered_set<string> new_module_name_set;
+  for ( auto pt_module: mPtMgr->file_module_list(filename) ) {
+    string name{pt_module->name()};
+    if ( !mPtMgr->check_def_name(name) ) {
+      // トップモジュールになる．
+      affected = true;
+      if ( old_top_name_set.count(name) == 0 ) {
+	// 新しいトップモジュール
+	full = true;
+      }
+    }
+    else if ( old_top_name_set.count(name) > 0 ) {
+      // トップモジュールでなくなった．
+      full = true;
+    }
+    module_name_set.insert(name);
+    new_module_name_set.insert(name);
+  }
+  if ( new_module_name_set != old_module_name_set ) {
+    // モジュール名の解決結果が変わる．
+    full = true;
+  }
+  for ( const auto& name: old_defname_list ) {
+    if ( !mPtMgr->check_def_name(name) ) {
+      // name のモジュールがトップモジュールになるかもしれない．
+      affected = true;
+      full = true;
+    }
+  }
+  for ( const auto& name: mPtMgr->file_defname_list(filename) ) {
+    if ( old_top_name_set.count(name) > 0 ) {
+      // name のトップモジュールがインスタンスになる．
+      affected = true;
+      full = true;
+    }
+  }
+  if ( !affected ) {
+    // インスタンス記述で用いられている名前もトップモジュールかどうかが
+    // 変わる可能性がある．
+    // ただし，以前にトップモジュールだったものは
+    // エラボレーション結果に含まれている．
+    for ( const auto& name: old_defname_list ) {
+      module_name_set.insert(name);
+    }
+    for ( const auto& name: mPtMgr->file_defname_list(filename) ) {
+      module_name_set.insert(name);
+    }
+    auto check = [&](const VlModule* module) {
+      if ( module_name_set.count(module->def_name()) > 0 ) {
+	affected = true;
+      }
+    };
+    // モジュールインスタンスは遅延エラボレーションでも作られているので
+    // 残りの処理は行わない．
+    for ( auto module: mElbMgr->all_module_list() ) {
+      check(module);
+    }
+    for ( auto module_array: mElbMgr->all_modulearray_list() ) {
+      if ( module_array->elem_num() > 0 ) {
+	check(module_array->elem_by_offset(0));
+      }
+    }
+  }
+  if ( !affected ) {
+    mPtMgr->release_removed();
+    return true;
+  }
+
+  if ( !full && mElaborator != nullptr ) {
+    // 古いモジュール定義のインスタンスとそれに依存する部分だけを作り直す．
+    auto nerr0 = MsgMgr::error_num();
+    if ( mElaborator->rebuild(*mPtMgr, old_module_set) &&
+	 MsgMgr::error_num() == nerr0 ) {
+      mPtMgr->release_removed();
+      return true;
+    }
+  }
+
+  // 全体をやり直す．
+  mElaborator.reset();
+  mElbMgr->clear();
+  bool ok = elaborate(mCellLibrary) == 0;
+  mPtMgr->release_removed();
+  return ok && mElabClean;
 }
 
 // @brief 登録されているモジュールのリストを返す．
@@ -85,9 +304,75 @@ VlMgr::pt_attr_list(const PtBase* pt_obj) const
 int
 VlMgr::elaborate(const ClibCellLibrary& cell_library)
 {
-  Elaborator elab(*mElbMgr, cell_library);
+  mCellLibrary = cell_library;
+  mElaborated = true;
+
+  // update_file() で部分的に作り直せるように
+  // 遅延させた処理がなくても Elaborator は残しておく．
+  mElaborator.reset(new Elaborator(*mElbMgr, mCellLibrary, mInfoMsg, mLazy));
 
-  return elab(*mPtMgr);
+  auto nerr0 = MsgMgr::error_num();
+  mElabErrorNum = (*mElaborator)(*mPtMgr);
+  mElabClean = mElabErrorNum == 0 && MsgMgr::error_num() == nerr0;
+  return mElabErrorNum;
+}
+
+// @brief スコープの中身を作る．
+void
+VlMgr::elaborate_scope(
+  const VlScope* scope
+) const
+{
+  if ( mElaborator != nullptr ) {
+    mElaborator->elaborate_scope(scope);
+  }
+}
+
+// @brief まだ作られていないスコープの中身をすべて作る．
+void
+VlMgr::elaborate_all() const
+{
+  if ( mElaborator != nullptr ) {
+    mElaborator->elaborate_all();
+  }
+}
+
+// @brief エラボレーション結果を読み出し専用にする．
+void
+VlMgr::freeze()
+{
+  elaborate_all();
+  mElbMgr->freeze();
+}
+
+// @brief freeze() が呼ばれている時 true を返す．
+bool
+VlMgr::is_frozen() const
+{
+  return mElbMgr->is_frozen();
+}
+
+// @brief エラボレーション結果をファイルに保存する．
+bool
+VlMgr::save_elaborated(
+  const string& path
+) const
+{
+  // ハッシュ値は読み込んだ時点の内容から求める．
+  vector<pair<string, std::uint64_t>> file_hash_list;
+  vector<pair<string, std::uint64_t>> dep_list;
+  for ( auto& filename: mFileList ) {
+    if ( mFileDepDict.count(filename) == 0 ) {
+      // 読み込みに失敗したファイルがある．
+      return false;
+    }
+    auto& file_dep_list = mFileDepDict.at(filename);
+    file_hash_list.push_back(file_dep_list.front());
+    dep_list.insert(dep_list.end(),
+		    file_dep_list.begin(), file_dep_list.end());
+  }
+  auto hash = VlSnapshot::input_hash(file_hash_list, mCellLibrary);
+  return VlSnapshot::save(*this, path, hash, dep_list);
 }
 
 // @brief UDP 定義のリストを返す．
@@ -130,6 +415,16 @@ VlMgr::find_user_systf(const char* name) const
 vector<const VlScope*>
 VlMgr::find_internalscope_list(const VlScope* parent) const
 {
+  return find_internalscope_span(parent).to_vector();
+}
+
+// @brief スコープに属する internal scope のリストを取り出す．
+// @param[in] parent 検索対象のスコープ
+// @return 結果の要素を参照する VlSpan を返す．
+VlSpan<const VlScope*>
+VlMgr::find_internalscope_span(const VlScope* parent) const
+{
+  elaborate_scope(parent);
   return mElbMgr->find_internalscope_list(parent);
 }
 
@@ -143,6 +438,18 @@ vector<const VlDecl*>
 VlMgr::find_decl_list(const VlScope* parent,
 		      int tag) const
 {
+  return find_decl_span(parent, tag).to_vector();
+}
+
+// @brief スコープとタグから宣言要素を取り出す．
+// @param[in] parent 検索対象のスコープ
+// @param[in] tag タグ
+// @return 結果の要素を参照する VlSpan を返す．
+VlSpan<const VlDecl*>
+VlMgr::find_decl_span(const VlScope* parent,
+		      int tag) const
+{
+  elaborate_scope(parent);
   return mElbMgr->find_decl_list(parent, tag);
 }
 
@@ -156,6 +463,18 @@ vector<const VlDeclArray*>
 VlMgr::find_declarray_list(const VlScope* parent,
 			   int tag) const
 {
+  return find_declarray_span(parent, tag).to_vector();
+}
+
+// @brief スコープとタグから宣言要素の配列を取り出す．
+// @param[in] parent 検索対象のスコープ
+// @param[in] tag タグ
+// @return 結果の要素を参照する VlSpan を返す．
+VlSpan<const VlDeclArray*>
+VlMgr::find_declarray_span(const VlScope* parent,
+			   int tag) const
+{
+  elaborate_scope(parent);
   return mElbMgr->find_declarray_list(parent, tag);
 }
 
@@ -165,6 +484,16 @@ VlMgr::find_declarray_list(const VlScope* parent,
 vector<const VlDefParam*>
 VlMgr::find_defparam_list(const VlScope* parent) const
 {
+  return find_defparam_span(parent).to_vector();
+}
+
+// @brief スコープに属する defparam のリストを取り出す．
+// @param[in] parent 検索対象のスコープ
+// @return 結果の要素を参照する VlSpan を返す．
+VlSpan<const VlDefParam*>
+VlMgr::find_defparam_span(const VlScope* parent) const
+{
+  elaborate_scope(parent);
   return mElbMgr->find_defparam_list(parent);
 }
 
@@ -174,6 +503,16 @@ VlMgr::find_defparam_list(const VlScope* parent) const
 vector<const VlParamAssign*>
 VlMgr::find_paramassign_list(const VlScope* parent) const
 {
+  return find_paramassign_span(parent).to_vector();
+}
+
+// @brief スコープに属する param assign のリストを取り出す．
+// @param[in] parent 検索対象のスコープ
+// @return 結果の要素を参照する VlSpan を返す．
+VlSpan<const VlParamAssign*>
+VlMgr::find_paramassign_span(const VlScope* parent) const
+{
+  elaborate_scope(parent);
   return mElbMgr->find_paramassign_list(parent);
 }
 
@@ -183,6 +522,16 @@ VlMgr::find_paramassign_list(const VlScope* parent) const
 vector<const VlModule*>
 VlMgr::find_module_list(const VlScope* parent) const
 {
+  return find_module_span(parent).to_vector();
+}
+
+// @brief スコープに属する module のリストを取り出す．
+// @param[in] parent 検索対象のスコープ
+// @return 結果の要素を参照する VlSpan を返す．
+VlSpan<const VlModule*>
+VlMgr::find_module_span(const VlScope* parent) const
+{
+  elaborate_scope(parent);
   return mElbMgr->find_module_list(parent);
 }
 
@@ -192,6 +541,16 @@ VlMgr::find_module_list(const VlScope* parent) const
 vector<const VlModuleArray*>
 VlMgr::find_modulearray_list(const VlScope* parent) const
 {
+  return find_modulearray_span(parent).to_vector();
+}
+
+// @brief スコープに属する module arrayのリストを取り出す．
+// @param[in] parent 検索対象のスコープ
+// @return 結果の要素を参照する VlSpan を返す．
+VlSpan<const VlModuleArray*>
+VlMgr::find_modulearray_span(const VlScope* parent) const
+{
+  elaborate_scope(parent);
   return mElbMgr->find_modulearray_list(parent);
 }
 
@@ -201,6 +560,16 @@ VlMgr::find_modulearray_list(const VlScope* parent) const
 vector<const VlPrimitive*>
 VlMgr::find_primitive_list(const VlScope* parent) const
 {
+  return find_primitive_span(parent).to_vector();
+}
+
+// @brief スコープに属する primitive のリストを取り出す．
+// @param[in] parent 検索対象のスコープ
+// @return 結果の要素を参照する VlSpan を返す．
+VlSpan<const VlPrimitive*>
+VlMgr::find_primitive_span(const VlScope* parent) const
+{
+  elaborate_scope(parent);
   return mElbMgr->find_primitive_list(parent);
 }
 
@@ -210,6 +579,16 @@ VlMgr::find_primitive_list(const VlScope* parent) const
 vector<const VlPrimArray*>
 VlMgr::find_primarray_list(const VlScope* parent) const
 {
+  return find_primarray_span(parent).to_vector();
+}
+
+// @brief スコープに属する primitive array のリストを取り出す．
+// @param[in] parent 検索対象のスコープ
+// @return 結果の要素を参照する VlSpan を返す．
+VlSpan<const VlPrimArray*>
+VlMgr::find_primarray_span(const VlScope* parent) const
+{
+  elaborate_scope(parent);
   return mElbMgr->find_primarray_list(parent);
 }
 
@@ -219,6 +598,16 @@ VlMgr::find_primarray_list(const VlScope* parent) const
 vector<const VlTaskFunc*>
 VlMgr::find_task_list(const VlScope* parent) const
 {
+  return find_task_span(parent).to_vector();
+}
+
+// @brief スコープに属するタスクのリストを取り出す．
+// @param[in] parent 検索対象のスコープ
+// @return 結果の要素を参照する VlSpan を返す．
+VlSpan<const VlTaskFunc*>
+VlMgr::find_task_span(const VlScope* parent) const
+{
+  elaborate_scope(parent);
   return mElbMgr->find_task_list(parent);
 }
 
@@ -228,6 +617,16 @@ VlMgr::find_task_list(const VlScope* parent) const
 vector<const VlTaskFunc*>
 VlMgr::find_function_list(const VlScope* parent) const
 {
+  return find_function_span(parent).to_vector();
+}
+
+// @brief スコープに属する関数のリストを取り出す．
+// @param[in] parent 検索対象のスコープ
+// @return 結果の要素を参照する VlSpan を返す．
+VlSpan<const VlTaskFunc*>
+VlMgr::find_function_span(const VlScope* parent) const
+{
+  elaborate_scope(parent);
   return mElbMgr->find_function_list(parent);
 }
 
@@ -237,6 +636,16 @@ VlMgr::find_function_list(const VlScope* parent) const
 vector<const VlContAssign*>
 VlMgr::find_contassign_list(const VlScope* parent) const
 {
+  return find_contassign_span(parent).to_vector();
+}
+
+// @brief スコープに属する continuous assignment のリストを取り出す．
+// @param[in] parent 検索対象のスコープ
+// @return 結果の要素を参照する VlSpan を返す．
+VlSpan<const VlContAssign*>
+VlMgr::find_contassign_span(const VlScope* parent) const
+{
+  elaborate_scope(parent);
   return mElbMgr->find_contassign_list(parent);
 }
 
@@ -246,9 +655,167 @@ VlMgr::find_contassign_list(const VlScope* parent) const
 vector<const VlProcess*>
 VlMgr::find_process_list(const VlScope* parent) const
 {
+  return find_process_span(parent).to_vector();
+}
+
+// @brief スコープに属する process のリストを取り出す．
+// @param[in] parent 検索対象のスコープ
+// @return 結果の要素を参照する VlSpan を返す．
+VlSpan<const VlProcess*>
+VlMgr::find_process_span(const VlScope* parent) const
+{
+  elaborate_scope(parent);
   return mElbMgr->find_process_list(parent);
 }
 
+// @brief 設計中のすべてのinternal scopeを返す．
+VlSpan<const VlScope*>
+VlMgr::all_internalscope_span() const
+{
+  elaborate_all();
+  return mElbMgr->all_internalscope_list();
+}
+
+// @brief 設計中のtag というタグを持つすべての宣言要素を返す．
+VlSpan<const VlDecl*>
+VlMgr::all_decl_span(
+  int tag
+) const
+{
+  elaborate_all();
+  return mElbMgr->all_decl_list(tag);
+}
+
+// @brief 設計中のtag というタグを持つすべての宣言要素の配列を返す．
+VlSpan<const VlDeclArray*>
+VlMgr::all_declarray_span(
+  int tag
+) const
+{
+  elaborate_all();
+  return mElbMgr->all_declarray_list(tag);
+}
+
+// @brief 設計中のすべてのdefparamを返す．
+VlSpan<const VlDefParam*>
+VlMgr::all_defparam_span() const
+{
+  elaborate_all();
+  return mElbMgr->all_defparam_list();
+}
+
+// @brief 設計中のすべてのparam assignを返す．
+VlSpan<const VlParamAssign*>
+VlMgr::all_paramassign_span() const
+{
+  elaborate_all();
+  return mElbMgr->all_paramassign_list();
+}
+
+// @brief 設計中のすべてのmoduleを返す．
+VlSpan<const VlModule*>
+VlMgr::all_module_span() const
+{
+  elaborate_all();
+  return mElbMgr->all_module_list();
+}
+
+// @brief 設計中のすべてのmodule arrayを返す．
+VlSpan<const VlModuleArray*>
+VlMgr::all_modulearray_span() const
+{
+  elaborate_all();
+  return mElbMgr->all_modulearray_list();
+}
+
+// @brief 設計中のすべてのprimitiveを返す．
+VlSpan<const VlPrimitive*>
+VlMgr::all_primitive_span() const
+{
+  elaborate_all();
+  return mElbMgr->all_primitive_list();
+}
+
+// @brief 設計中のすべてのprimitive arrayを返す．
+VlSpan<const VlPrimArray*>
+VlMgr::all_primarray_span() const
+{
+  elaborate_all();
+  return mElbMgr->all_primarray_list();
+}
+
+// @brief 設計中のすべてのタスクを返す．
+VlSpan<const VlTaskFunc*>
+VlMgr::all_task_span() const
+{
+  elaborate_all();
+  return mElbMgr->all_task_list();
+}
+
+// @brief 設計中のすべての関数を返す．
+VlSpan<const VlTaskFunc*>
+VlMgr::all_function_span() const
+{
+  elaborate_all();
+  return mElbMgr->all_function_list();
+}
+
+// @brief 設計中のすべてのcontinuous assignmentを返す．
+VlSpan<const VlContAssign*>
+VlMgr::all_contassign_span() const
+{
+  elaborate_all();
+  return mElbMgr->all_contassign_list();
+}
+
+// @brief 設計中のすべてのprocessを返す．
+VlSpan<const VlProcess*>
+VlMgr::all_process_span() const
+{
+  elaborate_all();
+  return mElbMgr->all_process_list();
+}
+
+// @brief 階層名から要素を取り出す．
+const VlObj*
+VlMgr::find_by_path(
+  string_view path
+) const
+{
+  if ( mElaborator == nullptr || !mElaborator->has_pending_stub() ) {
+    return mElbMgr->find_by_path(path);
+  }
+  // 途中のスコープの中身を作ってから名前を探す．
+  return mElbMgr->find_by_path(path,
+			       [&](const VlScope* scope) {
+				 elaborate_scope(scope);
+			       });
+}
+
+// @brief 複数の階層名から要素を取り出す．
+vector<const VlObj*>
+VlMgr::find_by_paths(
+  const vector<string>& path_list
+) const
+{
+  if ( mElaborator == nullptr || !mElaborator->has_pending_stub() ) {
+    return mElbMgr->find_by_paths(path_list);
+  }
+  return mElbMgr->find_by_paths(path_list,
+				[&](const VlScope* scope) {
+				  elaborate_scope(scope);
+				});
+}
+
+// @brief ビット単位の接続グラフを抽出する．
+VlNetlist
+VlMgr::extract_netlist(
+  SizeType thread_num
+) const
+{
+  return VlNetlist{*this, thread_num};
+}
+
 // @brief 属性リストを得る．
 // @param[in] obj 対象のオブジェクト
 vector<const VlAttribute*>
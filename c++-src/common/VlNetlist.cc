@@ -0,0 +1,657 @@
+﻿
+/// @file VlNetlist.cc
+/// @brief VlNetlist の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/VlNetlist.h"
+#include "ym/VlMgr.h"
+#include "ym/VlParallel.h"
+#include "ym/vl/VlDecl.h"
+#include "ym/vl/VlDeclArray.h"
+#include "ym/vl/VlExpr.h"
+#include "ym/vl/VlModule.h"
+#include "ym/vl/VlPort.h"
+#include "ym/vl/VlPrimitive.h"
+#include "ym/vl/VlContAssign.h"
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+BEGIN_NONAMESPACE
+
+// ネットに接続していないビットを表す値
+const SizeType NO_BIT = static_cast<SizeType>(-1);
+
+// 一つのモジュールインスタンスから取り出した情報
+struct ModuleResult
+{
+  // セルの種類
+  vector<VlNetlist::CellType> mCellType;
+
+  // セルの元のオブジェクト
+  vector<const VlObj*> mCellObj;
+
+  // セルの先頭のピン位置(mPinBit 中の位置)
+  vector<SizeType> mCellPinBegin;
+
+  // ピンの接続するビット
+  vector<SizeType> mPinBit;
+
+  // ピンの向き
+  vector<VpiDir> mPinDir;
+
+  // 同一視するビットの対
+  vector<pair<SizeType, SizeType>> mAliasList;
+
+};
+
+//////////////////////////////////////////////////////////////////////
+// 一つのモジュールインスタンスの接続を取り出すクラス
+//////////////////////////////////////////////////////////////////////
+class ModuleScanner
+{
+public:
+
+  /// @brief コンストラクタ
+  ModuleScanner(
+    const VlMgr& mgr,
+    const unordered_map<const VlDeclBase*, SizeType>& bit_base,
+    ModuleResult& result
+  ) : mMgr{mgr},
+      mBitBase{bit_base},
+      mResult{result}
+  {
+  }
+
+  /// @brief スコープの内容を取り出す．
+  ///
+  /// 子供のモジュールインスタンスはポートの接続のみを取り出し，
+  /// 中には入らない．
+  void
+  scan_scope(
+    const VlScope* scope
+  )
+  {
+    for ( auto prim: mMgr.find_primitive_span(scope) ) {
+      scan_primitive(prim);
+    }
+    for ( auto prim_array: mMgr.find_primarray_span(scope) ) {
+      SizeType n = prim_array->elem_num();
+      for ( SizeType i = 0; i < n; ++ i ) {
+	scan_primitive(prim_array->elem_by_offset(i));
+      }
+    }
+    for ( auto ca: mMgr.find_contassign_span(scope) ) {
+      scan_contassign(ca);
+    }
+    for ( auto module: mMgr.find_module_span(scope) ) {
+      scan_ports(module);
+    }
+    for ( auto module_array: mMgr.find_modulearray_span(scope) ) {
+      SizeType n = module_array->elem_num();
+      for ( SizeType i = 0; i < n; ++ i ) {
+	scan_ports(module_array->elem_by_offset(i));
+      }
+    }
+    for ( auto child: mMgr.find_internalscope_span(scope) ) {
+      scan_scope(child);
+    }
+  }
+
+
+private:
+
+  /// @brief primitive の接続を取り出す．
+  void
+  scan_primitive(
+    const VlPrimitive* prim
+  )
+  {
+    new_cell(VlNetlist::CellType::Primitive, prim);
+    for ( auto term: prim->prim_term_list() ) {
+      auto dir = term->direction();
+      collect(term->expr());
+      for ( auto bit: mExact ) {
+	add_pin(bit, dir);
+      }
+      for ( auto bit: mSupport ) {
+	add_pin(bit, VpiDir::Input);
+      }
+    }
+  }
+
+  /// @brief continuous assignment の接続を取り出す．
+  void
+  scan_contassign(
+    const VlContAssign* ca
+  )
+  {
+    new_cell(VlNetlist::CellType::ContAssign, ca);
+    collect(ca->rhs());
+    for ( auto bit: mExact ) {
+      add_pin(bit, VpiDir::Input);
+    }
+    for ( auto bit: mSupport ) {
+      add_pin(bit, VpiDir::Input);
+    }
+    collect(ca->lhs());
+    for ( auto bit: mExact ) {
+      add_pin(bit, VpiDir::Output);
+    }
+  }
+
+  /// @brief モジュールインスタンスのポートの接続を取り出す．
+  ///
+  /// 上位と下位の接続先のビットが共にネットの場合には同一視する．
+  /// 値を送る側が式の場合には Port セルを作り，式の中のビットを入力，
+  /// 受け取る側のビットを出力とする．
+  void
+  scan_ports(
+    const VlModule* module
+  )
+  {
+    for ( auto port: module->port_list() ) {
+      auto hi_expr = port->high_conn();
+      auto lo_expr = port->low_conn();
+      if ( hi_expr == nullptr || lo_expr == nullptr ) {
+	continue;
+      }
+      collect(hi_expr);
+      vector<SizeType> hi_exact{mExact};
+      vector<SizeType> hi_support{mSupport};
+      collect(lo_expr);
+      auto& lo_exact = mExact;
+      auto& lo_support = mSupport;
+
+      bool is_output = port->direction() == VpiDir::Output;
+      auto& src_support = is_output ? lo_support : hi_support;
+      auto& dst_exact = is_output ? hi_exact : lo_exact;
+      SizeType n = std::min(hi_exact.size(), lo_exact.size());
+      vector<SizeType> dst_list;
+      for ( SizeType i = 0; i < n; ++ i ) {
+	auto hi_bit = hi_exact[i];
+	auto lo_bit = lo_exact[i];
+	if ( hi_bit != NO_BIT && lo_bit != NO_BIT ) {
+	  mResult.mAliasList.push_back({hi_bit, lo_bit});
+	}
+	else if ( dst_exact[i] != NO_BIT ) {
+	  dst_list.push_back(dst_exact[i]);
+	}
+      }
+      if ( !src_support.empty() && !dst_list.empty() ) {
+	new_cell(VlNetlist::CellType::Port, port);
+	for ( auto bit: src_support ) {
+	  add_pin(bit, VpiDir::Input);
+	}
+	for ( auto bit: dst_list ) {
+	  add_pin(bit, VpiDir::Output);
+	}
+      }
+    }
+  }
+
+  /// @brief 新しいセルを作る．
+  void
+  new_cell(
+    VlNetlist::CellType type,
+    const VlObj* obj
+  )
+  {
+    mResult.mCellType.push_back(type);
+    mResult.mCellObj.push_back(obj);
+    mResult.mCellPinBegin.push_back(mResult.mPinBit.size());
+  }
+
+  /// @brief 最後に作ったセルにピンを加える．
+  void
+  add_pin(
+    SizeType bit,
+    VpiDir dir
+  )
+  {
+    if ( bit == NO_BIT ) {
+      // 定数などネットに接続していない．
+      return;
+    }
+    mResult.mPinBit.push_back(bit);
+    mResult.mPinDir.push_back(dir);
+  }
+
+  /// @brief 式の表すビットを求める．
+  ///
+  /// 結果は mExact と mSupport に入る．
+  /// - mExact は式の各ビットに対応するビット(LSB から)
+  ///   ネットでないビットは NO_BIT となる．
+  /// - mSupport は演算や可変の選択の中で参照されているビット
+  void
+  collect(
+    const VlExpr* expr
+  )
+  {
+    mExact.clear();
+    mSupport.clear();
+    collect_sub(expr);
+  }
+
+  /// @brief collect() の下請け関数
+  void
+  collect_sub(
+    const VlExpr* expr
+  )
+  {
+    SizeType pos = mExact.size();
+    if ( expr->is_primary() ) {
+      collect_primary(expr);
+    }
+    else if ( expr->is_bitselect() ) {
+      // 定数式のインデックスでも index() を持つものは
+      // index_val() が意味を持たない．
+      if ( expr->is_constant_select() && expr->index() == nullptr ) {
+	SizeType offset;
+	if ( calc_offset(expr->parent_expr(), expr->index_val(), offset) ) {
+	  collect_sub(expr->parent_expr());
+	  select(pos, offset, offset);
+	}
+	else {
+	  fill(pos, 1);
+	}
+      }
+      else {
+	to_support(expr->parent_expr(), pos);
+	to_support(expr->index(), pos);
+	fill(pos, 1);
+      }
+    }
+    else if ( expr->is_partselect() ) {
+      SizeType loffset;
+      SizeType roffset;
+      if ( expr->is_constant_select() && expr->base() == nullptr &&
+	   calc_offset(expr->parent_expr(), expr->left_range_val(), loffset) &&
+	   calc_offset(expr->parent_expr(), expr->right_range_val(), roffset) ) {
+	collect_sub(expr->parent_expr());
+	select(pos, std::min(loffset, roffset), std::max(loffset, roffset));
+      }
+      else {
+	to_support(expr->parent_expr(), pos);
+	to_support(expr->base(), pos);
+	fill(pos, expr->bit_size());
+      }
+    }
+    else if ( expr->is_operation() &&
+	      (expr->op_type() == VpiOpType::Concat ||
+	       expr->op_type() == VpiOpType::MultiConcat) ) {
+      // オペランドは MSB 側から並んでいるので逆順にたどる．
+      // MultiConcat の先頭のオペランドは繰り返し数
+      bool multi = expr->op_type() == VpiOpType::MultiConcat;
+      SizeType n = expr->operand_num();
+      SizeType start = multi ? 1 : 0;
+      for ( SizeType i = n; i > start; -- i ) {
+	collect_sub(expr->operand(i - 1));
+      }
+      if ( multi ) {
+	SizeType w = mExact.size() - pos;
+	SizeType rep = expr->rep_num();
+	for ( SizeType r = 1; r < rep; ++ r ) {
+	  for ( SizeType i = 0; i < w; ++ i ) {
+	    mExact.push_back(mExact[pos + i]);
+	  }
+	}
+      }
+    }
+    else {
+      // それ以外の式は参照しているビットのみを求める．
+      if ( expr->is_operation() ) {
+	for ( auto opr: expr->operand_list() ) {
+	  to_support(opr, pos);
+	}
+      }
+      else if ( expr->is_funccall() || expr->is_sysfunccall() ) {
+	for ( auto arg: expr->argument_list() ) {
+	  to_support(arg, pos);
+	}
+      }
+      fill(pos, expr->bit_size());
+    }
+  }
+
+  /// @brief プライマリのビットを求める．
+  void
+  collect_primary(
+    const VlExpr* expr
+  )
+  {
+    SizeType pos = mExact.size();
+    auto declarray = expr->declarray_obj();
+    if ( declarray != nullptr ) {
+      auto p = mBitBase.find(declarray);
+      if ( p == mBitBase.end() ) {
+	fill(pos, expr->bit_size());
+	return;
+      }
+      SizeType base = p->second;
+      SizeType w = declarray->bit_size();
+      if ( expr->declarray_dimension() == 0 ) {
+	// インデックスが定数の配列要素はオフセットに変換済み
+	if ( expr->is_constant_select() ) {
+	  base += expr->declarray_offset() * w;
+	}
+	for ( SizeType i = 0; i < w; ++ i ) {
+	  mExact.push_back(base + i);
+	}
+      }
+      else {
+	// 可変の配列要素は配列全体とインデックスを参照する．
+	SizeType n = declarray->array_size() * w;
+	for ( SizeType i = 0; i < n; ++ i ) {
+	  mSupport.push_back(base + i);
+	}
+	for ( SizeType d = 0; d < expr->declarray_dimension(); ++ d ) {
+	  to_support(expr->declarray_index(d), pos);
+	}
+	fill(pos, w);
+      }
+      return;
+    }
+
+    auto decl = expr->decl_base();
+    if ( decl != nullptr ) {
+      auto p = mBitBase.find(decl);
+      if ( p != mBitBase.end() ) {
+	SizeType base = p->second;
+	SizeType w = decl->bit_size();
+	for ( SizeType i = 0; i < w; ++ i ) {
+	  mExact.push_back(base + i);
+	}
+	return;
+      }
+    }
+    // parameter などネットでないもの
+    fill(pos, expr->bit_size());
+  }
+
+  /// @brief 選択のインデックスを LSB からのオフセットに変換する．
+  ///
+  /// 宣言要素に対する選択の場合には範囲指定に従って変換する．
+  /// 式に対する選択の場合にはインデックスがそのままオフセットとなる．
+  bool
+  calc_offset(
+    const VlExpr* parent,
+    int index,
+    SizeType& offset
+  )
+  {
+    if ( parent->is_primary() ) {
+      auto decl = parent->decl_base();
+      if ( decl != nullptr ) {
+	return decl->calc_bit_offset(index, offset);
+      }
+    }
+    if ( index < 0 ) {
+      return false;
+    }
+    offset = index;
+    return true;
+  }
+
+  /// @brief mExact の pos 以降から [lsb, msb] の部分を残す．
+  void
+  select(
+    SizeType pos,
+    SizeType lsb,
+    SizeType msb
+  )
+  {
+    SizeType n = mExact.size() - pos;
+    SizeType w = msb - lsb + 1;
+    for ( SizeType i = 0; i < w; ++ i ) {
+      SizeType src = lsb + i;
+      mExact[pos + i] = src < n ? mExact[pos + src] : NO_BIT;
+    }
+    mExact.resize(pos + w, NO_BIT);
+  }
+
+  /// @brief 式の参照しているビットを mSupport に加える．
+  ///
+  /// mExact は pos の位置まで戻す．
+  void
+  to_support(
+    const VlExpr* expr,
+    SizeType pos
+  )
+  {
+    if ( expr == nullptr ) {
+      return;
+    }
+    collect_sub(expr);
+    for ( SizeType i = pos; i < mExact.size(); ++ i ) {
+      if ( mExact[i] != NO_BIT ) {
+	mSupport.push_back(mExact[i]);
+      }
+    }
+    mExact.resize(pos);
+  }
+
+  /// @brief mExact を pos の位置から w ビットの NO_BIT にする．
+  void
+  fill(
+    SizeType pos,
+    SizeType w
+  )
+  {
+    mExact.resize(pos);
+    mExact.resize(pos + w, NO_BIT);
+  }
+
+
+private:
+
+  // エラボレーション結果
+  const VlMgr& mMgr;
+
+  // 宣言要素の先頭のビット番号の辞書
+  const unordered_map<const VlDeclBase*, SizeType>& mBitBase;
+
+  // 結果
+  ModuleResult& mResult;
+
+  // collect() の結果
+  vector<SizeType> mExact;
+  vector<SizeType> mSupport;
+
+};
+
+// union-find の代表元を求める．
+SizeType
+find_root(
+  vector<SizeType>& parent,
+  SizeType x
+)
+{
+  SizeType root = x;
+  while ( parent[root] != root ) {
+    root = parent[root];
+  }
+  // 経路圧縮
+  while ( parent[x] != root ) {
+    SizeType next = parent[x];
+    parent[x] = root;
+    x = next;
+  }
+  return root;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス VlNetlist
+//////////////////////////////////////////////////////////////////////
+
+// @brief エラボレーション結果から接続グラフを抽出するコンストラクタ
+VlNetlist::VlNetlist(
+  const VlMgr& mgr,
+  SizeType thread_num
+)
+{
+  // スコープごとの処理は複数のスレッドで行うので
+  // 遅延エラボレーションの残りはここで作っておく．
+  mgr.elaborate_all();
+
+  // 宣言要素のビットに番号を振る．
+  SizeType bit_num = 0;
+  for ( int tag: { vpiNet, vpiReg, vpiVariables } ) {
+    for ( auto decl: mgr.all_decl_span(tag) ) {
+      mDeclBitBase.emplace(decl, bit_num);
+      bit_num += decl->bit_size();
+    }
+  }
+  for ( int tag: { vpiNetArray, vpiRegArray, vpiVariables } ) {
+    for ( auto declarray: mgr.all_declarray_span(tag) ) {
+      mDeclBitBase.emplace(declarray, bit_num);
+      bit_num += declarray->array_size() * declarray->bit_size();
+    }
+  }
+
+  // モジュールインスタンスごとに接続を取り出す．
+  vector<const VlModule*> module_list;
+  for ( auto module: mgr.all_module_span() ) {
+    module_list.push_back(module);
+  }
+  for ( auto module_array: mgr.all_modulearray_span() ) {
+    SizeType n = module_array->elem_num();
+    for ( SizeType i = 0; i < n; ++ i ) {
+      module_list.push_back(module_array->elem_by_offset(i));
+    }
+  }
+  SizeType module_num = module_list.size();
+  vector<ModuleResult> result_list(module_num);
+  vl_parallel_for_chunk(module_num,
+			[&](SizeType begin,
+			    SizeType end) {
+			  for ( SizeType i = begin; i < end; ++ i ) {
+			    ModuleScanner scanner{mgr, mDeclBitBase,
+						  result_list[i]};
+			    scanner.scan_scope(module_list[i]);
+			  }
+			},
+			thread_num, 1);
+
+  // ポートで接続されたビットを併合する．
+  vector<SizeType> parent(bit_num);
+  for ( SizeType i = 0; i < bit_num; ++ i ) {
+    parent[i] = i;
+  }
+  for ( auto& result: result_list ) {
+    for ( auto& p: result.mAliasList ) {
+      auto r1 = find_root(parent, p.first);
+      auto r2 = find_root(parent, p.second);
+      // 番号の小さい方を代表元にする．
+      if ( r1 < r2 ) {
+	parent[r2] = r1;
+      }
+      else if ( r2 < r1 ) {
+	parent[r1] = r2;
+      }
+    }
+  }
+
+  // 代表元の順にネット番号を振る．
+  // 代表元はクラス中で最小のビットなので先に現れる．
+  mBitNet.resize(bit_num);
+  SizeType net_num = 0;
+  for ( SizeType i = 0; i < bit_num; ++ i ) {
+    auto root = find_root(parent, i);
+    if ( root == i ) {
+      mBitNet[i] = net_num;
+      ++ net_num;
+    }
+    else {
+      mBitNet[i] = mBitNet[root];
+    }
+  }
+  // 以降は不要
+  vector<SizeType>{}.swap(parent);
+
+  // セルとピンをまとめる．
+  SizeType cell_num = 0;
+  SizeType pin_num = 0;
+  for ( auto& result: result_list ) {
+    cell_num += result.mCellType.size();
+    pin_num += result.mPinBit.size();
+  }
+  mCellType.reserve(cell_num);
+  mCellObj.reserve(cell_num);
+  mCellPinBegin.reserve(cell_num + 1);
+  mPinCell.reserve(pin_num);
+  mPinNet.reserve(pin_num);
+  mPinDir.reserve(pin_num);
+  for ( auto& result: result_list ) {
+    SizeType n = result.mCellType.size();
+    SizeType m = result.mPinBit.size();
+    for ( SizeType i = 0; i < n; ++ i ) {
+      SizeType cell = mCellType.size();
+      mCellType.push_back(result.mCellType[i]);
+      mCellObj.push_back(result.mCellObj[i]);
+      mCellPinBegin.push_back(mPinNet.size());
+      SizeType end = i + 1 < n ? result.mCellPinBegin[i + 1] : m;
+      for ( SizeType j = result.mCellPinBegin[i]; j < end; ++ j ) {
+	mPinCell.push_back(cell);
+	mPinNet.push_back(mBitNet[result.mPinBit[j]]);
+	mPinDir.push_back(result.mPinDir[j]);
+      }
+    }
+    // 使い終わった領域はすぐに解放する．
+    result = ModuleResult{};
+  }
+  mCellPinBegin.push_back(mPinNet.size());
+
+  // ネットごとのピンのリストを作る．
+  mNetPinBegin.assign(net_num + 1, 0);
+  for ( auto net: mPinNet ) {
+    ++ mNetPinBegin[net + 1];
+  }
+  for ( SizeType i = 0; i < net_num; ++ i ) {
+    mNetPinBegin[i + 1] += mNetPinBegin[i];
+  }
+  mNetPinList.resize(pin_num);
+  vector<SizeType> fill_pos{mNetPinBegin.begin(), mNetPinBegin.end() - 1};
+  for ( SizeType pin = 0; pin < pin_num; ++ pin ) {
+    auto net = mPinNet[pin];
+    mNetPinList[fill_pos[net]] = pin;
+    ++ fill_pos[net];
+  }
+}
+
+// @brief 宣言要素のビットの属するネットを返す．
+SizeType
+VlNetlist::net_id(
+  const VlDeclBase* decl,
+  SizeType offset
+) const
+{
+  auto p = mDeclBitBase.find(decl);
+  if ( p == mDeclBitBase.end() ) {
+    return net_num();
+  }
+  SizeType bit = p->second + offset;
+  if ( bit >= bit_num() ) {
+    return net_num();
+  }
+  return mBitNet[bit];
+}
+
+// @brief 宣言要素の配列の要素のビットの属するネットを返す．
+SizeType
+VlNetlist::net_id(
+  const VlDeclArray* declarray,
+  SizeType array_offset,
+  SizeType offset
+) const
+{
+  return net_id(declarray, array_offset * declarray->bit_size() + offset);
+}
+
+END_NAMESPACE_YM_VERILOG
@@ -0,0 +1,942 @@
+﻿
+/// @file VlSnapshot.cc
+/// @brief VlSnapshot の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/VlSnapshot.h"
+#include "ym/VlMgr.h"
+#include "ym/vl/VlAttribute.h"
+#include "ym/vl/VlContAssign.h"
+#include "ym/vl/VlDecl.h"
+#include "ym/vl/VlDeclArray.h"
+#include "ym/vl/VlExpr.h"
+#include "ym/vl/VlModule.h"
+#include "ym/vl/VlPrimitive.h"
+#include "ym/vl/VlTaskFunc.h"
+#include "ym/vl/VlUdp.h"
+#include "ym/ClibCell.h"
+#include "ym/ClibPin.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+BEGIN_NONAMESPACE
+
+// ファイルの先頭のマジックナンバー
+const char SNAPSHOT_MAGIC[8] = { 'Y', 'M', 'V', 'L', 'S', 'N', 'A', 'P' };
+
+// 形式のバージョン
+// レコードの形式を変えた場合には必ず変更すること．
+const std::uint32_t SNAPSHOT_VERSION = 2;
+
+// バイト順を確かめるための値
+const std::uint32_t BYTE_ORDER_MARK = 0x01020304U;
+
+// セクション番号
+enum {
+  SEC_STR,
+  SEC_SCOPE,
+  SEC_DECL,
+  SEC_PRIM,
+  SEC_TERM,
+  SEC_CONTASSIGN,
+  SEC_UDP,
+  SEC_UDPROW,
+  SEC_ATTR,
+  SEC_DEP,
+  SEC_NUM
+};
+
+// セクションの位置と要素数
+struct Section
+{
+  std::uint64_t mOffset;
+  std::uint64_t mNum;
+};
+
+// ファイルのヘッダ
+struct Header
+{
+  char mMagic[8];
+  std::uint32_t mVersion;
+  std::uint32_t mByteOrder;
+  std::uint64_t mInputHash;
+  std::uint64_t mFileSize;
+  Section mSection[SEC_NUM];
+};
+
+// セクションの先頭の境界
+const SizeType SECTION_ALIGN = 8;
+
+// FNV-1a ハッシュの初期値
+const std::uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+
+// FNV-1a ハッシュの乗数
+const std::uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+// FNV-1a ハッシュにバイト列を加える．
+void
+fnv_add(
+  std::uint64_t& h,
+  const char* data,
+  SizeType size
+)
+{
+  for ( SizeType i = 0; i < size; ++ i ) {
+    h ^= static_cast<unsigned char>(data[i]);
+    h *= FNV_PRIME;
+  }
+}
+
+// 境界に合わせて切り上げる．
+inline
+SizeType
+align_up(
+  SizeType pos
+)
+{
+  return (pos + SECTION_ALIGN - 1) / SECTION_ALIGN * SECTION_ALIGN;
+}
+
+//////////////////////////////////////////////////////////////////////
+// スナップショットを作るクラス
+//////////////////////////////////////////////////////////////////////
+class SnapshotWriter
+{
+public:
+
+  /// @brief コンストラクタ
+  SnapshotWriter(
+    const VlMgr& mgr
+  ) : mMgr{mgr}
+  {
+  }
+
+  /// @brief エラボレーション結果を集める．
+  void
+  collect();
+
+  /// @brief ファイルに書き出す．
+  bool
+  write(
+    const string& path,
+    std::uint64_t input_hash,
+    const vector<pair<string, std::uint64_t>>& dep_list
+  );
+
+
+private:
+
+  /// @brief スコープを登録する．
+  void
+  reg_scope(
+    const VlScope* scope
+  );
+
+  /// @brief 文字列を登録する．
+  std::uint32_t
+  reg_str(
+    const string& str
+  );
+
+  /// @brief 式を文字列として登録する．
+  std::uint32_t
+  reg_expr(
+    const VlExpr* expr
+  );
+
+  /// @brief 宣言要素のレコードを作る．
+  void
+  new_decl(
+    const VlDeclBase* decl,
+    int tag,
+    std::uint32_t scope,
+    std::uint32_t array_size,
+    const VlExpr* init
+  );
+
+  /// @brief 属性を登録する．
+  void
+  reg_attr(
+    const VlObj* obj,
+    std::uint32_t kind,
+    std::uint32_t id
+  );
+
+  /// @brief スコープの番号を返す．
+  ///
+  /// 登録されていない場合は NONE を返す．
+  std::uint32_t
+  scope_id(
+    const VlScope* scope
+  ) const
+  {
+    auto p = mScopeMap.find(scope);
+    if ( p == mScopeMap.end() ) {
+      return VlSnapshot::NONE;
+    }
+    return p->second;
+  }
+
+
+private:
+
+  // エラボレーション結果
+  const VlMgr& mMgr;
+
+  // スコープのリスト
+  vector<const VlScope*> mScopeList;
+
+  // スコープの番号の辞書
+  unordered_map<const VlScope*, std::uint32_t> mScopeMap;
+
+  // UDP 定義の番号の辞書
+  unordered_map<const VlUdpDefn*, std::uint32_t> mUdpMap;
+
+  // 文字列の番号の辞書
+  unordered_map<string, std::uint32_t> mStrMap;
+
+  // 文字列の表
+  string mStrPool;
+
+  // 各セクションの内容
+  vector<VlSnapshot::Scope> mScopeArray;
+  vector<VlSnapshot::Decl> mDeclArray;
+  vector<VlSnapshot::Prim> mPrimArray;
+  vector<VlSnapshot::PrimTerm> mTermArray;
+  vector<VlSnapshot::ContAssign> mContAssignArray;
+  vector<VlSnapshot::Udp> mUdpArray;
+  vector<std::uint32_t> mUdpRowArray;
+  vector<VlSnapshot::Attr> mAttrArray;
+  vector<VlSnapshot::Dep> mDepArray;
+
+};
+
+// @brief エラボレーション結果を集める．
+void
+SnapshotWriter::collect()
+{
+  // UDP 定義
+  for ( auto udp: mMgr.udp_list() ) {
+    std::uint32_t id = mUdpArray.size();
+    mUdpMap.emplace(udp, id);
+    std::uint32_t row_begin = mUdpRowArray.size();
+    SizeType n = udp->table_size();
+    for ( SizeType i = 0; i < n; ++ i ) {
+      mUdpRowArray.push_back(reg_str(udp->table_entry(i)->str()));
+    }
+    std::uint32_t row_end = mUdpRowArray.size();
+    mUdpArray.push_back({reg_str(udp->def_name()),
+			 static_cast<std::uint32_t>(udp->prim_type()),
+			 static_cast<std::uint32_t>(udp->port_num()),
+			 reg_str(udp->init_val_string()),
+			 row_begin, row_end});
+  }
+
+  // スコープは親が子より先に来るように階層をたどって登録する．
+  for ( auto module: mMgr.topmodule_list() ) {
+    reg_scope(module);
+  }
+
+  // 設計全体のリストを親のスコープごとに振り分ける．
+  SizeType scope_num = mScopeList.size();
+  struct DeclInfo {
+    const VlDeclBase* mDecl;
+    int mTag;
+    std::uint32_t mArraySize;
+    const VlExpr* mInit;
+  };
+  vector<vector<DeclInfo>> decl_bucket(scope_num);
+  for ( int tag: { vpiNet, vpiReg, vpiVariables, vpiNamedEvent,
+		   vpiParameter, vpiSpecParam } ) {
+    for ( auto decl: mMgr.all_decl_span(tag) ) {
+      auto id = scope_id(decl->parent_scope());
+      if ( id != VlSnapshot::NONE ) {
+	decl_bucket[id].push_back({decl, tag, 0, decl->init_value()});
+      }
+    }
+  }
+  for ( int tag: { vpiNetArray, vpiRegArray, vpiVariables,
+		   vpiNamedEventArray } ) {
+    for ( auto declarray: mMgr.all_declarray_span(tag) ) {
+      auto id = scope_id(declarray->parent_scope());
+      if ( id != VlSnapshot::NONE ) {
+	std::uint32_t array_size = declarray->array_size();
+	decl_bucket[id].push_back({declarray, tag, array_size, nullptr});
+      }
+    }
+  }
+  vector<vector<const VlPrimitive*>> prim_bucket(scope_num);
+  for ( auto prim: mMgr.all_primitive_span() ) {
+    auto id = scope_id(prim->parent_scope());
+    if ( id != VlSnapshot::NONE ) {
+      prim_bucket[id].push_back(prim);
+    }
+  }
+  for ( auto prim_array: mMgr.all_primarray_span() ) {
+    auto id = scope_id(prim_array->parent_scope());
+    if ( id != VlSnapshot::NONE ) {
+      SizeType n = prim_array->elem_num();
+      for ( SizeType i = 0; i < n; ++ i ) {
+	prim_bucket[id].push_back(prim_array->elem_by_offset(i));
+      }
+    }
+  }
+
+  // スコープごとに連続して並べる．
+  for ( std::uint32_t id = 0; id < scope_num; ++ id ) {
+    auto& rec = mScopeArray[id];
+    rec.mDeclBegin = mDeclArray.size();
+    for ( auto& info: decl_bucket[id] ) {
+      reg_attr(info.mDecl, VlSnapshot::kDecl, mDeclArray.size());
+      new_decl(info.mDecl, info.mTag, id, info.mArraySize, info.mInit);
+    }
+    rec.mDeclEnd = mDeclArray.size();
+
+    rec.mPrimBegin = mPrimArray.size();
+    for ( auto prim: prim_bucket[id] ) {
+      reg_attr(prim, VlSnapshot::kPrim, mPrimArray.size());
+      std::uint32_t term_begin = mTermArray.size();
+      for ( auto term: prim->prim_term_list() ) {
+	mTermArray.push_back({static_cast<std::uint32_t>(term->direction()),
+			      reg_expr(term->expr())});
+      }
+      std::uint32_t term_end = mTermArray.size();
+      std::uint32_t udp_id = VlSnapshot::NONE;
+      auto p = mUdpMap.find(prim->udp_defn());
+      if ( p != mUdpMap.end() ) {
+	udp_id = p->second;
+      }
+      auto name = prim->name();
+      mPrimArray.push_back({name.empty() ? VlSnapshot::NONE : reg_str(name),
+			    id,
+			    static_cast<std::uint32_t>(prim->prim_type()),
+			    reg_str(prim->def_name()),
+			    udp_id,
+			    term_begin, term_end});
+    }
+    rec.mPrimEnd = mPrimArray.size();
+
+    rec.mContAssignBegin = mContAssignArray.size();
+    // continuous assignment は親のスコープを持たないので
+    // スコープごとのリストを用いる．
+    for ( auto ca: mMgr.find_contassign_span(mScopeList[id]) ) {
+      reg_attr(ca, VlSnapshot::kContAssign, mContAssignArray.size());
+      mContAssignArray.push_back({id, reg_expr(ca->lhs()), reg_expr(ca->rhs())});
+    }
+    rec.mContAssignEnd = mContAssignArray.size();
+
+    reg_attr(mScopeList[id], VlSnapshot::kScope, id);
+  }
+}
+
+// @brief スコープを登録する．
+void
+SnapshotWriter::reg_scope(
+  const VlScope* scope
+)
+{
+  if ( mScopeMap.count(scope) > 0 ) {
+    return;
+  }
+  std::uint32_t id = mScopeList.size();
+  mScopeList.push_back(scope);
+  mScopeMap.emplace(scope, id);
+
+  auto name = scope->name();
+  std::uint32_t def_name = VlSnapshot::NONE;
+  if ( scope->type() == VpiObjType::Module ) {
+    auto module = static_cast<const VlModule*>(scope);
+    def_name = reg_str(module->def_name());
+  }
+  VlSnapshot::Scope rec;
+  rec.mName = name.empty() ? VlSnapshot::NONE : reg_str(name);
+  rec.mDefName = def_name;
+  rec.mParent = scope_id(scope->parent_scope());
+  rec.mType = static_cast<std::uint32_t>(scope->type());
+  rec.mDeclBegin = rec.mDeclEnd = 0;
+  rec.mPrimBegin = rec.mPrimEnd = 0;
+  rec.mContAssignBegin = rec.mContAssignEnd = 0;
+  mScopeArray.push_back(rec);
+
+  for ( auto child: mMgr.find_internalscope_span(scope) ) {
+    reg_scope(child);
+  }
+  for ( auto module: mMgr.find_module_span(scope) ) {
+    reg_scope(module);
+  }
+  for ( auto module_array: mMgr.find_modulearray_span(scope) ) {
+    SizeType n = module_array->elem_num();
+    for ( SizeType i = 0; i < n; ++ i ) {
+      reg_scope(module_array->elem_by_offset(i));
+    }
+  }
+  for ( auto task: mMgr.find_task_span(scope) ) {
+    reg_scope(task);
+  }
+  for ( auto func: mMgr.find_function_span(scope) ) {
+    reg_scope(func);
+  }
+}
+
+// @brief 文字列を登録する．
+std::uint32_t
+SnapshotWriter::reg_str(
+  const string& str
+)
+{
+  auto p = mStrMap.find(str);
+  if ( p != mStrMap.end() ) {
+    return p->second;
+  }
+  std::uint32_t id = mStrPool.size();
+  mStrPool.append(str);
+  mStrPool.push_back('\0');
+  mStrMap.emplace(str, id);
+  return id;
+}
+
+// @brief 式を文字列として登録する．
+std::uint32_t
+SnapshotWriter::reg_expr(
+  const VlExpr* expr
+)
+{
+  if ( expr == nullptr ) {
+    return VlSnapshot::NONE;
+  }
+  return reg_str(expr->decompile());
+}
+
+// @brief 宣言要素のレコードを作る．
+void
+SnapshotWriter::new_decl(
+  const VlDeclBase* decl,
+  int tag,
+  std::uint32_t scope,
+  std::uint32_t array_size,
+  const VlExpr* init
+)
+{
+  VlSnapshot::Decl rec;
+  rec.mName = reg_str(decl->name());
+  rec.mScope = scope;
+  rec.mTag = tag;
+  rec.mType = static_cast<std::uint32_t>(decl->type());
+  rec.mFlags = 0;
+  if ( decl->is_signed() ) {
+    rec.mFlags |= 1U;
+  }
+  if ( decl->has_range() ) {
+    rec.mFlags |= 2U;
+    rec.mLeft = decl->left_range_val();
+    rec.mRight = decl->right_range_val();
+  }
+  else {
+    rec.mLeft = 0;
+    rec.mRight = 0;
+  }
+  rec.mBitSize = decl->bit_size();
+  rec.mArraySize = array_size;
+  rec.mInitValue = reg_expr(init);
+  mDeclArray.push_back(rec);
+}
+
+// @brief 属性を登録する．
+void
+SnapshotWriter::reg_attr(
+  const VlObj* obj,
+  std::uint32_t kind,
+  std::uint32_t id
+)
+{
+  for ( auto attr: mMgr.find_attr(obj) ) {
+    mAttrArray.push_back({kind, id,
+			  reg_str(attr->name()),
+			  reg_expr(attr->expr()),
+			  attr->def_attribute() ? 1U : 0U});
+  }
+}
+
+// @brief ファイルに書き出す．
+bool
+SnapshotWriter::write(
+  const string& path,
+  std::uint64_t input_hash,
+  const vector<pair<string, std::uint64_t>>& dep_list
+)
+{
+  for ( auto& p: dep_list ) {
+    mDepArray.push_back({reg_str(p.first), 0U, p.second});
+  }
+
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.mMagic, SNAPSHOT_MAGIC, sizeof(header.mMagic));
+  header.mVersion = SNAPSHOT_VERSION;
+  header.mByteOrder = BYTE_ORDER_MARK;
+  header.mInputHash = input_hash;
+
+  // 各セクションの内容
+  const void* data[SEC_NUM] = {
+    mStrPool.data(),
+    mScopeArray.data(),
+    mDeclArray.data(),
+    mPrimArray.data(),
+    mTermArray.data(),
+    mContAssignArray.data(),
+    mUdpArray.data(),
+    mUdpRowArray.data(),
+    mAttrArray.data(),
+    mDepArray.data()
+  };
+  SizeType num[SEC_NUM] = {
+    mStrPool.size(),
+    mScopeArray.size(),
+    mDeclArray.size(),
+    mPrimArray.size(),
+    mTermArray.size(),
+    mContAssignArray.size(),
+    mUdpArray.size(),
+    mUdpRowArray.size(),
+    mAttrArray.size(),
+    mDepArray.size()
+  };
+  SizeType elem_size[SEC_NUM] = {
+    sizeof(char),
+    sizeof(VlSnapshot::Scope),
+    sizeof(VlSnapshot::Decl),
+    sizeof(VlSnapshot::Prim),
+    sizeof(VlSnapshot::PrimTerm),
+    sizeof(VlSnapshot::ContAssign),
+    sizeof(VlSnapshot::Udp),
+    sizeof(std::uint32_t),
+    sizeof(VlSnapshot::Attr),
+    sizeof(VlSnapshot::Dep)
+  };
+
+  SizeType pos = align_up(sizeof(Header));
+  for ( SizeType i = 0; i < SEC_NUM; ++ i ) {
+    header.mSection[i].mOffset = pos;
+    header.mSection[i].mNum = num[i];
+    pos = align_up(pos + num[i] * elem_size[i]);
+  }
+  header.mFileSize = pos;
+
+  ofstream s{path, std::ios::binary};
+  if ( !s ) {
+    return false;
+  }
+  const char zero[SECTION_ALIGN] = { 0 };
+  s.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  SizeType cur = sizeof(header);
+  for ( SizeType i = 0; i < SEC_NUM; ++ i ) {
+    SizeType offset = header.mSection[i].mOffset;
+    s.write(zero, offset - cur);
+    SizeType size = num[i] * elem_size[i];
+    s.write(reinterpret_cast<const char*>(data[i]), size);
+    cur = offset + size;
+  }
+  s.write(zero, pos - cur);
+  return static_cast<bool>(s);
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス VlSnapshot
+//////////////////////////////////////////////////////////////////////
+
+// @brief デストラクタ
+VlSnapshot::~VlSnapshot()
+{
+  close();
+}
+
+// @brief ファイルの内容からハッシュ値を求める．
+std::uint64_t
+VlSnapshot::file_hash(
+  const string& filename
+)
+{
+  std::uint64_t h = FNV_OFFSET;
+  ifstream s{filename, std::ios::binary};
+  if ( !s ) {
+    // 読めないことも記録する．
+    fnv_add(h, "\xff", 1);
+    return h;
+  }
+  char buf[4096];
+  while ( s.read(buf, sizeof(buf)) || s.gcount() > 0 ) {
+    fnv_add(h, buf, s.gcount());
+  }
+  return h;
+}
+
+// @brief セルライブラリのハッシュ値を求める．
+std::uint64_t
+VlSnapshot::library_hash(
+  const ClibCellLibrary& cell_library
+)
+{
+  std::uint64_t h = FNV_OFFSET;
+  SizeType nc = cell_library.cell_num();
+  for ( SizeType id = 0; id < nc; ++ id ) {
+    auto cell = cell_library.cell(id);
+    auto name = cell.name();
+    fnv_add(h, name.c_str(), name.size() + 1);
+    SizeType np = cell.pin_num();
+    for ( SizeType pid = 0; pid < np; ++ pid ) {
+      auto pin = cell.pin(pid);
+      auto pin_name = pin.name();
+      fnv_add(h, pin_name.c_str(), pin_name.size() + 1);
+      char dir = pin.is_input() ? 'i' : pin.is_output() ? 'o' : 'b';
+      fnv_add(h, &dir, 1);
+    }
+    // セルの区切り
+    fnv_add(h, "\xff", 1);
+  }
+  return h;
+}
+
+// @brief 入力ファイルの内容とセルライブラリからハッシュ値を求める．
+std::uint64_t
+VlSnapshot::input_hash(
+  const vector<string>& filename_list,
+  const ClibCellLibrary& cell_library
+)
+{
+  vector<pair<string, std::uint64_t>> file_hash_list;
+  file_hash_list.reserve(filename_list.size());
+  for ( auto& filename: filename_list ) {
+    file_hash_list.push_back({filename, file_hash(filename)});
+  }
+  return input_hash(file_hash_list, cell_library);
+}
+
+// @brief 求めておいたファイルごとのハッシュ値からハッシュ値を求める．
+std::uint64_t
+VlSnapshot::input_hash(
+  const vector<pair<string, std::uint64_t>>& file_hash_list,
+  const ClibCellLibrary& cell_library
+)
+{
+  std::uint64_t h = FNV_OFFSET;
+  for ( auto& p: file_hash_list ) {
+    fnv_add(h, p.first.c_str(), p.first.size() + 1);
+    fnv_add(h, reinterpret_cast<const char*>(&p.second), sizeof(p.second));
+  }
+  auto lib_hash = library_hash(cell_library);
+  fnv_add(h, reinterpret_cast<const char*>(&lib_hash), sizeof(lib_hash));
+  return h;
+}
+
+// @brief エラボレーション結果をファイルに書き出す．
+bool
+VlSnapshot::save(
+  const VlMgr& mgr,
+  const string& path,
+  std::uint64_t input_hash,
+  const vector<pair<string, std::uint64_t>>& dep_list
+)
+{
+  mgr.elaborate_all();
+  SnapshotWriter writer{mgr};
+  writer.collect();
+  return writer.write(path, input_hash, dep_list);
+}
+
+// @brief ファイルを開く．
+bool
+VlSnapshot::open(
+  const string& path,
+  std::uint64_t input_hash
+)
+{
+  close();
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if ( fd < 0 ) {
+    return false;
+  }
+  struct stat st;
+  if ( fstat(fd, &st) < 0 || st.st_size < static_cast<off_t>(sizeof(Header)) ) {
+    ::close(fd);
+    return false;
+  }
+  SizeType size = st.st_size;
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // マップした後はファイル記述子は不要
+  ::close(fd);
+  if ( addr == MAP_FAILED ) {
+    return false;
+  }
+  mData = static_cast<const char*>(addr);
+  mSize = size;
+
+  // 形式を検査する．
+  auto header = reinterpret_cast<const Header*>(mData);
+  bool ok = std::memcmp(header->mMagic, SNAPSHOT_MAGIC, sizeof(header->mMagic)) == 0 &&
+    header->mVersion == SNAPSHOT_VERSION &&
+    header->mByteOrder == BYTE_ORDER_MARK &&
+    header->mFileSize == mSize &&
+    header->mInputHash == input_hash;
+  for ( SizeType i = 0; ok && i < SEC_NUM; ++ i ) {
+    auto& sec = header->mSection[i];
+    ok = sec.mOffset % SECTION_ALIGN == 0 &&
+      sec.mOffset <= mSize &&
+      sec.mNum <= mSize - sec.mOffset;
+  }
+  if ( ok ) {
+    // 要素数が範囲に収まっているかを調べる．
+    ok = section<Scope>(SEC_SCOPE).size() == header->mSection[SEC_SCOPE].mNum &&
+      section<Decl>(SEC_DECL).size() == header->mSection[SEC_DECL].mNum &&
+      section<Prim>(SEC_PRIM).size() == header->mSection[SEC_PRIM].mNum &&
+      section<PrimTerm>(SEC_TERM).size() == header->mSection[SEC_TERM].mNum &&
+      section<ContAssign>(SEC_CONTASSIGN).size() == header->mSection[SEC_CONTASSIGN].mNum &&
+      section<Udp>(SEC_UDP).size() == header->mSection[SEC_UDP].mNum &&
+      section<std::uint32_t>(SEC_UDPROW).size() == header->mSection[SEC_UDPROW].mNum &&
+      section<Attr>(SEC_ATTR).size() == header->mSection[SEC_ATTR].mNum &&
+      section<Dep>(SEC_DEP).size() == header->mSection[SEC_DEP].mNum;
+  }
+  if ( ok ) {
+    // 文字列の表は '\0' で終わっていなければならない．
+    auto str_sec = section<char>(SEC_STR);
+    ok = str_sec.empty() || str_sec[str_sec.size() - 1] == '\0';
+  }
+  if ( ok ) {
+    // 範囲を表すフィールドを検査する．
+    auto decl_num = decl_list().size();
+    auto prim_num = prim_list().size();
+    auto ca_num = contassign_list().size();
+    auto term_num = section<PrimTerm>(SEC_TERM).size();
+    auto row_num = section<std::uint32_t>(SEC_UDPROW).size();
+    for ( auto& rec: scope_list() ) {
+      if ( rec.mDeclBegin > rec.mDeclEnd || rec.mDeclEnd > decl_num ||
+	   rec.mPrimBegin > rec.mPrimEnd || rec.mPrimEnd > prim_num ||
+	   rec.mContAssignBegin > rec.mContAssignEnd ||
+	   rec.mContAssignEnd > ca_num ) {
+	ok = false;
+	break;
+      }
+    }
+    for ( auto& rec: prim_list() ) {
+      if ( rec.mTermBegin > rec.mTermEnd || rec.mTermEnd > term_num ) {
+	ok = false;
+	break;
+      }
+    }
+    for ( auto& rec: udp_list() ) {
+      if ( rec.mRowBegin > rec.mRowEnd || rec.mRowEnd > row_num ) {
+	ok = false;
+	break;
+      }
+    }
+  }
+  if ( ok ) {
+    // 読み込んだファイルの内容が変わっていないか調べる．
+    for ( auto& rec: dep_list() ) {
+      if ( file_hash(string{str(rec.mName)}) != rec.mHash ) {
+	ok = false;
+	break;
+      }
+    }
+  }
+  if ( !ok ) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+// @brief ファイルを閉じる．
+void
+VlSnapshot::close()
+{
+  if ( mData != nullptr ) {
+    munmap(const_cast<char*>(mData), mSize);
+    mData = nullptr;
+    mSize = 0;
+  }
+}
+
+// @brief セクションの先頭と末尾を返す．
+template<typename T>
+VlSpan<T>
+VlSnapshot::section(
+  SizeType id
+) const
+{
+  if ( mData == nullptr ) {
+    return VlSpan<T>{};
+  }
+  auto header = reinterpret_cast<const Header*>(mData);
+  auto& sec = header->mSection[id];
+  // 壊れたファイルでも領域外を参照しないようにする．
+  SizeType num = std::min<SizeType>(sec.mNum, (mSize - sec.mOffset) / sizeof(T));
+  auto begin = reinterpret_cast<const T*>(mData + sec.mOffset);
+  return VlSpan<T>{begin, begin + num};
+}
+
+// @brief 文字列を返す．
+std::string_view
+VlSnapshot::str(
+  std::uint32_t id
+) const
+{
+  auto str_sec = section<char>(SEC_STR);
+  if ( id >= str_sec.size() ) {
+    return std::string_view{};
+  }
+  return std::string_view{str_sec.begin() + id};
+}
+
+// @brief スコープのリストを返す．
+VlSpan<VlSnapshot::Scope>
+VlSnapshot::scope_list() const
+{
+  return section<Scope>(SEC_SCOPE);
+}
+
+// @brief 宣言要素のリストを返す．
+VlSpan<VlSnapshot::Decl>
+VlSnapshot::decl_list() const
+{
+  return section<Decl>(SEC_DECL);
+}
+
+// @brief スコープに属する宣言要素のリストを返す．
+VlSpan<VlSnapshot::Decl>
+VlSnapshot::decl_list(
+  std::uint32_t scope
+) const
+{
+  auto& rec = scope_list()[scope];
+  auto all = decl_list();
+  return VlSpan<Decl>{all.begin() + rec.mDeclBegin,
+		      all.begin() + rec.mDeclEnd};
+}
+
+// @brief primitive のリストを返す．
+VlSpan<VlSnapshot::Prim>
+VlSnapshot::prim_list() const
+{
+  return section<Prim>(SEC_PRIM);
+}
+
+// @brief スコープに属する primitive のリストを返す．
+VlSpan<VlSnapshot::Prim>
+VlSnapshot::prim_list(
+  std::uint32_t scope
+) const
+{
+  auto& rec = scope_list()[scope];
+  auto all = prim_list();
+  return VlSpan<Prim>{all.begin() + rec.mPrimBegin,
+		      all.begin() + rec.mPrimEnd};
+}
+
+// @brief primitive の端子のリストを返す．
+VlSpan<VlSnapshot::PrimTerm>
+VlSnapshot::prim_term_list(
+  std::uint32_t prim
+) const
+{
+  auto& rec = prim_list()[prim];
+  auto all = section<PrimTerm>(SEC_TERM);
+  return VlSpan<PrimTerm>{all.begin() + rec.mTermBegin,
+			  all.begin() + rec.mTermEnd};
+}
+
+// @brief continuous assignment のリストを返す．
+VlSpan<VlSnapshot::ContAssign>
+VlSnapshot::contassign_list() const
+{
+  return section<ContAssign>(SEC_CONTASSIGN);
+}
+
+// @brief スコープに属する continuous assignment のリストを返す．
+VlSpan<VlSnapshot::ContAssign>
+VlSnapshot::contassign_list(
+  std::uint32_t scope
+) const
+{
+  auto& rec = scope_list()[scope];
+  auto all = contassign_list();
+  return VlSpan<ContAssign>{all.begin() + rec.mContAssignBegin,
+			    all.begin() + rec.mContAssignEnd};
+}
+
+// @brief UDP 定義のリストを返す．
+VlSpan<VlSnapshot::Udp>
+VlSnapshot::udp_list() const
+{
+  return section<Udp>(SEC_UDP);
+}
+
+// @brief UDP 定義の table entry のリストを返す．
+VlSpan<std::uint32_t>
+VlSnapshot::udp_table(
+  std::uint32_t udp
+) const
+{
+  auto& rec = udp_list()[udp];
+  auto all = section<std::uint32_t>(SEC_UDPROW);
+  return VlSpan<std::uint32_t>{all.begin() + rec.mRowBegin,
+			       all.begin() + rec.mRowEnd};
+}
+
+// @brief 属性のリストを返す．
+VlSpan<VlSnapshot::Attr>
+VlSnapshot::attr_list() const
+{
+  return section<Attr>(SEC_ATTR);
+}
+
+// @brief 読み込んだファイルのリストを返す．
+VlSpan<VlSnapshot::Dep>
+VlSnapshot::dep_list() const
+{
+  return section<Dep>(SEC_DEP);
+}
+
+// @brief スコープの階層名を返す．
+string
+VlSnapshot::scope_full_name(
+  std::uint32_t scope
+) const
+{
+  auto scopes = scope_list();
+  vector<std::uint32_t> path;
+  // 壊れたファイルで循環していても止まるように深さを制限する．
+  for ( auto id = scope;
+	id < scopes.size() && path.size() <= scopes.size();
+	id = scopes[id].mParent ) {
+    path.push_back(id);
+  }
+  string ans;
+  for ( SizeType i = path.size(); i > 0; -- i ) {
+    if ( !ans.empty() ) {
+      ans += '.';
+    }
+    auto name = str(scopes[path[i - 1]].mName);
+    if ( name.empty() ) {
+      ans += "<anonymous>";
+    }
+    else {
+      ans += name;
+    }
+  }
+  return ans;
+}
+
+END_NAMESPACE_YM_VERILOG
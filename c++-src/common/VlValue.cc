@@ -17,65 +17,66 @@ BEGIN_NAMESPACE_YM_VERILOG
 //////////////////////////////////////////////////////////////////////
 
 // @brief 空のコンストラクタ
-VlValue::VlValue() :
-  mRep{new VlValueError{}}
+VlValue::VlValue()
 {
 }
 
 // @brief コピーコンストラクタ
 VlValue::VlValue(
   const VlValue& src
-) : mRep{src.mRep}
-{
-}
+) = default;
 
 // @brief ムーブコンストラクタ
 VlValue::VlValue(
   VlValue&& src
-) : mRep{std::move(src.mRep)}
-{
-}
+) = default;
 
 // @brief 整数値からのコンストラクタ
 VlValue::VlValue(
   int val
-) : mRep{new VlValueInt{val}}
+) : mType{Type::INT},
+    mInt{val}
 {
 }
 
 // @brief std::uint32_t からのコンストラクタ
 VlValue::VlValue(
   std::uint32_t val
-) : mRep{new VlValueUint{val}}
+) : mType{Type::UINT},
+    mUint{val}
 {
 }
 
 // @brief スカラー値からのコンストラクタ
 VlValue::VlValue(
   const VlScalarVal& val
-) : mRep{new VlValueScalar{val}}
+) : mType{Type::SCALAR},
+    mScalar{val}
 {
 }
 
 // @brief time からのコンストラクタ
 VlValue::VlValue(
   VlTime val
-) : mRep{new VlValueTime{val}}
+) : mType{Type::TIME},
+    mTime{val}
 {
 }
 
 // @brief 実数からのコンストラクタ
 VlValue::VlValue(
   double val
-) : mRep{new VlValueReal(val)}
+) : mType{Type::REAL},
+    mReal{val}
 {
 }
 
 // @brief ビットベクタからのコンストラクタ
 VlValue::VlValue(
   const BitVector& val
-) : mRep{new VlValueBitVector{val}}
+)
 {
+  set(val);
 }
 
 // @brief 型変換を伴うコンストラクタ
@@ -84,30 +85,7 @@ VlValue::VlValue(
   const VlValueType& value_type
 )
 {
-  if ( value_type.is_int_type() ) {
-    mRep = shared_ptr<VlValueRep>{new VlValueInt{src.int_value()}};
-  }
-  else if ( value_type.is_real_type() ) {
-    mRep = shared_ptr<VlValueRep>{new VlValueReal{src.real_value()}};
-  }
-  else if ( value_type.is_time_type() ) {
-    mRep = shared_ptr<VlValueRep>{new VlValueTime{src.time_value()}};
-  }
-  else if ( value_type.is_no_type() ) {
-    mRep = src.mRep;
-  }
-  else if ( value_type.is_bitvector_type() ) {
-    auto src_bv = src.bitvector_value();
-    auto value_p = new VlValueBitVector{BitVector{src_bv,
-						  value_type.size(),
-						  value_type.is_sized(),
-						  value_type.is_signed(),
-						  src_bv.base()}};
-    mRep = shared_ptr<VlValueRep>{value_p};
-  }
-  else {
-    ASSERT_NOT_REACHED;
-  }
+  set_with_type(src, value_type);
 }
 
 // @brief 型変換を伴うムーブコンストラクタ
@@ -116,32 +94,12 @@ VlValue::VlValue(
   const VlValueType& value_type
 )
 {
-  if ( this->value_type() == value_type || value_type.is_no_type() ) {
+  if ( src.value_type() == value_type || value_type.is_no_type() ) {
     // 型が同じ場合だけムーブを使う．
-    mRep = std::move(src.mRep);
+    *this = std::move(src);
   }
   else {
-    if ( value_type.is_int_type() ) {
-      mRep = shared_ptr<VlValueRep>{new VlValueInt{src.int_value()}};
-    }
-    else if ( value_type.is_real_type() ) {
-      mRep = shared_ptr<VlValueRep>{new VlValueReal{src.real_value()}};
-    }
-    else if ( value_type.is_time_type() ) {
-      mRep = shared_ptr<VlValueRep>{new VlValueTime{src.time_value()}};
-    }
-    else if ( value_type.is_bitvector_type() ) {
-      auto src_bv = src.bitvector_value();
-      auto value_p = new VlValueBitVector{BitVector{src_bv,
-						    value_type.size(),
-						    value_type.is_sized(),
-						    value_type.is_signed(),
-						    src_bv.base()}};
-      mRep = shared_ptr<VlValueRep>{value_p};
-    }
-    else {
-      ASSERT_NOT_REACHED;
-    }
+    set_with_type(src, value_type);
   }
 }
 
@@ -149,21 +107,13 @@ VlValue::VlValue(
 VlValue&
 VlValue::operator=(
   const VlValue& src
-)
-{
-  mRep = src.mRep;
-  return *this;
-}
+) = default;
 
 // @brief ムーブ代入演算子
 VlValue&
 VlValue::operator=(
   VlValue&& src
-)
-{
-  mRep = std::move(src.mRep);
-  return *this;
-}
+) = default;
 
 // @brief デストラクタ
 VlValue::~VlValue()
@@ -176,7 +126,9 @@ VlValue::set(
   int val
 )
 {
-  mRep = shared_ptr<VlValueRep>{new VlValueInt{val}};
+  mType = Type::INT;
+  mInt = val;
+  mRep = nullptr;
 }
 
 // @brief unsigned int の値をセットする．
@@ -185,7 +137,9 @@ VlValue::set(
   unsigned int val
 )
 {
-  mRep = shared_ptr<VlValueRep>{new VlValueUint{val}};
+  mType = Type::UINT;
+  mUint = val;
+  mRep = nullptr;
 }
 
 // @brief スカラー値をセットする．
@@ -194,7 +148,9 @@ VlValue::set(
   const VlScalarVal& val
 )
 {
-  mRep = shared_ptr<VlValueRep>{new VlValueScalar{val}};
+  mType = Type::SCALAR;
+  mScalar = val;
+  mRep = nullptr;
 }
 
 // @brief time の値をセットする．
@@ -203,7 +159,9 @@ VlValue::set(
   VlTime val
 )
 {
-  mRep = shared_ptr<VlValueRep>{new VlValueTime{val}};
+  mType = Type::TIME;
+  mTime = val;
+  mRep = nullptr;
 }
 
 // @brief 実数値をセットする．
@@ -212,7 +170,9 @@ VlValue::set(
   double val
 )
 {
-  mRep = shared_ptr<VlValueRep>{new VlValueReal{val}};
+  mType = Type::REAL;
+  mReal = val;
+  mRep = nullptr;
 }
 
 // @brief ビットベクタの値をセットする．
@@ -221,7 +181,365 @@ VlValue::set(
   const BitVector& val
 )
 {
-  mRep = shared_ptr<VlValueRep>{new VlValueBitVector{val}};
+  mType = Type::BITVECTOR;
+  if ( val.size() <= INLINE_BITS ) {
+    // ヒープ領域を使わずに直接保持する．
+    mBitVector = val;
+    mRep = nullptr;
+  }
+  else {
+    mRep = shared_ptr<VlValueRep>{new VlValueBitVector{val}};
+  }
+}
+
+// @brief 型変換を行いながら値を設定する．
+void
+VlValue::set_with_type(
+  const VlValue& src,
+  const VlValueType& value_type
+)
+{
+  if ( value_type.is_int_type() ) {
+    set(src.int_value());
+  }
+  else if ( value_type.is_real_type() ) {
+    set(src.real_value());
+  }
+  else if ( value_type.is_time_type() ) {
+    set(src.time_value());
+  }
+  else if ( value_type.is_no_type() ) {
+    *this = src;
+  }
+  else if ( value_type.is_bitvector_type() ) {
+    auto src_bv = src.bitvector_value();
+    set(BitVector{src_bv,
+		  value_type.size(),
+		  value_type.is_sized(),
+		  value_type.is_signed(),
+		  src_bv.base()});
+  }
+  else {
+    ASSERT_NOT_REACHED;
+  }
+}
+
+// @brief 整数型に変換可能な時に true を返す．
+bool
+VlValue::is_int_compat() const
+{
+  switch ( mType ) {
+  case Type::INT:
+  case Type::UINT:
+  case Type::REAL:
+    return true;
+
+  case Type::SCALAR:
+    return !mScalar.is_xz();
+
+  case Type::TIME:
+    return mTime.value() <= 0x7FFFFFFFUL;
+
+  case Type::BITVECTOR:
+    return mRep != nullptr ? mRep->is_int_compat() : mBitVector.is_int();
+
+  case Type::ERROR:
+    return false;
+  }
+  ASSERT_NOT_REACHED;
+  return false;
+}
+
+// @brief unsigned uint 型に変換可能な時に true を返す．
+bool
+VlValue::is_uint_compat() const
+{
+  switch ( mType ) {
+  case Type::INT:
+  case Type::UINT:
+  case Type::REAL:
+    return true;
+
+  case Type::SCALAR:
+    return !mScalar.is_xz();
+
+  case Type::TIME:
+    return mTime.value() <= 0xFFFFFFFFUL;
+
+  case Type::BITVECTOR:
+    return mRep != nullptr ? mRep->is_uint_compat() : mBitVector.is_uint32();
+
+  case Type::ERROR:
+    return false;
+  }
+  ASSERT_NOT_REACHED;
+  return false;
+}
+
+// @brief 実数型に変換可能な時に true を返す．
+bool
+VlValue::is_real_compat() const
+{
+  switch ( mType ) {
+  case Type::INT:
+  case Type::UINT:
+  case Type::REAL:
+  case Type::TIME:
+    return true;
+
+  case Type::SCALAR:
+    return !mScalar.is_xz();
+
+  case Type::BITVECTOR:
+    return true;
+
+  case Type::ERROR:
+    return false;
+  }
+  ASSERT_NOT_REACHED;
+  return false;
+}
+
+// @brief time 型に変換可能な時に true を返す．
+bool
+VlValue::is_time_compat() const
+{
+  switch ( mType ) {
+  case Type::INT:
+  case Type::UINT:
+  case Type::REAL:
+  case Type::TIME:
+    return true;
+
+  case Type::SCALAR:
+    return !mScalar.is_xz();
+
+  case Type::BITVECTOR:
+    return mRep != nullptr ? mRep->is_time_compat() : mBitVector.is_time();
+
+  case Type::ERROR:
+    return false;
+  }
+  ASSERT_NOT_REACHED;
+  return false;
+}
+
+// @brief ビットベクタ型に変換可能な時に true を返す．
+bool
+VlValue::is_bitvector_compat() const
+{
+  switch ( mType ) {
+  case Type::INT:
+  case Type::UINT:
+  case Type::SCALAR:
+  case Type::TIME:
+  case Type::BITVECTOR:
+    return true;
+
+  case Type::REAL:
+  case Type::ERROR:
+    return false;
+  }
+  ASSERT_NOT_REACHED;
+  return false;
+}
+
+// @brief 整数型の値を返す．
+int
+VlValue::int_value() const
+{
+  switch ( mType ) {
+  case Type::INT:       return mInt;
+  case Type::UINT:      return static_cast<int>(mUint);
+  case Type::SCALAR:    return mScalar.to_int();
+  case Type::REAL:      return static_cast<int>(mReal);
+  case Type::TIME:      return static_cast<int>(mTime.to_uint());
+  case Type::BITVECTOR:
+    return mRep != nullptr ? mRep->int_value() : mBitVector.to_int();
+  case Type::ERROR:     return 0;
+  }
+  ASSERT_NOT_REACHED;
+  return 0;
+}
+
+// @brief unsigned int 型の値を返す．
+unsigned int
+VlValue::uint_value() const
+{
+  switch ( mType ) {
+  case Type::INT:       return static_cast<unsigned int>(mInt);
+  case Type::UINT:      return mUint;
+  case Type::SCALAR:    return static_cast<unsigned int>(mScalar.to_int());
+  case Type::REAL:      return static_cast<unsigned int>(mReal);
+  case Type::TIME:      return mTime.to_uint();
+  case Type::BITVECTOR:
+    return mRep != nullptr ? mRep->uint_value() : mBitVector.to_uint32();
+  case Type::ERROR:     return 0;
+  }
+  ASSERT_NOT_REACHED;
+  return 0;
+}
+
+// @brief スカラー型の値を返す．
+VlScalarVal
+VlValue::scalar_value() const
+{
+  switch ( mType ) {
+  case Type::INT:       return VlScalarVal(mInt);
+  case Type::UINT:      return VlScalarVal(mUint);
+  case Type::SCALAR:    return mScalar;
+  case Type::REAL:      return VlScalarVal(mReal);
+  case Type::TIME:      return VlScalarVal(mTime.low());
+  case Type::BITVECTOR:
+    return mRep != nullptr ? mRep->scalar_value() : mBitVector.to_scalar();
+  case Type::ERROR:     return VlScalarVal::x();
+  }
+  ASSERT_NOT_REACHED;
+  return VlScalarVal::x();
+}
+
+// @brief 論理型の値を返す．
+VlScalarVal
+VlValue::logic_value() const
+{
+  switch ( mType ) {
+  case Type::INT:
+    return mInt != 0 ? VlScalarVal::one() : VlScalarVal::zero();
+
+  case Type::UINT:
+    return mUint != 0 ? VlScalarVal::one() : VlScalarVal::zero();
+
+  case Type::SCALAR:
+    return mScalar.is_z() ? VlScalarVal::x() : mScalar;
+
+  case Type::REAL:
+    return mReal != 0.0 ? VlScalarVal::one() : VlScalarVal::zero();
+
+  case Type::TIME:
+    return mTime.value() != 0UL ? VlScalarVal::one() : VlScalarVal::zero();
+
+  case Type::BITVECTOR:
+    return mRep != nullptr ? mRep->logic_value() : mBitVector.to_logic();
+
+  case Type::ERROR:
+    return VlScalarVal::x();
+  }
+  ASSERT_NOT_REACHED;
+  return VlScalarVal::x();
+}
+
+// @brief 実数型の値を返す．
+double
+VlValue::real_value() const
+{
+  switch ( mType ) {
+  case Type::INT:       return static_cast<double>(mInt);
+  case Type::UINT:      return static_cast<double>(mUint);
+  case Type::SCALAR:    return static_cast<double>(mScalar.to_int());
+  case Type::REAL:      return mReal;
+  case Type::TIME:      return mTime.to_real();
+  case Type::BITVECTOR:
+    return mRep != nullptr ? mRep->real_value() : mBitVector.to_real();
+  case Type::ERROR:     return 0.0;
+  }
+  ASSERT_NOT_REACHED;
+  return 0.0;
+}
+
+// @brief time 型の値を返す．
+VlTime
+VlValue::time_value() const
+{
+  switch ( mType ) {
+  case Type::INT:       return VlTime(static_cast<unsigned int>(mInt));
+  case Type::UINT:      return VlTime(mUint);
+  case Type::SCALAR:    return VlTime(static_cast<unsigned int>(mScalar.to_int()));
+  case Type::REAL:      return VlTime(mReal);
+  case Type::TIME:      return mTime;
+  case Type::BITVECTOR:
+    return mRep != nullptr ? mRep->time_value() : mBitVector.to_time();
+  case Type::ERROR:     return VlTime();
+  }
+  ASSERT_NOT_REACHED;
+  return VlTime();
+}
+
+// @brief ビットベクタ型の値を返す．
+BitVector
+VlValue::bitvector_value(
+  const VlValueType& req
+) const
+{
+  switch ( mType ) {
+  case Type::INT:       return BitVector(mInt).coerce(req);
+  case Type::UINT:      return BitVector{mUint}.coerce(req);
+  case Type::SCALAR:    return BitVector{mScalar}.coerce(req);
+  case Type::REAL:      return BitVector{};
+  case Type::TIME:      return BitVector{mTime}.coerce(req);
+  case Type::BITVECTOR:
+    if ( mRep != nullptr ) {
+      return mRep->bitvector_value(req);
+    }
+    return BitVector{mBitVector}.coerce(req);
+  case Type::ERROR:     return BitVector{};
+  }
+  ASSERT_NOT_REACHED;
+  return BitVector{};
+}
+
+// @brief ハッシュ値を返す．
+SizeType
+VlValue::hash() const
+{
+  SizeType h = static_cast<SizeType>(mType) * 1048573;
+  switch ( mType ) {
+  case Type::INT:       return h + static_cast<unsigned int>(mInt);
+  case Type::UINT:      return h + mUint;
+  case Type::SCALAR:    return h + mScalar.to_int();
+  case Type::REAL:      return h + std::hash<double>{}(mReal);
+  case Type::TIME:      return h + mTime.hash();
+  case Type::BITVECTOR:
+    if ( mRep != nullptr ) {
+      return h + mRep->bitvector_value({}).hash();
+    }
+    return h + mBitVector.hash();
+  case Type::ERROR:     return h;
+  }
+  ASSERT_NOT_REACHED;
+  return h;
+}
+
+// @brief 型と値が全く等しい時に true を返す．
+bool
+VlValue::is_identical(
+  const VlValue& right
+) const
+{
+  if ( mType != right.mType ) {
+    return false;
+  }
+  switch ( mType ) {
+  case Type::INT:       return mInt == right.mInt;
+  case Type::UINT:      return mUint == right.mUint;
+  case Type::SCALAR:    return mScalar == right.mScalar;
+  case Type::REAL:      return mReal == right.mReal;
+  case Type::TIME:      return mTime == right.mTime;
+  case Type::BITVECTOR:
+    if ( mRep == nullptr && right.mRep == nullptr ) {
+      return mBitVector.is_identical(right.mBitVector);
+    }
+    if ( mRep == right.mRep ) {
+      return true;
+    }
+    if ( mRep == nullptr || right.mRep == nullptr ) {
+      // 長さが異なる．
+      return false;
+    }
+    return mRep->bitvector_value({}).is_identical(right.mRep->bitvector_value({}));
+  case Type::ERROR:     return true;
+  }
+  ASSERT_NOT_REACHED;
+  return false;
 }
 
 // @relates VlValue
@@ -76,13 +76,55 @@ EiGfRoot::name() const
   return mPtItem->name();
 }
 
+// @brief 子供のスコープの数の見積もりを設定する．
+void
+EiGfRoot::reserve(
+  SizeType num
+)
+{
+  if ( mTable.empty() ) {
+    mArray.reserve(num);
+  }
+  else {
+    mTable.reserve(num);
+  }
+}
+
 // @brief 子供のスコープを追加する．
+//
+// generate-for 文のインデックスはほとんどの場合等差数列となるので
+// 配列で保持する．等差数列でなくなった時点でハッシュ表に切り替える．
 void
 EiGfRoot::add(
   SizeType index,
   const VlScope* block
 )
 {
+  if ( mTable.empty() ) {
+    int n = mArray.size();
+    int diff = static_cast<int>(index) - mOffset;
+    if ( n == 0 ) {
+      mOffset = index;
+      mArray.push_back(block);
+      return;
+    }
+    if ( n == 1 && diff != 0 ) {
+      mStride = diff;
+      mArray.push_back(block);
+      return;
+    }
+    if ( n > 1 && diff == mStride * n ) {
+      mArray.push_back(block);
+      return;
+    }
+
+    // 等差数列でなくなったのでハッシュ表に移す．
+    for ( int i = 0; i < n; ++ i ) {
+      mTable.emplace(mStride * i + mOffset, mArray[i]);
+    }
+    mArray.clear();
+    mArray.shrink_to_fit();
+  }
   mTable.emplace(index, block);
 }
 
@@ -92,12 +134,30 @@ EiGfRoot::elem_by_index(
   SizeType index
 )
 {
-  if ( mTable.count(index) ) {
-    return mTable.at(index);
+  if ( !mTable.empty() ) {
+    auto p = mTable.find(index);
+    if ( p != mTable.end() ) {
+      return p->second;
+    }
+    return nullptr;
   }
-  else {
+
+  int n = mArray.size();
+  int diff = static_cast<int>(index) - mOffset;
+  if ( n == 0 ) {
+    return nullptr;
+  }
+  if ( n == 1 || diff == 0 ) {
+    return diff == 0 ? mArray[0] : nullptr;
+  }
+  if ( diff % mStride != 0 ) {
+    return nullptr;
+  }
+  int pos = diff / mStride;
+  if ( pos < 0 || pos >= n ) {
     return nullptr;
   }
+  return mArray[pos];
 }
 
 END_NAMESPACE_YM_VERILOG
@@ -17,9 +17,6 @@
 #include "ym/pt/PtMisc.h"
 
 #include "ym/ClibCell.h"
-#include "ym/ClibPin.h"
-
-#include "ym/Range.h"
 
 
 BEGIN_NAMESPACE_YM_VERILOG
@@ -110,11 +107,11 @@ EiFactory::new_PrimitiveArray(
 ElbPrimitive*
 EiFactory::new_CellPrimitive(
   ElbPrimHead* head,
-  const ClibCell& cell,
+  const vector<VpiDir>& dir_list,
   const PtInst* pt_inst
 )
 {
-  auto prim = new EiPrimitive2{head, cell, pt_inst};
+  auto prim = new EiPrimitive2{head, dir_list, pt_inst};
   return prim;
 }
 
@@ -122,7 +119,7 @@ EiFactory::new_CellPrimitive(
 ElbPrimArray*
 EiFactory::new_CellPrimitiveArray(
   ElbPrimHead* head,
-  const ClibCell& cell,
+  const vector<VpiDir>& dir_list,
   const PtInst* pt_inst,
   const PtExpr* left,
   const PtExpr* right,
@@ -133,7 +130,7 @@ EiFactory::new_CellPrimitiveArray(
   EiRangeImpl range;
   range.set(left, right, left_val, right_val);
 
-  auto prim_array = new EiPrimArray{head, cell, pt_inst, range};
+  auto prim_array = new EiPrimArray{head, dir_list, pt_inst, range};
   return prim_array;
 }
 
@@ -438,7 +435,7 @@ EiPrimArray::EiPrimArray(
 // @brief コンストラクタ
 EiPrimArray::EiPrimArray(
   ElbPrimHead* head,
-  const ClibCell& cell,
+  const vector<VpiDir>& dir_list,
   const PtInst* pt_inst,
   const EiRangeImpl& range
 ) : mHead{head},
@@ -447,10 +444,9 @@ EiPrimArray::EiPrimArray(
     mArray(mRange.size())
 {
   SizeType n = mRange.size();
-  SizeType port_num = pt_inst->port_num();
   for ( SizeType i = 0; i < n; ++ i ) {
     SizeType index = mRange.index(i);
-    mArray[i].init(this, index, port_num);
+    mArray[i].init(this, index, dir_list);
   }
 }
 
@@ -787,31 +783,16 @@ EiPrimitive::init_port(
   }
 }
 
-// @brief ポート配列を初期化する．
+// @brief セルのポート配列を初期化する．
 void
 EiPrimitive::init_port(
-  SizeType port_num,
-  const ClibCell& cell
+  const vector<VpiDir>& dir_list
 )
 {
-  mPortArray = vector<EiPrimTerm>(port_num);
-
-  for ( auto id: Range(cell.pin_num()) ) {
-    auto pin = cell.pin(id);
-    VpiDir dir;
-    if ( pin.is_input() ) {
-      dir = VpiDir::Input;
-    }
-    else if ( pin.is_output() ) {
-      dir = VpiDir::Output;
-    }
-    else if ( pin.is_inout() ) {
-      dir = VpiDir::Inout;
-    }
-    else {
-      ASSERT_NOT_REACHED;
-    }
-    mPortArray[id].set(this, id, dir);
+  SizeType n = dir_list.size();
+  mPortArray = vector<EiPrimTerm>(n);
+  for ( SizeType id = 0; id < n; ++ id ) {
+    mPortArray[id].set(this, id, dir_list[id]);
   }
 }
 
@@ -854,19 +835,18 @@ EiPrimitive1::init(
   init_port(port_num);
 }
 
-// @brief 初期設定を行う．
+// @brief セルの要素として初期設定を行う．
 void
 EiPrimitive1::init(
   EiPrimArray* prim_array,
   SizeType index,
-  SizeType port_num,
-  const ClibCell& cell
+  const vector<VpiDir>& dir_list
 )
 {
   mPrimArray = prim_array;
   mIndex = index;
 
-  init_port(port_num, cell);
+  init_port(dir_list);
 }
 
 // @brief 名前の取得
@@ -910,12 +890,12 @@ EiPrimitive2::EiPrimitive2(
 // @brief コンストラクタ
 EiPrimitive2::EiPrimitive2(
   ElbPrimHead* head,
-  const ClibCell& cell,
+  const vector<VpiDir>& dir_list,
   const PtInst* pt_inst
 ) : mHead{head},
     mPtInst{pt_inst}
 {
-  init_port(pt_inst->port_num(), cell);
+  init_port(dir_list);
 }
 
 // @brief デストラクタ
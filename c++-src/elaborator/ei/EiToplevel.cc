@@ -70,4 +70,12 @@ EiToplevel::full_name() const
   return "";
 }
 
+// @brief fullname をストリームに書き出す．
+void
+EiToplevel::write_full_name(
+  ostream& /*s*/
+) const
+{
+}
+
 END_NAMESPACE_YM_VERILOG
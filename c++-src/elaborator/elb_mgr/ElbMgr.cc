@@ -22,6 +22,7 @@
 #include "ym/vl/VlUdp.h"
 #include "ym/pt/PtUdp.h"
 #include "ym/pt/PtMisc.h"
+#include "ym/pt/PtModule.h"
 #include "elaborator/ElbGfRoot.h"
 #include "elaborator/ElbUdp.h"
 #include "elaborator/ElbModule.h"
@@ -53,7 +54,9 @@ const int debug = debug_all;
 
 // @brief コンストラクタ
 ElbMgr::ElbMgr() :
-  mFactory{ElbFactory::new_obj()}
+  mFactory{ElbFactory::new_obj()},
+  mRootUnit{new ElbUnit},
+  mCurUnit{mRootUnit}
 {
 }
 
@@ -61,29 +64,432 @@ ElbMgr::ElbMgr() :
 ElbMgr::~ElbMgr()
 {
   clear();
+  delete mRootUnit;
 }
 
 // @brief 内容をクリアする．
 void
 ElbMgr::clear()
 {
-  for ( auto head: mHeadList ) {
-    delete head;
+  // 全てのユニットを破壊する．
+  vector<ElbUnit*> unit_list{mRootUnit};
+  for ( SizeType rpos = 0; rpos < unit_list.size(); ++ rpos ) {
+    auto unit = unit_list[rpos];
+    unit_list.insert(unit_list.end(),
+		     unit->mChildList.begin(), unit->mChildList.end());
   }
-  mHeadList.clear();
-
-  for ( auto obj: mObjList ) {
-    delete obj;
+  for ( auto unit: unit_list ) {
+    delete_unit(unit);
   }
-  mObjList.clear();
+  mRootUnit = new ElbUnit;
+  mCurUnit = mRootUnit;
+  mUnitDict.clear();
+  mModuleUnitDict.clear();
+  mGeneration = 0;
+  mStaleOverride = false;
 
   mUdpList.clear();
   mUdpHash.clear();
   mTopmoduleList.clear();
   mSystfHash.clear();
+  mObjDict.clear();
+  mModuleDefDict.clear();
   mTagDict.clear();
+  mAllInternalScopeList.clear();
+  mAllDeclListDict.clear();
+  mAllDeclArrayListDict.clear();
+  mAllDefParamList.clear();
+  mAllParamAssignList.clear();
+  mAllModuleList.clear();
+  mAllModuleArrayList.clear();
+  mAllPrimitiveList.clear();
+  mAllPrimArrayList.clear();
+  mAllContAssignList.clear();
+  mAllTaskList.clear();
+  mAllFunctionList.clear();
+  mAllProcessList.clear();
   mAttrHash.clear();
   mTopLevel = nullptr;
+  mNewObjList.clear();
+  mRecordNewObj = true;
+  mFrozen = false;
+}
+
+// @brief スコープごとの要素の表を作る．
+void
+ElbMgr::make_scope_table()
+{
+  mTagDict.make_table();
+}
+
+// @brief 遅延して作られる内部の状態をすべて確定させる．
+void
+ElbMgr::freeze()
+{
+  if ( mFrozen ) {
+    return;
+  }
+
+  if ( !mTagDict.has_table() ) {
+    mTagDict.make_table();
+  }
+  mObjDict.freeze();
+
+  // スコープの fullname のキャッシュは VlScope 自身が
+  // 排他制御して作るのでここで求めておく必要はない．
+
+  mFrozen = true;
+}
+
+// @brief モジュールインスタンスのユニットを作る．
+ElbUnit*
+ElbMgr::new_unit(
+  const VlScope* parent,
+  const PtModule* pt_module,
+  const PtItem* pt_head,
+  const PtInst* pt_inst
+)
+{
+  auto parent_unit = unit_of(parent);
+  auto unit = new ElbUnit;
+  unit->mParent = parent_unit;
+  unit->mParentScope = parent;
+  unit->mPtModule = pt_module;
+  unit->mPtHead = pt_head;
+  unit->mPtInst = pt_inst;
+  unit->mGeneration = mGeneration;
+  parent_unit->mChildList.push_back(unit);
+  if ( pt_module != nullptr ) {
+    mModuleUnitDict[pt_module].push_back(unit);
+  }
+  return unit;
+}
+
+// @brief 以降に生成する要素を所有するユニットを設定する．
+ElbUnit*
+ElbMgr::set_cur_unit(
+  ElbUnit* unit
+)
+{
+  auto prev_unit = mCurUnit;
+  mCurUnit = unit != nullptr ? unit : mRootUnit;
+  return prev_unit;
+}
+
+// @brief スコープを含むユニットを返す．
+ElbUnit*
+ElbMgr::unit_of(
+  const VlScope* scope
+) const
+{
+  for ( ; scope != nullptr; scope = scope->parent_scope() ) {
+    auto p = mUnitDict.find(scope);
+    if ( p != mUnitDict.end() ) {
+      return p->second;
+    }
+  }
+  return mRootUnit;
+}
+
+// @brief defparam 文で他のスコープのパラメータを書き換えたことを記録する．
+void
+ElbMgr::reg_override(
+  const VlScope* scope
+)
+{
+  auto target = unit_of(scope);
+  if ( target->mGeneration != mGeneration ) {
+    // 作り直していないユニットのパラメータはすでに使われている．
+    mStaleOverride = true;
+  }
+  add_dependency(mCurUnit, target);
+  add_dependency(target, mCurUnit);
+}
+
+// @brief ファイルの再読み込みで作り直す必要のあるユニットを求める．
+vector<ElbUnit*>
+ElbMgr::invalid_unit_list(
+  const unordered_set<const PtModule*>& module_set
+) const
+{
+  vector<ElbUnit*> unit_list;
+  unordered_set<ElbUnit*> unit_set;
+  auto put = [&](ElbUnit* unit) {
+    if ( unit_set.count(unit) == 0 ) {
+      unit_set.emplace(unit);
+      unit_list.push_back(unit);
+    }
+  };
+  for ( auto pt_module: module_set ) {
+    auto p = mModuleUnitDict.find(pt_module);
+    if ( p != mModuleUnitDict.end() ) {
+      for ( auto unit: p->second ) {
+	put(unit);
+      }
+    }
+  }
+  for ( SizeType rpos = 0; rpos < unit_list.size(); ++ rpos ) {
+    auto unit = unit_list[rpos];
+    for ( auto child: unit->mChildList ) {
+      put(child);
+    }
+    for ( auto dep: unit->mDependentSet ) {
+      put(dep);
+    }
+  }
+
+  // 親が子供より前になるように深さの順に並べる．
+  unordered_map<ElbUnit*, SizeType> depth_dict;
+  for ( auto unit: unit_list ) {
+    SizeType depth = 0;
+    for ( auto unit1 = unit->mParent; unit1 != nullptr; unit1 = unit1->mParent ) {
+      ++ depth;
+    }
+    depth_dict.emplace(unit, depth);
+  }
+  std::stable_sort(unit_list.begin(), unit_list.end(),
+		   [&](ElbUnit* a, ElbUnit* b) {
+		     return depth_dict.at(a) < depth_dict.at(b);
+		   });
+  return unit_list;
+}
+
+// @brief ユニットとその要素を削除する．
+void
+ElbMgr::remove_units(
+  const vector<ElbUnit*>& unit_list
+)
+{
+  unordered_set<const ElbUnit*> unit_set{unit_list.begin(), unit_list.end()};
+
+  // 削除する要素とスコープ，および削除する要素を含む可能性のある
+  // 残りのスコープを求める．
+  unordered_set<const VlObj*> obj_set;
+  unordered_set<const VlScope*> scope_set;
+  unordered_set<const VlScope*> parent_set;
+  for ( auto unit: unit_list ) {
+    obj_set.insert(unit->mObjList.begin(), unit->mObjList.end());
+    for ( auto scope: unit->mScopeList ) {
+      obj_set.emplace(scope);
+      scope_set.emplace(scope);
+    }
+  }
+  for ( auto unit: unit_list ) {
+    if ( unit->mParentScope != nullptr &&
+	 scope_set.count(unit->mParentScope) == 0 ) {
+      parent_set.emplace(unit->mParentScope);
+    }
+    for ( auto scope: unit->mScopeList ) {
+      auto parent = scope->parent_scope();
+      if ( parent != nullptr && scope_set.count(parent) == 0 ) {
+	parent_set.emplace(parent);
+      }
+    }
+  }
+
+  mObjDict.remove(scope_set, parent_set, obj_set);
+  mTagDict.remove(scope_set, parent_set, obj_set);
+  for ( auto unit: unit_list ) {
+    for ( auto module: unit->mModuleList ) {
+      mModuleDefDict.remove(module);
+    }
+  }
+
+  // 種類ごとのリストから取り除く．
+  auto filter = [&](auto& list) {
+    list.erase(std::remove_if(list.begin(), list.end(),
+			      [&](const VlObj* obj) {
+				return obj_set.count(obj) > 0;
+			      }),
+	       list.end());
+  };
+  filter(mTopmoduleList);
+  filter(mAllInternalScopeList);
+  for ( auto& p: mAllDeclListDict ) {
+    filter(p.second);
+  }
+  for ( auto& p: mAllDeclArrayListDict ) {
+    filter(p.second);
+  }
+  filter(mAllDefParamList);
+  filter(mAllParamAssignList);
+  filter(mAllModuleList);
+  filter(mAllModuleArrayList);
+  filter(mAllPrimitiveList);
+  filter(mAllPrimArrayList);
+  filter(mAllContAssignList);
+  filter(mAllTaskList);
+  filter(mAllFunctionList);
+  filter(mAllProcessList);
+  for ( auto obj: obj_set ) {
+    mAttrHash.erase(obj);
+    mUnitDict.erase(obj);
+  }
+  mNewObjList.clear();
+
+  // 残りのユニットとの関係を切ってから破壊する．
+  for ( auto unit: unit_list ) {
+    for ( auto dep: unit->mDependentSet ) {
+      if ( unit_set.count(dep) == 0 ) {
+	dep->mDependSet.erase(unit);
+      }
+    }
+    for ( auto used: unit->mDependSet ) {
+      if ( unit_set.count(used) == 0 ) {
+	used->mDependentSet.erase(unit);
+      }
+    }
+    auto parent = unit->mParent;
+    if ( parent != nullptr && unit_set.count(parent) == 0 ) {
+      auto& child_list = parent->mChildList;
+      child_list.erase(std::remove(child_list.begin(), child_list.end(), unit),
+		       child_list.end());
+    }
+    if ( unit->mPtModule != nullptr ) {
+      auto p = mModuleUnitDict.find(unit->mPtModule);
+      if ( p != mModuleUnitDict.end() ) {
+	auto& module_unit_list = p->second;
+	module_unit_list.erase(std::remove(module_unit_list.begin(),
+					   module_unit_list.end(), unit),
+			       module_unit_list.end());
+	if ( module_unit_list.empty() ) {
+	  mModuleUnitDict.erase(p);
+	}
+      }
+    }
+  }
+  for ( auto unit: unit_list ) {
+    delete_unit(unit);
+  }
+
+  mCurUnit = mRootUnit;
+  ++ mGeneration;
+  mStaleOverride = false;
+  mFrozen = false;
+}
+
+// @brief topmodule のリストをモジュール定義の順に並べ直す．
+void
+ElbMgr::sort_topmodule_list(
+  const vector<const PtModule*>& pt_module_list
+)
+{
+  unordered_map<string, SizeType> order_dict;
+  for ( SizeType i = 0; i < pt_module_list.size(); ++ i ) {
+    order_dict.emplace(pt_module_list[i]->name(), i);
+  }
+  auto order = [&](const VlModule* module) {
+    auto p = order_dict.find(module->def_name());
+    if ( p != order_dict.end() ) {
+      return p->second;
+    }
+    return pt_module_list.size();
+  };
+  std::stable_sort(mTopmoduleList.begin(), mTopmoduleList.end(),
+		   [&](const VlModule* a, const VlModule* b) {
+		     return order(a) < order(b);
+		   });
+}
+
+// @brief 生成したモジュールを現在のユニットに登録する．
+void
+ElbMgr::reg_module_unit(
+  const VlModule* module
+)
+{
+  mUnitDict.emplace(module, mCurUnit);
+  mCurUnit->mModuleList.push_back(module);
+  reg_scope(module);
+}
+
+// @brief 生成したモジュール配列を現在のユニットに登録する．
+void
+ElbMgr::reg_module_unit(
+  const VlModuleArray* module_array
+)
+{
+  mUnitDict.emplace(module_array, mCurUnit);
+  SizeType n = module_array->elem_num();
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto module = module_array->elem_by_offset(i);
+    mUnitDict.emplace(module, mCurUnit);
+    reg_scope(module);
+  }
+}
+
+// @brief 検索結果の要素を所有するユニットを返す．
+ElbUnit*
+ElbMgr::unit_of(
+  ObjHandle* handle
+) const
+{
+  auto p = mUnitDict.find(handle->namedobj());
+  if ( p != mUnitDict.end() ) {
+    return p->second;
+  }
+  return unit_of(handle->parent_scope());
+}
+
+// @brief user が used の要素を参照したことを記録する．
+void
+ElbMgr::add_dependency(
+  ElbUnit* user,
+  ElbUnit* used
+)
+{
+  if ( user == mRootUnit ) {
+    // 作り直さないので記録する必要はない．
+    return;
+  }
+  for ( auto unit = user; unit != nullptr; unit = unit->mParent ) {
+    if ( unit == used ) {
+      // 祖先を作り直す時には user も作り直される．
+      return;
+    }
+  }
+  used->mDependentSet.emplace(user);
+  user->mDependSet.emplace(used);
+}
+
+// @brief ユニットとその要素を破壊する．
+void
+ElbMgr::delete_unit(
+  ElbUnit* unit
+)
+{
+  for ( auto head: unit->mHeadList ) {
+    delete head;
+  }
+  for ( auto obj: unit->mObjList ) {
+    delete obj;
+  }
+  delete unit;
+}
+
+// @brief 設計中の tag というタグを持つすべての宣言要素のリストを返す．
+VlSpan<const VlDecl*>
+ElbMgr::all_decl_list(
+  int tag
+) const
+{
+  auto p = mAllDeclListDict.find(tag);
+  if ( p == mAllDeclListDict.end() ) {
+    return VlSpan<const VlDecl*>{};
+  }
+  return p->second;
+}
+
+// @brief 設計中の tag というタグを持つすべての宣言要素の配列のリストを返す．
+VlSpan<const VlDeclArray*>
+ElbMgr::all_declarray_list(
+  int tag
+) const
+{
+  auto p = mAllDeclArrayListDict.find(tag);
+  if ( p == mAllDeclArrayListDict.end() ) {
+    return VlSpan<const VlDeclArray*>{};
+  }
+  return p->second;
 }
 
 // @brief UDP 定義のリストを返す．
@@ -141,7 +547,7 @@ ElbMgr::reg_user_systf(
 ObjHandle*
 ElbMgr::find_obj(
   const VlScope* parent,
-  const string& name
+  string_view name
 ) const
 {
   return mObjDict.find(parent, name);
@@ -151,7 +557,7 @@ ElbMgr::find_obj(
 const VlScope*
 ElbMgr::find_namedobj(
   const VlScope* parent,
-  const string& name
+  string_view name
 ) const
 {
   auto handle{find_obj(parent, name)};
@@ -191,6 +597,8 @@ ElbMgr::find_obj_up(
 	DOUT << "--> Found: " << handle->name() << " @ "
 	     << base_scope->name() << endl << endl;
       }
+      // 他のインスタンスの要素を参照した場合は依存関係を記録する．
+      add_dependency(mCurUnit, unit_of(handle));
       return handle;
     }
     // base_scope が上限だったのでこれ以上 upward search できない．
@@ -282,8 +690,11 @@ ElbMgr::reg_internalscope(
   const VlScope* obj
 )
 {
+  reg_scope(obj);
   mObjDict.add(obj);
   mTagDict.add_internalscope(obj);
+  mAllInternalScopeList.push_back(obj);
+  add_new_obj(obj);
 }
 
 // @brief 属性リストを登録する．
@@ -301,7 +712,7 @@ const VlScope*
 ElbMgr::new_Toplevel()
 {
   auto scope{factory().new_Toplevel()};
-  mObjList.push_back(scope);
+  reg_obj(scope);
   mTopLevel = scope;
   return scope;
 }
@@ -314,7 +725,7 @@ ElbMgr::new_StmtBlockScope(
 )
 {
   auto scope{factory().new_StmtBlockScope(parent, pt_stmt)};
-  mObjList.push_back(scope);
+  reg_obj(scope);
   reg_internalscope(scope);
   return scope;
 }
@@ -327,7 +738,7 @@ ElbMgr::new_GenBlock(
 )
 {
   auto scope{factory().new_GenBlock(parent, pt_item)};
-  mObjList.push_back(scope);
+  reg_obj(scope);
   reg_internalscope(scope);
   return scope;
 }
@@ -340,8 +751,9 @@ ElbMgr::new_GfRoot(
 )
 {
   auto gfroot{factory().new_GfRoot(parent, pt_item)};
-  mObjList.push_back(gfroot);
+  reg_obj(gfroot);
   mObjDict.add(gfroot);
+  add_new_obj(gfroot);
   return gfroot;
 }
 
@@ -354,7 +766,7 @@ ElbMgr::new_GfBlock(
 )
 {
   auto gfblock{factory().new_GfBlock(parent, pt_item, gvi)};
-  mObjList.push_back(gfblock);
+  reg_obj(gfblock);
   reg_internalscope(gfblock);
   return gfblock;
 }
@@ -367,7 +779,7 @@ ElbMgr::new_UdpDefn(
 )
 {
   auto udp{factory().new_UdpDefn(pt_udp, is_protected)};
-  mObjList.push_back(udp);
+  reg_obj(udp);
   mUdpList.push_back(udp);
   mUdpHash[pt_udp->name()] = udp;
   return udp;
@@ -383,13 +795,16 @@ ElbMgr::new_Module(
 )
 {
   auto module{factory().new_Module(parent, pt_module, pt_head, pt_inst)};
-  mObjList.push_back(module);
+  reg_obj(module);
+  reg_module_unit(module);
   mObjDict.add(module);
   mModuleDefDict.add(module);
   mTagDict.add_module(module);
+  mAllModuleList.push_back(module);
   if ( parent == mTopLevel ) {
     mTopmoduleList.push_back(module);
   }
+  add_new_obj(module);
   return module;
 }
 
@@ -408,9 +823,12 @@ ElbMgr::new_ModuleArray(
 {
   auto modulearray{factory().new_ModuleArray(parent, pt_module, pt_head, pt_inst,
 					     left, right, left_val, right_val)};
-  mObjList.push_back(modulearray);
+  reg_obj(modulearray);
+  reg_module_unit(modulearray);
   mObjDict.add(modulearray);
   mTagDict.add_modulearray(modulearray);
+  mAllModuleArrayList.push_back(modulearray);
+  add_new_obj(modulearray);
   return modulearray;
 }
 
@@ -422,7 +840,7 @@ ElbMgr::new_IOHead(
 )
 {
   auto head{factory().new_IOHead(module, pt_header)};
-  mHeadList.push_back(head);
+  reg_head(head);
   return head;
 }
 
@@ -434,7 +852,7 @@ ElbMgr::new_IOHead(
 )
 {
   auto head{factory().new_IOHead(taskfunc, pt_header)};
-  mHeadList.push_back(head);
+  reg_head(head);
   return head;
 }
 
@@ -447,7 +865,7 @@ ElbMgr::new_DeclHead(
 )
 {
   auto head{factory().new_DeclHead(parent, pt_head, has_delay)};
-  mHeadList.push_back(head);
+  reg_head(head);
   return head;
 }
 
@@ -465,7 +883,7 @@ ElbMgr::new_DeclHead(
 {
   auto head{factory().new_DeclHead(parent, pt_head, left, right,
 				   left_val, right_val, has_delay)};
-  mHeadList.push_back(head);
+  reg_head(head);
   return head;
 }
 
@@ -478,7 +896,7 @@ ElbMgr::new_DeclHead(
 )
 {
   auto head{factory().new_DeclHead(parent, pt_head, aux_type)};
-  mHeadList.push_back(head);
+  reg_head(head);
   return head;
 }
 
@@ -496,7 +914,7 @@ ElbMgr::new_DeclHead(
 {
   auto head{factory().new_DeclHead(parent, pt_head, aux_type,
 				   left, right, left_val, right_val)};
-  mHeadList.push_back(head);
+  reg_head(head);
   return head;
 }
 
@@ -508,7 +926,7 @@ ElbMgr::new_DeclHead(
 )
 {
   auto head{factory().new_DeclHead(parent, pt_item)};
-  mHeadList.push_back(head);
+  reg_head(head);
   return head;
 }
 
@@ -525,7 +943,7 @@ ElbMgr::new_DeclHead(
 {
   auto head{factory().new_DeclHead(parent, pt_item, left, right,
 				   left_val, right_val)};
-  mHeadList.push_back(head);
+  reg_head(head);
   return head;
 }
 
@@ -539,9 +957,10 @@ ElbMgr::new_Decl(
 )
 {
   auto decl{factory().new_Decl(head, pt_item, init)};
-  mObjList.push_back(decl);
+  reg_obj(decl);
   mObjDict.add(decl);
   mTagDict.add_decl(tag, decl);
+  mAllDeclListDict[tag].push_back(decl);
   return decl;
 }
 
@@ -554,8 +973,9 @@ ElbMgr::new_ImpNet(
 )
 {
   auto decl{factory().new_ImpNet(parent, pt_expr, net_type)};
-  mObjList.push_back(decl);
+  reg_obj(decl);
   mTagDict.add_decl(vpiNet, decl);
+  mAllDeclListDict[vpiNet].push_back(decl);
   return decl;
 }
 
@@ -569,8 +989,9 @@ ElbMgr::new_DeclArray(
 )
 {
   auto decl{factory().new_DeclArray(head, pt_item, range_src)};
-  mObjList.push_back(decl);
+  reg_obj(decl);
   mObjDict.add(decl);
+  mAllDeclArrayListDict[tag].push_back(decl);
   if ( tag == vpiVariables ) {
     // ちょっと汚い補正
     tag += 100;
@@ -587,7 +1008,7 @@ ElbMgr::new_ParamHead(
 )
 {
   auto head{factory().new_ParamHead(parent, pt_head)};
-  mHeadList.push_back(head);
+  reg_head(head);
   return head;
 }
 
@@ -604,7 +1025,7 @@ ElbMgr::new_ParamHead(
 {
   auto head{factory().new_ParamHead(parent, pt_head, left, right,
 				    left_val, right_val)};
-  mHeadList.push_back(head);
+  reg_head(head);
   return head;
 }
 
@@ -617,9 +1038,11 @@ ElbMgr::new_Parameter(
 )
 {
   auto param = factory().new_Parameter(head, pt_item, is_local);
-  mObjList.push_back(param);
+  reg_obj(param);
   mObjDict.add(param);
   mTagDict.add_decl(vpiParameter, param);
+  mAllDeclListDict[vpiParameter].push_back(param);
+  add_new_obj(param);
   return param;
 }
 
@@ -632,7 +1055,7 @@ ElbMgr::new_Genvar(
 )
 {
   auto genvar = factory().new_Genvar(parent, pt_item, val);
-  mObjList.push_back(genvar);
+  reg_obj(genvar);
   mObjDict.add(genvar);
   return genvar;
 }
@@ -646,7 +1069,7 @@ ElbMgr::new_CaHead(
 )
 {
   auto head = factory().new_CaHead(module, pt_head, delay);
-  mHeadList.push_back(head);
+  reg_head(head);
   return head;
 }
 
@@ -660,8 +1083,9 @@ ElbMgr::new_ContAssign(
 )
 {
   auto contassign = factory().new_ContAssign(head, pt_obj, lhs, rhs);
-  mObjList.push_back(contassign);
+  reg_obj(contassign);
   mTagDict.add_contassign(contassign);
+  mAllContAssignList.push_back(contassign);
   return contassign;
 }
 
@@ -675,8 +1099,9 @@ ElbMgr::new_ContAssign(
 )
 {
   auto contassign = factory().new_ContAssign(module, pt_obj, lhs, rhs);
-  mObjList.push_back(contassign);
+  reg_obj(contassign);
   mTagDict.add_contassign(contassign);
+  mAllContAssignList.push_back(contassign);
   return contassign;
 }
 
@@ -692,8 +1117,9 @@ ElbMgr::new_ParamAssign(
 {
   auto paramassign = factory().new_ParamAssign(module, pt_obj, param,
 					       rhs_expr, rhs_value);
-  mObjList.push_back(paramassign);
+  reg_obj(paramassign);
   mTagDict.add_paramassign(paramassign);
+  mAllParamAssignList.push_back(paramassign);
   return paramassign;
 }
 
@@ -709,8 +1135,9 @@ ElbMgr::new_NamedParamAssign(
 {
   auto paramassign = factory().new_NamedParamAssign(module, pt_obj, param,
 						    rhs_expr, rhs_value);
-  mObjList.push_back(paramassign);
+  reg_obj(paramassign);
   mTagDict.add_paramassign(paramassign);
+  mAllParamAssignList.push_back(paramassign);
   return paramassign;
 }
 
@@ -727,8 +1154,9 @@ ElbMgr::new_DefParam(
 {
   auto defparam = factory().new_DefParam(module, pt_header, pt_defparam,
 					 param, rhs_expr, rhs_value);
-  mObjList.push_back(defparam);
+  reg_obj(defparam);
   mTagDict.add_defparam(defparam);
+  mAllDefParamList.push_back(defparam);
   return defparam;
 }
 
@@ -741,7 +1169,7 @@ ElbMgr::new_PrimHead(
 )
 {
   auto head = factory().new_PrimHead(parent, pt_header, has_delay);
-  mHeadList.push_back(head);
+  reg_head(head);
   return head;
 }
 
@@ -755,7 +1183,7 @@ ElbMgr::new_UdpHead(
 )
 {
   auto head = factory().new_UdpHead(parent, pt_header, udp, has_delay);
-  mHeadList.push_back(head);
+  reg_head(head);
   return head;
 }
 
@@ -768,7 +1196,7 @@ ElbMgr::new_CellHead(
 )
 {
   auto head = factory().new_CellHead(parent, pt_header, cell);
-  mHeadList.push_back(head);
+  reg_head(head);
   return head;
 }
 
@@ -780,9 +1208,10 @@ ElbMgr::new_Primitive(
 )
 {
   auto prim = factory().new_Primitive(head, pt_inst);
-  mObjList.push_back(prim);
+  reg_obj(prim);
   mObjDict.add(prim);
   mTagDict.add_primitive(prim);
+  mAllPrimitiveList.push_back(prim);
   return prim;
 }
 
@@ -799,8 +1228,9 @@ ElbMgr::new_PrimitiveArray(
 {
   auto prim = factory().new_PrimitiveArray(head, pt_inst, left, right,
 					   left_val, right_val);
-  mObjList.push_back(prim);
+  reg_obj(prim);
   mTagDict.add_primarray(prim);
+  mAllPrimArrayList.push_back(prim);
   return prim;
 }
 
@@ -808,12 +1238,15 @@ ElbMgr::new_PrimitiveArray(
 ElbPrimitive*
 ElbMgr::new_CellPrimitive(
   ElbPrimHead* head,
-  const ClibCell& cell,
+  const vector<VpiDir>& dir_list,
   const PtInst* pt_inst
 )
 {
-  auto prim = factory().new_CellPrimitive(head, cell, pt_inst);
-  mObjList.push_back(prim);
+  auto prim = factory().new_CellPrimitive(head, dir_list, pt_inst);
+  reg_obj(prim);
+  mObjDict.add(prim);
+  mTagDict.add_primitive(prim);
+  mAllPrimitiveList.push_back(prim);
   return prim;
 }
 
@@ -821,7 +1254,7 @@ ElbMgr::new_CellPrimitive(
 ElbPrimArray*
 ElbMgr::new_CellPrimitiveArray(
   ElbPrimHead* head,
-  const ClibCell& cell,
+  const vector<VpiDir>& dir_list,
   const PtInst* pt_inst,
   const PtExpr* left,
   const PtExpr* right,
@@ -829,10 +1262,12 @@ ElbMgr::new_CellPrimitiveArray(
   int right_val
 )
 {
-  auto prim = factory().new_CellPrimitiveArray(head, cell, pt_inst,
+  auto prim = factory().new_CellPrimitiveArray(head, dir_list, pt_inst,
 					       left, right,
 					       left_val, right_val);
-  mObjList.push_back(prim);
+  reg_obj(prim);
+  mTagDict.add_primarray(prim);
+  mAllPrimArrayList.push_back(prim);
   return prim;
 }
 
@@ -846,9 +1281,12 @@ ElbMgr::new_Function(
 {
   auto func = factory().new_Function(parent, pt_item, const_func);
   #warning "reg_Function" で共通化すべき
-  mObjList.push_back(func);
+  reg_obj(func);
+  reg_scope(func);
   mObjDict.add(func);
   mTagDict.add_function(func);
+  mAllFunctionList.push_back(func);
+  add_new_obj(func);
   return func;
 }
 
@@ -868,9 +1306,12 @@ ElbMgr::new_Function(
 				     left, right,
 				     left_val, right_val,
 				     const_func);
-  mObjList.push_back(func);
+  reg_obj(func);
+  reg_scope(func);
   mObjDict.add(func);
   mTagDict.add_function(func);
+  mAllFunctionList.push_back(func);
+  add_new_obj(func);
   return func;
 }
 
@@ -882,9 +1323,12 @@ ElbMgr::new_Task(
 )
 {
   auto task = factory().new_Task(parent, pt_item);
-  mObjList.push_back(task);
+  reg_obj(task);
+  reg_scope(task);
   mObjDict.add(task);
   mTagDict.add_task(task);
+  mAllTaskList.push_back(task);
+  add_new_obj(task);
   return task;
 }
 
@@ -896,8 +1340,9 @@ ElbMgr::new_Process(
 )
 {
   auto process = factory().new_Process(parent, pt_item);
-  mObjList.push_back(process);
+  reg_obj(process);
   mTagDict.add_process(process);
+  mAllProcessList.push_back(process);
   return process;
 }
 
@@ -915,7 +1360,7 @@ ElbMgr::new_Assignment(
 {
   auto stmt = factory().new_Assignment(parent, process, pt_stmt,
 				       lhs, rhs, block, control);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -931,7 +1376,7 @@ ElbMgr::new_AssignStmt(
 {
   auto stmt = factory().new_AssignStmt(parent, process, pt_stmt,
 				       lhs, rhs);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -945,7 +1390,7 @@ ElbMgr::new_DeassignStmt(
 )
 {
   auto stmt = factory().new_DeassignStmt(parent, process, pt_stmt, lhs);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -960,7 +1405,7 @@ ElbMgr::new_ForceStmt(
 )
 {
   auto stmt = factory().new_ForceStmt(parent, process, pt_stmt, lhs, rhs);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -974,7 +1419,7 @@ ElbMgr::new_ReleaseStmt(
 )
 {
   auto stmt = factory().new_ReleaseStmt(parent, process, pt_stmt, lhs);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -988,7 +1433,7 @@ ElbMgr::new_Begin(
 )
 {
   auto stmt = factory().new_Begin(parent, process, pt_stmt, stmt_list);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1002,7 +1447,7 @@ ElbMgr::new_Fork(
 )
 {
   auto stmt = factory().new_Fork(parent, process, pt_stmt, stmt_list);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1016,7 +1461,7 @@ ElbMgr::new_NamedBegin(
 )
 {
   auto stmt = factory().new_NamedBegin(block, process, pt_stmt, stmt_list);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1030,7 +1475,7 @@ ElbMgr::new_NamedFork(
 )
 {
   auto stmt = factory().new_NamedFork(block, process, pt_stmt, stmt_list);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1045,7 +1490,7 @@ ElbMgr::new_WhileStmt(
 )
 {
   auto stmt = factory().new_WhileStmt(parent, process, pt_stmt, cond, body);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1060,7 +1505,7 @@ ElbMgr::new_RepeatStmt(
 )
 {
   auto stmt = factory().new_RepeatStmt(parent, process, pt_stmt, cond, body);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1075,7 +1520,7 @@ ElbMgr::new_WaitStmt(
 )
 {
   auto stmt = factory().new_WaitStmt(parent, process, pt_stmt, cond, body);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1093,7 +1538,7 @@ ElbMgr::new_ForStmt(
 {
   auto stmt = factory().new_ForStmt(parent, process, pt_stmt, cond,
 				    init_stmt, inc_stmt, body);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1107,7 +1552,7 @@ ElbMgr::new_ForeverStmt(
 )
 {
   auto stmt = factory().new_ForeverStmt(parent, process, pt_stmt, body);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1124,7 +1569,7 @@ ElbMgr::new_IfStmt(
 {
   auto stmt = factory().new_IfStmt(parent, process, pt_stmt,
 				   cond, then_stmt, else_stmt);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1140,7 +1585,7 @@ ElbMgr::new_CaseStmt(
 {
   auto stmt = factory().new_CaseStmt(parent, process, pt_stmt,
 				     expr, caseitem_list);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1153,7 +1598,7 @@ ElbMgr::new_CaseItem(
 )
 {
   auto caseitem = factory().new_CaseItem(pt_item, label_list, body);
-  mObjList.push_back(caseitem);
+  reg_obj(caseitem);
   return caseitem;
 }
 
@@ -1168,7 +1613,7 @@ ElbMgr::new_EventStmt(
 {
   auto stmt = factory().new_EventStmt(parent, process, pt_stmt,
 				      named_event);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1181,7 +1626,7 @@ ElbMgr::new_NullStmt(
 )
 {
   auto stmt = factory().new_NullStmt(parent, process, pt_stmt);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1197,7 +1642,7 @@ ElbMgr::new_TaskCall(
 {
   auto stmt = factory().new_TaskCall(parent, process, pt_stmt,
 				     task, arg_array);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1213,7 +1658,7 @@ ElbMgr::new_SysTaskCall(
 {
   auto stmt = factory().new_SysTaskCall(parent, process, pt_stmt,
 					user_systf, arg_array);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1227,7 +1672,7 @@ ElbMgr::new_DisableStmt(
 )
 {
   auto stmt = factory().new_DisableStmt(parent, process, pt_stmt, target);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1243,7 +1688,7 @@ ElbMgr::new_CtrlStmt(
 {
   auto stmt = factory().new_CtrlStmt(parent, process, pt_stmt,
 				     control, body);
-  mObjList.push_back(stmt);
+  reg_obj(stmt);
   return stmt;
 }
 
@@ -1255,7 +1700,7 @@ ElbMgr::new_DelayControl(
 )
 {
   auto control = factory().new_DelayControl(pt_control, delay);
-  mObjList.push_back(control);
+  reg_obj(control);
   return control;
 }
 
@@ -1267,7 +1712,7 @@ ElbMgr::new_EventControl(
 )
 {
   auto control = factory().new_EventControl(pt_control, event_list);
-  mObjList.push_back(control);
+  reg_obj(control);
   return control;
 }
 
@@ -1280,7 +1725,7 @@ ElbMgr::new_RepeatControl(
 )
 {
   auto control = factory().new_RepeatControl(pt_control, rep, event_list);
-  mObjList.push_back(control);
+  reg_obj(control);
   return control;
 }
 
@@ -1294,7 +1739,7 @@ ElbMgr::new_UnaryOp(
 {
   auto expr = factory().new_UnaryOp(pt_expr, op_type,
 				    opr1);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1309,7 +1754,7 @@ ElbMgr::new_BinaryOp(
 {
   auto expr = factory().new_BinaryOp(pt_expr, op_type,
 				     opr1, opr2);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1325,7 +1770,7 @@ ElbMgr::new_TernaryOp(
 {
   auto expr = factory().new_TernaryOp(pt_expr, op_type,
 				      opr1, opr2, opr3);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1337,7 +1782,7 @@ ElbMgr::new_ConcatOp(
 )
 {
   auto expr = factory().new_ConcatOp(pt_expr, opr_list);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1353,7 +1798,7 @@ ElbMgr::new_MultiConcatOp(
   auto expr = factory().new_MultiConcatOp(pt_expr,
 					  rep_num, rep_expr,
 					  opr_list);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1365,7 +1810,7 @@ ElbMgr::new_Primary(
 )
 {
   auto expr = factory().new_Primary(pt_expr, obj);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1377,7 +1822,7 @@ ElbMgr::new_Primary(
 )
 {
   auto expr = factory().new_Primary(pt_item, obj);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1389,7 +1834,7 @@ ElbMgr::new_Primary(
 )
 {
   auto expr = factory().new_Primary(pt_expr, obj);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1402,7 +1847,7 @@ ElbMgr::new_Primary(
 )
 {
   auto expr = factory().new_Primary(pt_expr, obj, index_list);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1415,7 +1860,7 @@ ElbMgr::new_Primary(
 )
 {
   auto expr = factory().new_Primary(pt_expr, obj, offset);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1430,7 +1875,7 @@ ElbMgr::new_BitSelect(
 {
   auto expr = factory().new_BitSelect(pt_expr, base,
 				      bit_index, bit_index_val);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1443,7 +1888,7 @@ ElbMgr::new_BitSelect(
 )
 {
   auto expr = factory().new_BitSelect(pt_expr, base, bit_index_val);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1456,7 +1901,7 @@ ElbMgr::new_BitSelect(
 )
 {
   auto expr = factory().new_BitSelect(pt_expr, base, bit_index);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1474,7 +1919,7 @@ ElbMgr::new_PartSelect(
   auto expr = factory().new_PartSelect(pt_expr, obj,
 				       index1, index2,
 				       index1_val, index2_val);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1489,7 +1934,7 @@ ElbMgr::new_PartSelect(
 {
   auto expr = factory().new_PartSelect(pt_expr, base,
 				       index1, index2);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1505,7 +1950,7 @@ ElbMgr::new_PlusPartSelect(
 {
   auto expr = factory().new_PlusPartSelect(pt_expr, obj, base,
 					   range_expr, range_val);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1521,7 +1966,7 @@ ElbMgr::new_MinusPartSelect(
 {
   auto expr = factory().new_MinusPartSelect(pt_expr, obj, base,
 					    range_expr, range_val);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1532,7 +1977,7 @@ ElbMgr::new_Constant(
 )
 {
   auto expr = factory().new_Constant(pt_expr);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1544,7 +1989,7 @@ ElbMgr::new_GenvarConstant(
 )
 {
   auto expr = factory().new_GenvarConstant(pt_primary, val);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1557,7 +2002,7 @@ ElbMgr::new_FuncCall(
 )
 {
   auto expr = factory().new_FuncCall(pt_expr, func, arg_list);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1571,7 +2016,7 @@ ElbMgr::new_SysFuncCall(
 {
   auto expr = factory().new_SysFuncCall(pt_expr, user_systf,
 					arg_list);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1583,7 +2028,7 @@ ElbMgr::new_ArgHandle(
 )
 {
   auto expr = factory().new_ArgHandle(pt_expr, arg);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1595,7 +2040,7 @@ ElbMgr::new_ArgHandle(
 )
 {
   auto expr = factory().new_ArgHandle(pt_expr, arg);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1607,7 +2052,7 @@ ElbMgr::new_ArgHandle(
 )
 {
   auto expr = factory().new_ArgHandle(pt_expr, arg);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1620,7 +2065,7 @@ ElbMgr::new_Lhs(
 )
 {
   auto expr = factory().new_Lhs(pt_expr, opr_array, lhs_elem_array);
-  mObjList.push_back(expr);
+  reg_obj(expr);
   return expr;
 }
 
@@ -1632,7 +2077,7 @@ ElbMgr::new_Delay(
 )
 {
   auto delay = factory().new_Delay(pt_obj, expr_list);
-  mObjList.push_back(delay);
+  reg_obj(delay);
   return delay;
 }
 
@@ -1645,7 +2090,7 @@ ElbMgr::new_Attribute(
 )
 {
   auto attr = factory().new_Attribute(pt_attr, expr, def);
-  mObjList.push_back(attr);
+  reg_obj(attr);
   return attr;
 }
 
@@ -0,0 +1,286 @@
+﻿
+/// @file ElbMgr_path.cc
+/// @brief ElbMgr の階層名による検索の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "elaborator/ElbMgr.h"
+#include "elaborator/ObjHandle.h"
+#include "ym/vl/VlModule.h"
+#include "ym/vl/VlPrimitive.h"
+#include "ym/vl/VlTaskFunc.h"
+#include <numeric>
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+BEGIN_NONAMESPACE
+
+// 解決済みのスコープのスタック
+// 各要素は (その要素の直後の '.' の位置, 解決されたスコープ)
+using ScopeStack = vector<pair<SizeType, const VlScope*>>;
+
+// 空白文字の時 true を返す．
+inline
+bool
+is_space(
+  char c
+)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// path の pos から始まる一つの要素を読む．
+//
+// 要素は 名前 [インデックス]* の形をしている．
+// 名前が '\' で始まる場合は escaped identifier として空白までを名前とする．
+// 成功した場合 pos は末尾か次の '.' を指す．
+bool
+read_comp(
+  string_view path,
+  SizeType& pos,
+  string_view& name,
+  vector<int>& index_list
+)
+{
+  index_list.clear();
+  SizeType n = path.size();
+  if ( pos >= n ) {
+    return false;
+  }
+  if ( path[pos] == '\\' ) {
+    SizeType begin = pos + 1;
+    pos = begin;
+    while ( pos < n && !is_space(path[pos]) ) {
+      ++ pos;
+    }
+    name = path.substr(begin, pos - begin);
+    // 終端の空白は読み飛ばす．
+    while ( pos < n && is_space(path[pos]) ) {
+      ++ pos;
+    }
+  }
+  else {
+    SizeType begin = pos;
+    while ( pos < n && path[pos] != '.' && path[pos] != '[' ) {
+      ++ pos;
+    }
+    name = path.substr(begin, pos - begin);
+  }
+  if ( name.empty() ) {
+    return false;
+  }
+
+  while ( pos < n && path[pos] == '[' ) {
+    ++ pos;
+    bool neg = false;
+    if ( pos < n && path[pos] == '-' ) {
+      neg = true;
+      ++ pos;
+    }
+    SizeType begin = pos;
+    int val = 0;
+    while ( pos < n && path[pos] >= '0' && path[pos] <= '9' ) {
+      val = val * 10 + (path[pos] - '0');
+      ++ pos;
+    }
+    if ( pos == begin || pos >= n || path[pos] != ']' ) {
+      return false;
+    }
+    ++ pos;
+    index_list.push_back(neg ? -val : val);
+  }
+
+  return pos == n || path[pos] == '.';
+}
+
+// parent の中の一つの要素を解決する．
+//
+// 見つからなければ nullptr を返す．
+// 結果がスコープの場合は scope にそれを設定し，
+// そうでなければ nullptr を設定する．
+const VlObj*
+resolve_comp(
+  const ObjDict& obj_dict,
+  const VlScope* parent,
+  string_view name,
+  const vector<int>& index_list,
+  const VlScope*& scope
+)
+{
+  scope = nullptr;
+  auto handle = obj_dict.find(parent, name);
+  if ( handle == nullptr ) {
+    return nullptr;
+  }
+
+  if ( index_list.empty() ) {
+    if ( handle->scope() != nullptr ) {
+      scope = handle->scope();
+    }
+    else if ( handle->module() != nullptr ) {
+      scope = handle->module();
+    }
+    else if ( handle->taskfunc() != nullptr ) {
+      scope = handle->taskfunc();
+    }
+    if ( scope != nullptr ) {
+      return scope;
+    }
+    return handle->namedobj();
+  }
+
+  // module array と generate for の要素
+  int index = index_list[0];
+  auto elem = handle->array_elem(index);
+  if ( elem != nullptr ) {
+    if ( index_list.size() > 1 ) {
+      // 多次元のインスタンス配列はない．
+      return nullptr;
+    }
+    scope = elem;
+    return elem;
+  }
+
+  // primitive array の要素
+  auto prim_array = handle->prim_array();
+  if ( prim_array != nullptr ) {
+    if ( index_list.size() > 1 ) {
+      return nullptr;
+    }
+    return prim_array->elem_by_index(index);
+  }
+
+  // 宣言要素のビット選択や配列要素は VlObj としては存在しないので
+  // 宣言要素自身を返す．
+  if ( handle->decl() != nullptr ||
+       handle->declarray() != nullptr ||
+       handle->parameter() != nullptr ||
+       handle->genvar() != nullptr ) {
+    return handle->namedobj();
+  }
+
+  return nullptr;
+}
+
+// path の pos 以降を scope を起点として解決する．
+//
+// stack が nullptr でなければ途中で解決したスコープを積む．
+// prepare は名前を探す前のスコープと結果のスコープに適用する．
+// scope にはすでに適用されているものとする．
+const VlObj*
+resolve_path(
+  const ObjDict& obj_dict,
+  string_view path,
+  SizeType pos,
+  const VlScope* scope,
+  vector<int>& index_list,
+  ScopeStack* stack,
+  const ElbMgr::ScopeFunc& prepare
+)
+{
+  if ( scope == nullptr ) {
+    return nullptr;
+  }
+  for ( ; ; ) {
+    string_view name;
+    if ( !read_comp(path, pos, name, index_list) ) {
+      return nullptr;
+    }
+    const VlScope* next_scope;
+    auto obj = resolve_comp(obj_dict, scope, name, index_list, next_scope);
+    if ( obj == nullptr ) {
+      return nullptr;
+    }
+    if ( next_scope != nullptr && prepare ) {
+      prepare(next_scope);
+    }
+    if ( pos == path.size() ) {
+      return obj;
+    }
+    // 後ろに要素が続くのにスコープでない．
+    if ( next_scope == nullptr ) {
+      return nullptr;
+    }
+    if ( stack != nullptr ) {
+      stack->push_back({pos, next_scope});
+    }
+    // '.' を読み飛ばす．
+    ++ pos;
+    scope = next_scope;
+  }
+}
+
+END_NONAMESPACE
+
+// @brief 階層名から要素を取り出す．
+const VlObj*
+ElbMgr::find_by_path(
+  string_view path,
+  const ScopeFunc& prepare
+) const
+{
+  if ( mTopLevel != nullptr && prepare ) {
+    prepare(mTopLevel);
+  }
+  vector<int> index_list;
+  return resolve_path(mObjDict, path, 0, mTopLevel, index_list, nullptr,
+		      prepare);
+}
+
+// @brief 複数の階層名から要素を取り出す．
+vector<const VlObj*>
+ElbMgr::find_by_paths(
+  const vector<string>& path_list,
+  const ScopeFunc& prepare
+) const
+{
+  if ( mTopLevel != nullptr && prepare ) {
+    prepare(mTopLevel);
+  }
+  SizeType n = path_list.size();
+  vector<const VlObj*> ans_list(n, nullptr);
+
+  // 共通の接頭辞を持つ階層名が隣り合うように整列した順に処理する．
+  vector<SizeType> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(),
+       [&](SizeType a, SizeType b) {
+	 return path_list[a] < path_list[b];
+       });
+
+  // 直前の階層名の解決済みのスコープのスタック
+  ScopeStack stack;
+  vector<int> index_list;
+  string_view prev_path;
+  for ( auto i: order ) {
+    string_view path{path_list[i]};
+
+    // 直前の階層名との共通部分の長さ
+    SizeType l = 0;
+    SizeType m = std::min(path.size(), prev_path.size());
+    while ( l < m && path[l] == prev_path[l] ) {
+      ++ l;
+    }
+    // 共通部分に含まれる要素のスコープだけを再利用する．
+    while ( !stack.empty() && stack.back().first >= l ) {
+      stack.pop_back();
+    }
+
+    SizeType pos = 0;
+    const VlScope* scope = mTopLevel;
+    if ( !stack.empty() ) {
+      pos = stack.back().first + 1;
+      scope = stack.back().second;
+    }
+    ans_list[i] = resolve_path(mObjDict, path, pos, scope, index_list, &stack,
+			       prepare);
+    prev_path = path;
+  }
+
+  return ans_list;
+}
+
+END_NAMESPACE_YM_VERILOG
@@ -22,6 +22,43 @@
 
 BEGIN_NAMESPACE_YM_VERILOG
 
+BEGIN_NONAMESPACE
+
+// @brief list の内容を array の末尾に追加する．
+template<typename T>
+void
+append(
+  vector<T>& array,
+  const vector<T>& list,
+  SizeType& begin,
+  SizeType& end
+)
+{
+  begin = array.size();
+  array.insert(array.end(), list.begin(), list.end());
+  end = array.size();
+}
+
+// @brief list から obj_set に含まれる要素を取り除く．
+// @return list が空になったら true を返す．
+template<typename T>
+bool
+remove_elems(
+  vector<T>& list,
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  list.erase(std::remove_if(list.begin(), list.end(),
+			    [&](const VlObj* obj) {
+			      return obj_set.count(obj) > 0;
+			    }),
+	     list.end());
+  return list.empty();
+}
+
+END_NONAMESPACE
+
+
 //////////////////////////////////////////////////////////////////////
 // クラス TagDict
 //////////////////////////////////////////////////////////////////////
@@ -44,6 +81,105 @@ TagDict::clear()
     delete p.second;
   }
   mHash.clear();
+  mTagListDict.clear();
+  clear_table();
+}
+
+// @brief 要素を削除する．
+void
+TagDict::remove(
+  const unordered_set<const VlScope*>& scope_set,
+  const unordered_set<const VlScope*>& parent_set,
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  for ( auto scope: scope_set ) {
+    auto p = mTagListDict.find(scope);
+    if ( p == mTagListDict.end() ) {
+      continue;
+    }
+    for ( auto tag: p->second ) {
+      Key key{scope, tag};
+      auto q = mHash.find(key);
+      delete q->second;
+      mHash.erase(q);
+    }
+    mTagListDict.erase(p);
+  }
+  for ( auto parent: parent_set ) {
+    auto p = mTagListDict.find(parent);
+    if ( p == mTagListDict.end() ) {
+      continue;
+    }
+    auto& tag_list = p->second;
+    SizeType wpos = 0;
+    for ( auto tag: tag_list ) {
+      Key key{parent, tag};
+      auto q = mHash.find(key);
+      if ( q->second->remove(obj_set) ) {
+	delete q->second;
+	mHash.erase(q);
+      }
+      else {
+	tag_list[wpos] = tag;
+	++ wpos;
+      }
+    }
+    tag_list.erase(tag_list.begin() + wpos, tag_list.end());
+    if ( tag_list.empty() ) {
+      mTagListDict.erase(p);
+    }
+  }
+  clear_table();
+}
+
+// @brief スコープごとの要素の表を作る．
+void
+TagDict::make_table()
+{
+  clear_table();
+
+  // 同じスコープの要素が連続するように整列させる．
+  vector<pair<Key, TagDictCell*>> cell_list{mHash.begin(), mHash.end()};
+  sort(cell_list.begin(), cell_list.end(),
+       [](const pair<Key, TagDictCell*>& a,
+	  const pair<Key, TagDictCell*>& b) {
+	 if ( a.first.mParent != b.first.mParent ) {
+	   return std::less<const VlScope*>{}(a.first.mParent, b.first.mParent);
+	 }
+	 return a.first.mTag < b.first.mTag;
+       });
+
+  mRangeArray.reserve(cell_list.size());
+  for ( auto& p: cell_list ) {
+    auto& key = p.first;
+    auto cell = p.second;
+    SizeType pos = mRangeArray.size();
+    TagRange range{key.mTag, 0, 0};
+    cell->copy_to(mTable, range.mBegin, range.mEnd);
+    mRangeArray.push_back(range);
+    auto q = mScopeTable.find(key.mParent);
+    if ( q == mScopeTable.end() ) {
+      mScopeTable.emplace(key.mParent, ScopeRange{pos, pos + 1});
+    }
+    else {
+      q->second.mEnd = pos + 1;
+    }
+  }
+  mHasTable = true;
+}
+
+// @brief make_table() で作った表を破棄する．
+void
+TagDict::clear_table()
+{
+  if ( !mHasTable ) {
+    return;
+  }
+  mTable = TagDictTable{};
+  mRangeArray.clear();
+  mScopeTable.clear();
+  mHasTable = false;
 }
 
 // @brief Cell を登録する．
@@ -56,6 +192,7 @@ TagDict::put_cell(
 {
   Key key{parent, tag};
   mHash.emplace(key, cell);
+  mTagListDict[parent].push_back(tag);
 }
 
 // @brief タグから該当する Cell を探す．
@@ -66,12 +203,24 @@ TagDict::find_cell(
 ) const
 {
   Key key{parent, tag};
-  if ( mHash.count(key) > 0 ) {
-    return mHash.at(key);
+  auto p = mHash.find(key);
+  if ( p != mHash.end() ) {
+    return p->second;
   }
   return nullptr;
 }
 
+// @brief 要素を追加するために Cell を探す．
+TagDictCell*
+TagDict::find_cell_for_add(
+  const VlScope* parent,
+  int tag
+)
+{
+  clear_table();
+  return find_cell(parent, tag);
+}
+
 
 //////////////////////////////////////////////////////////////////////
 // TagDictCell
@@ -87,11 +236,12 @@ TagDictCell::add_decl(
 }
 
 // 宣言要素のリストを得る．
-vector<const VlDecl*>
+const vector<const VlDecl*>&
 TagDictCell::decl_list()
 {
   ASSERT_NOT_REACHED;
-  return vector<const VlDecl*>{};
+  static vector<const VlDecl*> dummy;
+  return dummy;
 }
 
 // 宣言要素配列を追加する．
@@ -104,11 +254,12 @@ TagDictCell::add_declarray(
 }
 
 // 宣言要素配列のリストを得る．
-vector<const VlDeclArray*>
+const vector<const VlDeclArray*>&
 TagDictCell::declarray_list()
 {
   ASSERT_NOT_REACHED;
-  return vector<const VlDeclArray*>{};
+  static vector<const VlDeclArray*> dummy;
+  return dummy;
 }
 
 // defparam を追加する．
@@ -121,11 +272,12 @@ TagDictCell::add_defparam(
 }
 
 // defparam のリストを得る．
-vector<const VlDefParam*>
+const vector<const VlDefParam*>&
 TagDictCell::defparam_list()
 {
   ASSERT_NOT_REACHED;
-  return vector<const VlDefParam*>{};
+  static vector<const VlDefParam*> dummy;
+  return dummy;
 }
 
 // param assign を追加する．
@@ -138,11 +290,12 @@ TagDictCell::add_paramassign(
 }
 
 // param assign のリストを得る．
-vector<const VlParamAssign*>
+const vector<const VlParamAssign*>&
 TagDictCell::paramassign_list()
 {
   ASSERT_NOT_REACHED;
-  return vector<const VlParamAssign*>{};
+  static vector<const VlParamAssign*> dummy;
+  return dummy;
 }
 
 // module array を追加する．
@@ -155,11 +308,12 @@ TagDictCell::add_modulearray(
 }
 
 // module array のリストを得る．
-vector<const VlModuleArray*>
+const vector<const VlModuleArray*>&
 TagDictCell::modulearray_list()
 {
   ASSERT_NOT_REACHED;
-  return vector<const VlModuleArray*>{};
+  static vector<const VlModuleArray*> dummy;
+  return dummy;
 }
 
 // module を追加する．
@@ -172,11 +326,12 @@ TagDictCell::add_module(
 }
 
 // module のリストを得る．
-vector<const VlModule*>
+const vector<const VlModule*>&
 TagDictCell::module_list()
 {
   ASSERT_NOT_REACHED;
-  return vector<const VlModule*>{};
+  static vector<const VlModule*> dummy;
+  return dummy;
 }
 
 // primitive array を追加する．
@@ -189,11 +344,12 @@ TagDictCell::add_primarray(
 }
 
 // primitive array のリストを得る．
-vector<const VlPrimArray*>
+const vector<const VlPrimArray*>&
 TagDictCell::primarray_list()
 {
   ASSERT_NOT_REACHED;
-  return vector<const VlPrimArray*>{};
+  static vector<const VlPrimArray*> dummy;
+  return dummy;
 }
 
 // primitive を追加する．
@@ -206,11 +362,12 @@ TagDictCell::add_primitive(
 }
 
 // primitive のリストを得る．
-vector<const VlPrimitive*>
+const vector<const VlPrimitive*>&
 TagDictCell::primitive_list()
 {
   ASSERT_NOT_REACHED;
-  return vector<const VlPrimitive*>{};
+  static vector<const VlPrimitive*> dummy;
+  return dummy;
 }
 
 // @brief タスク/関数を追加する．
@@ -223,11 +380,12 @@ TagDictCell::add_taskfunc(
 }
 
 // @brief タスク/関数のリストを得る．
-vector<const VlTaskFunc*>
+const vector<const VlTaskFunc*>&
 TagDictCell::taskfunc_list()
 {
   ASSERT_NOT_REACHED;
-  return vector<const VlTaskFunc*>{};
+  static vector<const VlTaskFunc*> dummy;
+  return dummy;
 }
 
 // continuous assignment を追加する．
@@ -240,11 +398,12 @@ TagDictCell::add_contassign(
 }
 
 // continuous assignment のリストを得る．
-vector<const VlContAssign*>
+const vector<const VlContAssign*>&
 TagDictCell::contassign_list()
 {
   ASSERT_NOT_REACHED;
-  return vector<const VlContAssign*>{};
+  static vector<const VlContAssign*> dummy;
+  return dummy;
 }
 
 // process を追加する．
@@ -257,11 +416,12 @@ TagDictCell::add_process(
 }
 
 // process のリストを得る．
-vector<const VlProcess*>
+const vector<const VlProcess*>&
 TagDictCell::process_list()
 {
   ASSERT_NOT_REACHED;
-  return vector<const VlProcess*>{};
+  static vector<const VlProcess*> dummy;
+  return dummy;
 }
 
 // internal scope を追加する．
@@ -274,11 +434,12 @@ TagDictCell::add_internalscope(
 }
 
 // internal scope のリストを得る．
-vector<const VlScope*>
+const vector<const VlScope*>&
 TagDictCell::internalscope_list()
 {
   ASSERT_NOT_REACHED;
-  return vector<const VlScope*>{};
+  static vector<const VlScope*> dummy;
+  return dummy;
 }
 
 
@@ -295,6 +456,20 @@ public:
     const VlScope* obj
   );
 
+  /// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+  void
+  copy_to(
+    TagDictTable& table,
+    SizeType& begin,
+    SizeType& end
+  ) const override;
+
+  /// @brief obj_set に含まれる要素を削除する．
+  bool
+  remove(
+    const unordered_set<const VlObj*>& obj_set
+  ) override;
+
   /// @brief 要素の追加
   void
   add_internalscope(
@@ -302,7 +477,7 @@ public:
   ) override;
 
   /// @brief 要素のリストを返す．
-  vector<const VlScope*>
+  const vector<const VlScope*>&
   internalscope_list() override;
 
 
@@ -323,6 +498,26 @@ CellScope::CellScope(
 {
 }
 
+// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+void
+CellScope::copy_to(
+  TagDictTable& table,
+  SizeType& begin,
+  SizeType& end
+) const
+{
+  append(table.mInternalScopeArray, mList, begin, end);
+}
+
+// @brief obj_set に含まれる要素を削除する．
+bool
+CellScope::remove(
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  return remove_elems(mList, obj_set);
+}
+
 // @brief 要素の追加
 void
 CellScope::add_internalscope(
@@ -333,7 +528,7 @@ CellScope::add_internalscope(
 }
 
 // @brief 要素のリストを得る．
-vector<const VlScope*>
+const vector<const VlScope*>&
 CellScope::internalscope_list()
 {
   return mList;
@@ -349,7 +544,7 @@ TagDict::add_internalscope(
   auto parent = obj->parent_scope();
 
   // 該当の Cell が存在するか調べる．
-  auto cell = find_cell(parent, vpiInternalScope);
+  auto cell = find_cell_for_add(parent, vpiInternalScope);
   if ( cell ) {
     cell->add_internalscope(obj);
   }
@@ -360,18 +555,22 @@ TagDict::add_internalscope(
 }
 
 // @brief internal scope のリストを取り出す．
-vector<const VlScope*>
+VlSpan<const VlScope*>
 TagDict::find_internalscope_list(
   const VlScope* parent
 ) const
 {
+  if ( mHasTable ) {
+    return find_span(parent, vpiInternalScope, mTable.mInternalScopeArray);
+  }
+
   // 該当の Cell が存在するか調べる．
   auto cell = find_cell(parent, vpiInternalScope);
   if ( cell ) {
     return cell->internalscope_list();
   }
   else {
-    return vector<const VlScope*>();
+    return VlSpan<const VlScope*>{};
   }
 }
 
@@ -389,6 +588,20 @@ public:
     const VlDecl* obj
   );
 
+  /// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+  void
+  copy_to(
+    TagDictTable& table,
+    SizeType& begin,
+    SizeType& end
+  ) const override;
+
+  /// @brief obj_set に含まれる要素を削除する．
+  bool
+  remove(
+    const unordered_set<const VlObj*>& obj_set
+  ) override;
+
   /// @brief 要素の追加
   void
   add_decl(
@@ -396,7 +609,7 @@ public:
   ) override;
 
   /// @brief 宣言要素のリストを得る．
-  vector<const VlDecl*>
+  const vector<const VlDecl*>&
   decl_list() override;
 
 
@@ -417,6 +630,26 @@ CellDecl::CellDecl(
 {
 }
 
+// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+void
+CellDecl::copy_to(
+  TagDictTable& table,
+  SizeType& begin,
+  SizeType& end
+) const
+{
+  append(table.mDeclArray, mList, begin, end);
+}
+
+// @brief obj_set に含まれる要素を削除する．
+bool
+CellDecl::remove(
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  return remove_elems(mList, obj_set);
+}
+
 // @brief 要素の追加
 void
 CellDecl::add_decl(
@@ -427,7 +660,7 @@ CellDecl::add_decl(
 }
 
 // @brief 宣言のリストを得る．
-vector<const VlDecl*>
+const vector<const VlDecl*>&
 CellDecl::decl_list()
 {
   return mList;
@@ -443,7 +676,7 @@ TagDict::add_decl(
   auto parent = obj->parent_scope();
 
   // 該当の Cell が存在するか調べる．
-  auto cell = find_cell(parent, tag);
+  auto cell = find_cell_for_add(parent, tag);
   if ( cell ) {
     cell->add_decl(obj);
   }
@@ -454,19 +687,23 @@ TagDict::add_decl(
 }
 
 // @brief タグから該当する宣言要素のリストを返す．
-vector<const VlDecl*>
+VlSpan<const VlDecl*>
 TagDict::find_decl_list(
   const VlScope* parent,
   int tag
 ) const
 {
+  if ( mHasTable ) {
+    return find_span(parent, tag, mTable.mDeclArray);
+  }
+
   // 該当の Cell が存在するか調べる．
   auto cell = find_cell(parent, tag);
   if ( cell ) {
     return cell->decl_list();
   }
   else {
-    return vector<const VlDecl*>{};
+    return VlSpan<const VlDecl*>{};
   }
 }
 
@@ -484,6 +721,20 @@ public:
     const VlDeclArray* obj
   );
 
+  /// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+  void
+  copy_to(
+    TagDictTable& table,
+    SizeType& begin,
+    SizeType& end
+  ) const override;
+
+  /// @brief obj_set に含まれる要素を削除する．
+  bool
+  remove(
+    const unordered_set<const VlObj*>& obj_set
+  ) override;
+
   /// @brief 要素の追加
   void
   add_declarray(
@@ -491,7 +742,7 @@ public:
   ) override;
 
   /// @brief 宣言のリストを得る．
-  vector<const VlDeclArray*>
+  const vector<const VlDeclArray*>&
   declarray_list() override;
 
 
@@ -512,6 +763,26 @@ CellDeclArray::CellDeclArray(
 {
 }
 
+// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+void
+CellDeclArray::copy_to(
+  TagDictTable& table,
+  SizeType& begin,
+  SizeType& end
+) const
+{
+  append(table.mDeclArrayArray, mList, begin, end);
+}
+
+// @brief obj_set に含まれる要素を削除する．
+bool
+CellDeclArray::remove(
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  return remove_elems(mList, obj_set);
+}
+
 // @brief 要素の追加
 void
 CellDeclArray::add_declarray(
@@ -522,7 +793,7 @@ CellDeclArray::add_declarray(
 }
 
 // @brief 宣言素のリストを得る．
-vector<const VlDeclArray*>
+const vector<const VlDeclArray*>&
 CellDeclArray::declarray_list()
 {
   return mList;
@@ -538,7 +809,7 @@ TagDict::add_declarray(
   auto parent = obj->parent_scope();
 
   // 該当の Cell が存在するか調べる．
-  auto cell = find_cell(parent, tag);
+  auto cell = find_cell_for_add(parent, tag);
   if ( cell ) {
     cell->add_declarray(obj);
   }
@@ -549,19 +820,23 @@ TagDict::add_declarray(
 }
 
 // @brief タグから該当する宣言要素のリストを返す．
-vector<const VlDeclArray*>
+VlSpan<const VlDeclArray*>
 TagDict::find_declarray_list(
   const VlScope* parent,
   int tag
 ) const
 {
+  if ( mHasTable ) {
+    return find_span(parent, tag, mTable.mDeclArrayArray);
+  }
+
   // 該当の Cell が存在するか調べる．
   auto cell = find_cell(parent, tag);
   if ( cell ) {
     return cell->declarray_list();
   }
   else {
-    return vector<const VlDeclArray*>{};
+    return VlSpan<const VlDeclArray*>{};
   }
 }
 
@@ -579,6 +854,20 @@ public:
     const VlDefParam* obj
   );
 
+  /// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+  void
+  copy_to(
+    TagDictTable& table,
+    SizeType& begin,
+    SizeType& end
+  ) const override;
+
+  /// @brief obj_set に含まれる要素を削除する．
+  bool
+  remove(
+    const unordered_set<const VlObj*>& obj_set
+  ) override;
+
   /// @brief 要素の追加
   void
   add_defparam(
@@ -586,7 +875,7 @@ public:
   ) override;
 
   /// @brief defparam のを得る．
-  vector<const VlDefParam*>
+  const vector<const VlDefParam*>&
   defparam_list() override;
 
 
@@ -607,6 +896,26 @@ CellDefParam::CellDefParam(
 {
 }
 
+// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+void
+CellDefParam::copy_to(
+  TagDictTable& table,
+  SizeType& begin,
+  SizeType& end
+) const
+{
+  append(table.mDefParamArray, mList, begin, end);
+}
+
+// @brief obj_set に含まれる要素を削除する．
+bool
+CellDefParam::remove(
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  return remove_elems(mList, obj_set);
+}
+
 // @brief 要素の追加
 void
 CellDefParam::add_defparam(
@@ -617,7 +926,7 @@ CellDefParam::add_defparam(
 }
 
 // @brief defparam のリストを得る．
-vector<const VlDefParam*>
+const vector<const VlDefParam*>&
 CellDefParam::defparam_list()
 {
   return mList;
@@ -632,7 +941,7 @@ TagDict::add_defparam(
   auto parent = obj->parent_module();
 
   // 該当の Cell が存在するか調べる．
-  auto cell = find_cell(parent, vpiDefParam);
+  auto cell = find_cell_for_add(parent, vpiDefParam);
   if ( cell ) {
     cell->add_defparam(obj);
   }
@@ -643,18 +952,22 @@ TagDict::add_defparam(
 }
 
 // @brief defparam のリストを取り出す．
-vector<const VlDefParam*>
+VlSpan<const VlDefParam*>
 TagDict::find_defparam_list(
   const VlScope* parent
 ) const
 {
+  if ( mHasTable ) {
+    return find_span(parent, vpiDefParam, mTable.mDefParamArray);
+  }
+
   // 該当の Cell が存在するか調べる．
   auto cell = find_cell(parent, vpiDefParam);
   if ( cell ) {
     return cell->defparam_list();
   }
   else {
-    return vector<const VlDefParam*>{};
+    return VlSpan<const VlDefParam*>{};
   }
 }
 
@@ -672,6 +985,20 @@ public:
     const VlParamAssign* obj
   );
 
+  /// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+  void
+  copy_to(
+    TagDictTable& table,
+    SizeType& begin,
+    SizeType& end
+  ) const override;
+
+  /// @brief obj_set に含まれる要素を削除する．
+  bool
+  remove(
+    const unordered_set<const VlObj*>& obj_set
+  ) override;
+
   /// @brief 要素の追加
   void
   add_paramassign(
@@ -679,7 +1006,7 @@ public:
   ) override;
 
   /// @brief param assign のリストを得る．
-  vector<const VlParamAssign*>
+  const vector<const VlParamAssign*>&
   paramassign_list() override;
 
 
@@ -700,6 +1027,26 @@ CellParamAssign::CellParamAssign(
 {
 }
 
+// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+void
+CellParamAssign::copy_to(
+  TagDictTable& table,
+  SizeType& begin,
+  SizeType& end
+) const
+{
+  append(table.mParamAssignArray, mList, begin, end);
+}
+
+// @brief obj_set に含まれる要素を削除する．
+bool
+CellParamAssign::remove(
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  return remove_elems(mList, obj_set);
+}
+
 // @brief 要素の追加
 void
 CellParamAssign::add_paramassign(
@@ -710,7 +1057,7 @@ CellParamAssign::add_paramassign(
 }
 
 // @brief param assign のリストを得る．
-vector<const VlParamAssign*>
+const vector<const VlParamAssign*>&
 CellParamAssign::paramassign_list()
 {
   return mList;
@@ -725,7 +1072,7 @@ TagDict::add_paramassign(
   auto parent = obj->parent_module();
 
   // 該当の Cell が存在するか調べる．
-  auto cell = find_cell(parent, vpiParamAssign);
+  auto cell = find_cell_for_add(parent, vpiParamAssign);
   if ( cell ) {
     cell->add_paramassign(obj);
   }
@@ -736,18 +1083,22 @@ TagDict::add_paramassign(
 }
 
 // @brief param assign のリストを取り出す．
-vector<const VlParamAssign*>
+VlSpan<const VlParamAssign*>
 TagDict::find_paramassign_list(
   const VlScope* parent
 ) const
 {
+  if ( mHasTable ) {
+    return find_span(parent, vpiParamAssign, mTable.mParamAssignArray);
+  }
+
   // 該当の Cell が存在するか調べる．
   auto cell = find_cell(parent, vpiParamAssign);
   if ( cell ) {
     return cell->paramassign_list();
   }
   else {
-    return vector<const VlParamAssign*>{};
+    return VlSpan<const VlParamAssign*>{};
   }
 }
 
@@ -765,6 +1116,20 @@ public:
     const VlModuleArray* obj
   );
 
+  /// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+  void
+  copy_to(
+    TagDictTable& table,
+    SizeType& begin,
+    SizeType& end
+  ) const override;
+
+  /// @brief obj_set に含まれる要素を削除する．
+  bool
+  remove(
+    const unordered_set<const VlObj*>& obj_set
+  ) override;
+
   /// @brief 要素の追加
   void
   add_modulearray(
@@ -772,7 +1137,7 @@ public:
   ) override;
 
   /// @brief module array のリストを得る．
-  vector<const VlModuleArray*>
+  const vector<const VlModuleArray*>&
   modulearray_list() override;
 
 
@@ -793,6 +1158,26 @@ CellModuleArray::CellModuleArray(
 {
 }
 
+// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+void
+CellModuleArray::copy_to(
+  TagDictTable& table,
+  SizeType& begin,
+  SizeType& end
+) const
+{
+  append(table.mModuleArrayArray, mList, begin, end);
+}
+
+// @brief obj_set に含まれる要素を削除する．
+bool
+CellModuleArray::remove(
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  return remove_elems(mList, obj_set);
+}
+
 // @brief 要素の追加
 void
 CellModuleArray::add_modulearray(
@@ -803,7 +1188,7 @@ CellModuleArray::add_modulearray(
 }
 
 // @brief module array のリストを得る．
-vector<const VlModuleArray*>
+const vector<const VlModuleArray*>&
 CellModuleArray::modulearray_list()
 {
   return mList;
@@ -818,7 +1203,7 @@ TagDict::add_modulearray(
   auto parent = obj->parent_scope();
 
   // 該当の Cell が存在するか調べる．
-  auto cell = find_cell(parent, vpiModuleArray);
+  auto cell = find_cell_for_add(parent, vpiModuleArray);
   if ( cell ) {
     cell->add_modulearray(obj);
   }
@@ -829,18 +1214,22 @@ TagDict::add_modulearray(
 }
 
 // @brief module array のリストを取り出す．
-vector<const VlModuleArray*>
+VlSpan<const VlModuleArray*>
 TagDict::find_modulearray_list(
   const VlScope* parent
 ) const
 {
+  if ( mHasTable ) {
+    return find_span(parent, vpiModuleArray, mTable.mModuleArrayArray);
+  }
+
   // 該当の Cell が存在するか調べる．
   auto cell = find_cell(parent, vpiModuleArray);
   if ( cell ) {
     return cell->modulearray_list();
   }
   else {
-    return vector<const VlModuleArray*>{};
+    return VlSpan<const VlModuleArray*>{};
   }
 }
 
@@ -858,6 +1247,20 @@ public:
     const VlModule* obj
   );
 
+  /// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+  void
+  copy_to(
+    TagDictTable& table,
+    SizeType& begin,
+    SizeType& end
+  ) const override;
+
+  /// @brief obj_set に含まれる要素を削除する．
+  bool
+  remove(
+    const unordered_set<const VlObj*>& obj_set
+  ) override;
+
   /// @brief 要素の追加
   void
   add_module(
@@ -865,7 +1268,7 @@ public:
   ) override;
 
   /// @brief module のリストを得る．
-  vector<const VlModule*>
+  const vector<const VlModule*>&
   module_list() override;
 
 
@@ -886,6 +1289,26 @@ CellModule::CellModule(
 {
 }
 
+// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+void
+CellModule::copy_to(
+  TagDictTable& table,
+  SizeType& begin,
+  SizeType& end
+) const
+{
+  append(table.mModuleArray, mList, begin, end);
+}
+
+// @brief obj_set に含まれる要素を削除する．
+bool
+CellModule::remove(
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  return remove_elems(mList, obj_set);
+}
+
 // @brief 要素の追加
 void
 CellModule::add_module(
@@ -896,7 +1319,7 @@ CellModule::add_module(
 }
 
 // @brief module のリストを得る．
-vector<const VlModule*>
+const vector<const VlModule*>&
 CellModule::module_list()
 {
   return mList;
@@ -911,7 +1334,7 @@ TagDict::add_module(
   auto parent = obj->parent_scope();
 
   // 該当の Cell が存在するか調べる．
-  auto cell = find_cell(parent, vpiModule);
+  auto cell = find_cell_for_add(parent, vpiModule);
   if ( cell ) {
     cell->add_module(obj);
   }
@@ -922,18 +1345,22 @@ TagDict::add_module(
 }
 
 // @brief module のリストを取り出す．
-vector<const VlModule*>
+VlSpan<const VlModule*>
 TagDict::find_module_list(
   const VlScope* parent
 ) const
 {
+  if ( mHasTable ) {
+    return find_span(parent, vpiModule, mTable.mModuleArray);
+  }
+
   // 該当の Cell が存在するか調べる．
   auto cell = find_cell(parent, vpiModule);
   if ( cell ) {
     return cell->module_list();
   }
   else {
-    return vector<const VlModule*>{};
+    return VlSpan<const VlModule*>{};
   }
 }
 
@@ -951,6 +1378,20 @@ public:
     const VlPrimArray* obj
   );
 
+  /// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+  void
+  copy_to(
+    TagDictTable& table,
+    SizeType& begin,
+    SizeType& end
+  ) const override;
+
+  /// @brief obj_set に含まれる要素を削除する．
+  bool
+  remove(
+    const unordered_set<const VlObj*>& obj_set
+  ) override;
+
   /// @brief 要素の追加
   void
   add_primarray(
@@ -958,7 +1399,7 @@ public:
   ) override;
 
   /// @brief primitive array のリストを得る．
-  vector<const VlPrimArray*>
+  const vector<const VlPrimArray*>&
   primarray_list() override;
 
 
@@ -979,6 +1420,26 @@ CellPrimArray::CellPrimArray(
 {
 }
 
+// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+void
+CellPrimArray::copy_to(
+  TagDictTable& table,
+  SizeType& begin,
+  SizeType& end
+) const
+{
+  append(table.mPrimArrayArray, mList, begin, end);
+}
+
+// @brief obj_set に含まれる要素を削除する．
+bool
+CellPrimArray::remove(
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  return remove_elems(mList, obj_set);
+}
+
 // @brief 要素の追加
 void
 CellPrimArray::add_primarray(
@@ -989,7 +1450,7 @@ CellPrimArray::add_primarray(
 }
 
 // @brief primitive array のリストを得る．
-vector<const VlPrimArray*>
+const vector<const VlPrimArray*>&
 CellPrimArray::primarray_list()
 {
   return mList;
@@ -1004,7 +1465,7 @@ TagDict::add_primarray(
   auto parent = obj->parent_scope();
 
   // 該当の Cell が存在するか調べる．
-  auto cell = find_cell(parent, vpiPrimitiveArray);
+  auto cell = find_cell_for_add(parent, vpiPrimitiveArray);
   if ( cell ) {
     cell->add_primarray(obj);
   }
@@ -1015,18 +1476,22 @@ TagDict::add_primarray(
 }
 
 // @brief primitive array のリストを取り出す．
-vector<const VlPrimArray*>
+VlSpan<const VlPrimArray*>
 TagDict::find_primarray_list(
   const VlScope* parent
 ) const
 {
+  if ( mHasTable ) {
+    return find_span(parent, vpiPrimitiveArray, mTable.mPrimArrayArray);
+  }
+
   // 該当の Cell が存在するか調べる．
   auto cell = find_cell(parent, vpiPrimitiveArray);
   if ( cell ) {
     return cell->primarray_list();
   }
   else {
-    return vector<const VlPrimArray*>{};
+    return VlSpan<const VlPrimArray*>{};
   }
 }
 
@@ -1044,6 +1509,20 @@ public:
     const VlPrimitive* obj
   );
 
+  /// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+  void
+  copy_to(
+    TagDictTable& table,
+    SizeType& begin,
+    SizeType& end
+  ) const override;
+
+  /// @brief obj_set に含まれる要素を削除する．
+  bool
+  remove(
+    const unordered_set<const VlObj*>& obj_set
+  ) override;
+
   /// @brief 要素の追加
   void
   add_primitive(
@@ -1051,7 +1530,7 @@ public:
   ) override;
 
   /// @brief primitive のリストを得る．
-  vector<const VlPrimitive*>
+  const vector<const VlPrimitive*>&
   primitive_list() override;
 
 
@@ -1072,6 +1551,26 @@ CellPrimitive::CellPrimitive(
 {
 }
 
+// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+void
+CellPrimitive::copy_to(
+  TagDictTable& table,
+  SizeType& begin,
+  SizeType& end
+) const
+{
+  append(table.mPrimitiveArray, mList, begin, end);
+}
+
+// @brief obj_set に含まれる要素を削除する．
+bool
+CellPrimitive::remove(
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  return remove_elems(mList, obj_set);
+}
+
 // @brief 要素の追加
 void
 CellPrimitive::add_primitive(
@@ -1082,7 +1581,7 @@ CellPrimitive::add_primitive(
 }
 
 // @brief primitive のリストを得る．
-vector<const VlPrimitive*>
+const vector<const VlPrimitive*>&
 CellPrimitive::primitive_list()
 {
   return mList;
@@ -1097,7 +1596,7 @@ TagDict::add_primitive(
   auto parent = obj->parent_scope();
 
   // 該当の Cell が存在するか調べる．
-  auto cell = find_cell(parent, vpiPrimitive);
+  auto cell = find_cell_for_add(parent, vpiPrimitive);
   if ( cell ) {
     cell->add_primitive(obj);
   }
@@ -1108,18 +1607,22 @@ TagDict::add_primitive(
 }
 
 // @brief primitive のリストを取り出す．
-vector<const VlPrimitive*>
+VlSpan<const VlPrimitive*>
 TagDict::find_primitive_list(
   const VlScope* parent
 ) const
 {
+  if ( mHasTable ) {
+    return find_span(parent, vpiPrimitive, mTable.mPrimitiveArray);
+  }
+
   // 該当の Cell が存在するか調べる．
   auto cell = find_cell(parent, vpiPrimitive);
   if ( cell ) {
     return cell->primitive_list();
   }
   else {
-    return vector<const VlPrimitive*>{};
+    return VlSpan<const VlPrimitive*>{};
   }
 }
 
@@ -1137,6 +1640,20 @@ public:
     const VlTaskFunc* obj
   );
 
+  /// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+  void
+  copy_to(
+    TagDictTable& table,
+    SizeType& begin,
+    SizeType& end
+  ) const override;
+
+  /// @brief obj_set に含まれる要素を削除する．
+  bool
+  remove(
+    const unordered_set<const VlObj*>& obj_set
+  ) override;
+
   /// @brief 要素の追加
   void
   add_taskfunc(
@@ -1144,7 +1661,7 @@ public:
   ) override;
 
   /// @brief 要素のリストを得る．
-  vector<const VlTaskFunc*>
+  const vector<const VlTaskFunc*>&
   taskfunc_list() override;
 
 
@@ -1165,6 +1682,26 @@ CellTaskFunc::CellTaskFunc(
 {
 }
 
+// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+void
+CellTaskFunc::copy_to(
+  TagDictTable& table,
+  SizeType& begin,
+  SizeType& end
+) const
+{
+  append(table.mTaskFuncArray, mList, begin, end);
+}
+
+// @brief obj_set に含まれる要素を削除する．
+bool
+CellTaskFunc::remove(
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  return remove_elems(mList, obj_set);
+}
+
 // @brief 要素の追加
 void
 CellTaskFunc::add_taskfunc(
@@ -1175,7 +1712,7 @@ CellTaskFunc::add_taskfunc(
 }
 
 // @brief 要素のリストを得る．
-vector<const VlTaskFunc*>
+const vector<const VlTaskFunc*>&
 CellTaskFunc::taskfunc_list()
 {
   return mList;
@@ -1190,7 +1727,7 @@ TagDict::add_task(
   auto parent = obj->parent_scope();
 
   // 該当の Cell が存在するか調べる．
-  auto cell = find_cell(parent, vpiTask);
+  auto cell = find_cell_for_add(parent, vpiTask);
   if ( cell ) {
     cell->add_taskfunc(obj);
   }
@@ -1201,18 +1738,22 @@ TagDict::add_task(
 }
 
 // @brief タスクのリストを取り出す．
-vector<const VlTaskFunc*>
+VlSpan<const VlTaskFunc*>
 TagDict::find_task_list(
   const VlScope* parent
 ) const
 {
+  if ( mHasTable ) {
+    return find_span(parent, vpiTask, mTable.mTaskFuncArray);
+  }
+
   // 該当の Cell が存在するか調べる．
   auto cell = find_cell(parent, vpiTask);
   if ( cell ) {
     return cell->taskfunc_list();
   }
   else {
-    return vector<const VlTaskFunc*>{};
+    return VlSpan<const VlTaskFunc*>{};
   }
 }
 
@@ -1225,7 +1766,7 @@ TagDict::add_function(
   auto parent = obj->parent_scope();
 
   // 該当の Cell が存在するか調べる．
-  auto cell = find_cell(parent, vpiFunction);
+  auto cell = find_cell_for_add(parent, vpiFunction);
   if ( cell ) {
     cell->add_taskfunc(obj);
   }
@@ -1236,18 +1777,22 @@ TagDict::add_function(
 }
 
 // @brief function のリストを取り出す．
-vector<const VlTaskFunc*>
+VlSpan<const VlTaskFunc*>
 TagDict::find_function_list(
   const VlScope* parent
 ) const
 {
+  if ( mHasTable ) {
+    return find_span(parent, vpiFunction, mTable.mTaskFuncArray);
+  }
+
   // 該当の Cell が存在するか調べる．
   auto cell = find_cell(parent, vpiFunction);
   if ( cell ) {
     return cell->taskfunc_list();
   }
   else {
-    return vector<const VlTaskFunc*>{};
+    return VlSpan<const VlTaskFunc*>{};
   }
 }
 
@@ -1265,6 +1810,20 @@ public:
     const VlContAssign* obj
   );
 
+  /// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+  void
+  copy_to(
+    TagDictTable& table,
+    SizeType& begin,
+    SizeType& end
+  ) const override;
+
+  /// @brief obj_set に含まれる要素を削除する．
+  bool
+  remove(
+    const unordered_set<const VlObj*>& obj_set
+  ) override;
+
   /// @brief 要素の追加
   void
   add_contassign(
@@ -1272,7 +1831,7 @@ public:
   ) override;
 
   /// @brief 要素のリストを得る．
-  vector<const VlContAssign*>
+  const vector<const VlContAssign*>&
   contassign_list() override;
 
 
@@ -1293,6 +1852,26 @@ CellContAssign::CellContAssign(
 {
 }
 
+// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+void
+CellContAssign::copy_to(
+  TagDictTable& table,
+  SizeType& begin,
+  SizeType& end
+) const
+{
+  append(table.mContAssignArray, mList, begin, end);
+}
+
+// @brief obj_set に含まれる要素を削除する．
+bool
+CellContAssign::remove(
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  return remove_elems(mList, obj_set);
+}
+
 // @brief 要素の追加
 void
 CellContAssign::add_contassign(
@@ -1303,7 +1882,7 @@ CellContAssign::add_contassign(
 }
 
 // @brief 要素のリストを得る．
-vector<const VlContAssign*>
+const vector<const VlContAssign*>&
 CellContAssign::contassign_list()
 {
   return mList;
@@ -1318,7 +1897,7 @@ TagDict::add_contassign(
   auto parent = obj->module();
 
   // 該当の Cell が存在するか調べる．
-  auto cell = find_cell(parent, vpiContAssign);
+  auto cell = find_cell_for_add(parent, vpiContAssign);
   if ( cell ) {
     cell->add_contassign(obj);
   }
@@ -1329,18 +1908,22 @@ TagDict::add_contassign(
 }
 
 // @brief continuous assignment のリストを取り出す．
-vector<const VlContAssign*>
+VlSpan<const VlContAssign*>
 TagDict::find_contassign_list(
   const VlScope* parent
 ) const
 {
+  if ( mHasTable ) {
+    return find_span(parent, vpiContAssign, mTable.mContAssignArray);
+  }
+
   // 該当の Cell が存在するか調べる．
   auto cell = find_cell(parent, vpiContAssign);
   if ( cell ) {
     return cell->contassign_list();
   }
   else {
-    return vector<const VlContAssign*>{};
+    return VlSpan<const VlContAssign*>{};
   }
 }
 
@@ -1358,6 +1941,20 @@ public:
     const VlProcess* obj
   );
 
+  /// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+  void
+  copy_to(
+    TagDictTable& table,
+    SizeType& begin,
+    SizeType& end
+  ) const override;
+
+  /// @brief obj_set に含まれる要素を削除する．
+  bool
+  remove(
+    const unordered_set<const VlObj*>& obj_set
+  ) override;
+
   /// @brief 要素の追加
   void
   add_process(
@@ -1365,7 +1962,7 @@ public:
   ) override;
 
   /// @brief 要素のリストを得る．
-  vector<const VlProcess*>
+  const vector<const VlProcess*>&
   process_list() override;
 
 
@@ -1386,6 +1983,26 @@ CellProcess::CellProcess(
 {
 }
 
+// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+void
+CellProcess::copy_to(
+  TagDictTable& table,
+  SizeType& begin,
+  SizeType& end
+) const
+{
+  append(table.mProcessArray, mList, begin, end);
+}
+
+// @brief obj_set に含まれる要素を削除する．
+bool
+CellProcess::remove(
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  return remove_elems(mList, obj_set);
+}
+
 // @brief 要素の追加
 void
 CellProcess::add_process(
@@ -1396,7 +2013,7 @@ CellProcess::add_process(
 }
 
 // @brief 要素のリストを得る．
-vector<const VlProcess*>
+const vector<const VlProcess*>&
 CellProcess::process_list()
 {
   return mList;
@@ -1411,7 +2028,7 @@ TagDict::add_process(
   auto parent = obj->parent_scope();
 
   // 該当の Cell が存在するか調べる．
-  auto cell = find_cell(parent, vpiProcess);
+  auto cell = find_cell_for_add(parent, vpiProcess);
   if ( cell ) {
     cell->add_process(obj);
   }
@@ -1422,18 +2039,22 @@ TagDict::add_process(
 }
 
 // @brief process のリストを取り出す．
-vector<const VlProcess*>
+VlSpan<const VlProcess*>
 TagDict::find_process_list(
   const VlScope* parent
 ) const
 {
+  if ( mHasTable ) {
+    return find_span(parent, vpiProcess, mTable.mProcessArray);
+  }
+
   // 該当の Cell が存在するか調べる．
   auto cell = find_cell(parent, vpiProcess);
   if ( cell ) {
     return cell->process_list();
   }
   else {
-    return vector<const VlProcess*>{};
+    return VlSpan<const VlProcess*>{};
   }
 }
 
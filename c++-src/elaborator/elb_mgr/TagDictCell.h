@@ -10,6 +10,7 @@
 
 #include "ym/verilog.h"
 #include "ym/vl/VlFwd.h"
+#include "elaborator/TagDict.h"
 
 
 BEGIN_NAMESPACE_YM_VERILOG
@@ -25,6 +26,23 @@ public:
   virtual
   ~TagDictCell() = default;
 
+  /// @brief 要素を TagDictTable の該当する配列の末尾に追加する．
+  virtual
+  void
+  copy_to(
+    TagDictTable& table, ///< [in] 追加先の表
+    SizeType& begin,     ///< [out] 追加した要素の先頭の位置
+    SizeType& end        ///< [out] 追加した要素の末尾の次の位置
+  ) const = 0;
+
+  /// @brief obj_set に含まれる要素を削除する．
+  /// @return 要素がなくなったら true を返す．
+  virtual
+  bool
+  remove(
+    const unordered_set<const VlObj*>& obj_set ///< [in] 削除する要素の集合
+  ) = 0;
+
   /// @brief  宣言要素を追加する．
   virtual
   void
@@ -34,7 +52,7 @@ public:
 
   /// @brief  宣言要素のリストを得る．
   virtual
-  vector<const VlDecl*>
+  const vector<const VlDecl*>&
   decl_list();
 
   /// @brief  配列型宣言要素を追加する．
@@ -46,7 +64,7 @@ public:
 
   /// @brief  配列型宣言要素のリストを得る．
   virtual
-  vector<const VlDeclArray*>
+  const vector<const VlDeclArray*>&
   declarray_list();
 
   /// @brief  defparam を追加する．
@@ -58,7 +76,7 @@ public:
 
   /// @brief  defparam のリストを得る．
   virtual
-  vector<const VlDefParam*>
+  const vector<const VlDefParam*>&
   defparam_list();
 
   /// @brief  param assign を追加する．
@@ -70,7 +88,7 @@ public:
 
   /// @brief  param assign のリストを得る．
   virtual
-  vector<const VlParamAssign*>
+  const vector<const VlParamAssign*>&
   paramassign_list();
 
   /// @brief module array を追加する．
@@ -82,7 +100,7 @@ public:
 
   /// @brief module array のリストを得る．
   virtual
-  vector<const VlModuleArray*>
+  const vector<const VlModuleArray*>&
   modulearray_list();
 
   /// @brief  module を追加する．
@@ -94,7 +112,7 @@ public:
 
   /// @brief  module のリストを得る．
   virtual
-  vector<const VlModule*>
+  const vector<const VlModule*>&
   module_list();
 
   /// @brief  primitive array を追加する．
@@ -106,7 +124,7 @@ public:
 
   /// @brief  primitive array のリストを得る．
   virtual
-  vector<const VlPrimArray*>
+  const vector<const VlPrimArray*>&
   primarray_list();
 
   /// @brief  primitive を追加する．
@@ -118,7 +136,7 @@ public:
 
   /// @brief  primitive のリストを得る．
   virtual
-  vector<const VlPrimitive*>
+  const vector<const VlPrimitive*>&
   primitive_list();
 
   /// @brief タスク/関数を追加する．
@@ -130,7 +148,7 @@ public:
 
   /// @brief タスク/関数のリストを得る．
   virtual
-  vector<const VlTaskFunc*>
+  const vector<const VlTaskFunc*>&
   taskfunc_list();
 
   /// @brief continuous assignment を追加する．
@@ -142,7 +160,7 @@ public:
 
   /// @brief  continuous assignment のリストを得る．
   virtual
-  vector<const VlContAssign*>
+  const vector<const VlContAssign*>&
   contassign_list();
 
   /// @brief  process を追加する．
@@ -154,7 +172,7 @@ public:
 
   /// @brief  process のリストを得る．
   virtual
-  vector<const VlProcess*>
+  const vector<const VlProcess*>&
   process_list();
 
   /// @brief internal scope を追加する．
@@ -166,7 +184,7 @@ public:
 
   /// @brief internal scope のリストを得る．
   virtual
-  vector<const VlScope*>
+  const vector<const VlScope*>&
   internalscope_list();
 
 };
@@ -0,0 +1,103 @@
+﻿
+/// @file VlHierName.cc
+/// @brief VlHierName の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/vl/VlHierName.h"
+#include "ym/vl/VlScope.h"
+#include <functional>
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+BEGIN_NONAMESPACE
+
+// 根から obj までの要素のリストを作る．
+// ただし名前を持たない toplevel は含まない．
+vector<const VlNamedObj*>
+path_list(
+  const VlNamedObj* obj
+)
+{
+  vector<const VlNamedObj*> ans;
+  for ( auto p = obj; p != nullptr; p = p->parent_scope() ) {
+    if ( p->parent_scope() == nullptr && p->name() == string() ) {
+      // toplevel
+      break;
+    }
+    ans.push_back(p);
+  }
+  std::reverse(ans.begin(), ans.end());
+  return ans;
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス VlHierName
+//////////////////////////////////////////////////////////////////////
+
+// @brief 親の階層名を返す．
+VlHierName
+VlHierName::parent() const
+{
+  if ( mObj == nullptr ) {
+    return VlHierName{};
+  }
+  return VlHierName{mObj->parent_scope()};
+}
+
+// @brief 階層の深さを返す．
+SizeType
+VlHierName::depth() const
+{
+  return path_list(mObj).size();
+}
+
+// @brief 階層名の比較
+int
+VlHierName::compare(
+  const VlHierName& right
+) const
+{
+  if ( mObj == right.mObj ) {
+    return 0;
+  }
+
+  auto list1 = path_list(mObj);
+  auto list2 = path_list(right.mObj);
+  SizeType n1 = list1.size();
+  SizeType n2 = list2.size();
+  SizeType n = std::min(n1, n2);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( list1[i] == list2[i] ) {
+      // 共通の祖先は比較しなくてよい．
+      continue;
+    }
+    auto name1 = list1[i]->name();
+    auto name2 = list2[i]->name();
+    if ( name1 < name2 ) {
+      return -1;
+    }
+    if ( name1 > name2 ) {
+      return 1;
+    }
+  }
+  if ( n1 < n2 ) {
+    return -1;
+  }
+  if ( n1 > n2 ) {
+    return 1;
+  }
+  // 名前が同じでも異なる要素なら operator==() と合わせるために
+  // ポインタの順で区別する．
+  if ( std::less<const VlNamedObj*>{}(mObj, right.mObj) ) {
+    return -1;
+  }
+  return 1;
+}
+
+END_NAMESPACE_YM_VERILOG
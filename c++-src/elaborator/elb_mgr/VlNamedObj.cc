@@ -29,17 +29,66 @@ VlNamedObj::parent_module() const
 string
 VlNamedObj::full_name() const
 {
-  string tmp;
-  if ( name() != string() ) {
-    tmp = name();
+  ostringstream buf;
+  write_full_name(buf);
+  return buf.str();
+}
+
+// @brief fullname をストリームに書き出す．
+void
+VlNamedObj::write_full_name(
+  ostream& s
+) const
+{
+  // 親のスコープから順に書き出すので文字列のコピーは起こらない．
+  auto parent = parent_scope();
+  if ( parent ) {
+    parent->write_full_name(s);
+    s << ".";
   }
-  else {
-    tmp = "<anonymous>";
+  auto tmp = name();
+  if ( tmp != string() ) {
+    s << tmp;
   }
-  if ( parent_scope() ) {
-    return parent_scope()->full_name() + "." + tmp;
+  else {
+    s << "<anonymous>";
   }
-  return tmp;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス VlScope
+//////////////////////////////////////////////////////////////////////
+
+// @brief fullname の取得
+string
+VlScope::full_name() const
+{
+  return cached_full_name();
+}
+
+// @brief fullname をストリームに書き出す．
+void
+VlScope::write_full_name(
+  ostream& s
+) const
+{
+  s << cached_full_name();
+}
+
+// @brief キャッシュされた fullname を返す．
+const string&
+VlScope::cached_full_name() const
+{
+  // 他のスレッドが作成中の場合は完了するまで待つ．
+  std::call_once(mFullNameFlag, [this]() {
+    // 親のスコープの fullname もキャッシュされているので
+    // ここでのコストは名前の長さに比例する．
+    ostringstream buf;
+    VlNamedObj::write_full_name(buf);
+    mFullName = buf.str();
+  });
+  return mFullName;
 }
 
 
@@ -40,6 +40,10 @@ AttrGen::instantiate_attribute(
   auto pt_obj = attr_info.obj();
   if ( mHash.count(pt_obj) == 0 ) {
     // また未生成なので作る．
+    // 構文木要素ごとのユニットが所有する．
+    auto unit = mgr().new_unit(nullptr, nullptr, nullptr, nullptr);
+    auto prev_unit = mgr().set_cur_unit(unit);
+    mUnitDict.emplace(pt_obj, unit);
     auto pt_attr_list = attr_info.attr_list();
     bool def{attr_info.def()};
     vector<const VlAttribute*> attr_list;
@@ -58,6 +62,7 @@ AttrGen::instantiate_attribute(
     }
     // attr_list が空でも処理済みの意味で追加する．
     mHash.emplace(pt_obj, attr_list);
+    mgr().set_cur_unit(prev_unit);
   }
   mHash.at(pt_obj);
 }
@@ -76,4 +81,24 @@ AttrGen::attribute_list(
   }
 }
 
+// @brief pt_obj_set に含まれない構文木要素の属性リストを取り除く．
+vector<ElbUnit*>
+AttrGen::remove_obsolete(
+  const unordered_set<const PtBase*>& pt_obj_set
+)
+{
+  vector<ElbUnit*> unit_list;
+  for ( auto p = mUnitDict.begin(); p != mUnitDict.end(); ) {
+    auto pt_obj = p->first;
+    if ( pt_obj_set.count(pt_obj) > 0 ) {
+      ++ p;
+      continue;
+    }
+    unit_list.push_back(p->second);
+    mHash.erase(pt_obj);
+    p = mUnitDict.erase(p);
+  }
+  return unit_list;
+}
+
 END_NAMESPACE_YM_VERILOG
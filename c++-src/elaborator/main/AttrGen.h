@@ -64,6 +64,15 @@ public:
     const PtBase* pt_obj ///< [in] 元となる構文木要素
   );
 
+  /// @brief pt_obj_set に含まれない構文木要素の属性リストを取り除く．
+  /// @return 取り除いた属性リストを所有するユニットのリストを返す．
+  ///
+  /// ユニットの削除は呼び出し側で行う．
+  vector<ElbUnit*>
+  remove_obsolete(
+    const unordered_set<const PtBase*>& pt_obj_set ///< [in] 現在の構文木要素の集合
+  );
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -73,6 +82,9 @@ private:
   // ハッシュ表
   unordered_map<const PtBase*, vector<const VlAttribute*>> mHash;
 
+  // 構文木要素をキーにして属性リストを所有するユニットを持つ辞書
+  unordered_map<const PtBase*, ElbUnit*> mUnitDict;
+
   // 空のリスト
   vector<const VlAttribute*> mEmptyList{};
 
@@ -0,0 +1,97 @@
+
+/// @file CellCache.cc
+/// @brief CellCache の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "CellCache.h"
+#include "ym/ClibPin.h"
+#include "ym/Range.h"
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+// クラス CellInfo
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+CellInfo::CellInfo(
+  const ClibCell& cell
+) : mCell{cell}
+{
+  SizeType n = cell.pin_num();
+  mDirList.reserve(n);
+  mPinDict.reserve(n);
+  for ( auto id: Range(n) ) {
+    auto pin = cell.pin(id);
+    VpiDir dir;
+    if ( pin.is_input() ) {
+      dir = VpiDir::Input;
+    }
+    else if ( pin.is_output() ) {
+      dir = VpiDir::Output;
+    }
+    else if ( pin.is_inout() ) {
+      dir = VpiDir::Inout;
+    }
+    else {
+      ASSERT_NOT_REACHED;
+    }
+    mDirList.push_back(dir);
+    mPinDict.emplace(pin.name(), id);
+  }
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス CellCache
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+CellCache::CellCache(
+  const ClibCellLibrary& cell_library
+) : mCellLibrary{cell_library}
+{
+}
+
+// @brief デストラクタ
+CellCache::~CellCache()
+{
+}
+
+// @brief セルの情報を探す．
+const CellInfo*
+CellCache::find(
+  const string& name
+)
+{
+  auto p = mDict.find(name);
+  if ( p != mDict.end() ) {
+    ++ mHitNum;
+    return p->second.get();
+  }
+
+  ++ mMissNum;
+  unique_ptr<CellInfo> info;
+  auto cell = mCellLibrary.cell(name);
+  if ( cell.is_valid() ) {
+    info.reset(new CellInfo{cell});
+  }
+  auto ans = info.get();
+  mDict.emplace(name, std::move(info));
+  return ans;
+}
+
+// @brief 内容をクリアする．
+void
+CellCache::clear()
+{
+  mDict.clear();
+  mHitNum = 0;
+  mMissNum = 0;
+}
+
+END_NAMESPACE_YM_VERILOG
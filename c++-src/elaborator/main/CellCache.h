@@ -0,0 +1,185 @@
+#ifndef CELLCACHE_H
+#define CELLCACHE_H
+
+/// @file CellCache.h
+/// @brief CellCache のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/verilog.h"
+#include "ym/ClibCellLibrary.h"
+#include "ym/ClibCell.h"
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+/// @class CellInfo CellCache.h "CellCache.h"
+/// @brief セルインスタンスの生成と接続に用いるセルの情報
+///
+/// ピン名からピン番号への辞書とピンごとの向きを持つ．
+/// セルの種類ごとに一度だけ作られ，同じセルのインスタンスの間で
+/// 共有される．
+//////////////////////////////////////////////////////////////////////
+class CellInfo
+{
+public:
+
+  /// @brief コンストラクタ
+  CellInfo(
+    const ClibCell& cell ///< [in] セル
+  );
+
+  /// @brief デストラクタ
+  ~CellInfo() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief セルを返す．
+  const ClibCell&
+  cell() const
+  {
+    return mCell;
+  }
+
+  /// @brief ピン数を返す．
+  SizeType
+  pin_num() const
+  {
+    return mDirList.size();
+  }
+
+  /// @brief ピンの向きのリストを返す．
+  ///
+  /// セルインスタンスの端子の初期化に用いる．
+  const vector<VpiDir>&
+  dir_list() const
+  {
+    return mDirList;
+  }
+
+  /// @brief ピンの向きを返す．
+  VpiDir
+  pin_dir(
+    SizeType id ///< [in] ピン番号 ( 0 <= id < pin_num() )
+  ) const
+  {
+    ASSERT_COND( id < pin_num() );
+    return mDirList[id];
+  }
+
+  /// @brief ピン名からピン番号を返す．
+  /// @return 見つからない場合は pin_num() を返す．
+  SizeType
+  pin_id(
+    const string& name ///< [in] ピン名
+  ) const
+  {
+    auto p = mPinDict.find(name);
+    if ( p == mPinDict.end() ) {
+      return pin_num();
+    }
+    return p->second;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // セル
+  ClibCell mCell;
+
+  // ピンの向きのリスト
+  vector<VpiDir> mDirList;
+
+  // ピン名をキーにしてピン番号を保持する辞書
+  unordered_map<string, SizeType> mPinDict;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class CellCache CellCache.h "CellCache.h"
+/// @brief セル名をキーにして CellInfo を保持するキャッシュ
+///
+/// ゲートレベルのネットリストではほとんどのインスタンスがセルなので
+/// ライブラリの検索とピン名の解決をセルの種類ごとに一度で済ませる．
+/// 見つからなかったセル名も登録しておく．
+//////////////////////////////////////////////////////////////////////
+class CellCache
+{
+public:
+
+  /// @brief コンストラクタ
+  CellCache(
+    const ClibCellLibrary& cell_library ///< [in] セルライブラリ
+  );
+
+  /// @brief デストラクタ
+  ~CellCache();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief セルの情報を探す．
+  /// @return name という名のセルの情報を返す．
+  ///
+  /// なければ nullptr を返す．
+  const CellInfo*
+  find(
+    const string& name ///< [in] セル名
+  );
+
+  /// @brief 内容をクリアする．
+  void
+  clear();
+
+  /// @brief 見つかった回数を返す．
+  SizeType
+  hit_num() const
+  {
+    return mHitNum;
+  }
+
+  /// @brief 見つからなかった回数を返す．
+  SizeType
+  miss_num() const
+  {
+    return mMissNum;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // セルライブラリ
+  const ClibCellLibrary& mCellLibrary;
+
+  // セル名をキーにしてセルの情報を保持する辞書
+  // セルがない場合は nullptr を持つ．
+  unordered_map<string, unique_ptr<CellInfo>> mDict;
+
+  // 見つかった回数
+  SizeType mHitNum{0};
+
+  // 見つからなかった回数
+  SizeType mMissNum{0};
+
+};
+
+END_NAMESPACE_YM_VERILOG
+
+#endif // CELLCACHE_H
@@ -277,15 +277,14 @@ DeclGen::instantiate_iodecl(
 	ASSERT_NOT_REACHED;
       }
 
-      {
-	ostringstream buf;
-	buf << "IODecl(" << pt_item->name() << ")@"
-	    << scope->full_name() << " created.";
-	put_info(__FILE__, __LINE__,
-		 pt_head->file_region(),
-		 "ELABXXX",
-		 buf.str());
-      }
+      put_info_lazy(__FILE__, __LINE__,
+		    pt_head->file_region(),
+		    "ELABXXX",
+		    [&](ostream& s) {
+		      s << "IODecl(" << pt_item->name() << ")@";
+		      scope->write_full_name(s);
+		      s << " created.";
+		    });
     }
   }
 }
@@ -375,14 +374,14 @@ DeclGen::instantiate_param_head(
     auto attr_list = attribute_list(pt_head);
     mgr().reg_attr(param, attr_list);
 
-    {
-      ostringstream buf;
-      buf << "Parameter(" << param->full_name() << ") created.";
-      put_info(__FILE__, __LINE__,
-	       file_region,
-	       "ELABXXX",
-	       buf.str());
-    }
+    put_info_lazy(__FILE__, __LINE__,
+		  file_region,
+		  "ELABXXX",
+		  [&](ostream& s) {
+		    s << "Parameter(";
+		    param->write_full_name(s);
+		    s << ") created.";
+		  });
 
     // 右辺の式は constant expression のはずなので今つくる．
     auto pt_init_expr = pt_item->init_value();
@@ -424,8 +423,8 @@ DeclGen::instantiate_net_head(
   ASSERT_COND( net_head );
 
   if ( pt_delay ) {
-    add_phase3stub(make_stub(this, &DeclGen::link_net_delay,
-			     net_head, pt_delay));
+    add_phase3stub(scope, make_stub(this, &DeclGen::link_net_delay,
+				    net_head, pt_delay));
   }
 
   for ( auto pt_item: pt_head->item_list() ) {
@@ -451,14 +450,14 @@ DeclGen::instantiate_net_head(
       auto attr_list = attribute_list(pt_head);
       mgr().reg_attr(net_array, attr_list);
 
-      {
-	ostringstream buf;
-	buf << "NetArray(" << net_array->full_name() << ") created.";
-	put_info(__FILE__, __LINE__,
-		 pt_item->file_region(),
-		 "ELABXXX",
-		 buf.str());
-      }
+      put_info_lazy(__FILE__, __LINE__,
+		    pt_item->file_region(),
+		    "ELABXXX",
+		    [&](ostream& s) {
+		      s << "NetArray(";
+		      net_array->write_full_name(s);
+		      s << ") created.";
+		    });
     }
     else {
       // 単一の要素
@@ -468,22 +467,22 @@ DeclGen::instantiate_net_head(
 	// 初期割り当てつき
 	// net の初期割り当ては continuous assignment と同等なので
 	// あとで作る．
-	add_phase3stub(make_stub(this, &DeclGen::link_net_assign,
-				 net, pt_item));
+	add_phase3stub(scope, make_stub(this, &DeclGen::link_net_assign,
+					net, pt_item));
       }
 
       // attribute instance の生成
       auto attr_list = attribute_list(pt_head);
       mgr().reg_attr(net, attr_list);
 
-      {
-	ostringstream buf;
-	buf << "Net(" << net->full_name() << ") created.";
-	put_info(__FILE__, __LINE__,
-		 pt_item->file_region(),
-		 "ELABXXX",
-		 buf.str());
-      }
+      put_info_lazy(__FILE__, __LINE__,
+		    pt_item->file_region(),
+		    "ELABXXX",
+		    [&](ostream& s) {
+		      s << "Net(";
+		      net->write_full_name(s);
+		      s << ") created.";
+		    });
     }
   }
 }
@@ -569,14 +568,14 @@ DeclGen::instantiate_reg_head(
       auto attr_list = attribute_list(pt_head);
       mgr().reg_attr(reg_array, attr_list);
 
-      {
-	ostringstream buf;
-	buf << "RegArray(" << reg_array->full_name() << ") created.";
-	put_info(__FILE__, __LINE__,
-		 pt_item->file_region(),
-		 "ELABXXX",
-		 buf.str());
-      }
+      put_info_lazy(__FILE__, __LINE__,
+		    pt_item->file_region(),
+		    "ELABXXX",
+		    [&](ostream& s) {
+		      s << "RegArray(";
+		      reg_array->write_full_name(s);
+		      s << ") created.";
+		    });
     }
     else {
       // 単独の要素
@@ -593,14 +592,14 @@ DeclGen::instantiate_reg_head(
       auto attr_list = attribute_list(pt_head);
       mgr().reg_attr(reg, attr_list);
 
-      {
-	ostringstream buf;
-	buf << "Reg(" << reg->full_name() << ") created.";
-	put_info(__FILE__, __LINE__,
-		 pt_item->file_region(),
-		 "ELABXXX",
-		 buf.str());
-      }
+      put_info_lazy(__FILE__, __LINE__,
+		    pt_item->file_region(),
+		    "ELABXXX",
+		    [&](ostream& s) {
+		      s << "Reg(";
+		      reg->write_full_name(s);
+		      s << ") created.";
+		    });
     }
   }
 }
@@ -637,14 +636,14 @@ DeclGen::instantiate_var_head(
       auto attr_list = attribute_list(pt_head);
       mgr().reg_attr(var_array, attr_list);
 
-      {
-	ostringstream buf;
-	buf << "VarArray(" << var_array->full_name() << ") created.";
-	put_info(__FILE__, __LINE__,
-		 pt_item->file_region(),
-		 "ELABXXX",
-		 buf.str());
-      }
+      put_info_lazy(__FILE__, __LINE__,
+		    pt_item->file_region(),
+		    "ELABXXX",
+		    [&](ostream& s) {
+		      s << "VarArray(";
+		      var_array->write_full_name(s);
+		      s << ") created.";
+		    });
     }
     else {
       // 単独の変数
@@ -661,14 +660,14 @@ DeclGen::instantiate_var_head(
       auto attr_list = attribute_list(pt_head);
       mgr().reg_attr(var, attr_list);
 
-      {
-	ostringstream buf;
-	buf << "Var(" << var->full_name() << ") created.";
-	put_info(__FILE__, __LINE__,
-		 pt_item->file_region(),
-		 "ELABXXX",
-		 buf.str());
-      }
+      put_info_lazy(__FILE__, __LINE__,
+		    pt_item->file_region(),
+		    "ELABXXX",
+		    [&](ostream& s) {
+		      s << "Var(";
+		      var->write_full_name(s);
+		      s << ") created.";
+		    });
     }
   }
 }
@@ -699,14 +698,14 @@ DeclGen::instantiate_event_head(
       auto attr_list = attribute_list(pt_head);
       mgr().reg_attr(ne_array, attr_list);
 
-      {
-	ostringstream buf;
-	buf << "NamedEventArray(" << ne_array->full_name() << ") created.";
-	put_info(__FILE__, __LINE__,
-		 pt_item->file_region(),
-		 "ELABXXX",
-		 buf.str());
-      }
+      put_info_lazy(__FILE__, __LINE__,
+		    pt_item->file_region(),
+		    "ELABXXX",
+		    [&](ostream& s) {
+		      s << "NamedEventArray(";
+		      ne_array->write_full_name(s);
+		      s << ") created.";
+		    });
     }
     else {
       // 単一の要素
@@ -716,14 +715,14 @@ DeclGen::instantiate_event_head(
       auto attr_list = attribute_list(pt_head);
       mgr().reg_attr(named_event, attr_list);
 
-      {
-	ostringstream buf;
-	buf << "NamedEvent(" << named_event->full_name() << ") created.";
-	put_info(__FILE__, __LINE__,
-		 pt_item->file_region(),
-		 "ELABXXX",
-		 buf.str());
-      }
+      put_info_lazy(__FILE__, __LINE__,
+		    pt_item->file_region(),
+		    "ELABXXX",
+		    [&](ostream& s) {
+		      s << "NamedEvent(";
+		      named_event->write_full_name(s);
+		      s << ") created.";
+		    });
     }
   }
 }
@@ -738,14 +737,14 @@ DeclGen::instantiate_genvar_head(
   for ( auto pt_item: pt_head->item_list() ) {
     auto genvar = mgr().new_Genvar(scope, pt_item, 0);
 
-    {
-      ostringstream buf;
-      buf << "Genvar(" << genvar->full_name() << ") created.";
-      put_info(__FILE__, __LINE__,
-	       pt_item->file_region(),
-	       "ELABXXX",
-	       buf.str());
-    }
+    put_info_lazy(__FILE__, __LINE__,
+		  pt_item->file_region(),
+		  "ELABXXX",
+		  [&](ostream& s) {
+		    s << "Genvar(";
+		    genvar->write_full_name(s);
+		    s << ") created.";
+		  });
   }
 }
 
@@ -18,6 +18,7 @@
 #include "AttrGen.h"
 #include "DefParamStub.h"
 #include "ElbStub.h"
+#include "CellCache.h"
 
 #include "ym/pt/PtModule.h"
 #include "ym/pt/PtItem.h"
@@ -72,10 +73,14 @@ END_NONAMESPACE
 // @brief コンストラクタ
 Elaborator::Elaborator(
   ElbMgr& elb_mgr,
-  const ClibCellLibrary& cell_library
+  const ClibCellLibrary& cell_library,
+  bool info_msg,
+  bool lazy
 ) : mDone{false},
+    mLazy{lazy},
     mMgr{elb_mgr},
     mCellLibrary{cell_library},
+    mCellCache{new CellCache(mCellLibrary)},
     mUdpGen{new UdpGen(*this, elb_mgr)},
     mModuleGen{new ModuleGen(*this, elb_mgr)},
     mDeclGen{new DeclGen(*this, elb_mgr)},
@@ -86,6 +91,7 @@ Elaborator::Elaborator(
     mAttrGen{new AttrGen(*this, elb_mgr)}
 {
   mAllowEmptyIORange = true;
+  mInfoMsg = info_msg;
 
   mUdpGen->init(mModuleGen.get(), mDeclGen.get(), mItemGen.get(), mStmtGen.get(),
 		mExprGen.get(), mExprEval.get(), mAttrGen.get());
@@ -177,6 +183,7 @@ Elaborator::operator()(
 
   // トップレベル階層の生成
   /// toplevel は実体を持たない仮想的なスコープ
+  mMgr.set_new_obj_recording(true);
   auto toplevel = mMgr.new_Toplevel();
 
   // トップモジュールの生成
@@ -188,7 +195,22 @@ Elaborator::operator()(
   }
 
   // 残りの要素の生成
+  elaborate_rest();
 
+  // これ以降は要素が追加されないので
+  // スコープごとの要素の表を作っておく．
+  // 遅延モードの場合は elaborate_all() で作る．
+  if ( !has_pending_stub() ) {
+    mMgr.make_scope_table();
+  }
+
+  return nerr;
+}
+
+// @brief トップモジュールの骨組みを作った後の残りの処理を行う．
+void
+Elaborator::elaborate_rest()
+{
   // Phase 1
   // トップモジュールから名前空間を表す骨組みを作る．
   // 最下位レベルのモジュールに行き着くか配列型のモジュールインスタンス
@@ -206,19 +228,9 @@ Elaborator::operator()(
 		    "\"instantiate_defparam\" starts.");
 
     // 未処理の defparam 文を処理する．
-    // 処理された要素は mDefParamList から削除される．
-    // 中にはまだ名前空間が構築されていないものもあるので mDefParamList
-    // が空にならない場合もある．
-    for ( auto p = mDefParamStubList.begin(); p != mDefParamStubList.end(); ) {
-      // リストの中で要素の削除を行うので反復子の扱いがちょっと複雑
-      auto q = p;
-      ++ p;
-
-      if ( mItemGen->defparam_override(*q, nullptr) ) {
-	// オーバーライドがうまく行ったらこの要素は捨てる．
-	mDefParamStubList.erase(q);
-      }
-    }
+    // 中にはまだ名前空間が構築されていないものもあるので
+    // 未解決のまま残る場合もある．
+    instantiate_defparam();
 
     // その結果にもとづいてモジュール配列インスタンスや
     // generate block の生成を行う．
@@ -236,12 +248,15 @@ Elaborator::operator()(
     // Phase1Stub の実行中に新しい stub が追加されるので
     // 追加用のリストと評価用のリストを分離している．
     mPhase1StubList2 = std::move(mPhase1StubList1);
-    mPhase1StubList2.eval();
+    mPhase1StubList2.eval(mMgr);
   }
 
   // 適用できなかった defparam 文のチェック
-  for ( auto stub: mDefParamStubList ) {
-    auto pt_defparam = stub.mPtDefparam;
+  for ( SizeType id = 0; id < mDefParamStubList.size(); ++ id ) {
+    if ( mDefParamDone[id] ) {
+      continue;
+    }
+    auto pt_defparam = mDefParamStubList[id].mPtDefparam;
     ostringstream buf;
     buf << pt_defparam->fullname() << " : not found.";
     MsgMgr::put_msg(__FILE__, __LINE__,
@@ -250,6 +265,8 @@ Elaborator::operator()(
 		    "ELAB",
 		    buf.str());
   }
+  // 以降に生成される要素は defparam 文には関係しない．
+  mMgr.set_new_obj_recording(false);
 
   // Phase 2
   // 配列要素やビット要素の生成を行う．
@@ -259,7 +276,7 @@ Elaborator::operator()(
 		  "ELAB",
 		  "Phase 2 starts.");
 
-  mPhase2StubList.eval();
+  mPhase2StubList.eval(mMgr);
 
   // Phase 3
   // 名前の解決(リンク)を行う．
@@ -269,9 +286,206 @@ Elaborator::operator()(
 		  "ELAB",
 		  "Phase 3 starts.");
 
-  mPhase3StubList.eval();
+  mPhase3StubList.eval(mMgr);
+}
 
-  return nerr;
+// @brief 読み直したモジュール定義に関係する部分だけを作り直す．
+bool
+Elaborator::rebuild(
+  const PtMgr& pt_mgr,
+  const unordered_set<const PtModule*>& module_set
+)
+{
+  // 作り直すユニットを求める．
+  // ユニットは削除されるので作り直しに必要な情報を取り出しておく．
+  auto unit_list = mMgr.invalid_unit_list(module_set);
+  unordered_set<const ElbUnit*> unit_set{unit_list.begin(), unit_list.end()};
+  unordered_set<const VlScope*> scope_set;
+  struct RootInfo
+  {
+    // インスタンスが置かれているスコープ
+    const VlScope* mParent;
+
+    // インスタンス記述のヘッダ
+    const PtItem* mPtHead;
+
+    // インスタンス記述
+    const PtInst* mPtInst;
+
+    // モジュール定義名
+    string mDefName;
+
+    // ループチェック用の祖先のモジュール定義のリスト
+    vector<const PtModule*> mAncestorList;
+  };
+  vector<RootInfo> root_list;
+  for ( auto unit: unit_list ) {
+    scope_set.insert(unit->mScopeList.begin(), unit->mScopeList.end());
+    if ( unit_set.count(unit->mParent) > 0 ) {
+      // 親とともに作り直される．
+      continue;
+    }
+    if ( unit->mPtModule == nullptr ) {
+      // インスタンス以外のユニットは作り直せない．
+      // まだ何も変更していないので全体を作り直せば良い．
+      return false;
+    }
+    RootInfo info{unit->mParentScope, unit->mPtHead, unit->mPtInst,
+		  unit->mPtModule->name(), {}};
+    for ( auto unit1 = unit->mParent; unit1 != nullptr; unit1 = unit1->mParent ) {
+      if ( unit1->mPtModule != nullptr ) {
+	info.mAncestorList.push_back(unit1->mPtModule);
+      }
+    }
+    root_list.push_back(info);
+  }
+
+  // 現在の構文木にない要素の属性リストも削除する．
+  auto attr_info_list = pt_mgr.all_attr_list();
+  unordered_set<const PtBase*> pt_obj_set;
+  for ( const auto& attr_info: attr_info_list ) {
+    pt_obj_set.emplace(attr_info.obj());
+  }
+  auto attr_unit_list = mAttrGen->remove_obsolete(pt_obj_set);
+
+  // 削除するユニットの処理待ちの stub を取り除く．
+  mPhase1StubList1.remove(unit_set);
+  mPhase2StubList.remove(unit_set);
+  mPhase3StubList.remove(unit_set);
+  for ( auto p = mLazyStubDict.begin(); p != mLazyStubDict.end(); ) {
+    p->second.remove(unit_set);
+    if ( p->second.empty() ) {
+      p = mLazyStubDict.erase(p);
+    }
+    else {
+      ++ p;
+    }
+  }
+  mLazyScopeList.erase(std::remove_if(mLazyScopeList.begin(), mLazyScopeList.end(),
+				      [&](const VlScope* scope) {
+					return mLazyStubDict.count(scope) == 0;
+				      }),
+		       mLazyScopeList.end());
+  mCfDict.remove(scope_set, {}, {});
+
+  unit_list.insert(unit_list.end(), attr_unit_list.begin(), attr_unit_list.end());
+  mMgr.remove_units(unit_list);
+  mExprEval->clear_cache();
+
+  // モジュールテンプレートと関数定義の辞書を作り直す．
+  // モジュール名の集合は変わっていないので重複のチェックは必要ない．
+  mModuleDict.clear();
+  mFuncDict.clear();
+  for ( auto pt_module: pt_mgr.pt_module_list() ) {
+    mModuleDict.emplace(pt_module->name(), pt_module);
+    for ( auto item: pt_module->item_list() ) {
+      if ( item->type() == PtItemType::Func ) {
+	auto key = gen_funckey(pt_module, item->name());
+	mFuncDict.emplace(key, item);
+      }
+    }
+  }
+
+  // 新しい要素の attribute instance の生成
+  // 生成済みのものはそのまま用いられる．
+  for ( const auto& attr_info: attr_info_list ) {
+    mAttrGen->instantiate_attribute(attr_info);
+  }
+
+  // 適用済みの defparam 文はそのままで良いので
+  // 作り直すインスタンスのものだけを登録し直す．
+  mDefParamStubList.clear();
+  mDefParamDone.clear();
+  mDefParamQueue.clear();
+  mDefParamIndex.clear();
+  mMgr.clear_new_obj_list();
+  mMgr.set_new_obj_recording(true);
+
+  for ( const auto& info: root_list ) {
+    auto pt_module = find_moduledef(info.mDefName);
+    if ( pt_module == nullptr ) {
+      return false;
+    }
+    // 祖先のモジュールの処理中とみなしてループチェックを行う．
+    for ( auto pt_module1: info.mAncestorList ) {
+      pt_module1->set_in_use();
+    }
+    if ( info.mPtHead == nullptr ) {
+      // トップモジュール
+      mModuleGen->phase1_topmodule(info.mParent, pt_module);
+    }
+    else {
+      mItemGen->phase1_module_inst(info.mParent, info.mPtHead,
+				   info.mPtInst, pt_module);
+    }
+    for ( auto pt_module1: info.mAncestorList ) {
+      pt_module1->reset_in_use();
+    }
+  }
+
+  elaborate_rest();
+
+  // 作り直したトップモジュールは末尾に加わっているので並べ直す．
+  // スコープごとの要素の表は削除の際に破棄されているが
+  // 必要になった時(freeze() など)に作られる．
+  mMgr.sort_topmodule_list(pt_mgr.pt_module_list());
+
+  // 作り直していないインスタンスのパラメータを書き換えていたら
+  // 結果は正しくない．
+  return !mMgr.has_stale_override();
+}
+
+// @brief スコープに記述された要素の phase3 の処理を行う．
+void
+Elaborator::elaborate_scope(
+  const VlScope* scope
+)
+{
+  if ( !has_pending_stub() ) {
+    return;
+  }
+
+  // スコープの要素は外側のスコープのタスク/関数や要素を参照するので
+  // モジュールまでの外側のスコープもあわせて外側から順に処理する．
+  // タスク/関数の本体は外側のスコープの要素として登録されている．
+  vector<const VlScope*> scope_list;
+  for ( auto scope1 = scope; scope1 != nullptr;
+	scope1 = scope1->parent_scope() ) {
+    scope_list.push_back(scope1);
+    if ( scope1->type() == VpiObjType::Module ) {
+      break;
+    }
+  }
+  for ( auto rp = scope_list.rbegin(); rp != scope_list.rend(); ++ rp ) {
+    auto p = mLazyStubDict.find(*rp);
+    if ( p == mLazyStubDict.end() ) {
+      continue;
+    }
+    // eval() の途中で辞書が変更されても良いように取り出しておく．
+    auto stub_list = std::move(p->second);
+    mLazyStubDict.erase(p);
+    stub_list.eval(mMgr);
+  }
+}
+
+// @brief 残っている phase3 の処理をすべて行う．
+void
+Elaborator::elaborate_all()
+{
+  if ( !has_pending_stub() ) {
+    return;
+  }
+  // 登録順に処理する．
+  // 処理済みのスコープは mLazyStubDict にないので飛ばされる．
+  while ( has_pending_stub() ) {
+    vector<const VlScope*> scope_list;
+    scope_list.swap(mLazyScopeList);
+    for ( auto scope: scope_list ) {
+      elaborate_scope(scope);
+    }
+  }
+
+  mMgr.make_scope_table();
 }
 
 // 後で処理する defparam 文を登録する．
@@ -282,17 +496,96 @@ Elaborator::add_defparamstub(
 )
 {
   for ( auto pt_defparam: pt_header->defparam_list() ) {
+    SizeType id = mDefParamStubList.size();
     mDefParamStubList.push_back(DefParamStub{module, pt_header, pt_defparam});
+    mDefParamDone.push_back(false);
+    // 最初の一回は無条件に試す．
+    mDefParamQueue.push_back(id);
+    // 階層名に含まれる要素名で索引を作る．
+    for ( auto name_branch: pt_defparam->namebranch_list() ) {
+      mDefParamIndex[name_branch->name()].push_back(id);
+    }
+    mDefParamIndex[pt_defparam->name()].push_back(id);
   }
 }
 
+// @brief 適用可能な defparam 文を適用する．
+//
+// 未解決の defparam 文を毎回全て試すと，後の繰り返しで生成される
+// 深い階層を参照する defparam 文が多い場合に2乗オーダーの時間がかかる．
+// そこで未解決の defparam 文は階層名に含まれる要素名で索引を作っておき，
+// その名前を持つ要素が新たに生成された時だけ再び適用を試みる．
+void
+Elaborator::instantiate_defparam()
+{
+  // 前回以降に生成された要素の名前に関係する defparam 文を起こす．
+  for ( auto obj: mMgr.new_obj_list() ) {
+    auto name = obj->name();
+    wake_defparam(name);
+    // generate for block の名前は "名前[インデックス]" の形をしている．
+    auto pos = name.find('[');
+    if ( pos != string::npos ) {
+      wake_defparam(name.substr(0, pos));
+    }
+    if ( obj->type() == VpiObjType::Module ) {
+      // モジュールはモジュール定義名でも参照される．
+      auto module = static_cast<const VlModule*>(obj);
+      wake_defparam(module->def_name());
+    }
+  }
+  mMgr.clear_new_obj_list();
+
+  // 登録順に処理する．
+  vector<SizeType> queue;
+  queue.swap(mDefParamQueue);
+  sort(queue.begin(), queue.end());
+  queue.erase(unique(queue.begin(), queue.end()), queue.end());
+  for ( auto id: queue ) {
+    if ( mDefParamDone[id] ) {
+      continue;
+    }
+    // defparam 文を含むモジュールのユニットのもとで処理する．
+    auto& stub = mDefParamStubList[id];
+    auto prev_unit = mMgr.set_cur_unit(mMgr.unit_of(stub.mModule));
+    bool stat = mItemGen->defparam_override(stub, nullptr);
+    mMgr.set_cur_unit(prev_unit);
+    if ( stat ) {
+      // オーバーライドがうまく行ったらもう試さない．
+      mDefParamDone[id] = true;
+    }
+  }
+}
+
+// @brief name を階層名に含む未解決の defparam 文を処理待ちにする．
+void
+Elaborator::wake_defparam(
+  const string& name
+)
+{
+  auto p = mDefParamIndex.find(name);
+  if ( p == mDefParamIndex.end() ) {
+    return;
+  }
+  auto& id_list = p->second;
+  // 適用済みのものはついでに取り除いておく．
+  SizeType wpos = 0;
+  for ( auto id: id_list ) {
+    if ( !mDefParamDone[id] ) {
+      id_list[wpos] = id;
+      ++ wpos;
+      mDefParamQueue.push_back(id);
+    }
+  }
+  id_list.erase(id_list.begin() + wpos, id_list.end());
+}
+
 // @brief phase1 で行う処理を登録する．
 void
 Elaborator::add_phase1stub(
   ElbStub* stub
 )
 {
-  mPhase1StubList1.push_back(stub);
+  mPhase1StubList1.push_back(stub, mMgr.cur_unit());
 }
 
 // @brief phase2 で行う処理を登録する．
@@ -301,16 +594,27 @@ Elaborator::add_phase2stub(
   ElbStub* stub
 )
 {
-  mPhase2StubList.push_back(stub);
+  mPhase2StubList.push_back(stub, mMgr.cur_unit());
 }
 
 // phase3 で行う処理を登録する．
 void
 Elaborator::add_phase3stub(
+  const VlScope* scope,
   ElbStub* stub
 )
 {
-  mPhase3StubList.push_back(stub);
+  if ( mLazy ) {
+    auto p = mLazyStubDict.find(scope);
+    if ( p == mLazyStubDict.end() ) {
+      p = mLazyStubDict.emplace(scope, ElbStubList{}).first;
+      mLazyScopeList.push_back(scope);
+    }
+    p->second.push_back(stub, mMgr.cur_unit());
+  }
+  else {
+    mPhase3StubList.push_back(stub, mMgr.cur_unit());
+  }
 }
 
 // @brief 名前からモジュール定義を取り出す．
@@ -374,12 +678,12 @@ Elaborator::reg_constant_function(
 }
 
 // @brief セルの探索
-ClibCell
+const CellInfo*
 Elaborator::find_cell(
   const string& name
-) const
+)
 {
-  return mCellLibrary.cell(name);
+  return mCellCache->find(name);
 }
 
 END_NAMESPACE_YM_VERILOG
@@ -137,7 +137,18 @@ ElbProxy::instantiate_constant_function(
   const PtItem* pt_function
 )
 {
-  return mItemGen->instantiate_constant_function(parent, pt_function);
+  // 他のインスタンスの処理中に作られることもあるが，
+  // 関数は parent を含むユニットが所有する．
+  auto prev_unit = mgr().set_cur_unit(mgr().unit_of(parent));
+  try {
+    auto func = mItemGen->instantiate_constant_function(parent, pt_function);
+    mgr().set_cur_unit(prev_unit);
+    return func;
+  }
+  catch ( ... ) {
+    mgr().set_cur_unit(prev_unit);
+    throw;
+  }
 }
 
 // @brief スコープに関係するステートメントの実体化を行う．
@@ -399,6 +410,9 @@ ElbProxy::put_info(
   const string& msg
 )
 {
+  if ( !info_msg() ) {
+    return;
+  }
   MsgMgr::put_msg(file, line,
 		  loc,
 		  MsgType::Info,
@@ -74,6 +74,13 @@ protected:
   bool
   allow_empty_io_range();
 
+  /// @brief 情報メッセージを出力するか
+  bool
+  info_msg() const
+  {
+    return mElaborator.mInfoMsg;
+  }
+
 
 protected:
   //////////////////////////////////////////////////////////////////////
@@ -114,10 +121,10 @@ protected:
   }
 
   /// @brief セルの探索
-  /// @return name という名のセルを返す．
+  /// @return name という名のセルの情報を返す．
   ///
-  /// なければ不正値を返す．
-  ClibCell
+  /// なければ nullptr を返す．
+  const CellInfo*
   find_cell(
     const string& name ///< [in] セル名
   ) const
@@ -177,10 +184,22 @@ protected:
   /// @brief phase3 で行う処理を登録する．
   void
   add_phase3stub(
-    ElbStub* stub ///< [in] phase3 で行う処理を表すスタブ
+    const VlScope* scope, ///< [in] 処理する要素の記述されたスコープ
+    ElbStub* stub         ///< [in] phase3 で行う処理を表すスタブ
+  )
+  {
+    mElaborator.add_phase3stub(scope, stub);
+  }
+
+  /// @brief 遅延させた phase3 の処理のうち scope に関係するものを行う．
+  ///
+  /// 遅延モードでなければ何もしない．
+  void
+  elaborate_scope(
+    const VlScope* scope ///< [in] 対象のスコープ
   )
   {
-    mElaborator.add_phase3stub(stub);
+    mElaborator.elaborate_scope(scope);
   }
 
   /// @brief 1引数版の ElbStub を作る．
@@ -563,6 +582,29 @@ protected:
     const string& msg      ///< [in] メッセージ
   );
 
+  /// @brief 情報メッセージを遅延評価で出力する．
+  ///
+  /// fmt は ostream& を引数にとる関数オブジェクトで，
+  /// 情報メッセージを出力しない設定の時には呼ばれない．
+  /// そのため full_name() などの重い処理を fmt の中に書いておけば
+  /// メッセージを捨てる場合のコストはかからない．
+  template<typename Fmt>
+  void
+  put_info_lazy(
+    const char* file,      ///< [in] ソースファイル名
+    int line,              ///< [in] ソースファイル上の行番号
+    const FileRegion& loc, ///< [in] 対象の箇所
+    const char* label,     ///< [in] ラベル
+    Fmt fmt                ///< [in] メッセージを生成する関数オブジェクト
+  )
+  {
+    if ( info_msg() ) {
+      ostringstream buf;
+      fmt(buf);
+      put_info(file, line, loc, label, buf.str());
+    }
+  }
+
 
 protected:
   //////////////////////////////////////////////////////////////////////
@@ -7,6 +7,7 @@
 /// All rights reserved.
 
 #include "elaborator/ElbStubList.h"
+#include "elaborator/ElbMgr.h"
 #include "ElbStub.h"
 
 
@@ -21,10 +22,11 @@ ElbStubList::~ElbStubList()
 // @brief 末尾に要素を追加する．
 void
 ElbStubList::push_back(
-  ElbStub* elem
+  ElbStub* elem,
+  ElbUnit* unit
 )
 {
-  mList.push_back(elem);
+  mList.push_back({elem, unit});
 }
 
 // @brief 空の時 true を返す．
@@ -36,21 +38,44 @@ ElbStubList::empty() const
 
 // @brief 要素の stub を評価する．
 void
-ElbStubList::eval()
+ElbStubList::eval(
+  ElbMgr& mgr
+)
 {
-  for ( auto stub: mList ) {
-    stub->eval();
-    delete stub;
+  for ( auto& elem: mList ) {
+    auto prev_unit = mgr.set_cur_unit(elem.mUnit);
+    elem.mStub->eval();
+    mgr.set_cur_unit(prev_unit);
+    delete elem.mStub;
   }
   mList.clear();
 }
 
+// @brief unit_set に含まれるユニットの stub を削除する．
+void
+ElbStubList::remove(
+  const unordered_set<const ElbUnit*>& unit_set
+)
+{
+  SizeType wpos = 0;
+  for ( auto& elem: mList ) {
+    if ( unit_set.count(elem.mUnit) > 0 ) {
+      delete elem.mStub;
+    }
+    else {
+      mList[wpos] = elem;
+      ++ wpos;
+    }
+  }
+  mList.erase(mList.begin() + wpos, mList.end());
+}
+
 // @brief 内容を空にする．
 void
 ElbStubList::clear()
 {
-  for ( auto stub: mList ) {
-    delete stub;
+  for ( auto& elem: mList ) {
+    delete elem.mStub;
   }
   mList.clear();
 }
@@ -0,0 +1,115 @@
+
+/// @file ExprCache.cc
+/// @brief ExprCache の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2020 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ExprCache.h"
+#include "ym/pt/PtExpr.h"
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+// クラス ExprCache
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+ExprCache::ExprCache()
+{
+}
+
+// @brief デストラクタ
+ExprCache::~ExprCache()
+{
+}
+
+// @brief 式の情報を返す．
+const ExprCache::ExprInfo&
+ExprCache::expr_info(
+  const PtExpr* pt_expr
+)
+{
+  auto p = mInfoDict.find(pt_expr);
+  if ( p == mInfoDict.end() ) {
+    ExprInfo info;
+    scan_expr(pt_expr, info);
+    if ( !info.mCacheable ) {
+      info.mPrimaryList.clear();
+    }
+    p = mInfoDict.emplace(pt_expr, std::move(info)).first;
+  }
+  return p->second;
+}
+
+// @brief パース木を走査して式の情報を設定する．
+void
+ExprCache::scan_expr(
+  const PtExpr* pt_expr,
+  ExprInfo& info
+)
+{
+  switch ( pt_expr->type() ) {
+  case PtExprType::Opr:
+    {
+      SizeType n = pt_expr->operand_num();
+      for ( SizeType i = 0; i < n; ++ i ) {
+	scan_expr(pt_expr->operand(i), info);
+      }
+    }
+    break;
+
+  case PtExprType::Const:
+    break;
+
+  case PtExprType::Primary:
+    info.mPrimaryList.push_back(pt_expr);
+    break;
+
+  default:
+    // 関数呼び出しを含む式は対象外
+    info.mCacheable = false;
+    break;
+  }
+}
+
+// @brief 結果を探す．
+bool
+ExprCache::find(
+  const Key& key,
+  VlValue& val
+)
+{
+  auto p = mResultDict.find(key);
+  if ( p != mResultDict.end() ) {
+    val = p->second;
+    ++ mHitNum;
+    return true;
+  }
+  ++ mMissNum;
+  return false;
+}
+
+// @brief 結果を登録する．
+void
+ExprCache::put(
+  Key&& key,
+  const VlValue& val
+)
+{
+  mResultDict.emplace(std::move(key), val);
+}
+
+// @brief 内容をクリアする．
+void
+ExprCache::clear()
+{
+  mInfoDict.clear();
+  mResultDict.clear();
+  mHitNum = 0;
+  mMissNum = 0;
+}
+
+END_NAMESPACE_YM_VERILOG
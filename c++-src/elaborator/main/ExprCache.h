@@ -0,0 +1,200 @@
+#ifndef EXPRCACHE_H
+#define EXPRCACHE_H
+
+/// @file ExprCache.h
+/// @brief ExprCache のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2020 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/verilog.h"
+#include "ym/pt/PtP.h"
+#include "ym/VlValue.h"
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+/// @class ExprCache ExprCache.h "ExprCache.h"
+/// @brief 定数式の評価結果を保持するキャッシュ
+///
+/// 関数呼び出しを含まない定数式の値は，式の中に現れるプライマリ
+/// (パラメータや genvar の参照)の値だけで決まる．
+/// そこで式のパース木とプライマリの値のリスト(束縛)の組をキーにして
+/// 評価結果を保持する．
+/// 同じモジュールの多数のインスタンスで同じパラメータの値を用いて
+/// いる場合には範囲式やパラメータの初期値の評価が一度で済む．
+///
+/// 関数呼び出しを含む式は関数本体がパラメータを参照しうるので
+/// 対象外とする(関数の結果は FuncCache が扱う)．
+//////////////////////////////////////////////////////////////////////
+class ExprCache
+{
+public:
+
+  /// @brief 式の情報
+  struct ExprInfo
+  {
+    /// @brief キャッシュの対象の時 true
+    bool mCacheable{true};
+
+    /// @brief 式の中に現れるプライマリのリスト
+    ///
+    /// 配列のインデックスなどプライマリの内部の式は含まない．
+    vector<const PtExpr*> mPrimaryList;
+  };
+
+  /// @brief 評価結果の辞書のキー
+  struct Key
+  {
+    /// @brief 式を表すパース木
+    const PtExpr* mExpr;
+
+    /// @brief mPrimaryList の各要素の値のリスト
+    vector<VlValue> mBinding;
+  };
+
+
+public:
+
+  /// @brief コンストラクタ
+  ExprCache();
+
+  /// @brief デストラクタ
+  ~ExprCache();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 式の情報を返す．
+  ///
+  /// 初めて呼ばれた時にパース木を走査して作る．
+  const ExprInfo&
+  expr_info(
+    const PtExpr* pt_expr ///< [in] 式を表すパース木
+  );
+
+  /// @brief 結果を探す．
+  /// @retval true 見つかった．
+  /// @retval false 見つからなかった．
+  bool
+  find(
+    const Key& key, ///< [in] キー
+    VlValue& val    ///< [out] 結果
+  );
+
+  /// @brief 結果を登録する．
+  void
+  put(
+    Key&& key,         ///< [in] キー
+    const VlValue& val ///< [in] 結果
+  );
+
+  /// @brief 内容をクリアする．
+  ///
+  /// 統計情報もクリアされる．
+  void
+  clear();
+
+  /// @brief 見つかった回数を返す．
+  SizeType
+  hit_num() const
+  {
+    return mHitNum;
+  }
+
+  /// @brief 見つからなかった回数を返す．
+  SizeType
+  miss_num() const
+  {
+    return mMissNum;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // Key のハッシュ関数
+  struct KeyHash
+  {
+    SizeType
+    operator()(
+      const Key& key
+    ) const
+    {
+      SizeType h = reinterpret_cast<SizeType>(key.mExpr) / 8;
+      for ( auto& val: key.mBinding ) {
+	h = h * 97 + val.hash();
+      }
+      return h;
+    }
+  };
+
+  // Key の等価比較関数
+  struct KeyEq
+  {
+    bool
+    operator()(
+      const Key& left,
+      const Key& right
+    ) const
+    {
+      if ( left.mExpr != right.mExpr ) {
+	return false;
+      }
+      SizeType n = left.mBinding.size();
+      if ( right.mBinding.size() != n ) {
+	return false;
+      }
+      for ( SizeType i = 0; i < n; ++ i ) {
+	if ( !left.mBinding[i].is_identical(right.mBinding[i]) ) {
+	  return false;
+	}
+      }
+      return true;
+    }
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief パース木を走査して式の情報を設定する．
+  static
+  void
+  scan_expr(
+    const PtExpr* pt_expr, ///< [in] 式を表すパース木
+    ExprInfo& info         ///< [out] 式の情報
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 式の情報を保持する辞書
+  unordered_map<const PtExpr*, ExprInfo> mInfoDict;
+
+  // 評価結果を保持する辞書
+  unordered_map<Key, VlValue, KeyHash, KeyEq> mResultDict;
+
+  // 見つかった回数
+  SizeType mHitNum{0};
+
+  // 見つからなかった回数
+  SizeType mMissNum{0};
+
+};
+
+END_NAMESPACE_YM_VERILOG
+
+#endif // EXPRCACHE_H
@@ -140,6 +140,46 @@ ExprEval::evaluate_expr(
     pt_expr = pt_expr->operand0();
   }
 
+  if ( pt_expr->type() == PtExprType::Primary ) {
+    // プライマリはキャッシュしても意味がない．
+    return evaluate_primary(parent, pt_expr);
+  }
+
+  auto& info = mExprCache.expr_info(pt_expr);
+  if ( !info.mCacheable ) {
+    return evaluate_expr_sub(parent, pt_expr);
+  }
+
+  // 式の中のプライマリの値を求めてキーとする．
+  // 値が同じなら式の値も同じになる．
+  ExprCache::Key key{pt_expr, {}};
+  key.mBinding.reserve(info.mPrimaryList.size());
+  for ( auto pt_primary: info.mPrimaryList ) {
+    key.mBinding.push_back(evaluate_primary(parent, pt_primary));
+  }
+  VlValue val;
+  if ( mExprCache.find(key, val) ) {
+    return val;
+  }
+
+  val = evaluate_expr_sub(parent, pt_expr);
+  mExprCache.put(std::move(key), val);
+  return val;
+}
+
+// @brief キャッシュを用いずに式の値を評価する．
+VlValue
+ExprEval::evaluate_expr_sub(
+  const VlScope* parent,
+  const PtExpr* pt_expr
+)
+{
+  // '(' expression ')' の時の対応
+  while ( pt_expr->type() == PtExprType::Opr &&
+	  pt_expr->op_type() == VpiOpType::Null ) {
+    pt_expr = pt_expr->operand0();
+  }
+
   switch ( pt_expr->type() ) {
   case PtExprType::Opr:
     return evaluate_opr(parent, pt_expr);
@@ -173,10 +213,29 @@ ExprEval::evaluate_opr(
   auto op_type = pt_expr->op_type();
   SizeType op_size{pt_expr->operand_num()};
 
-  // オペランドの値の評価を行う．
-  vector<VlValue> val(op_size);
+  if ( op_type == VpiOpType::Concat || op_type == VpiOpType::MultiConcat ) {
+    // オペランド数が不定なのはこの二つだけ
+    vector<VlValue> val_list(op_size);
+    for ( SizeType i = 0; i < op_size; ++ i ) {
+      val_list[i] = evaluate_expr_sub(parent, pt_expr->operand(i));
+      // この演算はビットベクタ型に変換できなければならない．
+      if ( !val_list[i].is_bitvector_compat() ) {
+	ErrorGen::illegal_real_type(__FILE__, __LINE__, pt_expr->operand(i));
+      }
+    }
+    if ( op_type == VpiOpType::Concat ) {
+      return concat(val_list);
+    }
+    else {
+      return multi_concat(val_list);
+    }
+  }
+
+  // それ以外のオペランド数は高々3なので固定長の配列を用いる．
+  ASSERT_COND( op_size <= 3 );
+  VlValue val[3];
   for ( SizeType i = 0; i < op_size; ++ i ) {
-    val[i] = evaluate_expr(parent, pt_expr->operand(i));
+    val[i] = evaluate_expr_sub(parent, pt_expr->operand(i));
   }
 
   // 結果の型のチェックを行う．
@@ -203,8 +262,6 @@ ExprEval::evaluate_opr(
   case VpiOpType::ArithLShift:
   case VpiOpType::ArithRShift:
   case VpiOpType::Mod:
-  case VpiOpType::Concat:
-  case VpiOpType::MultiConcat:
     // この演算はビットベクタ型に変換できなければならない．
     for ( SizeType i = 0; i < op_size; ++ i ) {
       if ( !val[i].is_bitvector_compat() ) {
@@ -215,6 +272,7 @@ ExprEval::evaluate_opr(
 
   case VpiOpType::Plus:
   case VpiOpType::Minus:
+  case VpiOpType::Not:
   case VpiOpType::Add:
   case VpiOpType::Sub:
   case VpiOpType::Mult:
@@ -258,7 +316,7 @@ ExprEval::evaluate_opr(
     return reduction_xor(val[0]);
 
   case VpiOpType::UnaryXNor:
-    return reduction_xor(val[0]);
+    return reduction_xnor(val[0]);
 
   case VpiOpType::Plus:
     return val[0];
@@ -352,12 +410,6 @@ ExprEval::evaluate_opr(
     ASSERT_NOT_REACHED;
     break;
 
-  case VpiOpType::Concat:
-    return concat(val);
-
-  case VpiOpType::MultiConcat:
-    return multi_concat(val);
-
   default:
     ASSERT_NOT_REACHED;
     break;
@@ -657,9 +709,23 @@ ExprEval::evaluate_funccall(
     arg_list[i] = val1;
   }
 
+  // 引数のみで結果が決まる関数なら以前の結果を探す．
+  // 変数のビット幅はインスタンスごとに異なりうるのでキーに含める．
+  if ( !mFuncCodeMgr.is_self_contained(child_func) ) {
+    FuncEval eval{mFuncCodeMgr, child_func};
+    return eval(arg_list);
+  }
+
+  auto& shape = mFuncCodeMgr.decl_shape(child_func);
+  VlValue val;
+  if ( mFuncCache.find(pt_func, shape, arg_list, val) ) {
+    return val;
+  }
+
   // 関数の評価を行う．
-  FuncEval eval{child_func};
-  auto val = eval(arg_list);
+  FuncEval eval{mFuncCodeMgr, child_func};
+  val = eval(arg_list);
+  mFuncCache.put(pt_func, shape, arg_list, val);
   return val;
 }
 
@@ -12,6 +12,9 @@
 #include "ym/VlValue.h"
 #include "ym/pt/PtP.h"
 #include "ElbProxy.h"
+#include "FuncCode.h"
+#include "FuncCache.h"
+#include "ExprCache.h"
 
 
 BEGIN_NAMESPACE_YM_VERILOG
@@ -117,12 +120,52 @@ public:
     const PtExpr* pt_right ///< [in] 範囲のLSBを表すパース木
   );
 
+  /// @brief constant function の評価結果のキャッシュを返す．
+  ///
+  /// 統計情報を得るために用いる．
+  const FuncCache&
+  func_cache() const
+  {
+    return mFuncCache;
+  }
+
+  /// @brief 定数式の評価結果のキャッシュを返す．
+  ///
+  /// 統計情報を得るために用いる．
+  const ExprCache&
+  expr_cache() const
+  {
+    return mExprCache;
+  }
+
+  /// @brief constant function と定数式に関するキャッシュをクリアする．
+  ///
+  /// キャッシュは要素へのポインタをキーにしているので
+  /// ElbMgr から要素を削除した時に用いる．
+  /// 統計情報もクリアされる．
+  void
+  clear_cache()
+  {
+    mFuncCodeMgr.clear();
+    mFuncCache.clear();
+    mExprCache.clear();
+  }
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // 下請け関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief キャッシュを用いずに式の値を評価する．
+  ///
+  /// 部分式の評価にはこちらを用いる．
+  VlValue
+  evaluate_expr_sub(
+    const VlScope* parent, ///< [in] 親のスコープ
+    const PtExpr* pt_expr  ///< [in] 式を表すパース木
+  );
+
   /// @brief 演算子に対して式の値を評価する．
   VlValue
   evaluate_opr(
@@ -151,6 +194,21 @@ private:
     const PtExpr* pt_expr  ///< [in] 式を表すパース木
   );
 
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // constant function のコンパイル結果を保持するオブジェクト
+  FuncCodeMgr mFuncCodeMgr;
+
+  // constant function の評価結果のキャッシュ
+  FuncCache mFuncCache;
+
+  // 定数式の評価結果のキャッシュ
+  ExprCache mExprCache;
+
 };
 
 END_NAMESPACE_YM_VERILOG
@@ -130,6 +130,8 @@ ExprGen::instantiate_funccall(
     }
     child_func = handle->taskfunc();
     ASSERT_COND( child_func );
+    // 遅延モードでは呼び出し先の本体を作っておく．
+    elaborate_scope(child_func);
   }
 
   // 引数の生成
@@ -0,0 +1,81 @@
+
+/// @file FuncCache.cc
+/// @brief FuncCache の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2020 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "FuncCache.h"
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+// クラス FuncCache
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+FuncCache::FuncCache(
+  SizeType limit
+) : mLimit{limit}
+{
+}
+
+// @brief デストラクタ
+FuncCache::~FuncCache()
+{
+}
+
+// @brief 結果を探す．
+bool
+FuncCache::find(
+  const PtItem* pt_func,
+  const vector<int>& shape,
+  const vector<VlValue>& arg_list,
+  VlValue& val
+)
+{
+  auto p = mDict.find(pt_func);
+  if ( p != mDict.end() ) {
+    auto& result_dict = p->second;
+    auto q = result_dict.find(Key{shape, arg_list});
+    if ( q != result_dict.end() ) {
+      val = q->second;
+      ++ mHitNum;
+      return true;
+    }
+  }
+  ++ mMissNum;
+  return false;
+}
+
+// @brief 結果を登録する．
+void
+FuncCache::put(
+  const PtItem* pt_func,
+  const vector<int>& shape,
+  const vector<VlValue>& arg_list,
+  const VlValue& val
+)
+{
+  auto& result_dict = mDict[pt_func];
+  if ( result_dict.size() >= mLimit ) {
+    // 上限に達したので捨てる．
+    result_dict.clear();
+    ++ mFlushNum;
+  }
+  result_dict.emplace(Key{shape, arg_list}, val);
+}
+
+// @brief 内容をクリアする．
+void
+FuncCache::clear()
+{
+  mDict.clear();
+  mHitNum = 0;
+  mMissNum = 0;
+  mFlushNum = 0;
+}
+
+END_NAMESPACE_YM_VERILOG
@@ -0,0 +1,186 @@
+#ifndef FUNCCACHE_H
+#define FUNCCACHE_H
+
+/// @file FuncCache.h
+/// @brief FuncCache のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2020 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/verilog.h"
+#include "ym/pt/PtP.h"
+#include "ym/VlValue.h"
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+/// @class FuncCache FuncCache.h "FuncCache.h"
+/// @brief constant function の評価結果を保持するキャッシュ
+///
+/// constant function は副作用を持たないので，同じ関数を同じ引数で
+/// 呼び出せば同じ結果となる．
+/// 関数はパース木の関数定義(PtItem)で識別するので，同じモジュールの
+/// 異なるインスタンスからの呼び出しでも結果を共有できる．
+/// ただし，パラメータを参照する関数はインスタンスごとに結果が
+/// 異なりうるので登録してはいけない．
+/// また，入出力や内部変数のビット幅はインスタンスごとに異なりうるので
+/// それらを表す整数のリスト(FuncCodeMgr::decl_shape())もキーに含める．
+///
+/// 関数ごとの登録数が上限に達したらその関数の内容を捨てる．
+//////////////////////////////////////////////////////////////////////
+class FuncCache
+{
+public:
+
+  /// @brief コンストラクタ
+  FuncCache(
+    SizeType limit = 1024 ///< [in] 関数ごとの登録数の上限
+  );
+
+  /// @brief デストラクタ
+  ~FuncCache();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 結果を探す．
+  /// @retval true 見つかった．
+  /// @retval false 見つからなかった．
+  bool
+  find(
+    const PtItem* pt_func,           ///< [in] 関数定義
+    const vector<int>& shape,        ///< [in] 変数の型と範囲を表すリスト
+    const vector<VlValue>& arg_list, ///< [in] 引数のリスト
+    VlValue& val                     ///< [out] 結果
+  );
+
+  /// @brief 結果を登録する．
+  void
+  put(
+    const PtItem* pt_func,           ///< [in] 関数定義
+    const vector<int>& shape,        ///< [in] 変数の型と範囲を表すリスト
+    const vector<VlValue>& arg_list, ///< [in] 引数のリスト
+    const VlValue& val               ///< [in] 結果
+  );
+
+  /// @brief 内容をクリアする．
+  ///
+  /// 統計情報もクリアされる．
+  void
+  clear();
+
+  /// @brief 見つかった回数を返す．
+  SizeType
+  hit_num() const
+  {
+    return mHitNum;
+  }
+
+  /// @brief 見つからなかった回数を返す．
+  SizeType
+  miss_num() const
+  {
+    return mMissNum;
+  }
+
+  /// @brief 上限に達して内容を捨てた回数を返す．
+  SizeType
+  flush_num() const
+  {
+    return mFlushNum;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 一つの関数の中でのキー
+  struct Key
+  {
+    // 変数の型と範囲を表すリスト
+    vector<int> mShape;
+
+    // 引数のリスト
+    vector<VlValue> mArgList;
+  };
+
+  // キーのハッシュ関数
+  struct KeyHash
+  {
+    SizeType
+    operator()(
+      const Key& key
+    ) const
+    {
+      SizeType h = 0;
+      for ( auto v: key.mShape ) {
+	h = h * 31 + static_cast<SizeType>(v);
+      }
+      for ( auto& val: key.mArgList ) {
+	h = h * 97 + val.hash();
+      }
+      return h;
+    }
+  };
+
+  // キーの等価比較関数
+  struct KeyEq
+  {
+    bool
+    operator()(
+      const Key& left,
+      const Key& right
+    ) const
+    {
+      if ( left.mShape != right.mShape ) {
+	return false;
+      }
+      SizeType n = left.mArgList.size();
+      if ( right.mArgList.size() != n ) {
+	return false;
+      }
+      for ( SizeType i = 0; i < n; ++ i ) {
+	if ( !left.mArgList[i].is_identical(right.mArgList[i]) ) {
+	  return false;
+	}
+      }
+      return true;
+    }
+  };
+
+  // 一つの関数の結果を保持する辞書
+  using ResultDict = unordered_map<Key, VlValue, KeyHash, KeyEq>;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 関数ごとの登録数の上限
+  SizeType mLimit;
+
+  // 関数定義をキーにして結果の辞書を保持する辞書
+  unordered_map<const PtItem*, ResultDict> mDict;
+
+  // 見つかった回数
+  SizeType mHitNum{0};
+
+  // 見つからなかった回数
+  SizeType mMissNum{0};
+
+  // 内容を捨てた回数
+  SizeType mFlushNum{0};
+
+};
+
+END_NAMESPACE_YM_VERILOG
+
+#endif // FUNCCACHE_H
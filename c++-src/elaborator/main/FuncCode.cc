@@ -0,0 +1,747 @@
+
+/// @file FuncCode.cc
+/// @brief FuncCode の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2020 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "FuncCode.h"
+#include "ym/vl/VlTaskFunc.h"
+#include "ym/vl/VlIODecl.h"
+#include "ym/vl/VlDecl.h"
+#include "ym/vl/VlDeclArray.h"
+#include "ym/vl/VlStmt.h"
+#include "ym/vl/VlExpr.h"
+#include "ym/vl/VlRange.h"
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+BEGIN_NONAMESPACE
+
+// 型を表す整数を shape に加える．
+void
+add_type(
+  vector<int>& shape,
+  const VlValueType& type
+)
+{
+  shape.push_back(type.is_real_type() ? -1 : static_cast<int>(type.size()));
+  shape.push_back(type.is_signed() ? 1 : 0);
+}
+
+// 宣言要素の型と範囲を表す整数を shape に加える．
+void
+add_decl(
+  vector<int>& shape,
+  const VlDeclBase* decl
+)
+{
+  add_type(shape, decl->value_type());
+  if ( decl->has_range() ) {
+    shape.push_back(decl->left_range_val());
+    shape.push_back(decl->right_range_val());
+  }
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス FuncCode
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+FuncCode::FuncCode(
+  const VlTaskFunc* function
+) : mFunction{function}
+{
+  // 入力変数のスロットを確保する．
+  SizeType io_num{mFunction->io_num()};
+  for ( SizeType index = 0; index < io_num; ++ index ) {
+    auto io = mFunction->io(index);
+    ASSERT_COND( io->direction() == VpiDir::Input );
+    auto decl = io->decl();
+    mInputList.push_back({decl_slot(decl), type_id(decl->value_type())});
+  }
+
+  // 出力変数のスロットを確保する．
+  mOutput = decl_slot(mFunction->ovar());
+
+  // 本体のステートメントをコンパイルする．
+  // 一番外側のブロックは関数自身を表す．
+  mBlockStack.push_back(BlockInfo{nullptr, {}});
+  compile_stmt(mFunction->stmt());
+  for ( auto pos: mBlockStack.back().mJumpList ) {
+    mInstrList[pos].mA = cur_pc();
+  }
+  mBlockStack.pop_back();
+  emit(Op::Halt);
+
+  // コンパイル中にのみ用いるデータを捨てる．
+  mSlotDict.clear();
+  mArrayDict.clear();
+}
+
+// @brief デストラクタ
+FuncCode::~FuncCode()
+{
+}
+
+// @brief ステートメントをコンパイルする．
+void
+FuncCode::compile_stmt(
+  const VlStmt* stmt
+)
+{
+  switch ( stmt->type() ) {
+  case VpiObjType::Begin:
+    {
+      SizeType n{stmt->child_stmt_num()};
+      for ( SizeType i = 0; i < n; ++ i ) {
+	compile_stmt(stmt->child_stmt(i));
+      }
+    }
+    break;
+
+  case VpiObjType::NamedBegin:
+    {
+      // disable 文の飛び先となる．
+      mBlockStack.push_back(BlockInfo{stmt->scope(), {}});
+      SizeType n{stmt->child_stmt_num()};
+      for ( SizeType i = 0; i < n; ++ i ) {
+	compile_stmt(stmt->child_stmt(i));
+      }
+      for ( auto pos: mBlockStack.back().mJumpList ) {
+	mInstrList[pos].mA = cur_pc();
+      }
+      mBlockStack.pop_back();
+    }
+    break;
+
+  case VpiObjType::NullStmt:
+    // なにもしない．
+    break;
+
+  case VpiObjType::Assignment:
+    compile_assign(stmt);
+    break;
+
+  case VpiObjType::While:
+    {
+      int top = cur_pc();
+      int cond = compile_expr(stmt->expr());
+      int exit_jump = emit(Op::JumpIfFalse, cond);
+      compile_stmt(stmt->body_stmt());
+      emit(Op::Jump, top);
+      mInstrList[exit_jump].mB = cur_pc();
+    }
+    break;
+
+  case VpiObjType::Repeat:
+    {
+      // 繰り返し回数を専用のレジスタに入れて減らしていく．
+      int count = compile_int(stmt->expr());
+      int zero = const_reg(VlValue{0});
+      int one = const_reg(VlValue{1});
+      int cond = new_reg();
+      int top = cur_pc();
+      emit(Op::BinaryOp, cond, static_cast<int>(VpiOpType::Gt), count, zero);
+      int exit_jump = emit(Op::JumpIfFalse, cond);
+      compile_stmt(stmt->body_stmt());
+      emit(Op::BinaryOp, count, static_cast<int>(VpiOpType::Sub), count, one);
+      emit(Op::Jump, top);
+      mInstrList[exit_jump].mB = cur_pc();
+    }
+    break;
+
+  case VpiObjType::For:
+    {
+      compile_stmt(stmt->init_stmt());
+      int top = cur_pc();
+      int cond = compile_expr(stmt->expr());
+      int exit_jump = emit(Op::JumpIfFalse, cond);
+      compile_stmt(stmt->body_stmt());
+      compile_stmt(stmt->inc_stmt());
+      emit(Op::Jump, top);
+      mInstrList[exit_jump].mB = cur_pc();
+    }
+    break;
+
+  case VpiObjType::Forever:
+    {
+      int top = cur_pc();
+      compile_stmt(stmt->body_stmt());
+      emit(Op::Jump, top);
+    }
+    break;
+
+  case VpiObjType::If:
+    {
+      int cond = compile_expr(stmt->expr());
+      int else_jump = emit(Op::JumpIfFalse, cond);
+      compile_stmt(stmt->body_stmt());
+      mInstrList[else_jump].mB = cur_pc();
+    }
+    break;
+
+  case VpiObjType::IfElse:
+    {
+      int cond = compile_expr(stmt->expr());
+      int else_jump = emit(Op::JumpIfFalse, cond);
+      compile_stmt(stmt->body_stmt());
+      int end_jump = emit(Op::Jump);
+      mInstrList[else_jump].mB = cur_pc();
+      compile_stmt(stmt->else_stmt());
+      mInstrList[end_jump].mA = cur_pc();
+    }
+    break;
+
+  case VpiObjType::Case:
+    compile_case(stmt);
+    break;
+
+  case VpiObjType::Disable:
+    {
+      // 対象のブロックの終わりに飛ぶ．
+      // 見つからなければ関数の実行を終える．
+      auto target = stmt->target_scope();
+      int pos = emit(Op::Jump);
+      SizeType n = mBlockStack.size();
+      SizeType i = n - 1;
+      for ( ; i > 0; -- i ) {
+	if ( mBlockStack[i].mScope == target ) {
+	  break;
+	}
+      }
+      mBlockStack[i].mJumpList.push_back(pos);
+    }
+    break;
+
+  case VpiObjType::SysTaskCall:
+    // constant expression の評価時には無視される．
+    break;
+
+  default:
+    // 上記以外はエラー
+    ASSERT_NOT_REACHED;
+    break;
+  }
+}
+
+// @brief 代入文をコンパイルする．
+void
+FuncCode::compile_assign(
+  const VlStmt* stmt
+)
+{
+  ASSERT_COND( stmt->control() == nullptr );
+  ASSERT_COND( stmt->is_blocking() );
+
+  int val = compile_expr(stmt->rhs());
+
+  // lhs に val を代入する．
+  auto lhs = stmt->lhs();
+  SizeType nl{lhs->lhs_elem_num()};
+  if ( nl == 1 ) {
+    compile_lhs(lhs, val);
+  }
+  else {
+    // 左辺が連結式の場合
+    SizeType base{0};
+    for ( SizeType i = 0; i < nl; ++ i ) {
+      auto expr = lhs->lhs_elem(i);
+      SizeType w{expr->bit_size()};
+      int range = new_reg(2);
+      emit(Op::Const, range, mConstList.size());
+      mConstList.push_back(VlValue{static_cast<int>(base + w - 1)});
+      emit(Op::Const, range + 1, mConstList.size());
+      mConstList.push_back(VlValue{static_cast<int>(base)});
+      int part_val = new_reg();
+      emit(Op::PartSelect, part_val, val, range);
+      compile_lhs(expr, part_val);
+      base += w;
+    }
+  }
+}
+
+// @brief 左辺の要素への代入をコンパイルする．
+void
+FuncCode::compile_lhs(
+  const VlExpr* expr,
+  int val
+)
+{
+  // 対象が
+  // - 単独の要素
+  // - 配列要素
+  // の２通り．
+  // 代入範囲が
+  // - 要素全体
+  // - ビット選択
+  // - 範囲選択
+  // の3通りがある．
+  // 配列要素の部分的な代入は一旦要素を取り出して書き戻す．
+
+  auto decl = expr->decl_obj();
+  auto declarray = expr->declarray_obj();
+  int target;
+  int type;
+  int index = 0;
+  if ( decl ) {
+    target = decl_slot(decl);
+    type = type_id(decl->value_type());
+    if ( expr->is_primary() ) {
+      emit(Op::Assign, target, val, type);
+      return;
+    }
+  }
+  else if ( declarray ) {
+    int id = array_id(declarray);
+    index = compile_array_index(expr);
+    if ( expr->is_primary() ) {
+      emit(Op::StoreArray, id, index, val);
+      return;
+    }
+    target = new_reg();
+    type = mArrayList[id].mType;
+    emit(Op::LoadArray, target, id, index);
+  }
+  else {
+    ASSERT_NOT_REACHED;
+    return;
+  }
+
+  if ( expr->is_bitselect() ) {
+    int bit = compile_int(expr->index());
+    emit(Op::SetBit, target, bit, val, type);
+  }
+  else if ( expr->is_partselect() ) {
+    int range = new_reg(2);
+    emit(Op::Move, range, compile_int(expr->left_range()));
+    emit(Op::Move, range + 1, compile_int(expr->right_range()));
+    emit(Op::SetPart, target, range, val, type);
+  }
+  else {
+    ASSERT_NOT_REACHED;
+  }
+
+  if ( declarray ) {
+    emit(Op::StoreArray, array_id(declarray), index, target);
+  }
+}
+
+// @brief case 文をコンパイルする．
+//
+// caseitem を順番に調べ，最初に一致したものの本体を実行する．
+// ラベルは一致するものが見つかるまで順に評価する．
+// default はどこに書かれていても全ての caseitem が一致しなかった
+// 場合にのみ実行する．
+void
+FuncCode::compile_case(
+  const VlStmt* stmt
+)
+{
+  int case_type = static_cast<int>(stmt->case_type());
+  int switch_val = compile_expr(stmt->expr());
+  vector<int> end_jump_list;
+  const VlCaseItem* default_item = nullptr;
+  SizeType n = stmt->caseitem_num();
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto caseitem = stmt->caseitem(i);
+    SizeType nexp = caseitem->expr_num();
+    if ( nexp == 0 ) {
+      // default は最後に回す．
+      default_item = caseitem;
+      continue;
+    }
+
+    vector<int> body_jump_list;
+    for ( SizeType j = 0; j < nexp; ++ j ) {
+      int label_val = compile_expr(caseitem->expr(j));
+      int match = new_reg();
+      emit(Op::CaseMatch, match, case_type, switch_val, label_val);
+      body_jump_list.push_back(emit(Op::JumpIfTrue, match));
+    }
+    int next_jump = emit(Op::Jump);
+    for ( auto pos: body_jump_list ) {
+      mInstrList[pos].mB = cur_pc();
+    }
+    compile_stmt(caseitem->body_stmt());
+    end_jump_list.push_back(emit(Op::Jump));
+    mInstrList[next_jump].mA = cur_pc();
+  }
+  if ( default_item != nullptr ) {
+    compile_stmt(default_item->body_stmt());
+  }
+  for ( auto pos: end_jump_list ) {
+    mInstrList[pos].mA = cur_pc();
+  }
+}
+
+// @brief 式をコンパイルする．
+int
+FuncCode::compile_expr(
+  const VlExpr* expr
+)
+{
+  switch ( expr->type() ) {
+  case VpiObjType::Operation:   return compile_opr(expr);
+  case VpiObjType::Constant:    return const_reg(expr->constant_value());
+  case VpiObjType::FuncCall:    return compile_funccall(expr);
+  case VpiObjType::SysFuncCall: return const_reg(VlValue()); // 定数式の中では無視
+  default: // ここに来たらプライマリ系
+           // bitselect, partselect も含む．
+    return compile_primary(expr);
+  }
+  ASSERT_NOT_REACHED;
+  return 0;
+}
+
+// @brief 演算子をコンパイルする．
+int
+FuncCode::compile_opr(
+  const VlExpr* expr
+)
+{
+  SizeType n_op = expr->operand_num();
+  auto op_type = expr->op_type();
+  int dst = new_reg();
+  switch ( op_type ) {
+  case VpiOpType::Concat:
+  case VpiOpType::MultiConcat:
+    {
+      // オペランドを連続したレジスタに置く．
+      int base = new_reg(n_op);
+      for ( SizeType i = 0; i < n_op; ++ i ) {
+	emit(Op::Move, base + i, compile_expr(expr->operand(i)));
+      }
+      auto op = op_type == VpiOpType::Concat ? Op::Concat : Op::MultiConcat;
+      emit(op, dst, base, n_op);
+    }
+    return dst;
+
+  case VpiOpType::Condition:
+    {
+      int cond = compile_expr(expr->operand(0));
+      int then_val = compile_expr(expr->operand(1));
+      int else_val = compile_expr(expr->operand(2));
+      emit(Op::Condition, dst, cond, then_val, else_val);
+    }
+    return dst;
+
+  case VpiOpType::EventOr:
+  case VpiOpType::Null:
+  case VpiOpType::List:
+  case VpiOpType::MinTypMax:
+  case VpiOpType::Posedge:
+  case VpiOpType::Negedge:
+    // これらは使えない．
+    ASSERT_NOT_REACHED;
+    return dst;
+
+  default:
+    break;
+  }
+
+  if ( n_op == 1 ) {
+    int src = compile_expr(expr->operand(0));
+    emit(Op::UnaryOp, dst, static_cast<int>(op_type), src);
+  }
+  else {
+    ASSERT_COND( n_op == 2 );
+    int src1 = compile_expr(expr->operand(0));
+    int src2 = compile_expr(expr->operand(1));
+    emit(Op::BinaryOp, dst, static_cast<int>(op_type), src1, src2);
+  }
+  return dst;
+}
+
+// @brief 関数呼び出しをコンパイルする．
+int
+FuncCode::compile_funccall(
+  const VlExpr* expr
+)
+{
+  auto func = expr->function();
+
+  // 引数を連続したレジスタに置く．
+  SizeType n_io = expr->argument_num();
+  ASSERT_COND( n_io == func->io_num() );
+  int base = new_reg(n_io);
+  for ( SizeType i = 0; i < n_io; ++ i ) {
+    emit(Op::Move, base + i, compile_expr(expr->argument(i)));
+  }
+
+  int dst = new_reg();
+  emit(Op::Call, dst, mFuncList.size(), base);
+  mFuncList.push_back(func);
+  return dst;
+}
+
+// @brief プライマリをコンパイルする．
+int
+FuncCode::compile_primary(
+  const VlExpr* expr
+)
+{
+  auto decl_base = expr->decl_base();
+  if ( decl_base != nullptr &&
+       decl_base->type() == VpiObjType::Parameter &&
+       expr->is_const() ) {
+    // パラメータは定数として扱う．
+    mRefersParam = true;
+    return const_reg(expr->constant_value());
+  }
+
+  auto decl = expr->decl_obj();
+  auto declarray = expr->declarray_obj();
+  int base;
+  if ( decl ) {
+    base = decl_slot(decl);
+  }
+  else if ( declarray ) {
+    int id = array_id(declarray);
+    int index = compile_array_index(expr);
+    base = new_reg();
+    emit(Op::LoadArray, base, id, index);
+  }
+  else {
+    ASSERT_NOT_REACHED;
+    return 0;
+  }
+
+  if ( expr->is_primary() ) {
+    return base;
+  }
+
+  int dst = new_reg();
+  if ( expr->is_bitselect() ) {
+    int bit = compile_int(expr->index());
+    emit(Op::BitSelect, dst, base, bit);
+  }
+  else if ( expr->is_partselect() ) {
+    int range = new_reg(2);
+    emit(Op::Move, range, compile_int(expr->left_range()));
+    emit(Op::Move, range + 1, compile_int(expr->right_range()));
+    emit(Op::PartSelect, dst, base, range);
+  }
+  else {
+    ASSERT_NOT_REACHED;
+  }
+  return dst;
+}
+
+// @brief 式をコンパイルして整数に変換する．
+int
+FuncCode::compile_int(
+  const VlExpr* expr
+)
+{
+  int src = compile_expr(expr);
+  int dst = new_reg();
+  emit(Op::ToInt, dst, src, mExprList.size());
+  mExprList.push_back(expr);
+  return dst;
+}
+
+// @brief 配列のインデックスを連続したレジスタにコンパイルする．
+int
+FuncCode::compile_array_index(
+  const VlExpr* expr
+)
+{
+  SizeType n{expr->declarray_dimension()};
+  int base = new_reg(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    emit(Op::Move, base + i, compile_int(expr->declarray_index(i)));
+  }
+  return base;
+}
+
+// @brief 命令を追加する．
+int
+FuncCode::emit(
+  Op op,
+  int a,
+  int b,
+  int c,
+  int d
+)
+{
+  int pos = cur_pc();
+  mInstrList.push_back(Instr{op, a, b, c, d});
+  return pos;
+}
+
+// @brief 新しいレジスタを確保する．
+int
+FuncCode::new_reg(
+  SizeType n
+)
+{
+  int base = mInitFrame.size();
+  mInitFrame.resize(base + n);
+  return base;
+}
+
+// @brief 定数を値とするレジスタを作る．
+//
+// 定数は実行中に書き換えられないので初期値として持たせておく．
+int
+FuncCode::const_reg(
+  const VlValue& val
+)
+{
+  int reg = new_reg();
+  mInitFrame[reg] = val;
+  return reg;
+}
+
+// @brief 変数に対応するスロットを返す．
+int
+FuncCode::decl_slot(
+  const VlDeclBase* decl
+)
+{
+  auto p = mSlotDict.find(decl);
+  if ( p != mSlotDict.end() ) {
+    return p->second;
+  }
+
+  // 初期値は不定値とする．
+  int slot = new_reg();
+  if ( decl->value_type().is_real_type() ) {
+    mInitFrame[slot] = VlValue{0.0};
+  }
+  else {
+    mInitFrame[slot] = VlValue{BitVector(VlScalarVal::x(), decl->bit_size())};
+  }
+  mSlotDict.emplace(decl, slot);
+  add_decl(mDeclShape, decl);
+  return slot;
+}
+
+// @brief 配列の情報番号を返す．
+int
+FuncCode::array_id(
+  const VlDeclArray* declarray
+)
+{
+  auto p = mArrayDict.find(declarray);
+  if ( p != mArrayDict.end() ) {
+    return p->second;
+  }
+
+  SizeType n = declarray->array_size();
+  int base = new_reg(n);
+  VlValue init_val;
+  if ( declarray->value_type().is_real_type() ) {
+    init_val = VlValue{0.0};
+  }
+  else {
+    init_val = VlValue{BitVector(VlScalarVal::x(), declarray->bit_size())};
+  }
+  for ( SizeType i = 0; i < n; ++ i ) {
+    mInitFrame[base + i] = init_val;
+  }
+
+  add_decl(mDeclShape, declarray);
+  for ( SizeType i = 0; i < declarray->dimension(); ++ i ) {
+    auto range = declarray->range(i);
+    mDeclShape.push_back(range->left_range_val());
+    mDeclShape.push_back(range->right_range_val());
+  }
+
+  int id = mArrayList.size();
+  mArrayList.push_back(ArrayInfo{declarray, base,
+				 type_id(declarray->value_type())});
+  mArrayDict.emplace(declarray, id);
+  return id;
+}
+
+// @brief 型番号を返す．
+int
+FuncCode::type_id(
+  const VlValueType& type
+)
+{
+  SizeType n = mTypeList.size();
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( mTypeList[i] == type ) {
+      return i;
+    }
+  }
+  mTypeList.push_back(type);
+  return n;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス FuncCodeMgr
+//////////////////////////////////////////////////////////////////////
+
+// @brief 関数に対応する FuncCode を返す．
+const FuncCode&
+FuncCodeMgr::code(
+  const VlTaskFunc* function
+)
+{
+  auto p = mCodeDict.find(function);
+  if ( p == mCodeDict.end() ) {
+    auto code = new FuncCode{function};
+    p = mCodeDict.emplace(function, unique_ptr<FuncCode>{code}).first;
+  }
+  return *p->second;
+}
+
+// @brief 関数の結果が引数のみで決まる時 true を返す．
+bool
+FuncCodeMgr::is_self_contained(
+  const VlTaskFunc* function
+)
+{
+  auto p = mSelfContainedDict.find(function);
+  if ( p != mSelfContainedDict.end() ) {
+    return p->second;
+  }
+
+  // constant function は再帰呼び出しを含まないので
+  // この再帰は必ず停止する．
+  auto& func_code = code(function);
+  bool ans = !func_code.refers_param();
+  if ( ans ) {
+    for ( auto func: func_code.func_list() ) {
+      if ( !is_self_contained(func) ) {
+	ans = false;
+	break;
+      }
+    }
+  }
+  mSelfContainedDict.emplace(function, ans);
+  return ans;
+}
+
+// @brief 関数と呼び出している関数の変数の型と範囲を表す整数のリストを返す．
+const vector<int>&
+FuncCodeMgr::decl_shape(
+  const VlTaskFunc* function
+)
+{
+  auto p = mShapeDict.find(function);
+  if ( p != mShapeDict.end() ) {
+    return p->second;
+  }
+
+  auto& func_code = code(function);
+  auto shape = func_code.decl_shape();
+  for ( auto func: func_code.func_list() ) {
+    auto& shape1 = decl_shape(func);
+    shape.insert(shape.end(), shape1.begin(), shape1.end());
+  }
+  // unordered_map の要素は再ハッシュで移動しないので
+  // 返した参照は clear() まで有効．
+  return mShapeDict.emplace(function, std::move(shape)).first->second;
+}
+
+END_NAMESPACE_YM_VERILOG
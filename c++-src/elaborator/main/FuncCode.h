@@ -0,0 +1,443 @@
+#ifndef FUNCCODE_H
+#define FUNCCODE_H
+
+/// @file FuncCode.h
+/// @brief FuncCode のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2020 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/verilog.h"
+#include "ym/vl/VlFwd.h"
+#include "ym/VlValue.h"
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+/// @class FuncCode FuncCode.h "FuncCode.h"
+/// @brief constant function をコンパイルした命令列
+///
+/// 関数本体の VlStmt/VlExpr の木をレジスタ型の命令列に変換したもの．
+/// 変数(配列の場合は要素ごと)には固定のレジスタ(スロット)を割り当てる
+/// ので，実行時に辞書を引く必要はない．
+/// 式の途中結果にはそれぞれ別のレジスタを割り当てる．
+/// 再帰呼び出しはないので一つの関数に対して一つだけ作ればよい．
+///
+/// 実行は FuncEval が行う．
+//////////////////////////////////////////////////////////////////////
+class FuncCode
+{
+  friend class FuncEval;
+
+public:
+
+  /// @brief 命令の種類
+  ///
+  /// r[X] はレジスタ X を表す．
+  enum class Op {
+    Const,       ///< r[A] = 定数[B]
+    Move,        ///< r[A] = r[B]
+    Assign,      ///< r[A] = r[B] を型[C]に変換したもの
+    ToInt,       ///< r[A] = r[B] を整数に変換したもの(式[C]はエラー箇所)
+    BitSelect,   ///< r[A] = r[B][r[C]]
+    PartSelect,  ///< r[A] = r[B][r[C]:r[C + 1]]
+    SetBit,      ///< r[A][r[B]] = r[C] を行ってから型[D]に変換する．
+    SetPart,     ///< r[A][r[B]:r[B + 1]] = r[C] を行ってから型[D]に変換する．
+    LoadArray,   ///< r[A] = 配列[B][r[C], r[C + 1], ...]
+    StoreArray,  ///< 配列[A][r[B], r[B + 1], ...] = r[C]
+    UnaryOp,     ///< r[A] = 演算子[B](r[C])
+    BinaryOp,    ///< r[A] = 演算子[B](r[C], r[D])
+    Condition,   ///< r[A] = r[B] ? r[C] : r[D]
+    Concat,      ///< r[A] = {r[B], r[B + 1], ..., r[B + C - 1]}
+    MultiConcat, ///< r[A] = {r[B]{r[B + 1], ..., r[B + C - 1]}}
+    CaseMatch,   ///< r[A] = case の種類[B] で r[C] と r[D] が一致するか
+    Call,        ///< r[A] = 関数[B](r[C], r[C + 1], ...)
+    Jump,        ///< A 番目の命令に飛ぶ．
+    JumpIfFalse, ///< r[A] が真でなければ B 番目の命令に飛ぶ．
+    JumpIfTrue,  ///< r[A] が真なら B 番目の命令に飛ぶ．
+    Halt         ///< 実行を終える．
+  };
+
+  /// @brief 命令
+  struct Instr
+  {
+    Op mOp;
+    int mA;
+    int mB;
+    int mC;
+    int mD;
+  };
+
+  /// @brief 配列の情報
+  struct ArrayInfo
+  {
+    // 配列
+    const VlDeclArray* mArray;
+
+    // 先頭のスロット番号
+    int mBase;
+
+    // 要素の型番号
+    int mType;
+  };
+
+
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// function の本体をコンパイルする．
+  FuncCode(
+    const VlTaskFunc* function ///< [in] 関数
+  );
+
+  /// @brief デストラクタ
+  ~FuncCode();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 対象の関数を返す．
+  const VlTaskFunc*
+  function() const
+  {
+    return mFunction;
+  }
+
+  /// @brief レジスタ数を返す．
+  SizeType
+  reg_num() const
+  {
+    return mInitFrame.size();
+  }
+
+  /// @brief 命令列を返す．
+  const vector<Instr>&
+  instr_list() const
+  {
+    return mInstrList;
+  }
+
+  /// @brief パラメータを参照している時 true を返す．
+  ///
+  /// パラメータの値はインスタンスごとに異なりうるので，
+  /// この場合は関数の結果が引数だけでは決まらない．
+  bool
+  refers_param() const
+  {
+    return mRefersParam;
+  }
+
+  /// @brief 変数の型と範囲を表す整数のリストを返す．
+  ///
+  /// 入出力と内部変数の型と範囲はパラメータに依存しうるので，
+  /// 本体がパラメータを参照していなくても関数の結果は
+  /// インスタンスごとに異なりうる．
+  /// このリストが等しければ同じ引数に対して同じ結果となる．
+  const vector<int>&
+  decl_shape() const
+  {
+    return mDeclShape;
+  }
+
+  /// @brief 呼び出している関数のリストを返す．
+  const vector<const VlTaskFunc*>&
+  func_list() const
+  {
+    return mFuncList;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // ステートメントのコンパイル
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ステートメントをコンパイルする．
+  void
+  compile_stmt(
+    const VlStmt* stmt ///< [in] 対象のステートメント
+  );
+
+  /// @brief 代入文をコンパイルする．
+  void
+  compile_assign(
+    const VlStmt* stmt ///< [in] 対象のステートメント
+  );
+
+  /// @brief 左辺の要素への代入をコンパイルする．
+  void
+  compile_lhs(
+    const VlExpr* expr, ///< [in] 左辺式
+    int val             ///< [in] 値を持つレジスタ
+  );
+
+  /// @brief case 文をコンパイルする．
+  void
+  compile_case(
+    const VlStmt* stmt ///< [in] 対象のステートメント
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 式のコンパイル
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 式をコンパイルする．
+  /// @return 結果を持つレジスタを返す．
+  int
+  compile_expr(
+    const VlExpr* expr ///< [in] 対象の式
+  );
+
+  /// @brief 演算子をコンパイルする．
+  /// @return 結果を持つレジスタを返す．
+  int
+  compile_opr(
+    const VlExpr* expr ///< [in] 対象の式
+  );
+
+  /// @brief 関数呼び出しをコンパイルする．
+  /// @return 結果を持つレジスタを返す．
+  int
+  compile_funccall(
+    const VlExpr* expr ///< [in] 対象の式
+  );
+
+  /// @brief プライマリをコンパイルする．
+  /// @return 結果を持つレジスタを返す．
+  int
+  compile_primary(
+    const VlExpr* expr ///< [in] 対象の式
+  );
+
+  /// @brief 式をコンパイルして整数に変換する．
+  /// @return 結果を持つレジスタを返す．
+  int
+  compile_int(
+    const VlExpr* expr ///< [in] 対象の式
+  );
+
+  /// @brief 配列のインデックスを連続したレジスタにコンパイルする．
+  /// @return 先頭のレジスタを返す．
+  int
+  compile_array_index(
+    const VlExpr* expr ///< [in] 配列要素を表す式
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 下請け関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 命令を追加する．
+  /// @return 命令の番号を返す．
+  int
+  emit(
+    Op op,
+    int a = 0,
+    int b = 0,
+    int c = 0,
+    int d = 0
+  );
+
+  /// @brief 現在の命令の番号(次に追加される命令の番号)を返す．
+  int
+  cur_pc() const
+  {
+    return mInstrList.size();
+  }
+
+  /// @brief 新しいレジスタを確保する．
+  /// @return 先頭のレジスタ番号を返す．
+  int
+  new_reg(
+    SizeType n = 1 ///< [in] 連続して確保する数
+  );
+
+  /// @brief 定数を値とするレジスタを作る．
+  int
+  const_reg(
+    const VlValue& val ///< [in] 値
+  );
+
+  /// @brief 変数に対応するスロットを返す．
+  ///
+  /// なければ作る．
+  int
+  decl_slot(
+    const VlDeclBase* decl ///< [in] 変数
+  );
+
+  /// @brief 配列の情報番号を返す．
+  ///
+  /// なければ作る．
+  int
+  array_id(
+    const VlDeclArray* declarray ///< [in] 配列
+  );
+
+  /// @brief 型番号を返す．
+  int
+  type_id(
+    const VlValueType& type ///< [in] 型
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // disable 文の飛び先の情報
+  struct BlockInfo
+  {
+    // 対象のスコープ
+    // nullptr の時は関数全体を表す．
+    const VlScope* mScope;
+
+    // このブロックの終わりに飛ぶ Jump 命令のリスト
+    vector<int> mJumpList;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象の関数
+  const VlTaskFunc* mFunction;
+
+  // 命令列
+  vector<Instr> mInstrList;
+
+  // 呼び出し時のレジスタの初期値
+  vector<VlValue> mInitFrame;
+
+  // 定数のリスト
+  vector<VlValue> mConstList;
+
+  // 型のリスト
+  vector<VlValueType> mTypeList;
+
+  // エラー箇所を表す式のリスト
+  vector<const VlExpr*> mExprList;
+
+  // 配列の情報のリスト
+  vector<ArrayInfo> mArrayList;
+
+  // 呼び出される関数のリスト
+  vector<const VlTaskFunc*> mFuncList;
+
+  // 入力のスロット番号と型番号のリスト
+  vector<pair<int, int>> mInputList;
+
+  // 出力のスロット番号
+  int mOutput;
+
+  // パラメータを参照している時 true にするフラグ
+  bool mRefersParam{false};
+
+  // 変数の型と範囲を表す整数のリスト
+  vector<int> mDeclShape;
+
+  // 以下はコンパイル中のみ用いられる．
+
+  // 変数をキーにしてスロット番号を保持する辞書
+  unordered_map<const VlDeclBase*, int> mSlotDict;
+
+  // 配列をキーにして配列の情報番号を保持する辞書
+  unordered_map<const VlDeclArray*, int> mArrayDict;
+
+  // disable 文の飛び先のスタック
+  vector<BlockInfo> mBlockStack;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class FuncCodeMgr FuncCode.h "FuncCode.h"
+/// @brief FuncCode を関数ごとに一つだけ作って保持するクラス
+//////////////////////////////////////////////////////////////////////
+class FuncCodeMgr
+{
+public:
+
+  /// @brief コンストラクタ
+  FuncCodeMgr() = default;
+
+  /// @brief デストラクタ
+  ~FuncCodeMgr() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 関数に対応する FuncCode を返す．
+  ///
+  /// 初めて呼ばれた時にコンパイルする．
+  const FuncCode&
+  code(
+    const VlTaskFunc* function ///< [in] 関数
+  );
+
+  /// @brief 関数の結果が引数のみで決まる時 true を返す．
+  ///
+  /// 関数自身と呼び出している関数が全てパラメータを参照して
+  /// いない時に true となる．
+  /// 結果は関数ごとに一度だけ計算して保持する．
+  bool
+  is_self_contained(
+    const VlTaskFunc* function ///< [in] 関数
+  );
+
+  /// @brief 関数と呼び出している関数の変数の型と範囲を表す
+  ///        整数のリストを返す．
+  ///
+  /// FuncCode::decl_shape() を呼び出し順に連結したもの．
+  /// 関数ごとに一度だけ計算して保持するので，返り値の参照は
+  /// clear() が呼ばれるまで有効．
+  const vector<int>&
+  decl_shape(
+    const VlTaskFunc* function ///< [in] 関数
+  );
+
+  /// @brief 内容をクリアする．
+  void
+  clear()
+  {
+    mCodeDict.clear();
+    mSelfContainedDict.clear();
+    mShapeDict.clear();
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 関数をキーにして FuncCode を保持する辞書
+  unordered_map<const VlTaskFunc*, unique_ptr<FuncCode>> mCodeDict;
+
+  // 関数をキーにして is_self_contained() の結果を保持する辞書
+  unordered_map<const VlTaskFunc*, bool> mSelfContainedDict;
+
+  // 関数をキーにして decl_shape() の結果を保持する辞書
+  unordered_map<const VlTaskFunc*, vector<int>> mShapeDict;
+
+};
+
+END_NAMESPACE_YM_VERILOG
+
+#endif // FUNCCODE_H
@@ -9,20 +9,18 @@
 #include "FuncEval.h"
 #include "ErrorGen.h"
 #include "ym/vl/VlTaskFunc.h"
-#include "ym/vl/VlIODecl.h"
-#include "ym/vl/VlDecl.h"
 #include "ym/vl/VlDeclArray.h"
-#include "ym/vl/VlStmt.h"
 #include "ym/vl/VlExpr.h"
-#include "ym/Range.h"
 
 
 BEGIN_NAMESPACE_YM_VERILOG
 
 // @brief コンストラクタ
 FuncEval::FuncEval(
+  FuncCodeMgr& code_mgr,
   const VlTaskFunc* function
-) : mFunction{function}
+) : mCodeMgr{code_mgr},
+    mCode{code_mgr.code(function)}
 {
 }
 
@@ -37,763 +35,362 @@ FuncEval::operator()(
   const vector<VlValue>& arg_list
 )
 {
+  // レジスタを初期化する．
+  vector<VlValue> reg{mCode.mInitFrame};
+
   // 入力変数の値をセットする．
-  SizeType io_num{mFunction->io_num()};
+  SizeType io_num{mCode.mInputList.size()};
   ASSERT_COND( arg_list.size() == io_num );
-
   for ( SizeType index = 0; index < io_num; ++ index ) {
-    auto io = mFunction->io(index);
-    ASSERT_COND( io->direction() == VpiDir::Input );
-    auto decl = io->decl();
-    reg_val(decl, arg_list[index]);
+    auto& p = mCode.mInputList[index];
+    reg[p.first] = VlValue{arg_list[index], mCode.mTypeList[p.second]};
   }
 
-  // 本体のステートメントを実行する．
-  auto body = mFunction->stmt();
-  evaluate_stmt(body);
+  // 本体を実行する．
+  run(reg);
 
   // 出力結果を得る．
-  auto ovar = mFunction->ovar();
-  auto val = get_val(ovar);
-
-  return val;
+  return reg[mCode.mOutput];
 }
 
-// ステートメントを実行する．
-const VlScope*
-FuncEval::evaluate_stmt(
-  const VlStmt* stmt
-)
-{
-  // disable が実行された場合の対象のスコープ
-  const VlScope* break_scope{nullptr};
-
-  // ここでは個々のステートメント用の関数にディスパッチするだけ．
-  switch ( stmt->type() ) {
-  case VpiObjType::Begin:
-    break_scope = evaluate_seqblock(stmt);
-    break;
-
-  case VpiObjType::NamedBegin:
-    break_scope = evaluate_namedseqblock(stmt);
-    break;
-
-  case VpiObjType::NullStmt:
-    // なにもしない．
-    break;
-
-  case VpiObjType::Assignment:
-    break_scope = evaluate_assign(stmt);
-    break;
-
-  case VpiObjType::While:
-    break_scope = evaluate_while(stmt);
-    break;
-
-  case VpiObjType::Repeat:
-    break_scope = evaluate_repeat(stmt);
-    break;
-
-  case VpiObjType::For:
-    break_scope = evaluate_for(stmt);
-    break;
-
-  case VpiObjType::Forever:
-    break_scope = evaluate_forever(stmt);
-    break;
-
-  case VpiObjType::If:
-    break_scope = evaluate_if(stmt);
-    break;
-
-  case VpiObjType::IfElse:
-    break_scope = evaluate_ifelse(stmt);
-    break;
-
-  case VpiObjType::Case:
-    break_scope = evaluate_case(stmt);
-    break;
-
-  case VpiObjType::Disable:
-    break_scope = evaluate_disable(stmt);
-    break;
-
-  case VpiObjType::SysTaskCall:
-    // constant expression の評価時には無視される．
-    break;
-
-  default:
-    // 上記以外はエラー
-    ASSERT_NOT_REACHED;
-    break;
-  }
-
-  return break_scope;
-}
-
-// @brief begin-end ブロックの実行を行う．
-const VlScope*
-FuncEval::evaluate_seqblock(
-  const VlStmt* stmt
-)
-{
-  SizeType n{stmt->child_stmt_num()};
-  for ( SizeType i = 0; i < n; ++ i ) {
-    auto break_scope = evaluate_stmt(stmt->child_stmt(i));
-    if ( break_scope ) {
-      return break_scope;
-    }
-  }
-  return nullptr;
-}
-
-// @brief 名前付き begin-end ブロックの実行を行う．
-const VlScope*
-FuncEval::evaluate_namedseqblock(
-  const VlStmt* stmt
-)
-{
-  SizeType n{stmt->child_stmt_num()};
-  for ( SizeType i = 0; i < n; ++ i ) {
-    auto break_scope = evaluate_stmt(stmt->child_stmt(i));
-    if ( break_scope ) {
-      if ( break_scope == stmt->scope() ) {
-	// 自分自身のスコープの実行を終了する．
-	// 上のスコープには通常の終了として通知する．
-	break_scope = nullptr;
-      }
-      return break_scope;
-    }
-  }
-  return nullptr;
-}
-
-// @brief 代入文の実行を行う．
-const VlScope*
-FuncEval::evaluate_assign(
-  const VlStmt* stmt
-)
-{
-  ASSERT_COND( stmt->control() == nullptr );
-  ASSERT_COND( stmt->is_blocking() );
-
-  auto rhs = stmt->rhs();
-  auto val = evaluate_expr(rhs);
-
-  // lhs に val を代入する．
-  auto lhs = stmt->lhs();
-  SizeType nl{lhs->lhs_elem_num()};
-  if ( nl == 1 ) {
-    assign_value(lhs, val);
-  }
-  else {
-    // 左辺が連結式の場合
-    auto bv = val.bitvector_value();
-    SizeType base{0};
-    for ( SizeType i = 0; i < nl; ++ i ) {
-      auto expr = lhs->lhs_elem(i);
-      SizeType w{expr->bit_size()};
-      auto part_val = bv.part_select_op(base + w - 1, base);
-      assign_value(expr, VlValue(part_val));
-      base += w;
-    }
-  }
-
-  return nullptr;
-}
-
-// @brief 左辺の要素を値を代入する．
+// @brief 命令列を実行する．
 void
-FuncEval::assign_value(
-  const VlExpr* expr,
-  const VlValue& val
+FuncEval::run(
+  vector<VlValue>& reg
 )
 {
-  // 対象が
-  // - 単独の要素
-  // - 配列要素
-  // の２通り．
-  // 代入範囲が
-  // - 要素全体
-  // - ビット選択
-  // - 範囲選択
-  // の3通りがある．
-
-  auto decl = expr->decl_obj();
-  auto declarray = expr->declarray_obj();
-  if ( decl ) {
-    // 単独の要素
-    if ( expr->is_primary() ) {
-      // プライマリ
-      reg_val(decl, val);
-    }
-    else if ( expr->is_bitselect() ) {
-      // ビット選択
-      auto index_expr = expr->index();
-      int index = evaluate_int(index_expr);
-      reg_val(decl, val, index);
-    }
-    else if ( expr->is_partselect() ) {
-      // 範囲選択
-      auto left_expr = expr->left_range();
-      int left_index = evaluate_int(left_expr);
-      auto right_expr = expr->right_range();
-      int right_index = evaluate_int(right_expr);
-      reg_val(decl, val, left_index, right_index);
-    }
-  }
-  else if ( declarray ) {
-    // インデックスの値を求める．
-    SizeType n{expr->declarray_dimension()};
-    vector<int> index_array(n);
-    for ( SizeType i = 0; i < n; ++ i ) {
-      auto index_expr = expr->declarray_index(i);
-      index_array[i] = evaluate_int(index_expr);
-    }
-
-    SizeType offset;
-    bool stat = declarray->calc_array_offset(index_array, offset);
-    ASSERT_COND( stat );
-
-    if ( expr->is_primary() ) {
-      // プライマリ
-      reg_val(declarray, offset, val);
-    }
-    else if ( expr->is_bitselect() ) {
-      // ビット選択
-      auto index_expr = expr->index();
-      int index = evaluate_int(index_expr);
-      reg_val(declarray, offset, val, index);
-    }
-    else if ( expr->is_partselect() ) {
-      // 範囲選択
-      auto left_expr = expr->left_range();
-      int left_index = evaluate_int(left_expr);
-      auto right_expr{expr->right_range()};
-      int right_index = evaluate_int(right_expr);
-      reg_val(declarray, offset, val, left_index, right_index);
-    }
-  }
-}
-
-// @brief while 文の実行を行う．
-const VlScope*
-FuncEval::evaluate_while(
-  const VlStmt* stmt
-)
-{
-  auto cond_expr = stmt->expr();
-  auto body_stmt = stmt->body_stmt();
-  while ( evaluate_bool(cond_expr) ) {
-    auto break_scope = evaluate_stmt(body_stmt);
-    if ( break_scope ) {
-      return break_scope;
-    }
-  }
-  return nullptr;
-}
+  using Op = FuncCode::Op;
 
-// @brief repeat 文の実行を行う．
-const VlScope*
-FuncEval::evaluate_repeat(
-  const VlStmt* stmt
-)
-{
-  auto rep_expr = stmt->expr();
-  int rep_num = evaluate_int(rep_expr);
-  auto body_stmt = stmt->body_stmt();
-  for ( int i: Range(rep_num) ) {
-    auto break_scope = evaluate_stmt(body_stmt);
-    if ( break_scope ) {
-      return break_scope;
-    }
-  }
-  return nullptr;
-}
-
-// @brief for 文の実行を行う．
-const VlScope*
-FuncEval::evaluate_for(
-  const VlStmt* stmt
-)
-{
-  auto cond_expr = stmt->expr();
-  auto init_stmt = stmt->init_stmt();
-  auto body_stmt = stmt->body_stmt();
-  auto next_stmt = stmt->inc_stmt();
-  auto break_scope = evaluate_stmt(init_stmt);
-  if ( break_scope ) {
-    return break_scope;
-  }
-  while ( evaluate_bool(cond_expr) ) {
-    break_scope = evaluate_stmt(body_stmt);
-    if ( break_scope ) {
-      return break_scope;
-    }
-    break_scope = evaluate_stmt(next_stmt);
-    if ( break_scope ) {
-      return break_scope;
-    }
-  }
-  return nullptr;
-}
-
-// @brief forever 文の実行を行う．
-const VlScope*
-FuncEval::evaluate_forever(
-  const VlStmt* stmt
-)
-{
-  auto body_stmt = stmt->body_stmt();
+  auto& instr_list = mCode.mInstrList;
+  SizeType pc = 0;
   for ( ; ; ) {
-    auto break_scope = evaluate_stmt(body_stmt);
-    if ( break_scope ) {
-      return break_scope;
-    }
-  }
-  return nullptr;
-}
+    auto& instr = instr_list[pc];
+    ++ pc;
+    switch ( instr.mOp ) {
+    case Op::Const:
+      reg[instr.mA] = mCode.mConstList[instr.mB];
+      break;
+
+    case Op::Move:
+      reg[instr.mA] = reg[instr.mB];
+      break;
+
+    case Op::Assign:
+      reg[instr.mA] = VlValue{reg[instr.mB], mCode.mTypeList[instr.mC]};
+      break;
+
+    case Op::ToInt:
+      {
+	auto& val = reg[instr.mB];
+	if ( !val.is_int_compat() ) {
+	  auto expr = mCode.mExprList[instr.mC];
+	  ErrorGen::int_required(__FILE__, __LINE__, expr->file_region());
+	}
+	reg[instr.mA] = VlValue{val.int_value()};
+      }
+      break;
 
-// @brief if 文の実行を行う．
-const VlScope*
-FuncEval::evaluate_if(
-  const VlStmt* stmt
-)
-{
-  auto cond_expr = stmt->expr();
-  if ( evaluate_bool(cond_expr) ) {
-    auto then_stmt = stmt->body_stmt();
-    auto break_scope = evaluate_stmt(then_stmt);
-    return break_scope;
-  }
-  return nullptr;
-}
+    case Op::BitSelect:
+      {
+	auto bv = reg[instr.mB].bitvector_value();
+	int index = reg[instr.mC].int_value();
+	reg[instr.mA] = VlValue{bv.bit_select_op(index)};
+      }
+      break;
+
+    case Op::PartSelect:
+      {
+	auto bv = reg[instr.mB].bitvector_value();
+	int left = reg[instr.mC].int_value();
+	int right = reg[instr.mC + 1].int_value();
+	reg[instr.mA] = VlValue{bv.part_select_op(left, right)};
+      }
+      break;
+
+    case Op::SetBit:
+      {
+	auto& val0 = reg[instr.mA];
+	ASSERT_COND( val0.is_bitvector_compat() );
+	auto bv = val0.bitvector_value();
+	int index = reg[instr.mB].int_value();
+	bv.bit_select_op(index, reg[instr.mC].scalar_value());
+	val0 = VlValue{VlValue{bv}, mCode.mTypeList[instr.mD]};
+      }
+      break;
+
+    case Op::SetPart:
+      {
+	auto& val0 = reg[instr.mA];
+	ASSERT_COND( val0.is_bitvector_compat() );
+	auto bv = val0.bitvector_value();
+	int left = reg[instr.mB].int_value();
+	int right = reg[instr.mB + 1].int_value();
+	bv.part_select_op(left, right, reg[instr.mC].bitvector_value());
+	val0 = VlValue{VlValue{bv}, mCode.mTypeList[instr.mD]};
+      }
+      break;
 
-// @brief if-else 文の実行を行う．
-const VlScope*
-FuncEval::evaluate_ifelse(
-  const VlStmt* stmt
-)
-{
-  auto cond_expr = stmt->expr();
-  if ( evaluate_bool(cond_expr) ) {
-    auto then_stmt = stmt->body_stmt();
-    auto break_scope = evaluate_stmt(then_stmt);
-    return break_scope;
-  }
-  else {
-    auto else_stmt = stmt->else_stmt();
-    auto break_scope = evaluate_stmt(else_stmt);
-    return break_scope;
-  }
-}
+    case Op::LoadArray:
+      {
+	auto& info = mCode.mArrayList[instr.mB];
+	auto offset = array_offset(info, &reg[instr.mC]);
+	reg[instr.mA] = reg[info.mBase + offset];
+      }
+      break;
+
+    case Op::StoreArray:
+      {
+	auto& info = mCode.mArrayList[instr.mA];
+	auto offset = array_offset(info, &reg[instr.mB]);
+	reg[info.mBase + offset] = VlValue{reg[instr.mC],
+					   mCode.mTypeList[info.mType]};
+      }
+      break;
+
+    case Op::UnaryOp:
+      reg[instr.mA] = unary_op(static_cast<VpiOpType>(instr.mB),
+			       reg[instr.mC]);
+      break;
+
+    case Op::BinaryOp:
+      {
+	auto op_type = static_cast<VpiOpType>(instr.mB);
+	auto& src1 = reg[instr.mC];
+	auto& src2 = reg[instr.mD];
+	// 整数同士の場合は VlValue の演算を経由せずに計算する．
+	if ( src1.is_int() && src2.is_int() &&
+	     int_binary_op(op_type, src1.int_value(), src2.int_value(),
+			   reg[instr.mA]) ) {
+	  break;
+	}
+	reg[instr.mA] = binary_op(op_type, src1, src2);
+      }
+      break;
+
+    case Op::Condition:
+      reg[instr.mA] = ite(reg[instr.mB], reg[instr.mC], reg[instr.mD]);
+      break;
+
+    case Op::Concat:
+    case Op::MultiConcat:
+      {
+	auto begin = reg.begin() + instr.mB;
+	vector<VlValue> src_list{begin, begin + instr.mC};
+	if ( instr.mOp == Op::Concat ) {
+	  reg[instr.mA] = concat(src_list);
+	}
+	else {
+	  reg[instr.mA] = multi_concat(src_list);
+	}
+      }
+      break;
+
+    case Op::CaseMatch:
+      {
+	auto case_type = static_cast<VpiCaseType>(instr.mB);
+	auto& val = reg[instr.mC];
+	auto& label_val = reg[instr.mD];
+	VlValue eq_val;
+	if ( case_type == VpiCaseType::Exact ) {
+	  eq_val = eq(val, label_val);
+	}
+	else if ( case_type == VpiCaseType::X ) {
+	  eq_val = eq_with_x(val, label_val);
+	}
+	else if ( case_type == VpiCaseType::Z ) {
+	  eq_val = eq_with_xz(val, label_val);
+	}
+	else {
+	  ASSERT_NOT_REACHED;
+	}
+	reg[instr.mA] = eq_val;
+      }
+      break;
+
+    case Op::Call:
+      {
+	auto func = mCode.mFuncList[instr.mB];
+	auto begin = reg.begin() + instr.mC;
+	vector<VlValue> arg_list{begin, begin + func->io_num()};
+	FuncEval eval{mCodeMgr, func};
+	reg[instr.mA] = eval(arg_list);
+      }
+      break;
 
-// @brief case 文の実行を行う．
-const VlScope*
-FuncEval::evaluate_case(
-  const VlStmt* stmt
-)
-{
-  auto case_type = stmt->case_type();
-  auto expr = stmt->expr();
-  auto switch_val = evaluate_expr(expr);
-  SizeType n = stmt->caseitem_num();
-  for ( SizeType i = 0; i < n; ++ i ) {
-    auto caseitem{stmt->caseitem(i)};
-    if ( match(case_type, switch_val, caseitem) ) {
-      auto body = caseitem->body_stmt();
-      auto break_scope = evaluate_stmt(body);
-      return break_scope;
-    }
-  }
-  return nullptr;
-}
+    case Op::Jump:
+      pc = instr.mA;
+      break;
 
-// @brief caseitem のラベルと一致するか調べる．
-bool
-FuncEval::match(
-  VpiCaseType case_type,
-  const VlValue& val,
-  const VlCaseItem* caseitem
-)
-{
-  SizeType nexp = caseitem->expr_num();
-  if ( nexp == 0 ) {
-    // default なのでマッチする．
-    return true;
-  }
+    case Op::JumpIfFalse:
+      if ( !reg[instr.mA].logic_value().to_bool() ) {
+	pc = instr.mB;
+      }
+      break;
 
-  for ( SizeType i = 0; i < nexp; ++ i ) {
-    auto label_expr = caseitem->expr(i);
-    auto label_val = evaluate_expr(label_expr);
-    VlValue eq_val;
-    if ( case_type == VpiCaseType::Exact ) {
-      eq_val = eq(val, label_val);
-    }
-    else if ( case_type == VpiCaseType::X ) {
-      eq_val = eq_with_x(val, label_val);
-    }
-    else if ( case_type == VpiCaseType::Z ) {
-      eq_val = eq_with_xz(val, label_val);
-    }
-    else {
-      ASSERT_NOT_REACHED;
+    case Op::JumpIfTrue:
+      if ( reg[instr.mA].logic_value().to_bool() ) {
+	pc = instr.mB;
+      }
+      break;
+
+    case Op::Halt:
+      return;
     }
-    return eq_val.logic_value().to_bool();
   }
-  return false;
 }
 
-// @brief disable 文の実行を行う．
-const VlScope*
-FuncEval::evaluate_disable(
-  const VlStmt* stmt
-)
-{
-  return stmt->target_scope();
-}
-
-// @brief 式の評価を行う．
+// @brief 単項演算を行う．
 VlValue
-FuncEval::evaluate_expr(
-  const VlExpr* expr
+FuncEval::unary_op(
+  VpiOpType op_type,
+  const VlValue& src
 )
 {
-  switch ( expr->type() ) {
-  case VpiObjType::Operation:   return evaluate_opr(expr);
-  case VpiObjType::Constant:    return evaluate_const(expr);
-  case VpiObjType::FuncCall:    return evaluate_funccall(expr);
-  case VpiObjType::SysFuncCall: return VlValue(); // 定数式の中では無視
-  default: // ここに来たらプライマリ系
-           // bitselect, partselect も馥府．
-    return evaluate_primary(expr);
+  // ほとんど VlValue の該当の関数を呼び出すだけ．
+  switch ( op_type ) {
+  case VpiOpType::Minus:      return - src;
+  case VpiOpType::Plus:       return src;
+  case VpiOpType::Not:        return log_not(src);
+  case VpiOpType::BitNeg:     return bit_negate(src);
+  case VpiOpType::UnaryAnd:   return reduction_and(src);
+  case VpiOpType::UnaryNand:  return reduction_nand(src);
+  case VpiOpType::UnaryOr:    return reduction_or(src);
+  case VpiOpType::UnaryNor:   return reduction_nor(src);
+  case VpiOpType::UnaryXor:   return reduction_xor(src);
+  case VpiOpType::UnaryXNor:  return reduction_xnor(src);
+  default:
+    break;
   }
   ASSERT_NOT_REACHED;
   return VlValue();
 }
 
-// @brief 演算子に対して式の値を評価する．
+// @brief 二項演算を行う．
 VlValue
-FuncEval::evaluate_opr(
-  const VlExpr* expr
+FuncEval::binary_op(
+  VpiOpType op_type,
+  const VlValue& src1,
+  const VlValue& src2
 )
 {
-  SizeType n_op = expr->operand_num();
-  // オペランドの値を評価する．
-  vector<VlValue> opr_vals(n_op);
-  for ( SizeType i = 0; i < n_op; ++ i ) {
-    opr_vals[i] = evaluate_expr(expr->operand(i));
-  }
-
   // ほとんど VlValue の該当の関数を呼び出すだけ．
-  switch ( expr->op_type() ) {
-  case VpiOpType::Minus:
-    return - opr_vals[0];
-  case VpiOpType::Plus:
-    return opr_vals[0];
-  case VpiOpType::Not:
-    return log_not(opr_vals[0]);
-  case VpiOpType::BitNeg:
-    return bit_negate(opr_vals[0]);
-  case VpiOpType::UnaryAnd:
-    return reduction_and(opr_vals[0]);
-  case VpiOpType::UnaryNand:
-    return reduction_nand(opr_vals[0]);
-  case VpiOpType::UnaryOr:
-    return reduction_or(opr_vals[0]);
-  case VpiOpType::UnaryNor:
-    return reduction_nor(opr_vals[0]);
-  case VpiOpType::UnaryXor:
-    return reduction_xor(opr_vals[0]);
-  case VpiOpType::UnaryXNor:
-    return reduction_xnor(opr_vals[0]);
-  case VpiOpType::Sub:
-    return opr_vals[0] - opr_vals[1];
-  case VpiOpType::Div:
-    return opr_vals[0] / opr_vals[1];
-  case VpiOpType::Mod:
-    return opr_vals[0] % opr_vals[1];
-  case VpiOpType::Eq:
-    return eq(opr_vals[0], opr_vals[1]);
-  case VpiOpType::Neq:
-    return ne(opr_vals[0], opr_vals[1]);
-  case VpiOpType::CaseEq:
-    return eq_with_x(opr_vals[0], opr_vals[1]);
-  case VpiOpType::CaseNeq:
-    return log_not(eq_with_x(opr_vals[0], opr_vals[1]));
-  case VpiOpType::Gt:
-    return gt(opr_vals[0], opr_vals[1]);
-  case VpiOpType::Ge:
-    return ge(opr_vals[0], opr_vals[1]);
-  case VpiOpType::Lt:
-    return lt(opr_vals[0], opr_vals[1]);
-  case VpiOpType::Le:
-    return le(opr_vals[0], opr_vals[1]);
-  case VpiOpType::LShift:
-    return opr_vals[0] << opr_vals[1];
-  case VpiOpType::RShift:
-    return opr_vals[0] >> opr_vals[1];
-  case VpiOpType::Add:
-    return opr_vals[0] + opr_vals[1];
-  case VpiOpType::Mult:
-    return opr_vals[0] * opr_vals[1];
-  case VpiOpType::LogAnd:
-    return log_and(opr_vals[0], opr_vals[1]);
-  case VpiOpType::LogOr:
-    return log_or(opr_vals[0], opr_vals[1]);
-  case VpiOpType::BitAnd:
-    return bit_and(opr_vals[0], opr_vals[1]);
-  case VpiOpType::BitOr:
-    return bit_or(opr_vals[0], opr_vals[1]);
-  case VpiOpType::BitXor:
-    return bit_xor(opr_vals[0], opr_vals[1]);
-  case VpiOpType::BitXNor:
-    return bit_xnor(opr_vals[0], opr_vals[1]);
-  case VpiOpType::Condition:
-    return ite(opr_vals[0], opr_vals[1], opr_vals[2]);
-  case VpiOpType::Concat:
-    return concat(opr_vals);
-  case VpiOpType::MultiConcat:
-    return multi_concat(opr_vals);
-  case VpiOpType::ArithLShift:
-    // 算術左シフトは普通の左シフトと同じ
-    return opr_vals[0] << opr_vals[1];
-  case VpiOpType::ArithRShift:
-    return arshift(opr_vals[0], opr_vals[1]);
-  case VpiOpType::Power:
-    return power(opr_vals[0], opr_vals[1]);
-
-  case VpiOpType::EventOr:
-  case VpiOpType::Null:
-  case VpiOpType::List:
-  case VpiOpType::MinTypMax:
-  case VpiOpType::Posedge:
-  case VpiOpType::Negedge:
-    // これらは使えない．
-    ASSERT_NOT_REACHED;
-    return VlValue();
-  }
-}
-
-// @brief 定数に対して式の値を評価する．
-VlValue
-FuncEval::evaluate_const(
-  const VlExpr* expr
-)
-{
-  return expr->constant_value();
-}
-
-// @brief プライマリに対して式の値を評価する．
-VlValue
-FuncEval::evaluate_primary(
-  const VlExpr* expr
-)
-{
-  auto decl = expr->decl_obj();
-  auto declarray = expr->declarray_obj();
-  VlValue base_val;
-  if ( decl ) {
-    base_val = get_val(decl);
-  }
-  else if ( declarray ) {
-    // インデックスの値を求める．
-    SizeType n = expr->declarray_dimension();
-    vector<int> index_array(n);
-    for ( SizeType i = 0; i < n; ++ i ) {
-      auto index_expr = expr->declarray_index(i);
-      index_array[i] = evaluate_int(index_expr);
-    }
-
-    SizeType offset;
-    bool stat = declarray->calc_array_offset(index_array, offset);
-    ASSERT_COND( stat );
-
-    base_val = get_val(declarray, offset);
-  }
-  else {
-    ASSERT_NOT_REACHED;
-  }
-
-  if ( expr->is_primary() ) {
-    return base_val;
-  }
-  else if ( expr->is_bitselect() ) {
-    auto index_expr = expr->index();
-    int index = evaluate_int(index_expr);
-    auto bv = base_val.bitvector_value();
-    return VlValue(bv.bit_select_op(index));
-  }
-  else if ( expr->is_partselect() ) {
-    auto left_expr = expr->left_range();
-    int left_index = evaluate_int(left_expr);
-    auto right_expr = expr->right_range();
-    int right_index = evaluate_int(right_expr);
-    auto bv = base_val.bitvector_value();
-    return VlValue(bv.part_select_op(left_index, right_index));
+  switch ( op_type ) {
+  case VpiOpType::Sub:         return src1 - src2;
+  case VpiOpType::Div:         return src1 / src2;
+  case VpiOpType::Mod:         return src1 % src2;
+  case VpiOpType::Eq:          return eq(src1, src2);
+  case VpiOpType::Neq:         return ne(src1, src2);
+  case VpiOpType::CaseEq:      return eq_with_x(src1, src2);
+  case VpiOpType::CaseNeq:     return log_not(eq_with_x(src1, src2));
+  case VpiOpType::Gt:          return gt(src1, src2);
+  case VpiOpType::Ge:          return ge(src1, src2);
+  case VpiOpType::Lt:          return lt(src1, src2);
+  case VpiOpType::Le:          return le(src1, src2);
+  case VpiOpType::LShift:      return src1 << src2;
+  case VpiOpType::RShift:      return src1 >> src2;
+  case VpiOpType::Add:         return src1 + src2;
+  case VpiOpType::Mult:        return src1 * src2;
+  case VpiOpType::LogAnd:      return log_and(src1, src2);
+  case VpiOpType::LogOr:       return log_or(src1, src2);
+  case VpiOpType::BitAnd:      return bit_and(src1, src2);
+  case VpiOpType::BitOr:       return bit_or(src1, src2);
+  case VpiOpType::BitXor:      return bit_xor(src1, src2);
+  case VpiOpType::BitXNor:     return bit_xnor(src1, src2);
+  // 算術左シフトは普通の左シフトと同じ
+  case VpiOpType::ArithLShift: return src1 << src2;
+  case VpiOpType::ArithRShift: return arshift(src1, src2);
+  case VpiOpType::Power:       return power(src1, src2);
+  default:
+    break;
   }
-
   ASSERT_NOT_REACHED;
   return VlValue();
 }
 
-// @brief 関数呼び出しに対して式の値を評価する．
-VlValue
-FuncEval::evaluate_funccall(
-  const VlExpr* expr
+// @brief 整数同士の二項演算を行う．
+//
+// 結果は VlValue の演算と同じになるものだけを扱う．
+bool
+FuncEval::int_binary_op(
+  VpiOpType op_type,
+  int src1,
+  int src2,
+  VlValue& result
 )
 {
-  auto func = expr->function();
-
-  // 引数の値を評価する．
-  SizeType n_io = expr->argument_num();
-  ASSERT_COND( n_io == func->io_num() );
-  vector<VlValue> arg_list(n_io);
-  for ( SizeType i = 0; i < n_io; ++ i ) {
-    arg_list[i] = evaluate_expr(expr->argument(i));
-  }
+  // 桁あふれの時の振る舞いを規定するために符号なしで計算する．
+  auto usrc1 = static_cast<unsigned int>(src1);
+  auto usrc2 = static_cast<unsigned int>(src2);
+  auto one = VlScalarVal::one();
+  auto zero = VlScalarVal::zero();
+  switch ( op_type ) {
+  case VpiOpType::Add:
+    result.set(static_cast<int>(usrc1 + usrc2));
+    return true;
 
-  FuncEval eval{func};
-  return eval(arg_list);
-}
+  case VpiOpType::Sub:
+    result.set(static_cast<int>(usrc1 - usrc2));
+    return true;
 
-// @brief 式を評価して整数値を返す．
-int
-FuncEval::evaluate_int(
-  const VlExpr* expr
-)
-{
-  auto val = evaluate_expr(expr);
-  if ( !val.is_int_compat() ) {
-    ErrorGen::int_required(__FILE__, __LINE__, expr->file_region());
-  }
-  return val.int_value();
-}
+  case VpiOpType::Mult:
+    result.set(static_cast<int>(usrc1 * usrc2));
+    return true;
 
-// @brief 式を評価して整数値を返す．
-bool
-FuncEval::evaluate_bool(
-  const VlExpr* expr
-)
-{
-  auto val = evaluate_expr(expr);
-  return val.logic_value().to_bool();
-}
+  case VpiOpType::Eq:
+  case VpiOpType::CaseEq:
+    result.set(src1 == src2 ? one : zero);
+    return true;
 
-// @brief 値を登録する．
-void
-FuncEval::reg_val(
-  const VlDeclBase* obj,
-  const VlValue& val
-)
-{
-  reg_val(obj, 0, val);
-}
+  case VpiOpType::Neq:
+  case VpiOpType::CaseNeq:
+    result.set(src1 != src2 ? one : zero);
+    return true;
 
-// @brief 値を登録する．
-void
-FuncEval::reg_val(
-  const VlDeclBase* obj,
-  SizeType offset,
-  const VlValue& val
-)
-{
-  Key key{obj, offset};
-  mValMap.emplace(key, val);
-}
+  case VpiOpType::Lt:
+    result.set(src1 < src2 ? one : zero);
+    return true;
 
-// @brief 値を登録する．
-void
-FuncEval::reg_val(
-  const VlDeclBase* obj,
-  const VlValue& val,
-  int index
-)
-{
-  reg_val(obj, 0, val, index);
-}
+  case VpiOpType::Le:
+    result.set(src1 <= src2 ? one : zero);
+    return true;
 
-// @brief 値を登録する．
-void
-FuncEval::reg_val(
-  const VlDeclBase* obj,
-  SizeType offset,
-  const VlValue& val,
-  int index
-)
-{
-  Key key{obj, offset};
-  BitVector bv;
-  if ( mValMap.count(key) > 0 ) {
-    auto val0 = mValMap.at(key);
-    ASSERT_COND( val0.is_bitvector_compat() );
-    bv = val0.bitvector_value();
-  }
-  else {
-    bv = BitVector(VlScalarVal::x(), obj->bit_size());
-  }
+  case VpiOpType::Gt:
+    result.set(src1 > src2 ? one : zero);
+    return true;
 
-  auto sv = val.scalar_value();
-  bv.bit_select_op(index, sv);
-  mValMap.emplace(key, VlValue(bv));
-}
+  case VpiOpType::Ge:
+    result.set(src1 >= src2 ? one : zero);
+    return true;
 
-// @brief 値を登録する．
-void
-FuncEval::reg_val(
-  const VlDeclBase* obj,
-  const VlValue& val,
-  int left,
-  int right
-)
-{
-  reg_val(obj, 0, val, left, right);
+  default:
+    break;
+  }
+  return false;
 }
 
-// @brief 値を登録する．
-void
-FuncEval::reg_val(
-  const VlDeclBase* obj,
-  SizeType offset,
-  const VlValue& val,
-  int left,
-  int right
+// @brief 配列のオフセットを計算する．
+SizeType
+FuncEval::array_offset(
+  const FuncCode::ArrayInfo& info,
+  const VlValue* index_list
 )
 {
-  Key key{obj, offset};
-  BitVector bv;
-  if ( mValMap.count(key) > 0 ) {
-    auto val0 = mValMap.at(key);
-    ASSERT_COND( val0.is_bitvector_compat() );
-    bv = val0.bitvector_value();
+  auto declarray = info.mArray;
+  SizeType n = declarray->dimension();
+  SizeType offset;
+  if ( n == 1 ) {
+    bool stat = declarray->calc_array_offset(index_list[0].int_value(), offset);
+    ASSERT_COND( stat );
   }
   else {
-    bv = BitVector(VlScalarVal::x(), obj->bit_size());
+    vector<int> index_array(n);
+    for ( SizeType i = 0; i < n; ++ i ) {
+      index_array[i] = index_list[i].int_value();
+    }
+    bool stat = declarray->calc_array_offset(index_array, offset);
+    ASSERT_COND( stat );
   }
-
-  bv.part_select_op(left, right, val.bitvector_value());
-  mValMap.emplace(key, VlValue(bv));
-}
-
-// @brief 値を取り出す．
-VlValue
-FuncEval::get_val(
-  const VlDeclBase* obj
-)
-{
-  return get_val(obj, 0);
-}
-
-// @brief 値を取り出す．
-VlValue
-FuncEval::get_val(
-  const VlDeclBase* obj,
-  SizeType offset
-)
-{
-  Key key{obj, offset};
-  ASSERT_COND( mValMap.count(key) > 0 );
-  return mValMap.at(key);
+  return offset;
 }
 
 END_NAMESPACE_YM_VERILOG
@@ -65,6 +65,18 @@ public:
     const PtItem* pt_function ///< [in] 関数定義
   );
 
+  /// @brief 一つの module instance の生成を行う．
+  ///
+  /// インスタンスごとに ElbMgr のユニットを作る．
+  /// 配列型の場合は phase1 の処理として登録するだけ．
+  void
+  phase1_module_inst(
+    const VlScope* parent,    ///< [in] 親のスコープ
+    const PtItem* pt_head,    ///< [in] ヘッダ
+    const PtInst* pt_inst,    ///< [in] インスタンス定義
+    const PtModule* pt_module ///< [in] モジュールの構文木要素
+  );
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -139,9 +151,9 @@ private:
   /// @brief cell instance の生成を行う．
   void
   phase1_cell(
-    const VlScope* parent, ///< [in] 親のスコープ
-    const PtItem* pt_head, ///< [in] ヘッダ
-    ClibCell cell          ///< [in] セル番号
+    const VlScope* parent,    ///< [in] 親のスコープ
+    const PtItem* pt_head,    ///< [in] ヘッダ
+    const CellInfo* cell_info ///< [in] セルの情報
   );
 
   /// @brief module array のインスタンス化を行う．
@@ -187,9 +199,9 @@ private:
   /// @brief セル instance の生成を行う
   void
   instantiate_cell(
-    const VlScope* parent, ///< [in] 親のスコープ
-    const PtItem* pt_head, ///< [in] ヘッダ
-    ClibCell cell          ///< [in] セル
+    const VlScope* parent,    ///< [in] 親のスコープ
+    const PtItem* pt_head,    ///< [in] ヘッダ
+    const CellInfo* cell_info ///< [in] セルの情報
   );
 
   /// @brief gate delay の生成を行う
@@ -224,14 +236,16 @@ private:
   void
   link_cell_array(
     ElbPrimArray* prim_array, ///< [in] プリミティブ配列
-    const PtInst* pt_inst     ///< [in]インスタンス定義
+    const PtInst* pt_inst,    ///< [in]インスタンス定義
+    const CellInfo* cell_info ///< [in] セルの情報
   );
 
   /// @brief cell instance で使われている式の名前解決を行う．
   void
   link_cell(
-    ElbPrimitive* primitive, ///< [in] プリミティブ配列
-    const PtInst* pt_inst    ///< [in] インスタンス定義
+    ElbPrimitive* primitive,  ///< [in] プリミティブ配列
+    const PtInst* pt_inst,    ///< [in] インスタンス定義
+    const CellInfo* cell_info ///< [in] セルの情報
   );
 
   /// @brief generate block を実際にインスタンス化を行う．
@@ -79,16 +79,16 @@ ItemGen::phase1_item(
 
     case PtItemType::ContAssign:
       // phase3 で処理する．
-      add_phase3stub(make_stub(this, &ItemGen::instantiate_cont_assign,
-			       parent, pt_item));
+      add_phase3stub(parent, make_stub(this, &ItemGen::instantiate_cont_assign,
+				       parent, pt_item));
       break;
 
     case PtItemType::Initial:
     case PtItemType::Always:
       phase1_stmt(parent, pt_item->body());
       // 本体の生成は phase3 で処理する．
-      add_phase3stub(make_stub(this, &ItemGen::instantiate_process,
-			       parent, pt_item));
+      add_phase3stub(parent, make_stub(this, &ItemGen::instantiate_process,
+				       parent, pt_item));
       break;
 
     case PtItemType::Task:
@@ -192,19 +192,20 @@ ItemGen::defparam_override(
     return true;
   }
 
+  // 部分的に作り直す時のために書き換えたことを記録する．
+  mgr().reg_override(param->parent_scope());
+
   auto pt_rhs_expr = pt_defparam->expr();
   auto value = evaluate_expr(module, pt_rhs_expr);
 
-  {
-    ostringstream buf;
-    buf << "instantiating defparam: " << param->full_name()
-	<< " = " << pt_rhs_expr->decompile() << ".";
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    pt_defparam->file_region(),
-		    MsgType::Info,
-		    "ELAB",
-		    buf.str());
-  }
+  put_info_lazy(__FILE__, __LINE__,
+		pt_defparam->file_region(),
+		"ELAB",
+		[&](ostream& s) {
+		  s << "instantiating defparam: ";
+		  param->write_full_name(s);
+		  s << " = " << pt_rhs_expr->decompile() << ".";
+		});
 
   param->set_init_expr(pt_rhs_expr, value);
 
@@ -244,16 +245,13 @@ ItemGen::instantiate_cont_assign(
 
       auto ca = mgr().new_ContAssign(ca_head, pt_elem, lhs, rhs);
 
-      {
-	ostringstream buf;
-	buf << "instantiating continuous assign: "
-	    << lhs->decompile() << " = " << rhs->decompile() << ".";
-	MsgMgr::put_msg(__FILE__, __LINE__,
-			pt_elem->file_region(),
-			MsgType::Info,
-			"ELAB",
-			buf.str());
-      }
+      put_info_lazy(__FILE__, __LINE__,
+		    pt_elem->file_region(),
+		    "ELAB",
+		    [&](ostream& s) {
+		      s << "instantiating continuous assign: "
+			<< lhs->decompile() << " = " << rhs->decompile() << ".";
+		    });
     }
     catch ( const ElbError& error ) {
       put_error(error);
@@ -428,6 +426,10 @@ ItemGen::phase1_genfor(
   }
   genvar->set_value(init_val);
 
+  // 先に genvar の値の列を求めておく．
+  // 終了条件と増分の式は genvar と定数しか参照できないので
+  // ブロックの中身を生成する前に評価しても結果は変わらない．
+  vector<int> gvi_list;
   for ( ; ; ) {
     // 終了条件のチェック
     auto pt_cond_expr = pt_genfor->expr();
@@ -436,25 +438,28 @@ ItemGen::phase1_genfor(
       break;
     }
 
-    // スコープ名生成のために genvar の値を取得
-    {
-      int gvi = genvar->value();
-      auto genblock = mgr().new_GfBlock(parent, pt_genfor, gvi);
-      gfroot->add(gvi, genblock);
-
-      auto pt_item = genvar->pt_item();
-      auto genvar1 = mgr().new_Genvar(genblock, pt_item, gvi);
-
-      phase1_generate(genblock, pt_genfor);
-    }
+    gvi_list.push_back(genvar->value());
 
     // genvar の増加分の処理．
     auto pt_next_expr = pt_genfor->next_expr();
     int next_val = evaluate_int(parent, pt_next_expr);
     if ( next_val < 0 ) {
       ErrorGen::genvar_negative(__FILE__, __LINE__, pt_genfor);
-      genvar->set_value(next_val);
     }
+    genvar->set_value(next_val);
+  }
+
+  // 子供のスコープの領域をまとめて確保する．
+  gfroot->reserve(gvi_list.size());
+  for ( auto gvi: gvi_list ) {
+    genvar->set_value(gvi);
+    auto genblock = mgr().new_GfBlock(parent, pt_genfor, gvi);
+    gfroot->add(gvi, genblock);
+
+    auto pt_item = genvar->pt_item();
+    auto genvar1 = mgr().new_Genvar(genblock, pt_item, gvi);
+
+    phase1_generate(genblock, pt_genfor);
   }
 }
 
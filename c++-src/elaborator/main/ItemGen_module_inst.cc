@@ -10,6 +10,7 @@
 #include "ElbEnv.h"
 #include "ElbParamCon.h"
 #include "ErrorGen.h"
+#include "ElbError.h"
 
 #include "ym/BitVector.h"
 
@@ -59,9 +60,9 @@ ItemGen::phase1_muheader(
   }
 
   // 正式な仕様にはないが，セルライブラリを探す．
-  auto cell = find_cell(defname);
-  if ( cell.is_valid() ) {
-    phase1_cell(parent, pt_head, cell);
+  auto cell_info = find_cell(defname);
+  if ( cell_info ) {
+    phase1_cell(parent, pt_head, cell_info);
     return;
   }
 
@@ -83,48 +84,72 @@ ItemGen::phase1_module(
   }
 
   for ( auto pt_inst: pt_head->inst_list() ) {
-    auto name = pt_inst->name();
-    if ( name == nullptr ) {
-      // 名無しのモジュールインスタンスはない
-      ErrorGen::noname_module(__FILE__, __LINE__, pt_inst);
-    }
+    phase1_module_inst(parent, pt_head, pt_inst, pt_module);
+  }
+}
 
-    auto pt_left = pt_inst->left_range();
-    auto pt_right = pt_inst->right_range();
-    if ( pt_left && pt_right ) {
-      // 配列型は今すぐにはインスタンス化できない．
-      add_phase1stub(make_stub(this, &ItemGen::phase1_module_array,
-			       parent, pt_module, pt_head, pt_inst));
-    }
-    else {
-      // 単一の要素
-      auto module1 = mgr().new_Module(parent,
-				      pt_module,
-				      pt_head,
-				      pt_inst);
+// @brief 一つの module instance の生成を行う．
+void
+ItemGen::phase1_module_inst(
+  const VlScope* parent,
+  const PtItem* pt_head,
+  const PtInst* pt_inst,
+  const PtModule* pt_module
+)
+{
+  auto name = pt_inst->name();
+  if ( name == nullptr ) {
+    // 名無しのモジュールインスタンスはない
+    ErrorGen::noname_module(__FILE__, __LINE__, pt_inst);
+  }
 
-      // attribute instance の生成
-      auto attr_list = attribute_list(pt_module, pt_head);
-      mgr().reg_attr(module1, attr_list);
-
-      {
-	ostringstream buf;
-	buf << "\"" << module1->full_name() << "\" has been created.";
-	MsgMgr::put_msg(__FILE__, __LINE__,
-			pt_inst->file_region(),
-			MsgType::Info,
-			"ELAB",
-			buf.str());
-      }
+  // このインスタンスで生成される要素は専用のユニットが所有する．
+  auto unit = mgr().new_unit(parent, pt_module, pt_head, pt_inst);
+  auto prev_unit = mgr().set_cur_unit(unit);
+
+  auto pt_left = pt_inst->left_range();
+  auto pt_right = pt_inst->right_range();
+  if ( pt_left && pt_right ) {
+    // 配列型は今すぐにはインスタンス化できない．
+    add_phase1stub(make_stub(this, &ItemGen::phase1_module_array,
+			     parent, pt_module, pt_head, pt_inst));
+    mgr().set_cur_unit(prev_unit);
+    return;
+  }
 
-      // パラメータ割り当て式の生成
-      auto param_con_list = gen_param_con_list(parent, pt_head);
-      phase1_module_item(module1, pt_module, param_con_list);
+  // 単一の要素
+  try {
+    auto module1 = mgr().new_Module(parent,
+				    pt_module,
+				    pt_head,
+				    pt_inst);
 
-      add_phase3stub(make_stub(this, &ItemGen::link_module,
-			       module1, pt_module, pt_inst));
-    }
+    // attribute instance の生成
+    auto attr_list = attribute_list(pt_module, pt_head);
+    mgr().reg_attr(module1, attr_list);
+
+    put_info_lazy(__FILE__, __LINE__,
+		  pt_inst->file_region(),
+		  "ELAB",
+		  [&](ostream& s) {
+		    s << "\"";
+		    module1->write_full_name(s);
+		    s << "\" has been created.";
+		  });
+
+    // パラメータ割り当て式の生成
+    auto param_con_list = gen_param_con_list(parent, pt_head);
+    phase1_module_item(module1, pt_module, param_con_list);
+
+    add_phase3stub(parent, make_stub(this, &ItemGen::link_module,
+				     module1, pt_module, pt_inst));
   }
+  catch ( const ElbError& error ) {
+    // 他のインスタンスの処理は続ける．
+    pt_module->reset_in_use();
+    put_error(error);
+  }
+  mgr().set_cur_unit(prev_unit);
 }
 
 // @brief module array のインスタンス化を行う．
@@ -152,19 +177,16 @@ ItemGen::phase1_module_array(
 					    pt_left, pt_right,
 					    left_val, right_val);
 
-  {
-    ostringstream buf;
-    buf << "instantiating module array \"" << name << "\" of \""
-	<< defname << "\" [" << left_val << " : " << right_val << "].";
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    pt_head->file_region(),
-		    MsgType::Info,
-		    "ELAB",
-		    buf.str());
-  }
+  put_info_lazy(__FILE__, __LINE__,
+		pt_head->file_region(),
+		"ELAB",
+		[&](ostream& s) {
+		  s << "instantiating module array \"" << name << "\" of \""
+		    << defname << "\" [" << left_val << " : " << right_val << "].";
+		});
 
-  add_phase3stub(make_stub(this, &ItemGen::link_module_array,
-			   module_array, pt_module, pt_inst));
+  add_phase3stub(parent, make_stub(this, &ItemGen::link_module_array,
+				   module_array, pt_module, pt_inst));
 
   // パラメータ割り当て式の生成
   auto param_con_list = gen_param_con_list(parent, pt_head);
@@ -173,15 +195,14 @@ ItemGen::phase1_module_array(
   for ( SizeType i = 0; i < n; ++ i ) {
     auto module = module_array->elem(i);
 
-    {
-      ostringstream buf;
-      buf << "\"" << module->full_name() << "\" has been created.";
-      MsgMgr::put_msg(__FILE__, __LINE__,
-		      module_array->file_region(),
-		      MsgType::Info,
-		      "ELAB",
-		      buf.str());
-    }
+    put_info_lazy(__FILE__, __LINE__,
+		  module_array->file_region(),
+		  "ELAB",
+		  [&](ostream& s) {
+		    s << "\"";
+		    module->write_full_name(s);
+		    s << "\" has been created.";
+		  });
 
     // モジュール要素を作る．
     phase1_module_item(module, pt_module, param_con_list);
@@ -220,7 +241,7 @@ void
 ItemGen::phase1_cell(
   const VlScope* parent,
   const PtItem* pt_head,
-  ClibCell cell
+  const CellInfo* cell_info
 )
 {
   // この場合, parameter 割り当てリストは空でなければならない．
@@ -231,7 +252,7 @@ ItemGen::phase1_cell(
 
   // 今すぐには処理できないのでキューに積む．
   add_phase2stub(make_stub(this, &ItemGen::instantiate_cell,
-			   parent, pt_head, cell));
+			   parent, pt_head, cell_info));
 }
 
 // @brief module array instance の入出力端子の接続を行う．
@@ -356,7 +377,7 @@ ItemGen::link_module_array(
 	    tmp1 = mgr().new_BitSelect(pt_expr, tmp, i);
 	  }
 	  else {
-	    int lsb = i;
+	    int lsb = i * port_size;
 	    int msb = lsb + port_size - 1;
 	    tmp1 = mgr().new_PartSelect(pt_expr, tmp, msb, lsb);
 	  }
@@ -392,9 +413,9 @@ ItemGen::link_module_array(
 	// 0番目のモジュールがLSB側になる．
 	for ( SizeType i = 0; i < module_size; ++ i ) {
 	  auto module = module_array->elem(i);
-	  int index1 = i * port_size;
-	  int index2 = index2 + port_size - 1;
-	  auto expr1 = mgr().new_PartSelect(pt_expr, tmp, index1, index2);
+	  int lsb = i * port_size;
+	  int msb = lsb + port_size - 1;
+	  auto expr1 = mgr().new_PartSelect(pt_expr, tmp, msb, lsb);
 	  module->set_port_high_conn(index, expr1, conn_by_name);
 	}
       }
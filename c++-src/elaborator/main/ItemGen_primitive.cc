@@ -9,6 +9,7 @@
 #include "ItemGen.h"
 #include "ElbEnv.h"
 #include "ErrorGen.h"
+#include "CellCache.h"
 
 #include "ym/BitVector.h"
 
@@ -16,9 +17,6 @@
 #include "ym/pt/PtExpr.h"
 #include "ym/pt/PtMisc.h"
 
-#include "ym/ClibCell.h"
-#include "ym/ClibPin.h"
-
 #include "elaborator/ElbUdp.h"
 #include "elaborator/ElbPrimitive.h"
 #include "elaborator/ElbExpr.h"
@@ -62,8 +60,8 @@ ItemGen::instantiate_gateheader(
   bool has_delay = (pt_delay != nullptr);
   auto prim_head = mgr().new_PrimHead(parent, pt_head, has_delay);
   if ( has_delay ) {
-    add_phase3stub(make_stub(this, &ItemGen::link_gate_delay,
-			     prim_head, pt_delay));
+    add_phase3stub(parent, make_stub(this, &ItemGen::link_gate_delay,
+				     prim_head, pt_delay));
   }
 
   for ( auto pt_inst: pt_head->inst_list() ) {
@@ -107,18 +105,16 @@ ItemGen::instantiate_gateheader(
       auto attr_list = attribute_list(pt_head);
       mgr().reg_attr(prim_array, attr_list);
 
-      {
-	ostringstream buf;
-	buf << "instantiating primitive array: " << prim_array->full_name();
-	MsgMgr::put_msg(__FILE__, __LINE__,
-			fr,
-			MsgType::Info,
-			"ELAB",
-			buf.str());
-      }
+      put_info_lazy(__FILE__, __LINE__,
+		    fr,
+		    "ELAB",
+		    [&](ostream& s) {
+		      s << "instantiating primitive array: ";
+		      prim_array->write_full_name(s);
+		    });
 
-      add_phase3stub(make_stub(this, &ItemGen::link_prim_array,
-			       prim_array, pt_inst));
+      add_phase3stub(parent, make_stub(this, &ItemGen::link_prim_array,
+				       prim_array, pt_inst));
     }
     else {
       // 単一の要素の場合
@@ -128,18 +124,16 @@ ItemGen::instantiate_gateheader(
       auto attr_list = attribute_list(pt_head);
       mgr().reg_attr(prim, attr_list);
 
-      {
-	ostringstream buf;
-	buf << "instantiating primitive: " << prim->full_name();
-	MsgMgr::put_msg(__FILE__, __LINE__,
-			fr,
-			MsgType::Info,
-			"ELAB",
-			buf.str());
-      }
+      put_info_lazy(__FILE__, __LINE__,
+		    fr,
+		    "ELAB",
+		    [&](ostream& s) {
+		      s << "instantiating primitive: ";
+		      prim->write_full_name(s);
+		    });
 
-      add_phase3stub(make_stub(this, &ItemGen::link_primitive,
-			       prim, pt_inst));
+      add_phase3stub(parent, make_stub(this, &ItemGen::link_primitive,
+				       prim, pt_inst));
     }
   }
 }
@@ -160,8 +154,8 @@ ItemGen::instantiate_udpheader(
 				     udpdefn,
 				     has_delay);
   if ( has_delay ) {
-    add_phase3stub(make_stub(this, &ItemGen::link_udp_delay,
-			     prim_head, pt_head));
+    add_phase3stub(parent, make_stub(this, &ItemGen::link_udp_delay,
+				     prim_head, pt_head));
   }
 
   for ( auto pt_inst: pt_head->inst_list() ) {
@@ -190,8 +184,8 @@ ItemGen::instantiate_udpheader(
       auto attr_list = attribute_list(pt_head);
       mgr().reg_attr(prim_array, attr_list);
 
-      add_phase3stub(make_stub(this, &ItemGen::link_prim_array,
-			       prim_array, pt_inst));
+      add_phase3stub(parent, make_stub(this, &ItemGen::link_prim_array,
+				       prim_array, pt_inst));
     }
     else {
       // 単一の要素
@@ -201,8 +195,8 @@ ItemGen::instantiate_udpheader(
       auto attr_list = attribute_list(pt_head);
       mgr().reg_attr(primitive, attr_list);
 
-      add_phase3stub(make_stub(this, &ItemGen::link_primitive,
-			       primitive, pt_inst));
+      add_phase3stub(parent, make_stub(this, &ItemGen::link_primitive,
+				       primitive, pt_inst));
     }
   }
 }
@@ -212,10 +206,10 @@ void
 ItemGen::instantiate_cell(
   const VlScope* parent,
   const PtItem* pt_head,
-  ClibCell cell
+  const CellInfo* cell_info
 )
 {
-  auto prim_head = mgr().new_CellHead(parent, pt_head, cell);
+  auto prim_head = mgr().new_CellHead(parent, pt_head, cell_info->cell());
   for ( auto pt_inst: pt_head->inst_list() ) {
     // ポート数のチェックを行う．
     SizeType port_num = pt_inst->port_num();
@@ -223,14 +217,13 @@ ItemGen::instantiate_cell(
       // 名前による結合
       for ( auto pt_con: pt_inst->port_list() ) {
 	auto pin_name = pt_con->name();
-	auto pin = cell.pin(pin_name);
-	if ( pin.is_invalid() ) {
+	if ( cell_info->pin_id(pin_name) == cell_info->pin_num() ) {
 	  ErrorGen::illegal_pin_name(__FILE__, __LINE__, pt_con);
 	}
       }
     }
     else {
-      if ( cell.pin_num() != port_num ) {
+      if ( cell_info->pin_num() != port_num ) {
 	ErrorGen::port_num_mismatch(__FILE__, __LINE__, pt_inst);
       }
     }
@@ -243,28 +236,31 @@ ItemGen::instantiate_cell(
       int left_val;
       int right_val;
       tie(left_val, right_val) = evaluate_range(parent, pt_left, pt_right);
-      auto prim_array = mgr().new_PrimitiveArray(prim_head,
-						 pt_inst,
-						 pt_left, pt_right,
-						 left_val, right_val);
+      auto prim_array = mgr().new_CellPrimitiveArray(prim_head,
+						     cell_info->dir_list(),
+						     pt_inst,
+						     pt_left, pt_right,
+						     left_val, right_val);
 
       // attribute instance の生成
       auto attr_list = attribute_list(pt_head);
       mgr().reg_attr(prim_array, attr_list);
 
-      add_phase3stub(make_stub(this, &ItemGen::link_cell_array,
-			       prim_array, pt_inst));
+      add_phase3stub(parent, make_stub(this, &ItemGen::link_cell_array,
+				       prim_array, pt_inst, cell_info));
     }
     else {
       // 単一の要素
-      auto primitive = mgr().new_Primitive(prim_head, pt_inst);
+      auto primitive = mgr().new_CellPrimitive(prim_head,
+					       cell_info->dir_list(),
+					       pt_inst);
 
       // attribute instance の生成
       auto attr_list = attribute_list(pt_head);
       mgr().reg_attr(primitive, attr_list);
 
-      add_phase3stub(make_stub(this, &ItemGen::link_cell,
-			       primitive, pt_inst));
+      add_phase3stub(parent, make_stub(this, &ItemGen::link_cell,
+				       primitive, pt_inst, cell_info));
     }
   }
 }
@@ -434,31 +430,26 @@ ItemGen::link_primitive(
 void
 ItemGen::link_cell_array(
   ElbPrimArray* prim_array,
-  const PtInst* pt_inst
+  const PtInst* pt_inst,
+  const CellInfo* cell_info
 )
 {
   auto parent = prim_array->parent_scope();
   SizeType arraysize = prim_array->elem_num();
 
-  // ポートの情報を得るために先頭の要素を取り出す．
-  auto prim = prim_array->elem_by_offset(0);
-
   // YACC の文法から一つでも named_con なら全部そう
   bool conn_by_name = (pt_inst->port(0)->name() != nullptr);
 
-  auto cell = prim->cell();
-
   ElbEnv env1;
   ElbNetLhsEnv env2(env1);
   SizeType pos{0};
   for ( auto pt_con: pt_inst->port_list() ) {
-    int index;
+    SizeType index;
     if ( conn_by_name ) {
-      auto pin = cell.pin(pt_con->name());
-      if ( pin.is_invalid() ) {
+      index = cell_info->pin_id(pt_con->name());
+      if ( index == cell_info->pin_num() ) {
 	ErrorGen::illegal_pin_name(__FILE__, __LINE__, pt_con);
       }
-      index = pin.pin_id();
     }
     else {
       index = pos;
@@ -470,9 +461,8 @@ ItemGen::link_cell_array(
       ErrorGen::empty_port_expression(__FILE__, __LINE__, pt_con);
     }
 
-    auto term = prim->prim_term(index);
     ElbExpr* tmp{nullptr};
-    if ( term->direction() == VpiDir::Input ) {
+    if ( cell_info->pin_dir(index) == VpiDir::Input ) {
       // 入力に接続するのは通常の右辺式
       tmp = instantiate_expr(parent, env1, pt_expr);
     }
@@ -522,7 +512,8 @@ ItemGen::link_cell_array(
 void
 ItemGen::link_cell(
   ElbPrimitive* primitive,
-  const PtInst* pt_inst
+  const PtInst* pt_inst,
+  const CellInfo* cell_info
 )
 {
   auto parent = primitive->parent_scope();
@@ -530,19 +521,16 @@ ItemGen::link_cell(
   // YACC の文法から一つでも named_con なら全部そう
   bool conn_by_name = (pt_inst->port(0)->name() != nullptr);
 
-  auto cell = primitive->cell();
-
   ElbEnv env1;
   ElbNetLhsEnv env2(env1);
   SizeType pos{0};
   for ( auto pt_con: pt_inst->port_list() ) {
     SizeType index;
     if ( conn_by_name ) {
-      auto pin = cell.pin(pt_con->name());
-      if ( pin.is_invalid() ) {
+      index = cell_info->pin_id(pt_con->name());
+      if ( index == cell_info->pin_num() ) {
 	ErrorGen::illegal_pin_name(__FILE__, __LINE__, pt_con);
       }
-      index = pin.pin_id();
     }
     else {
       index = pos;
@@ -554,9 +542,8 @@ ItemGen::link_cell(
       continue;
     }
 
-    auto term = primitive->prim_term(index);
     ElbExpr* tmp{nullptr};
-    if ( term->direction() == VpiDir::Input ) {
+    if ( cell_info->pin_dir(index) == VpiDir::Input ) {
       // 入力に接続するのは通常の右辺式
       tmp = instantiate_expr(parent, env1, pt_expr);
     }
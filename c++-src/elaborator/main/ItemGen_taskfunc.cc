@@ -80,15 +80,14 @@ ItemGen::phase1_tf(
   auto attr_list = attribute_list(pt_item);
   mgr().reg_attr(taskfunc, attr_list);
 
-  {
-    ostringstream buf;
-    buf << "instantiating task/func : " << taskfunc->full_name() << ".";
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    pt_item->file_region(),
-		    MsgType::Info,
-		    "ELAB",
-		    buf.str());
-  }
+  put_info_lazy(__FILE__, __LINE__,
+		pt_item->file_region(),
+		"ELAB",
+		[&](ostream& s) {
+		  s << "instantiating task/func : ";
+		  taskfunc->write_full_name(s);
+		  s << ".";
+		});
 
   // 本体のステートメント内部のスコープの生成
   auto pt_body = pt_item->body();
@@ -96,7 +95,7 @@ ItemGen::phase1_tf(
 
   // 残りの仕事は phase2, phase3 で行う．
   add_phase2stub(make_stub(this, &ItemGen::phase2_tf, taskfunc, pt_item));
-  add_phase3stub(make_stub(this, &ItemGen::phase3_tf, taskfunc, pt_item));
+  add_phase3stub(parent, make_stub(this, &ItemGen::phase3_tf, taskfunc, pt_item));
 
   if ( debug ) {
     dout << "phase1_tf end" << endl
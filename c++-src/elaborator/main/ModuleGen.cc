@@ -55,15 +55,16 @@ ModuleGen::phase1_topmodule(
   const auto& file_region = pt_module->file_region();
   auto name = pt_module->name();
 
-  {
-    ostringstream buf;
-    buf << "instantiating top module \"" << name << "\".";
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    file_region,
-		    MsgType::Info,
-		    "ELAB",
-		    buf.str());
-  }
+  put_info_lazy(__FILE__, __LINE__,
+		file_region,
+		"ELAB",
+		[&](ostream& s) {
+		  s << "instantiating top module \"" << name << "\".";
+		});
+
+  // このインスタンスで生成される要素は専用のユニットが所有する．
+  auto unit = mgr().new_unit(toplevel, pt_module, nullptr, nullptr);
+  auto prev_unit = mgr().set_cur_unit(unit);
 
   // モジュール本体の生成
   auto module = mgr().new_Module(toplevel,
@@ -75,18 +76,19 @@ ModuleGen::phase1_topmodule(
   const auto& attr_list = attribute_list(pt_module);
   mgr().reg_attr(module, attr_list);
 
-  {
-    ostringstream buf;
-    buf << "module \"" << module->full_name() << "\" has been created.";
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    file_region,
-		    MsgType::Info,
-		    "ELAB",
-		    buf.str());
-  }
+  put_info_lazy(__FILE__, __LINE__,
+		file_region,
+		"ELAB",
+		[&](ostream& s) {
+		  s << "module \"";
+		  module->write_full_name(s);
+		  s << "\" has been created.";
+		});
 
   // 中身のうちスコープに関係する要素の生成
   phase1_module_item(module, pt_module, vector<ElbParamCon>());
+
+  mgr().set_cur_unit(prev_unit);
 }
 
 // @brief module の中身のうちスコープに関係する要素のインスタンス化をする．
@@ -125,17 +125,6 @@ ObjHandle::genvar() const
   return nullptr;
 }
 
-// @brief ハッシュ値を返す．
-SizeType
-ObjHandle::hash() const
-{
-  SizeType h = 0;
-  for ( auto c: name() ) {
-    h = h * 37 + static_cast<SizeType>(c);
-  }
-  return ((reinterpret_cast<PtrIntType>(parent_scope()) * h) >> 8);
-}
-
 
 //////////////////////////////////////////////////////////////////////
 // クラス ElbScopeHandle
@@ -183,60 +172,18 @@ ElbScopeHandle::full_name() const
   return mObj->full_name();
 }
 
-// @brief VlScope を返す．
-const VlScope*
-ElbScopeHandle::scope() const
+// @brief 対象のオブジェクトを返す．
+const VlNamedObj*
+ElbScopeHandle::namedobj() const
 {
   return mObj;
 }
 
-
-//////////////////////////////////////////////////////////////////////
-// クラス KeyObjHandle
-//////////////////////////////////////////////////////////////////////
-
-// @brief コンストラクタ
-KeyObjHandle::KeyObjHandle(
-  const VlScope* parent,
-  const string& name
-) : mParent{parent},
-    mName{name}
-{
-}
-
-// @brief 親のスコープを返す．
+// @brief VlScope を返す．
 const VlScope*
-KeyObjHandle::parent_scope() const
-{
-  return mParent;
-}
-
-// @brief オブジェクトの名前を返す．
-string
-KeyObjHandle::name() const
-{
-  return mName;
-}
-
-// @brief オブジェクトの型を返す．
-VpiObjType
-KeyObjHandle::type() const
-{
-  return VpiObjType::Scope; // 嘘
-}
-
-// @brief ファイル位置の取得
-FileRegion
-KeyObjHandle::file_region() const
-{
-  return FileRegion();
-}
-
-// @brief オブジェクトの階層付き名前を返す．
-string
-KeyObjHandle::full_name() const
+ElbScopeHandle::scope() const
 {
-  return string();
+  return mObj;
 }
 
 
@@ -279,6 +226,13 @@ NamedObjHandle::full_name() const
   return _namedobj()->full_name();
 }
 
+// @brief 対象のオブジェクトを返す．
+const VlNamedObj*
+NamedObjHandle::namedobj() const
+{
+  return _namedobj();
+}
+
 
 //////////////////////////////////////////////////////////////////////
 // クラス ElbTaskFuncHandle
@@ -560,7 +514,7 @@ ElbGenvarHandle::_namedobj() const
 
 
 //////////////////////////////////////////////////////////////////////
-// VlNamedObj を格納するハッシュ表
+// VlNamedObj を格納する辞書
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
@@ -578,10 +532,24 @@ ObjDict::~ObjDict()
 void
 ObjDict::clear()
 {
-  for ( auto handle: mHash ) {
-    delete handle;
+  for ( auto& p: mTableDict ) {
+    auto& table = p.second;
+    SizeType n = table.elem_num();
+    for ( SizeType i = 0; i < n; ++ i ) {
+      delete table.elem(i);
+    }
   }
-  mHash.clear();
+  mTableDict.clear();
+  mNameSet.clear();
+  mNamePool.clear();
+  mFrozen = false;
+}
+
+// @brief 検索用の表をすべて作り，以降の変更を禁止する．
+void
+ObjDict::freeze()
+{
+  mFrozen = true;
 }
 
 // @brief 要素を追加する．
@@ -783,14 +751,81 @@ ObjDict::add_handle(
   ObjHandle* handle
 )
 {
-  mHash.emplace(handle);
+  // freeze() 後は他のスレッドが参照しているかもしれない．
+  ASSERT_COND( !mFrozen );
+
+  auto name = intern(handle->name());
+  mTableDict[handle->parent_scope()].add(name, handle);
+}
+
+// @brief 名前を登録して格納場所を返す．
+const char*
+ObjDict::intern(
+  const string& name
+)
+{
+  auto p = mNameSet.find(name);
+  if ( p != mNameSet.end() ) {
+    return p->data();
+  }
+  mNamePool.push_back(name);
+  string_view name1{mNamePool.back()};
+  mNameSet.emplace(name1);
+  return name1.data();
+}
+
+// @brief 登録されている名前の格納場所を返す．
+const char*
+ObjDict::find_name(
+  string_view name
+) const
+{
+  auto p = mNameSet.find(name);
+  if ( p != mNameSet.end() ) {
+    return p->data();
+  }
+  return nullptr;
+}
+
+// @brief 要素を削除する．
+void
+ObjDict::remove(
+  const unordered_set<const VlScope*>& scope_set,
+  const unordered_set<const VlScope*>& parent_set,
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  for ( auto scope: scope_set ) {
+    auto p = mTableDict.find(scope);
+    if ( p == mTableDict.end() ) {
+      continue;
+    }
+    auto& table = p->second;
+    SizeType n = table.elem_num();
+    for ( SizeType i = 0; i < n; ++ i ) {
+      delete table.elem(i);
+    }
+    mTableDict.erase(p);
+  }
+  for ( auto parent: parent_set ) {
+    auto p = mTableDict.find(parent);
+    if ( p == mTableDict.end() ) {
+      continue;
+    }
+    auto& table = p->second;
+    table.remove(obj_set);
+    if ( table.elem_num() == 0 ) {
+      mTableDict.erase(p);
+    }
+  }
+  mFrozen = false;
 }
 
 // @brief 名前から該当する要素を検索する．
 ObjHandle*
 ObjDict::find(
   const VlScope* parent,
-  const string& name
+  string_view name
 ) const
 {
   if ( debug & debug_find_scope ) {
@@ -801,15 +836,22 @@ ObjDict::find(
 	 << "] )" << endl << endl;
   }
 
-  KeyObjHandle key{parent, name};
-  auto p = mHash.find(&key);
-  if ( p != mHash.end() ) {
+  ObjHandle* handle = nullptr;
+  // どのスコープにも現れない名前は登録されていない．
+  auto name1 = find_name(name);
+  if ( name1 != nullptr ) {
+    auto p = mTableDict.find(parent);
+    if ( p != mTableDict.end() ) {
+      handle = p->second.find(name1);
+    }
+  }
+  if ( handle != nullptr ) {
     if ( debug & debug_find_scope ) {
       DOUT << "--> Found"
 	   << endl << endl;
     }
 
-    return *p;
+    return handle;
   }
   else {
     if ( debug & debug_find_scope ) {
@@ -821,4 +863,132 @@ ObjDict::find(
   }
 }
 
+//////////////////////////////////////////////////////////////////////
+// クラス ObjDict::ScopeTable
+//////////////////////////////////////////////////////////////////////
+
+BEGIN_NONAMESPACE
+
+// 表を作らずに線形探索を行う要素数の上限
+const SizeType LINEAR_LIMIT = 8;
+
+END_NONAMESPACE
+
+// @brief 要素を追加する．
+void
+ObjDict::ScopeTable::add(
+  const char* name,
+  ObjHandle* handle
+)
+{
+  SizeType pos = mList.size();
+  mList.push_back({name, handle});
+  if ( mTable.empty() ) {
+    if ( mList.size() > LINEAR_LIMIT ) {
+      // それまでの要素からまとめて表を作る．
+      build(LINEAR_LIMIT * 4);
+    }
+    return;
+  }
+  if ( mList.size() * 2 > mTable.size() ) {
+    // 使用率を 1/2 以下に保つ．
+    build(mTable.size() * 2);
+  }
+  else {
+    insert(pos);
+  }
+}
+
+// @brief obj_set に含まれる要素を削除する．
+void
+ObjDict::ScopeTable::remove(
+  const unordered_set<const VlObj*>& obj_set
+)
+{
+  SizeType wpos = 0;
+  for ( auto& elem: mList ) {
+    if ( obj_set.count(elem.mHandle->namedobj()) > 0 ) {
+      delete elem.mHandle;
+    }
+    else {
+      mList[wpos] = elem;
+      ++ wpos;
+    }
+  }
+  if ( wpos == mList.size() ) {
+    return;
+  }
+  mList.erase(mList.begin() + wpos, mList.end());
+
+  // 位置が変わったので表を作り直す．
+  if ( mList.size() > LINEAR_LIMIT ) {
+    SizeType size = LINEAR_LIMIT * 4;
+    while ( mList.size() * 2 > size ) {
+      size *= 2;
+    }
+    build(size);
+  }
+  else {
+    mTable.clear();
+  }
+}
+
+// @brief 名前から該当する要素を検索する．
+ObjHandle*
+ObjDict::ScopeTable::find(
+  const char* name
+) const
+{
+  if ( mTable.empty() ) {
+    for ( auto& elem: mList ) {
+      if ( elem.mName == name ) {
+	return elem.mHandle;
+      }
+    }
+    return nullptr;
+  }
+
+  SizeType mask = mTable.size() - 1;
+  for ( SizeType h = hash_pos(name); mTable[h] != 0; h = (h + 1) & mask ) {
+    auto& elem = mList[mTable[h] - 1];
+    if ( elem.mName == name ) {
+      return elem.mHandle;
+    }
+  }
+  return nullptr;
+}
+
+// @brief 表の大きさを size にして全要素を入れ直す．
+void
+ObjDict::ScopeTable::build(
+  SizeType size
+)
+{
+  mTable.clear();
+  mTable.resize(size, 0);
+  SizeType n = mList.size();
+  for ( SizeType pos = 0; pos < n; ++ pos ) {
+    insert(pos);
+  }
+}
+
+// @brief mList の pos 番目の要素を表に入れる．
+//
+// 同名の要素がある場合には先に追加されたものを残す．
+void
+ObjDict::ScopeTable::insert(
+  SizeType pos
+)
+{
+  auto name = mList[pos].mName;
+  SizeType mask = mTable.size() - 1;
+  SizeType h = hash_pos(name);
+  for ( ; mTable[h] != 0; h = (h + 1) & mask ) {
+    if ( mList[mTable[h] - 1].mName == name ) {
+      return;
+    }
+  }
+  mTable[h] = pos + 1;
+}
+
 END_NAMESPACE_YM_VERILOG
@@ -13,65 +13,6 @@
 
 BEGIN_NAMESPACE_YM_VERILOG
 
-//////////////////////////////////////////////////////////////////////
-/// @class KeyObjHandle KeyObjHandle.h "KeyObjHandle.h"
-/// @brief 検索用のキーを表すクラス
-//////////////////////////////////////////////////////////////////////
-class KeyObjHandle :
-  public ObjHandle
-{
-public:
-
-  /// @brief コンストラクタ
-  KeyObjHandle(
-    const VlScope* parent, ///< [in] 親のスコープ
-    const string& name     ///< [in] 名前
-  );
-
-  /// @brief デストラクタ
-  ~KeyObjHandle() = default;
-
-
-public:
-  //////////////////////////////////////////////////////////////////////
-  // 外部インターフェイス
-  //////////////////////////////////////////////////////////////////////
-
-  /// @brief 親のスコープを返す．
-  const VlScope*
-  parent_scope() const override;
-
-  /// @brief オブジェクトの名前を返す．
-  string
-  name() const override;
-
-  /// @brief オブジェクトの型を返す．
-  VpiObjType
-  type() const override;
-
-  /// @brief ファイル位置の取得
-  FileRegion
-  file_region() const override;
-
-  /// @brief オブジェクトの階層付き名前を返す．
-  string
-  full_name() const override;
-
-
-private:
-  //////////////////////////////////////////////////////////////////////
-  // データメンバ
-  //////////////////////////////////////////////////////////////////////
-
-  // 親のスコープ
-  const VlScope* mParent;
-
-  // 名前
-  string mName;
-
-};
-
-
 //////////////////////////////////////////////////////////////////////
 /// @class ElbScopeHandle
 //////////////////////////////////////////////////////////////////////
@@ -111,6 +52,10 @@ public:
   string
   full_name() const override;
 
+  /// @brief 対象のオブジェクトを返す．
+  const VlNamedObj*
+  namedobj() const override;
+
   /// @brief VlScope を返す．
   const VlScope*
   scope() const override;
@@ -158,6 +103,10 @@ public:
   string
   full_name() const override;
 
+  /// @brief 対象のオブジェクトを返す．
+  const VlNamedObj*
+  namedobj() const override;
+
   /// @brief ハッシュ値を返す．
   SizeType
   hash() const;
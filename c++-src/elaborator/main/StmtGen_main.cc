@@ -390,6 +390,8 @@ StmtGen::instantiate_enable(
 
   auto task = handle->taskfunc();
   ASSERT_COND( task != nullptr );
+  // 遅延モードでは呼び出し先の本体を作っておく．
+  elaborate_scope(task);
 
   // 引数を生成する．
   vector<ElbExpr*> arg_list;
@@ -51,15 +51,12 @@ UdpGen::instantiate_udp(
   const auto& file_region = pt_udp->file_region();
   auto def_name = pt_udp->name();
 
-  {
-    ostringstream buf;
-    buf << "instantiating UDP \"" << def_name << "\".";
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    file_region,
-		    MsgType::Info,
-		    "ELAB",
-		    buf.str());
-  }
+  put_info_lazy(__FILE__, __LINE__,
+		file_region,
+		"ELAB",
+		[&](ostream& s) {
+		  s << "instantiating UDP \"" << def_name << "\".";
+		});
 
   SizeType io_size = pt_udp->port_num();
 
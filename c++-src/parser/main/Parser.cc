@@ -79,11 +79,20 @@ Parser::read_file(
     return false;
   }
 
+  mPtMgr.begin_file(filename);
   int stat = yyparse(*this);
+  mPtMgr.end_file();
 
   return (stat == 0);
 }
 
+// @brief read_file() でオープンしたファイルのリストを返す．
+const vector<string>&
+Parser::opened_file_list()
+{
+  return lex().opened_file_list();
+}
+
 // @brief yylex とのインターフェイス
 int
 Parser::yylex(
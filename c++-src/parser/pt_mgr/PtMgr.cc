@@ -15,14 +15,85 @@
 
 BEGIN_NAMESPACE_YM_VERILOG
 
+//////////////////////////////////////////////////////////////////////
+// クラス PtMgr::FileAlloc
+//////////////////////////////////////////////////////////////////////
+class PtMgr::FileAlloc :
+  public Alloc
+{
+public:
+
+  /// @brief コンストラクタ
+  explicit
+  FileAlloc(
+    Alloc* target ///< [in] 処理を委ねるアロケーター
+  ) : mTarget{target}
+  {
+  }
+
+  /// @brief 処理を委ねるアロケーターを設定する．
+  void
+  set_target(
+    Alloc* target ///< [in] 処理を委ねるアロケーター
+  )
+  {
+    mTarget = target;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // Alloc の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 実際にメモリ領域の確保を行う関数
+  void*
+  _get_memory(
+    SizeType n
+  ) override
+  {
+    return mTarget->get_memory(n);
+  }
+
+  /// @brief 実際にメモリ領域の開放を行う関数
+  void
+  _put_memory(
+    SizeType n,
+    void* blk
+  ) override
+  {
+    mTarget->put_memory(n, blk);
+  }
+
+  /// @brief 実際に destory() の処理を行う関数
+  ///
+  /// 領域は委ねた先のアロケーターが持っているので何もしない．
+  void
+  _destroy() override
+  {
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 処理を委ねるアロケーター
+  Alloc* mTarget;
+
+};
+
+
 //////////////////////////////////////////////////////////////////////
 // クラス PtMgr
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
 PtMgr::PtMgr() :
-  mAlloc{new SimpleAlloc}
+  mDefaultAlloc{new SimpleAlloc}
 {
+  mAlloc.reset(new FileAlloc{mDefaultAlloc.get()});
 }
 
 // @brief デストラクタ
@@ -82,6 +153,42 @@ PtMgr::all_attr_list() const
   return ans;
 }
 
+// @brief ファイル中で定義されたモジュールのリストを返す．
+vector<const PtModule*>
+PtMgr::file_module_list(
+  const string& filename
+) const
+{
+  if ( mFileDefDict.count(filename) == 0 ) {
+    return {};
+  }
+  return mFileDefList[mFileDefDict.at(filename)].mModuleList;
+}
+
+// @brief ファイル中で定義された UDP のリストを返す．
+vector<const PtUdp*>
+PtMgr::file_udp_list(
+  const string& filename
+) const
+{
+  if ( mFileDefDict.count(filename) == 0 ) {
+    return {};
+  }
+  return mFileDefList[mFileDefDict.at(filename)].mUdpList;
+}
+
+// @brief ファイル中のインスタンス記述で用いられている名前のリストを返す．
+vector<string>
+PtMgr::file_defname_list(
+  const string& filename
+) const
+{
+  if ( mFileDefDict.count(filename) == 0 ) {
+    return {};
+  }
+  return mFileDefList[mFileDefDict.at(filename)].mDefNameList;
+}
+
 // @brief 今までに生成したインスタンスをすべて破壊する．
 void
 PtMgr::clear()
@@ -90,9 +197,122 @@ PtMgr::clear()
   mModuleList.clear();
   mDefNames.clear();
   mStringPool.clear();
+  mAttrDict.clear();
+  mFileDefList.clear();
+  mFileDefDict.clear();
+  mCurFile = static_cast<SizeType>(-1);
+  mRemovedAllocList.clear();
 
   FileInfo::clear();
+  mAlloc->set_target(mDefaultAlloc.get());
   mAlloc->destroy();
+  mDefaultAlloc->destroy();
+}
+
+// @brief ファイルの読み込みを開始する．
+void
+PtMgr::begin_file(
+  const string& filename
+)
+{
+  mCurFile = static_cast<SizeType>(-1);
+  if ( mFileDefDict.count(filename) > 0 ) {
+    auto pos = mFileDefDict.at(filename);
+    if ( mFileDefList[pos].mRemoved ) {
+      // 削除されたファイルは元の位置に読み込む．
+      mFileDefList[pos].mRemoved = false;
+      mCurFile = pos;
+    }
+  }
+  if ( mCurFile >= mFileDefList.size() ) {
+    mCurFile = mFileDefList.size();
+    mFileDefList.push_back(FileDef{filename});
+    mFileDefDict[filename] = mCurFile;
+  }
+  // ファイルごとに破壊できるようにアロケーターを分けておく．
+  auto& file_def = mFileDefList[mCurFile];
+  file_def.mAlloc.reset(new SimpleAlloc);
+  mAlloc->set_target(file_def.mAlloc.get());
+}
+
+// @brief ファイルの読み込みを終了する．
+void
+PtMgr::end_file()
+{
+  if ( mCurFile + 1 < mFileDefList.size() ) {
+    // 途中のファイルを読み直したので全体の順番を作り直す．
+    mUdpList.clear();
+    mModuleList.clear();
+    for ( const auto& file_def: mFileDefList ) {
+      mUdpList.insert(mUdpList.end(),
+		      file_def.mUdpList.begin(), file_def.mUdpList.end());
+      mModuleList.insert(mModuleList.end(),
+			 file_def.mModuleList.begin(), file_def.mModuleList.end());
+    }
+  }
+  mCurFile = static_cast<SizeType>(-1);
+  mAlloc->set_target(mDefaultAlloc.get());
+}
+
+// @brief ファイル中で定義された要素の登録を取り消す．
+void
+PtMgr::remove_file(
+  const string& filename
+)
+{
+  if ( mFileDefDict.count(filename) == 0 ) {
+    return;
+  }
+  auto& file_def = mFileDefList[mFileDefDict.at(filename)];
+  if ( file_def.mRemoved ) {
+    return;
+  }
+
+  unordered_set<const PtUdp*> udp_set{file_def.mUdpList.begin(),
+				      file_def.mUdpList.end()};
+  mUdpList.erase(remove_if(mUdpList.begin(), mUdpList.end(),
+			   [&](const PtUdp* udp) {
+			     return udp_set.count(udp) > 0;
+			   }),
+		 mUdpList.end());
+  unordered_set<const PtModule*> module_set{file_def.mModuleList.begin(),
+					    file_def.mModuleList.end()};
+  mModuleList.erase(remove_if(mModuleList.begin(), mModuleList.end(),
+			      [&](const PtModule* module) {
+				return module_set.count(module) > 0;
+			      }),
+		    mModuleList.end());
+
+  for ( const auto& name: file_def.mDefNameList ) {
+    auto p = mDefNames.find(name);
+    ASSERT_COND( p != mDefNames.end() );
+    if ( -- p->second == 0 ) {
+      mDefNames.erase(p);
+    }
+  }
+
+  for ( auto pt_obj: file_def.mAttrObjList ) {
+    mAttrDict.erase(PtiAttrInfo{pt_obj, {}});
+  }
+
+  file_def.mUdpList.clear();
+  file_def.mModuleList.clear();
+  file_def.mDefNameList.clear();
+  file_def.mAttrObjList.clear();
+  file_def.mRemoved = true;
+
+  // 構文木の要素はまだ参照されているかもしれないので
+  // release_removed() まで破壊しない．
+  if ( file_def.mAlloc != nullptr ) {
+    mRemovedAllocList.push_back(std::move(file_def.mAlloc));
+  }
+}
+
+// @brief remove_file() で登録を取り消した構文木の要素を破壊する．
+void
+PtMgr::release_removed()
+{
+  mRemovedAllocList.clear();
 }
 
 // UDP の登録
@@ -102,6 +322,9 @@ PtMgr::reg_udp(
 )
 {
   mUdpList.push_back(udp);
+  if ( mCurFile < mFileDefList.size() ) {
+    mFileDefList[mCurFile].mUdpList.push_back(udp);
+  }
 }
 
 // モジュールの登録
@@ -111,6 +334,9 @@ PtMgr::reg_module(
 )
 {
   mModuleList.push_back(module);
+  if ( mCurFile < mFileDefList.size() ) {
+    mFileDefList[mCurFile].mModuleList.push_back(module);
+  }
 }
 
 // @brief インスタンス定義名を追加する．
@@ -119,7 +345,10 @@ PtMgr::reg_defname(
   const string& name
 )
 {
-  mDefNames.insert(name);
+  ++ mDefNames[name];
+  if ( mCurFile < mFileDefList.size() ) {
+    mFileDefList[mCurFile].mDefNameList.push_back(name);
+  }
 }
 
 // @brief attribute instance を登録する．
@@ -132,6 +361,9 @@ PtMgr::reg_attrinst(
 {
   if ( ai_list ) {
     mAttrDict.emplace(PtiAttrInfo{pt_obj, ai_list->to_vector(), def});
+    if ( mCurFile < mFileDefList.size() ) {
+      mFileDefList[mCurFile].mAttrObjList.push_back(pt_obj);
+    }
   }
 }
 
@@ -27,6 +27,7 @@ InputMgr::clear()
 {
   mFsStack.clear();
   mFileStack.clear();
+  mOpenedFileList.clear();
 }
 
 
@@ -57,6 +58,7 @@ InputMgr::open_file(
   in.swap(tmp_in);
 
   mFileStack.push_back(unique_ptr<Scanner>{new Scanner{in, {realname, parent_file}}});
+  mOpenedFileList.push_back(realname);
 
   return true;
 }
@@ -79,6 +79,16 @@ public:
     const FileLoc& parent_file = FileLoc() ///< [in] インクルード元のファイル情報
   );
 
+  /// @brief これまでにオープンしたファイルのリストを返す．
+  ///
+  /// インクルードされたファイルも含めてオープンした順に並ぶ．
+  /// 要素はサーチパスを考慮した実際のパス名
+  const vector<string>&
+  opened_file_list() const
+  {
+    return mOpenedFileList;
+  }
+
   /// @brief ファイルのオープン済チェック
   /// @retval true name という名のファイルがオープンされている．
   /// @retval false name というなのファイルはオープンされていない．
@@ -168,6 +178,9 @@ private:
   // ファイルごとのスキャナーのスタック
   vector<unique_ptr<Scanner>> mFileStack;
 
+  // オープンしたファイルのリスト
+  vector<string> mOpenedFileList;
+
 };
 
 END_NAMESPACE_YM_VERILOG
@@ -290,6 +290,13 @@ RawLex::open_file(const string& filename)
   return mInputMgr->open_file(filename);
 }
 
+// @brief これまでにオープンしたファイルのリストを返す．
+const vector<string>&
+RawLex::opened_file_list() const
+{
+  return mInputMgr->opened_file_list();
+}
+
 
 //////////////////////////////////////////////////////////////////////
 // トークンの読み出し関係
@@ -970,7 +977,7 @@ RawLex::read_dec_str(int c)
     return UNUMBER;
   }
   else if ( c == 'x' || c == 'X' ||
-	    c == 'Z' || c == 'Z' ||
+	    c == 'z' || c == 'Z' ||
 	    c == '?' ) {
     mStringBuff.put_char(c);
     // xz? と他の数字との混在はない．
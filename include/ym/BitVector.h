@@ -148,6 +148,18 @@ public:
     const string& str ///< [in] 値の内容を表すVerilog-HDL形式の文字列
   );
 
+  /// @brief Verilog-HDL 形式の文字列からの変換コンストラクタ (C文字列版)
+  ///
+  /// パース木の中の数字の文字列(PtExpr::const_str())から string を
+  /// 作らずに直接変換する．
+  /// サイズと基数は str に含まれていない．
+  BitVector(
+    SizeType size,   ///< [in] サイズ
+    bool is_signed,  ///< [in] 符号の有無を表すフラグ
+    SizeType base,   ///< [in] 基数を表す数字 (2, 8, 10, 16 のみが妥当な値)
+    const char* str  ///< [in] 値の内容を表すVerilog-HDL形式の文字列
+  );
+
   /// @brief 連結演算用のコンストラクタ
   ///
   /// src_list の内容を連結したものをセットする
@@ -771,6 +783,14 @@ public:
   bool
   has_xz() const;
 
+  /// @brief x/z 値を含まないことがわかっている時に true を返す．
+  ///
+  /// コンストラクタや演算子が安価にわかる範囲で保持しているフラグ
+  /// なので，false でも x/z を含んでいるとは限らない．
+  /// true の場合には演算は 1 の面だけを用いた2値の処理で済ませる．
+  bool
+  is_2state() const { return mFlags[4]; }
+
   /// @brief z を x に変える．
   /// @note ほとんどの演算で z は x と区別されていない
   void
@@ -827,8 +847,8 @@ public:
 
   /// @brief 論理値として評価する．
   /// @retval 0 0 の時
-  /// @retval 1 0 以外の確定値の時
-  /// @retval X 不定値を1ビットでも含む場合
+  /// @retval 1 1 のビットを1つでも含む時
+  /// @retval X 上記以外で不定値を1ビットでも含む場合
   VlScalarVal
   to_logic() const;
 
@@ -897,6 +917,21 @@ public:
     bool skip_zeros = true ///< [in] 0スキップフラグ
   ) const;
 
+  /// @brief ハッシュ値を返す．
+  ///
+  /// ビット長，sized/signed/base の属性と値(x/z も含む)が
+  /// 全て等しければ同じ値を返す．
+  SizeType
+  hash() const;
+
+  /// @brief ビット長，属性，値が全て等しい時に true を返す．
+  ///
+  /// operator== と異なり x/z も値として比較する．
+  bool
+  is_identical(
+    const BitVector& right ///< [in] 比較対象
+  ) const;
+
   /// @}
   //////////////////////////////////////////////////////////////////////
 
@@ -944,11 +979,19 @@ private:
   using uword = std::uint64_t;
 
   // mVal0, mVal1 のリサイズをする．
+  //
+  // 2値のフラグは落とされる．
   void
   resize(
     SizeType size
   );
 
+  // mVal1 から mVal0 を作り，2値のフラグを立てる．
+  //
+  // mVal1 が2値の値を表しているとして上位ビットのトリミングも行う．
+  void
+  set_2state();
+
   // 属性(サイズの有無, 符号の有無, 基数)をセットする．
   void
   set_type(
@@ -998,14 +1041,25 @@ private:
     SizeType base
   );
 
+  // 基数に応じて Verilog 形式の数字の文字列から変換する共通ルーティン
+  void
+  set_from_digits(
+    SizeType size,
+    bool is_sized,
+    bool is_signed,
+    SizeType base,
+    const char* str,
+    SizeType len
+  );
+
   // Verilog 形式の2進数から変換するための共通ルーティン
   void
   set_from_binstring(
     SizeType size,
     bool is_sized,
     bool is_signed,
-    const string& str,
-    int pos
+    const char* str,
+    SizeType len
   );
 
   // Verilog 形式の8進数から変換するための共通ルーティン
@@ -1014,8 +1068,8 @@ private:
     SizeType size,
     bool is_sized,
     bool is_signed,
-    const string& str,
-    int pos
+    const char* str,
+    SizeType len
   );
 
   // Verilog 形式の10進数から変換するための共通ルーティン
@@ -1024,8 +1078,8 @@ private:
     SizeType size,
     bool is_sized,
     bool is_signed,
-    const string& str,
-    int pos
+    const char* str,
+    SizeType len
   );
 
   // Verilog 形式の16進数から変換するための共通ルーティン
@@ -1034,8 +1088,8 @@ private:
     SizeType size,
     bool is_sized,
     bool is_signed,
-    const string& str,
-    int pos
+    const char* str,
+    SizeType len
   );
 
   // 文字列からの変換用コンストラクタの共通ルーティン
@@ -1045,25 +1099,187 @@ private:
     const char* str
   );
 
-  /// @brief src を 10 で割る．
-  /// @return 余りを返す．
+  /// @brief 除算と剰余算の共通関数
+  /// @return 除数が0の時 false を返す．
+  ///
+  /// src1, src2 は同じビット長で X/Z を含まないこと．
   static
-  int
-  div10(
-    const uword* src, ///< [in] 元の値
-    int n,            ///< [in]
-    uword* q          ///< [out] 求まった商を格納する変数
+  bool
+  divmod_base(
+    const BitVector& src1, ///< [in] 被除数
+    const BitVector& src2, ///< [in] 除数
+    BitVector& q,          ///< [out] 商
+    BitVector& r           ///< [out] 余り
   );
 
+  /// @brief 指定されたパタンのビットを含んでいたら true を返す．
+  ///
+  /// (val0 ^ inv0) & (val1 ^ inv1) が 0 でないビットを探す．
+  /// - x: inv0 = 0,    inv1 = 0
+  /// - z: inv0 = ALL1, inv1 = ALL1
+  /// - 1: inv0 = ALL1, inv1 = 0
+  /// - 0: inv0 = 0,    inv1 = ALL1
+  bool
+  has_pat(
+    uword inv0, ///< [in] val0 を反転させるパタン
+    uword inv1  ///< [in] val1 を反転させるパタン
+  ) const;
+
   /// @brief val を10進数で表した文字列を返す．
   static
   string
   dec_str_sub(
-    const uword* val,
-    int n
+    const uword* val, ///< [in] 値を表すワードの配列
+    SizeType n        ///< [in] ワード数
   );
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 値を保持するワードの配列
+  ///
+  /// INLINE_NUM ワード以下の時はオブジェクト内の配列を用いて，
+  /// それを越える時のみヒープ領域を確保する．
+  /// 多くの値は 128 ビット以下なので，コピーやムーブの際に
+  /// メモリ確保が起こらない．
+  class WordBuf
+  {
+  public:
+
+    /// @brief コンストラクタ
+    WordBuf() = default;
+
+    /// @brief コピーコンストラクタは禁止
+    WordBuf(
+      const WordBuf& src
+    ) = delete;
+
+    /// @brief ムーブコンストラクタ
+    WordBuf(
+      WordBuf&& src
+    ) : mCap{src.mCap}
+    {
+      steal(src);
+    }
+
+    /// @brief コピー代入演算子は禁止
+    WordBuf&
+    operator=(
+      const WordBuf& src
+    ) = delete;
+
+    /// @brief ムーブ代入演算子
+    WordBuf&
+    operator=(
+      WordBuf&& src
+    )
+    {
+      if ( &src != this ) {
+	free();
+	mCap = src.mCap;
+	steal(src);
+      }
+      return *this;
+    }
+
+    /// @brief デストラクタ
+    ~WordBuf()
+    {
+      free();
+    }
+
+    /// @brief 少なくとも n ワードの領域を確保する．
+    ///
+    /// 領域を確保し直した場合には以前の内容は失われる．
+    void
+    alloc(
+      SizeType n ///< [in] ワード数
+    )
+    {
+      if ( n > mCap ) {
+	free();
+	mHeap = new uword[n];
+	mCap = n;
+      }
+    }
+
+    /// @brief 先頭のアドレスを返す．
+    uword*
+    get()
+    {
+      return is_inline() ? mInline : mHeap;
+    }
+
+    /// @brief 先頭のアドレスを返す．
+    const uword*
+    get() const
+    {
+      return is_inline() ? mInline : mHeap;
+    }
+
+
+  private:
+
+    /// @brief 内部の配列を用いている時 true を返す．
+    bool
+    is_inline() const
+    {
+      return mCap <= INLINE_NUM;
+    }
+
+    /// @brief src の内容を奪う．
+    ///
+    /// mCap は設定済みとする．
+    void
+    steal(
+      WordBuf& src
+    )
+    {
+      if ( is_inline() ) {
+	for ( SizeType i = 0; i < INLINE_NUM; ++ i ) {
+	  mInline[i] = src.mInline[i];
+	}
+      }
+      else {
+	mHeap = src.mHeap;
+	src.mCap = INLINE_NUM;
+      }
+    }
+
+    /// @brief ヒープ領域を解放する．
+    void
+    free()
+    {
+      if ( !is_inline() ) {
+	delete [] mHeap;
+	mCap = INLINE_NUM;
+      }
+    }
+
+
+  private:
+
+    // 内部の配列のワード数
+    static
+    const SizeType INLINE_NUM = 2;
+
+    // 確保されているワード数
+    SizeType mCap{INLINE_NUM};
+
+    union {
+      // mCap <= INLINE_NUM の時の配列
+      uword mInline[INLINE_NUM]{};
+
+      // mCap > INLINE_NUM の時のヒープ領域
+      uword* mHeap;
+    };
+
+  };
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
@@ -1072,15 +1288,16 @@ private:
   // ビット長
   SizeType mSize{0U};
 
-  // sized, signed, base をパックした変数
+  // sized, signed, base と2値のフラグをパックした変数
   // base は 2ビットを使って 2, 8, 10, 16 を符号化する．
-  bitset<4> mFlags{0};
+  // 4ビット目が2値のフラグ(is_2state())
+  bitset<5> mFlags{0};
 
   // 値を保持するベクタ
   // サイズは block(mSize)
   // mVal0:Val1 の組み合わせで値を表す．
-  unique_ptr<uword> mVal0;
-  unique_ptr<uword> mVal1;
+  WordBuf mVal0;
+  WordBuf mVal1;
 
 
 public:
@@ -11,14 +11,20 @@
 #include "ym/verilog.h"
 #include "ym/pt/PtP.h"
 #include "ym/vl/VlFwd.h"
+#include "ym/VlSpan.h"
+#include "ym/VlParallel.h"
+#include "ym/VlNetlist.h"
+#include "ym/VlSnapshot.h"
 #include "ym/ClibCellLibrary.h"
 #include "ym/File.h"
+#include <string_view>
 
 
 BEGIN_NAMESPACE_YM_VERILOG
 
 class PtMgr;
 class ElbMgr;
+class Elaborator;
 
 //////////////////////////////////////////////////////////////////////
 /// @class VlMgr VlMgr.h "ym/VlMgr.h"
@@ -57,6 +63,43 @@ public:
     const vector<VlLineWatcher*> watcher_list = {} ///< [in] 行番号ウォッチャーのリスト
   );
 
+  /// @brief 編集されたファイルを読み直す．
+  /// @retval true 正常に終了した．
+  /// @retval false 読み込みかエラボレーションでエラーが起こった．
+  ///
+  /// read_file() で読み込んだファイルのうち filename だけを読み直して，
+  /// 他のファイルの構文木はそのまま用いる．
+  /// 読み込んでいないファイルの場合は read_file() と同じ動作をする．
+  /// ファイルの内容が変わっていなければ何もしない．
+  ///
+  /// elaborate() を呼んだ後の場合は以下のいずれかの時に再度
+  /// エラボレーションを行う．
+  /// - ファイル中で新旧どちらかに定義されているモジュールが
+  ///   エラボレーション結果のインスタンスとして使われている．
+  /// - ファイル中で新旧どちらかに UDP が定義されている．
+  /// - 新しい内容にトップモジュールとなるモジュールがある．
+  /// - インスタンス記述の変更により他のモジュールの
+  ///   トップモジュールかどうかが変わる．
+  /// - 前回のエラボレーションでエラーが起きている．
+  /// それ以外の場合はエラボレーション結果をそのまま用いる．
+  ///
+  /// 再度エラボレーションを行う場合は，通常は古いモジュール定義の
+  /// インスタンスとその要素を参照しているインスタンスだけを作り直す．
+  /// UDP の変更，ファイル中のモジュール名の変更，トップモジュールの変更，
+  /// 前回のエラー，作り直さないインスタンスへの defparam 文の適用が
+  /// ある場合や作り直しでエラーが起きた場合は全体をやり直す．
+  /// 作り直した要素は all_XXX_list() などの末尾に移るので
+  /// 順序は elaborate() の結果と異なることがある．
+  /// 再度エラボレーションを行う場合は freeze() は解除される．
+  /// 読み込みでエラーが起きた場合はエラボレーション結果は破棄される．
+  /// 古い内容の構文木はこの関数の終了時に解放される．
+  bool
+  update_file(
+    const string& filename,                        ///< [in] 読み込むファイル名
+    const SearchPathList& searchpath = {},         ///< [in] サーチパス
+    const vector<VlLineWatcher*> watcher_list = {} ///< [in] 行番号ウォッチャーのリスト
+  );
+
   /// @brief 登録されているモジュールのリストを返す．
   /// @return 登録されているモジュールのリスト
   const vector<const PtModule*>&
@@ -79,6 +122,44 @@ public:
   // elaboration 関係のメンバ関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief エラボレーション中の情報メッセージの出力を制御する．
+  ///
+  /// false にするとエラボレーション中の MsgType::Info のメッセージは
+  /// 文字列を生成する前に捨てられる．
+  /// デフォルトでは true (出力する)
+  void
+  set_info_msg(
+    bool flag ///< [in] 出力する時 true にする．
+  )
+  {
+    mInfoMsg = flag;
+  }
+
+  /// @brief 遅延エラボレーションを行うかどうかを設定する．
+  ///
+  /// true にすると elaborate() ではスコープ，モジュールインスタンス，
+  /// パラメータ，宣言要素，ポートまでを作り，continuous assignment,
+  /// process，primitive やモジュールインスタンスの接続，
+  /// タスク/関数の本体などのスコープの中身は，そのスコープを引数とする
+  /// find_XXX_list()/find_XXX_span() が最初に呼ばれた時に作られる．
+  /// defparam 文はどのスコープのパラメータも変更しうるので
+  /// 骨組みは常に全体を作る．
+  ///
+  /// モジュールインスタンスのポートの外側の接続は親のスコープの
+  /// 中身として扱われる．
+  /// find_by_path()/find_by_paths() では階層名の途中のスコープと
+  /// 結果のスコープの中身を作る．
+  /// all_XXX_span() や freeze()，extract_netlist()，save_elaborated()
+  /// では残りをすべて作る．
+  /// デフォルトでは false (すべてを elaborate() で作る)
+  void
+  set_lazy(
+    bool flag ///< [in] 遅延させる時 true にする．
+  )
+  {
+    mLazy = flag;
+  }
+
   /// @brief エラボレーションを行う．
   /// @return エラー数を返す．
   int
@@ -87,6 +168,58 @@ public:
     = ClibCellLibrary()
   );
 
+  /// @brief スコープの中身を作る．
+  ///
+  /// set_lazy(true) でエラボレーションした場合に scope に直接記述された
+  /// 要素のうちまだ作られていないものを作る．
+  /// scope を含むモジュールまでの外側のスコープの要素(タスク/関数の
+  /// 本体を含む)もあわせて作る．
+  /// それ以外の場合は何もしない．
+  /// find_XXX_list()/find_XXX_span() の中で呼ばれるので
+  /// 明示的に呼ぶ必要はない．
+  void
+  elaborate_scope(
+    const VlScope* scope ///< [in] 対象のスコープ
+  ) const;
+
+  /// @brief まだ作られていないスコープの中身をすべて作る．
+  ///
+  /// set_lazy(true) でエラボレーションした場合以外は何もしない．
+  void
+  elaborate_all() const;
+
+  /// @brief エラボレーション結果を読み出し専用にする．
+  ///
+  /// 最初の検索時に作られる表やキャッシュをここですべて作る．
+  /// これ以降はこのクラスの const なメンバ関数と，取り出した要素の
+  /// const なメンバ関数を複数のスレッドから同時に呼んでも良い．
+  /// clear() を呼ぶまで elaborate() を呼んではいけない．
+  /// 遅延エラボレーションで残っている処理もここで行う．
+  void
+  freeze();
+
+  /// @brief freeze() が呼ばれている時 true を返す．
+  bool
+  is_frozen() const;
+
+  /// @brief エラボレーション結果をファイルに保存する．
+  /// @retval true 成功した．
+  /// @retval false 読み込みに失敗したファイルがあるか，
+  ///               書き込みに失敗した．
+  ///
+  /// read_file() で読み込んだ時点のファイルの内容と elaborate() で
+  /// 用いたセルライブラリから求めたハッシュ値も記録される．
+  /// 保存したファイルは VlSnapshot::open() で読み込む．
+  /// その際に同じファイルのリストとセルライブラリから
+  /// VlSnapshot::input_hash() で求めた値を与えると，入力が変更されている
+  /// 場合には読み込まれない．
+  /// インクルードファイルも読み込んだ時点の内容のハッシュ値が記録され，
+  /// 変更されている場合には読み込まれない．
+  bool
+  save_elaborated(
+    const string& path ///< [in] 出力先のファイル名
+  ) const;
+
   /// @brief UDP 定義のリストを返す．
   const vector<const VlUdpDefn*>&
   udp_list() const;
@@ -134,6 +267,15 @@ public:
     const VlScope* parent ///< [in] 検索対象のスコープ
   ) const;
 
+  /// @brief スコープに属する internal scope のリストを取り出す．
+  ///
+  /// find_internalscope_list() と同じ要素をコピーせずに参照する．
+  /// 結果はエラボレーション結果が変更されるまで有効である．
+  VlSpan<const VlScope*>
+  find_internalscope_span(
+    const VlScope* parent ///< [in] 検索対象のスコープ
+  ) const;
+
   /// @brief スコープとタグから宣言要素を取り出す．
   /// @return 結果のリストを返す．
   ///
@@ -144,6 +286,16 @@ public:
     int tag                ///< [in] タグ
   ) const;
 
+  /// @brief スコープとタグから宣言要素を取り出す．
+  ///
+  /// find_decl_list() と同じ要素をコピーせずに参照する．
+  /// 結果はエラボレーション結果が変更されるまで有効である．
+  VlSpan<const VlDecl*>
+  find_decl_span(
+    const VlScope* parent, ///< [in] 検索対象のスコープ
+    int tag                ///< [in] タグ
+  ) const;
+
   /// @brief スコープとタグから宣言要素の配列を取り出す．
   /// @retrun 結果のリストを返す．
   ///
@@ -154,6 +306,16 @@ public:
     int tag            	   ///< [in] タグ
   ) const;
 
+  /// @brief スコープとタグから宣言要素の配列を取り出す．
+  ///
+  /// find_declarray_list() と同じ要素をコピーせずに参照する．
+  /// 結果はエラボレーション結果が変更されるまで有効である．
+  VlSpan<const VlDeclArray*>
+  find_declarray_span(
+    const VlScope* parent, ///< [in] 検索対象のスコープ
+    int tag            	   ///< [in] タグ
+  ) const;
+
   /// @brief スコープに属する defparam のリストを取り出す．
   /// @return 結果のリストを返す．
   vector<const VlDefParam*>
@@ -161,6 +323,15 @@ public:
     const VlScope* parent ///< [in] 検索対象のスコープ
   ) const;
 
+  /// @brief スコープに属する defparam のリストを取り出す．
+  ///
+  /// find_defparam_list() と同じ要素をコピーせずに参照する．
+  /// 結果はエラボレーション結果が変更されるまで有効である．
+  VlSpan<const VlDefParam*>
+  find_defparam_span(
+    const VlScope* parent ///< [in] 検索対象のスコープ
+  ) const;
+
   /// @brief スコープに属する param assign のリストを取り出す．
   /// @return 結果のリストを返す．
   vector<const VlParamAssign*>
@@ -168,6 +339,15 @@ public:
     const VlScope* parent ///< [in] 検索対象のスコープ
   ) const;
 
+  /// @brief スコープに属する param assign のリストを取り出す．
+  ///
+  /// find_paramassign_list() と同じ要素をコピーせずに参照する．
+  /// 結果はエラボレーション結果が変更されるまで有効である．
+  VlSpan<const VlParamAssign*>
+  find_paramassign_span(
+    const VlScope* parent ///< [in] 検索対象のスコープ
+  ) const;
+
   /// @brief スコープに属する module のリストを取り出す．
   /// @return 結果のリストを返す．
   vector<const VlModule*>
@@ -175,6 +355,15 @@ public:
     const VlScope* parent ///< [in] 検索対象のスコープ
   ) const;
 
+  /// @brief スコープに属する module のリストを取り出す．
+  ///
+  /// find_module_list() と同じ要素をコピーせずに参照する．
+  /// 結果はエラボレーション結果が変更されるまで有効である．
+  VlSpan<const VlModule*>
+  find_module_span(
+    const VlScope* parent ///< [in] 検索対象のスコープ
+  ) const;
+
   /// @brief スコープに属する module arrayのリストを取り出す．
   /// @return 結果のリストを返す．
   vector<const VlModuleArray*>
@@ -182,6 +371,15 @@ public:
     const VlScope* parent ///< [in] 検索対象のスコープ
   ) const;
 
+  /// @brief スコープに属する module arrayのリストを取り出す．
+  ///
+  /// find_modulearray_list() と同じ要素をコピーせずに参照する．
+  /// 結果はエラボレーション結果が変更されるまで有効である．
+  VlSpan<const VlModuleArray*>
+  find_modulearray_span(
+    const VlScope* parent ///< [in] 検索対象のスコープ
+  ) const;
+
   /// @brief スコープに属する primitive のリストを取り出す．
   /// @return 結果のリストを返す．
   vector<const VlPrimitive*>
@@ -189,6 +387,15 @@ public:
     const VlScope* parent ///< [in] 検索対象のスコープ
   ) const;
 
+  /// @brief スコープに属する primitive のリストを取り出す．
+  ///
+  /// find_primitive_list() と同じ要素をコピーせずに参照する．
+  /// 結果はエラボレーション結果が変更されるまで有効である．
+  VlSpan<const VlPrimitive*>
+  find_primitive_span(
+    const VlScope* parent ///< [in] 検索対象のスコープ
+  ) const;
+
   /// @brief スコープに属する primitive array のリストを取り出す．
   /// @return 結果のリストを返す．
   vector<const VlPrimArray*>
@@ -196,6 +403,15 @@ public:
     const VlScope* parent ///< [in] 検索対象のスコープ
   ) const;
 
+  /// @brief スコープに属する primitive array のリストを取り出す．
+  ///
+  /// find_primarray_list() と同じ要素をコピーせずに参照する．
+  /// 結果はエラボレーション結果が変更されるまで有効である．
+  VlSpan<const VlPrimArray*>
+  find_primarray_span(
+    const VlScope* parent ///< [in] 検索対象のスコープ
+  ) const;
+
   /// @brief スコープに属するタスクのリストを取り出す．
   /// @return 結果のリストを返す．
   vector<const VlTaskFunc*>
@@ -203,6 +419,15 @@ public:
     const VlScope* parent ///< [in] 検索対象のスコープ
   ) const;
 
+  /// @brief スコープに属するタスクのリストを取り出す．
+  ///
+  /// find_task_list() と同じ要素をコピーせずに参照する．
+  /// 結果はエラボレーション結果が変更されるまで有効である．
+  VlSpan<const VlTaskFunc*>
+  find_task_span(
+    const VlScope* parent ///< [in] 検索対象のスコープ
+  ) const;
+
   /// @brief スコープに属する関数のリストを取り出す．
   /// @return 結果のリストを返す．
   vector<const VlTaskFunc*>
@@ -210,6 +435,15 @@ public:
     const VlScope* parent ///< [in] 検索対象のスコープ
   ) const;
 
+  /// @brief スコープに属する関数のリストを取り出す．
+  ///
+  /// find_function_list() と同じ要素をコピーせずに参照する．
+  /// 結果はエラボレーション結果が変更されるまで有効である．
+  VlSpan<const VlTaskFunc*>
+  find_function_span(
+    const VlScope* parent ///< [in] 検索対象のスコープ
+  ) const;
+
   /// @brief スコープに属する continuous assignment のリストを取り出す．
   /// @return 結果のリストを返す．
   vector<const VlContAssign*>
@@ -217,6 +451,15 @@ public:
     const VlScope* parent ///< [in] 検索対象のスコープ
   ) const;
 
+  /// @brief スコープに属する continuous assignment のリストを取り出す．
+  ///
+  /// find_contassign_list() と同じ要素をコピーせずに参照する．
+  /// 結果はエラボレーション結果が変更されるまで有効である．
+  VlSpan<const VlContAssign*>
+  find_contassign_span(
+    const VlScope* parent ///< [in] 検索対象のスコープ
+  ) const;
+
   /// @brief スコープに属する process のリストを取り出す．
   /// @return 結果のリストを返す．
   vector<const VlProcess*>
@@ -224,12 +467,485 @@ public:
     const VlScope* parent ///< [in] 検索対象のスコープ
   ) const;
 
+  /// @brief スコープに属する process のリストを取り出す．
+  ///
+  /// find_process_list() と同じ要素をコピーせずに参照する．
+  /// 結果はエラボレーション結果が変更されるまで有効である．
+  VlSpan<const VlProcess*>
+  find_process_span(
+    const VlScope* parent ///< [in] 検索対象のスコープ
+  ) const;
+
   /// @brief 属性リストを得る．
   vector<const VlAttribute*>
   find_attr(
     const VlObj* obj ///< [in] 対象のオブジェクト
   ) const;
 
+  /// @brief 階層名から要素を取り出す．
+  /// @return 見付かった要素を返す．
+  /// @return なければ nullptr を返す．
+  ///
+  /// 階層名はトップモジュールの名前から始まる '.' 区切りの名前で，
+  /// 各要素には [インデックス] を付けられる．
+  /// - module array, generate for, primitive array のインデックスは
+  ///   その要素を表す．
+  /// - 宣言要素のビット選択や配列要素は要素として存在しないので
+  ///   宣言要素自身を返す．
+  /// - '\' で始まる名前は空白までを escaped identifier とする．
+  ///
+  /// 名前の検索用のハッシュ表は最初の呼び出し時に作られる．
+  /// 遅延エラボレーションの場合は階層名の途中のスコープ(結果の
+  /// 親のスコープを含む)と結果がスコープの場合はその中身を作るので，
+  /// 返された要素の中身やポートの接続は作られている．
+  const VlObj*
+  find_by_path(
+    string_view path ///< [in] 階層名 (例: "top.u_core.u_alu.sum[3]")
+  ) const;
+
+  /// @brief 複数の階層名から要素を取り出す．
+  /// @return path_list と同じ順に結果を並べたリストを返す．
+  ///
+  /// 各要素の意味は find_by_path() と同じ．
+  /// 共通の接頭辞を持つ階層名はその部分の解決結果を共有するので
+  /// find_by_path() を繰り返し呼ぶよりも速い．
+  /// 遅延エラボレーションで作られるスコープの中身も find_by_path()
+  /// と同じ．
+  vector<const VlObj*>
+  find_by_paths(
+    const vector<string>& path_list ///< [in] 階層名のリスト
+  ) const;
+
+  /// @brief ビット単位の接続グラフを抽出する．
+  ///
+  /// モジュールインスタンスごとの処理を複数のスレッドで行う．
+  /// 結果は thread_num によらず同じになる．
+  VlNetlist
+  extract_netlist(
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+  ) const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 設計全体の要素を種類ごとに列挙するメンバ関数
+  //
+  // スコープの階層をたどらずに同じ種類の要素をすべて訪問する．
+  // find_xxx_list() の結果をすべてのスコープについて集めたものと
+  // 同じ要素を含む．
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 設計中のすべてのinternal scopeを返す．
+  ///
+  /// 生成順に並んでいる．
+  VlSpan<const VlScope*>
+  all_internalscope_span() const;
+
+  /// @brief 設計中のすべてのinternal scopeに func を適用する．
+  template<typename Func>
+  void
+  for_each_internalscope(
+    Func&& func ///< [in] 適用する関数
+  ) const
+  {
+    for ( auto obj: all_internalscope_span() ) {
+      func(obj);
+    }
+  }
+
+  /// @brief 設計中のすべてのinternal scopeに複数のスレッドで func を適用する．
+  ///
+  /// 適用順は不定である．func はスレッドセーフでなければならない．
+  template<typename Func>
+  void
+  parallel_for_each_internalscope(
+    Func&& func,            ///< [in] 適用する関数
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+  ) const
+  {
+    vl_parallel_for_each(all_internalscope_span(), func, thread_num);
+  }
+
+  /// @brief 設計中のtag というタグを持つすべての宣言要素を返す．
+  ///
+  /// 生成順に並んでいる．
+  VlSpan<const VlDecl*>
+  all_decl_span(
+    int tag ///< [in] タグ
+  ) const;
+
+  /// @brief 設計中のtag というタグを持つすべての宣言要素に func を適用する．
+  template<typename Func>
+  void
+  for_each_decl(
+    int tag,    ///< [in] タグ
+    Func&& func ///< [in] 適用する関数
+  ) const
+  {
+    for ( auto obj: all_decl_span(tag) ) {
+      func(obj);
+    }
+  }
+
+  /// @brief 設計中のtag というタグを持つすべての宣言要素に複数のスレッドで func を適用する．
+  ///
+  /// 適用順は不定である．func はスレッドセーフでなければならない．
+  template<typename Func>
+  void
+  parallel_for_each_decl(
+    int tag,                ///< [in] タグ
+    Func&& func,            ///< [in] 適用する関数
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+  ) const
+  {
+    vl_parallel_for_each(all_decl_span(tag), func, thread_num);
+  }
+
+  /// @brief 設計中のtag というタグを持つすべての宣言要素の配列を返す．
+  ///
+  /// 生成順に並んでいる．
+  VlSpan<const VlDeclArray*>
+  all_declarray_span(
+    int tag ///< [in] タグ
+  ) const;
+
+  /// @brief 設計中のtag というタグを持つすべての宣言要素の配列に func を適用する．
+  template<typename Func>
+  void
+  for_each_declarray(
+    int tag,    ///< [in] タグ
+    Func&& func ///< [in] 適用する関数
+  ) const
+  {
+    for ( auto obj: all_declarray_span(tag) ) {
+      func(obj);
+    }
+  }
+
+  /// @brief 設計中のtag というタグを持つすべての宣言要素の配列に複数のスレッドで func を適用する．
+  ///
+  /// 適用順は不定である．func はスレッドセーフでなければならない．
+  template<typename Func>
+  void
+  parallel_for_each_declarray(
+    int tag,                ///< [in] タグ
+    Func&& func,            ///< [in] 適用する関数
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+  ) const
+  {
+    vl_parallel_for_each(all_declarray_span(tag), func, thread_num);
+  }
+
+  /// @brief 設計中のすべてのdefparamを返す．
+  ///
+  /// 生成順に並んでいる．
+  VlSpan<const VlDefParam*>
+  all_defparam_span() const;
+
+  /// @brief 設計中のすべてのdefparamに func を適用する．
+  template<typename Func>
+  void
+  for_each_defparam(
+    Func&& func ///< [in] 適用する関数
+  ) const
+  {
+    for ( auto obj: all_defparam_span() ) {
+      func(obj);
+    }
+  }
+
+  /// @brief 設計中のすべてのdefparamに複数のスレッドで func を適用する．
+  ///
+  /// 適用順は不定である．func はスレッドセーフでなければならない．
+  template<typename Func>
+  void
+  parallel_for_each_defparam(
+    Func&& func,            ///< [in] 適用する関数
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+  ) const
+  {
+    vl_parallel_for_each(all_defparam_span(), func, thread_num);
+  }
+
+  /// @brief 設計中のすべてのparam assignを返す．
+  ///
+  /// 生成順に並んでいる．
+  VlSpan<const VlParamAssign*>
+  all_paramassign_span() const;
+
+  /// @brief 設計中のすべてのparam assignに func を適用する．
+  template<typename Func>
+  void
+  for_each_paramassign(
+    Func&& func ///< [in] 適用する関数
+  ) const
+  {
+    for ( auto obj: all_paramassign_span() ) {
+      func(obj);
+    }
+  }
+
+  /// @brief 設計中のすべてのparam assignに複数のスレッドで func を適用する．
+  ///
+  /// 適用順は不定である．func はスレッドセーフでなければならない．
+  template<typename Func>
+  void
+  parallel_for_each_paramassign(
+    Func&& func,            ///< [in] 適用する関数
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+  ) const
+  {
+    vl_parallel_for_each(all_paramassign_span(), func, thread_num);
+  }
+
+  /// @brief 設計中のすべてのmoduleを返す．
+  ///
+  /// 生成順に並んでいる．
+  VlSpan<const VlModule*>
+  all_module_span() const;
+
+  /// @brief 設計中のすべてのmoduleに func を適用する．
+  template<typename Func>
+  void
+  for_each_module(
+    Func&& func ///< [in] 適用する関数
+  ) const
+  {
+    for ( auto obj: all_module_span() ) {
+      func(obj);
+    }
+  }
+
+  /// @brief 設計中のすべてのmoduleに複数のスレッドで func を適用する．
+  ///
+  /// 適用順は不定である．func はスレッドセーフでなければならない．
+  template<typename Func>
+  void
+  parallel_for_each_module(
+    Func&& func,            ///< [in] 適用する関数
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+  ) const
+  {
+    vl_parallel_for_each(all_module_span(), func, thread_num);
+  }
+
+  /// @brief 設計中のすべてのmodule arrayを返す．
+  ///
+  /// 生成順に並んでいる．
+  VlSpan<const VlModuleArray*>
+  all_modulearray_span() const;
+
+  /// @brief 設計中のすべてのmodule arrayに func を適用する．
+  template<typename Func>
+  void
+  for_each_modulearray(
+    Func&& func ///< [in] 適用する関数
+  ) const
+  {
+    for ( auto obj: all_modulearray_span() ) {
+      func(obj);
+    }
+  }
+
+  /// @brief 設計中のすべてのmodule arrayに複数のスレッドで func を適用する．
+  ///
+  /// 適用順は不定である．func はスレッドセーフでなければならない．
+  template<typename Func>
+  void
+  parallel_for_each_modulearray(
+    Func&& func,            ///< [in] 適用する関数
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+  ) const
+  {
+    vl_parallel_for_each(all_modulearray_span(), func, thread_num);
+  }
+
+  /// @brief 設計中のすべてのprimitiveを返す．
+  ///
+  /// 生成順に並んでいる．
+  VlSpan<const VlPrimitive*>
+  all_primitive_span() const;
+
+  /// @brief 設計中のすべてのprimitiveに func を適用する．
+  template<typename Func>
+  void
+  for_each_primitive(
+    Func&& func ///< [in] 適用する関数
+  ) const
+  {
+    for ( auto obj: all_primitive_span() ) {
+      func(obj);
+    }
+  }
+
+  /// @brief 設計中のすべてのprimitiveに複数のスレッドで func を適用する．
+  ///
+  /// 適用順は不定である．func はスレッドセーフでなければならない．
+  template<typename Func>
+  void
+  parallel_for_each_primitive(
+    Func&& func,            ///< [in] 適用する関数
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+  ) const
+  {
+    vl_parallel_for_each(all_primitive_span(), func, thread_num);
+  }
+
+  /// @brief 設計中のすべてのprimitive arrayを返す．
+  ///
+  /// 生成順に並んでいる．
+  VlSpan<const VlPrimArray*>
+  all_primarray_span() const;
+
+  /// @brief 設計中のすべてのprimitive arrayに func を適用する．
+  template<typename Func>
+  void
+  for_each_primarray(
+    Func&& func ///< [in] 適用する関数
+  ) const
+  {
+    for ( auto obj: all_primarray_span() ) {
+      func(obj);
+    }
+  }
+
+  /// @brief 設計中のすべてのprimitive arrayに複数のスレッドで func を適用する．
+  ///
+  /// 適用順は不定である．func はスレッドセーフでなければならない．
+  template<typename Func>
+  void
+  parallel_for_each_primarray(
+    Func&& func,            ///< [in] 適用する関数
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+  ) const
+  {
+    vl_parallel_for_each(all_primarray_span(), func, thread_num);
+  }
+
+  /// @brief 設計中のすべてのタスクを返す．
+  ///
+  /// 生成順に並んでいる．
+  VlSpan<const VlTaskFunc*>
+  all_task_span() const;
+
+  /// @brief 設計中のすべてのタスクに func を適用する．
+  template<typename Func>
+  void
+  for_each_task(
+    Func&& func ///< [in] 適用する関数
+  ) const
+  {
+    for ( auto obj: all_task_span() ) {
+      func(obj);
+    }
+  }
+
+  /// @brief 設計中のすべてのタスクに複数のスレッドで func を適用する．
+  ///
+  /// 適用順は不定である．func はスレッドセーフでなければならない．
+  template<typename Func>
+  void
+  parallel_for_each_task(
+    Func&& func,            ///< [in] 適用する関数
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+  ) const
+  {
+    vl_parallel_for_each(all_task_span(), func, thread_num);
+  }
+
+  /// @brief 設計中のすべての関数を返す．
+  ///
+  /// 生成順に並んでいる．
+  VlSpan<const VlTaskFunc*>
+  all_function_span() const;
+
+  /// @brief 設計中のすべての関数に func を適用する．
+  template<typename Func>
+  void
+  for_each_function(
+    Func&& func ///< [in] 適用する関数
+  ) const
+  {
+    for ( auto obj: all_function_span() ) {
+      func(obj);
+    }
+  }
+
+  /// @brief 設計中のすべての関数に複数のスレッドで func を適用する．
+  ///
+  /// 適用順は不定である．func はスレッドセーフでなければならない．
+  template<typename Func>
+  void
+  parallel_for_each_function(
+    Func&& func,            ///< [in] 適用する関数
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+  ) const
+  {
+    vl_parallel_for_each(all_function_span(), func, thread_num);
+  }
+
+  /// @brief 設計中のすべてのcontinuous assignmentを返す．
+  ///
+  /// 生成順に並んでいる．
+  VlSpan<const VlContAssign*>
+  all_contassign_span() const;
+
+  /// @brief 設計中のすべてのcontinuous assignmentに func を適用する．
+  template<typename Func>
+  void
+  for_each_contassign(
+    Func&& func ///< [in] 適用する関数
+  ) const
+  {
+    for ( auto obj: all_contassign_span() ) {
+      func(obj);
+    }
+  }
+
+  /// @brief 設計中のすべてのcontinuous assignmentに複数のスレッドで func を適用する．
+  ///
+  /// 適用順は不定である．func はスレッドセーフでなければならない．
+  template<typename Func>
+  void
+  parallel_for_each_contassign(
+    Func&& func,            ///< [in] 適用する関数
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+  ) const
+  {
+    vl_parallel_for_each(all_contassign_span(), func, thread_num);
+  }
+
+  /// @brief 設計中のすべてのprocessを返す．
+  ///
+  /// 生成順に並んでいる．
+  VlSpan<const VlProcess*>
+  all_process_span() const;
+
+  /// @brief 設計中のすべてのprocessに func を適用する．
+  template<typename Func>
+  void
+  for_each_process(
+    Func&& func ///< [in] 適用する関数
+  ) const
+  {
+    for ( auto obj: all_process_span() ) {
+      func(obj);
+    }
+  }
+
+  /// @brief 設計中のすべてのprocessに複数のスレッドで func を適用する．
+  ///
+  /// 適用順は不定である．func はスレッドセーフでなければならない．
+  template<typename Func>
+  void
+  parallel_for_each_process(
+    Func&& func,            ///< [in] 適用する関数
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+  ) const
+  {
+    vl_parallel_for_each(all_process_span(), func, thread_num);
+  }
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -242,6 +958,35 @@ private:
   // Elb オブジェクトを管理するクラス
   unique_ptr<ElbMgr> mElbMgr;
 
+  // エラボレーション中の情報メッセージを出力する時 true
+  bool mInfoMsg{true};
+
+  // 遅延エラボレーションを行う時 true
+  bool mLazy{false};
+
+  // 遅延エラボレーションの残りの処理を持つオブジェクト
+  unique_ptr<Elaborator> mElaborator;
+
+  // read_file() で読み込んだファイル名のリスト
+  vector<string> mFileList;
+
+  // ファイル名をキーにして，読み込んだ時にオープンしたファイルと
+  // その時点の内容のハッシュ値のリストを保持する辞書
+  // 先頭はそのファイル自身で，インクルードファイルが続く．
+  unordered_map<string, vector<pair<string, std::uint64_t>>> mFileDepDict;
+
+  // elaborate() で用いたセルライブラリ
+  ClibCellLibrary mCellLibrary;
+
+  // elaborate() を呼んだ時 true にする．
+  bool mElaborated{false};
+
+  // 最後のエラボレーションのエラー数
+  int mElabErrorNum{0};
+
+  // 最後のエラボレーションでエラーメッセージが出ていない時 true
+  bool mElabClean{false};
+
 };
 
 END_NAMESPACE_YM_VERILOG
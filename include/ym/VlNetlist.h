@@ -0,0 +1,272 @@
+﻿#ifndef YM_VLNETLIST_H
+#define YM_VLNETLIST_H
+
+/// @file ym/VlNetlist.h
+/// @brief VlNetlist のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/verilog.h"
+#include "ym/vl/VlFwd.h"
+#include "ym/VlSpan.h"
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+class VlMgr;
+
+//////////////////////////////////////////////////////////////////////
+/// @class VlNetlist VlNetlist.h "ym/VlNetlist.h"
+/// @brief エラボレーション結果から作ったビット単位の平坦な接続グラフ
+///
+/// 以下の3種類の要素からなる．
+/// - ネット: 宣言要素(net/reg/variable)のビットをモジュールの
+///   ポートを通した接続で併合したもの．
+/// - セル: primitive インスタンス(配列の要素を含む)，
+///   continuous assignment，および式で接続されたポート．
+/// - ピン: セルとネットの接続．
+///
+/// セル，ネット，ピンには 0 から始まる番号が振られる．
+/// 番号はエラボレーション結果が同じなら抽出に用いたスレッド数に
+/// よらず同じになる．
+/// - セルはモジュールインスタンスの生成順に，その中では
+///   スコープごとに primitive, primitive array, continuous assignment,
+///   子供のモジュールのポートの順に並ぶ．内部スコープはその後に続く．
+/// - ピンはセルの順に並び，一つのセルのピンは連続している．
+/// - ネットは含まれるビットのうち最初に生成された宣言要素の
+///   ビットの順に並ぶ．
+///
+/// ネットごとのピンのリストは compressed sparse row 形式で持つので
+/// メモリ使用量はピン数とビット数に比例する．
+/// 定数に接続されたピンは作らない．
+//////////////////////////////////////////////////////////////////////
+class VlNetlist
+{
+public:
+
+  /// @brief セルの種類
+  enum class CellType : std::uint8_t {
+    Primitive,  ///< primitive インスタンス
+    ContAssign, ///< continuous assignment
+    Port        ///< 式で接続されたモジュールのポート
+  };
+
+  /// @brief 空のコンストラクタ
+  VlNetlist() = default;
+
+  /// @brief エラボレーション結果から接続グラフを抽出するコンストラクタ
+  ///
+  /// モジュールインスタンスごとの処理を複数のスレッドで行う．
+  VlNetlist(
+    const VlMgr& mgr,       ///< [in] エラボレーション結果
+    SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+  );
+
+  /// @brief デストラクタ
+  ~VlNetlist() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 全体の情報を取り出す関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ネット数を返す．
+  SizeType
+  net_num() const
+  {
+    return mNetPinBegin.empty() ? 0 : mNetPinBegin.size() - 1;
+  }
+
+  /// @brief セル数を返す．
+  SizeType
+  cell_num() const
+  {
+    return mCellType.size();
+  }
+
+  /// @brief ピン数を返す．
+  SizeType
+  pin_num() const
+  {
+    return mPinNet.size();
+  }
+
+  /// @brief ビット数を返す．
+  ///
+  /// 併合する前の宣言要素のビットの総数
+  SizeType
+  bit_num() const
+  {
+    return mBitNet.size();
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // セルの情報を取り出す関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief セルの種類を返す．
+  CellType
+  cell_type(
+    SizeType cell ///< [in] セル番号 ( 0 <= cell < cell_num() )
+  ) const
+  {
+    ASSERT_COND( cell < cell_num() );
+    return mCellType[cell];
+  }
+
+  /// @brief セルの元になったオブジェクトを返す．
+  ///
+  /// cell_type() に応じて VlPrimitive, VlContAssign, VlPort のいずれか
+  const VlObj*
+  cell_obj(
+    SizeType cell ///< [in] セル番号 ( 0 <= cell < cell_num() )
+  ) const
+  {
+    ASSERT_COND( cell < cell_num() );
+    return mCellObj[cell];
+  }
+
+  /// @brief セルのピン数を返す．
+  SizeType
+  cell_pin_num(
+    SizeType cell ///< [in] セル番号 ( 0 <= cell < cell_num() )
+  ) const
+  {
+    ASSERT_COND( cell < cell_num() );
+    return mCellPinBegin[cell + 1] - mCellPinBegin[cell];
+  }
+
+  /// @brief セルのピンを返す．
+  /// @return ピン番号を返す．
+  SizeType
+  cell_pin(
+    SizeType cell, ///< [in] セル番号 ( 0 <= cell < cell_num() )
+    SizeType pos   ///< [in] 位置 ( 0 <= pos < cell_pin_num(cell) )
+  ) const
+  {
+    ASSERT_COND( pos < cell_pin_num(cell) );
+    return mCellPinBegin[cell] + pos;
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // ピンの情報を取り出す関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ピンの属しているセルを返す．
+  SizeType
+  pin_cell(
+    SizeType pin ///< [in] ピン番号 ( 0 <= pin < pin_num() )
+  ) const
+  {
+    ASSERT_COND( pin < pin_num() );
+    return mPinCell[pin];
+  }
+
+  /// @brief ピンの接続しているネットを返す．
+  SizeType
+  pin_net(
+    SizeType pin ///< [in] ピン番号 ( 0 <= pin < pin_num() )
+  ) const
+  {
+    ASSERT_COND( pin < pin_num() );
+    return mPinNet[pin];
+  }
+
+  /// @brief ピンの向きを返す．
+  ///
+  /// セルから見た向きで，Input はネットの値を読むことを表す．
+  VpiDir
+  pin_dir(
+    SizeType pin ///< [in] ピン番号 ( 0 <= pin < pin_num() )
+  ) const
+  {
+    ASSERT_COND( pin < pin_num() );
+    return mPinDir[pin];
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // ネットの情報を取り出す関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ネットに接続しているピンのリストを返す．
+  VlSpan<SizeType>
+  net_pin_list(
+    SizeType net ///< [in] ネット番号 ( 0 <= net < net_num() )
+  ) const
+  {
+    ASSERT_COND( net < net_num() );
+    return VlSpan<SizeType>{mNetPinList.data() + mNetPinBegin[net],
+			    mNetPinList.data() + mNetPinBegin[net + 1]};
+  }
+
+  /// @brief 宣言要素のビットの属するネットを返す．
+  /// @return ネット番号を返す．
+  /// @return 対象外の宣言要素の場合には net_num() を返す．
+  SizeType
+  net_id(
+    const VlDeclBase* decl, ///< [in] 宣言要素
+    SizeType offset         ///< [in] LSB からのビット位置
+  ) const;
+
+  /// @brief 宣言要素の配列の要素のビットの属するネットを返す．
+  /// @return ネット番号を返す．
+  /// @return 対象外の宣言要素の場合には net_num() を返す．
+  SizeType
+  net_id(
+    const VlDeclArray* declarray, ///< [in] 宣言要素の配列
+    SizeType array_offset,        ///< [in] 配列のオフセット
+    SizeType offset               ///< [in] LSB からのビット位置
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 宣言要素の先頭のビット番号の辞書
+  unordered_map<const VlDeclBase*, SizeType> mDeclBitBase;
+
+  // ビットごとのネット番号
+  vector<SizeType> mBitNet;
+
+  // セルの種類
+  vector<CellType> mCellType;
+
+  // セルの元のオブジェクト
+  vector<const VlObj*> mCellObj;
+
+  // セルの先頭のピン番号
+  // 末尾に pin_num() を持つ．
+  vector<SizeType> mCellPinBegin;
+
+  // ピンの属するセル
+  vector<SizeType> mPinCell;
+
+  // ピンの接続するネット
+  vector<SizeType> mPinNet;
+
+  // ピンの向き
+  vector<VpiDir> mPinDir;
+
+  // ネットごとのピンのリストの先頭位置
+  // 末尾に pin_num() を持つ．
+  vector<SizeType> mNetPinBegin;
+
+  // ネットごとのピンのリスト
+  vector<SizeType> mNetPinList;
+
+};
+
+END_NAMESPACE_YM_VERILOG
+
+#endif // YM_VLNETLIST_H
@@ -0,0 +1,142 @@
+﻿#ifndef YM_VLPARALLEL_H
+#define YM_VLPARALLEL_H
+
+/// @file ym/VlParallel.h
+/// @brief vl_parallel_for_each() のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/verilog.h"
+#include "ym/VlSpan.h"
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+/// @brief 並列処理で用いるスレッド数を決める．
+///
+/// thread_num が 0 の場合にはハードウェアのスレッド数を用いる．
+inline
+SizeType
+vl_thread_num(
+  SizeType thread_num ///< [in] 指定されたスレッド数
+)
+{
+  if ( thread_num == 0 ) {
+    thread_num = std::thread::hardware_concurrency();
+  }
+  return thread_num > 0 ? thread_num : 1;
+}
+
+/// @brief [0, n) の範囲をチャンクに分けて複数のスレッドで処理する．
+///
+/// 各スレッドは未処理のチャンクを一つずつ取り出して
+/// func(begin, end) を呼び出す．
+/// func は異なるチャンクに対して同時に呼ばれるのでスレッドセーフで
+/// なければならない．
+/// func が例外を送出した場合には，すべてのスレッドの終了後に
+/// 最初の例外を再送出する．
+/// 一つの要素の処理が重い場合には min_chunk を小さくする．
+template<typename Func>
+void
+vl_parallel_for_chunk(
+  SizeType n,              ///< [in] 要素数
+  Func&& func,             ///< [in] チャンクごとに呼ばれる関数
+  SizeType thread_num = 0, ///< [in] スレッド数(0 の時は自動)
+  SizeType min_chunk = 64  ///< [in] チャンクの要素数の下限
+)
+{
+  thread_num = vl_thread_num(thread_num);
+
+  // スレッド間の負荷の偏りを吸収できるように
+  // スレッド数より多めのチャンクに分ける．
+  // ただし小さすぎるチャンクは切り替えのコストが勝つので下限を設ける．
+  if ( min_chunk == 0 ) {
+    min_chunk = 1;
+  }
+  SizeType chunk = n / (thread_num * 8);
+  if ( chunk < min_chunk ) {
+    chunk = min_chunk;
+  }
+  SizeType chunk_num = (n + chunk - 1) / chunk;
+  if ( thread_num > chunk_num ) {
+    thread_num = chunk_num;
+  }
+  if ( thread_num <= 1 ) {
+    if ( n > 0 ) {
+      func(0, n);
+    }
+    return;
+  }
+
+  std::atomic<SizeType> next{0};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto worker = [&]() {
+    for ( ; ; ) {
+      SizeType c = next.fetch_add(1);
+      if ( c >= chunk_num ) {
+	break;
+      }
+      SizeType begin = c * chunk;
+      SizeType end = std::min(begin + chunk, n);
+      try {
+	func(begin, end);
+      }
+      catch ( ... ) {
+	std::lock_guard<std::mutex> lock{error_mutex};
+	if ( !error ) {
+	  error = std::current_exception();
+	}
+	// 残りのチャンクは処理しない．
+	next = chunk_num;
+	break;
+      }
+    }
+  };
+
+  vector<std::thread> thread_list;
+  thread_list.reserve(thread_num - 1);
+  for ( SizeType i = 1; i < thread_num; ++ i ) {
+    thread_list.emplace_back(worker);
+  }
+  // 呼び出し側のスレッドも処理を行う．
+  worker();
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+  if ( error ) {
+    std::rethrow_exception(error);
+  }
+}
+
+/// @brief span の各要素に対して複数のスレッドで func を適用する．
+///
+/// 要素はチャンク単位でスレッドに割り当てられる．
+/// 適用順は不定である．func はスレッドセーフでなければならない．
+template<typename T, typename Func>
+void
+vl_parallel_for_each(
+  VlSpan<T> span,         ///< [in] 対象の要素の並び
+  Func&& func,            ///< [in] 各要素に適用する関数
+  SizeType thread_num = 0 ///< [in] スレッド数(0 の時は自動)
+)
+{
+  vl_parallel_for_chunk(span.size(),
+			[&](SizeType begin,
+			    SizeType end) {
+			  for ( SizeType i = begin; i < end; ++ i ) {
+			    func(span[i]);
+			  }
+			},
+			thread_num);
+}
+
+END_NAMESPACE_YM_VERILOG
+
+#endif // YM_VLPARALLEL_H
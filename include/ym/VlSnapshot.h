@@ -0,0 +1,365 @@
+﻿#ifndef YM_VLSNAPSHOT_H
+#define YM_VLSNAPSHOT_H
+
+/// @file ym/VlSnapshot.h
+/// @brief VlSnapshot のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/verilog.h"
+#include "ym/VlSpan.h"
+#include "ym/ClibCellLibrary.h"
+#include <cstdint>
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+class VlMgr;
+
+//////////////////////////////////////////////////////////////////////
+/// @class VlSnapshot VlSnapshot.h "ym/VlSnapshot.h"
+/// @brief VlMgr::save_elaborated() で保存したエラボレーション結果を
+///        読み出すクラス
+///
+/// ファイルはポインタを含まない固定長のレコードの配列と文字列の表から
+/// なるので，open() ではファイルをメモリにマップして内容を検査するだけで
+/// 各レコードはマップしたページをそのまま参照する．
+///
+/// 保存される内容は以下の通り．
+/// - スコープ(トップレベル，モジュール，内部スコープ，タスク，関数)
+/// - 宣言要素(配列を含む)
+/// - primitive インスタンスとその端子
+/// - continuous assignment
+/// - UDP 定義
+/// - 上記の要素に付加された属性
+///
+/// 宣言要素，primitive, continuous assignment はスコープごとに
+/// 連続して並んでいるので，スコープごとのリストは VlSpan として取り出せる．
+/// 式は VlExpr::decompile() の結果の文字列として保存される．
+///
+/// ファイルには入力ファイルの内容とセルライブラリから求めたハッシュ値が
+/// 記録されており，open() に与えたハッシュ値と異なる場合は古いものとして
+/// 読み込まない．
+/// また，インクルードファイルを含めて読み込んだファイルごとに
+/// 読み込んだ時点の内容のハッシュ値が記録されており，open() の時点の
+/// 内容と異なる場合も読み込まない．
+//////////////////////////////////////////////////////////////////////
+class VlSnapshot
+{
+public:
+
+  /// @brief 該当する要素がないことを表す番号
+  static constexpr std::uint32_t NONE = 0xFFFFFFFFU;
+
+  /// @brief スコープを表すレコード
+  struct Scope
+  {
+    std::uint32_t mName;             ///< 名前
+    std::uint32_t mDefName;          ///< モジュールの定義名(NONE の場合あり)
+    std::uint32_t mParent;           ///< 親のスコープ(NONE の場合あり)
+    std::uint32_t mType;             ///< VpiObjType
+    std::uint32_t mDeclBegin;        ///< 宣言要素の先頭
+    std::uint32_t mDeclEnd;          ///< 宣言要素の末尾の次
+    std::uint32_t mPrimBegin;        ///< primitive の先頭
+    std::uint32_t mPrimEnd;          ///< primitive の末尾の次
+    std::uint32_t mContAssignBegin;  ///< continuous assignment の先頭
+    std::uint32_t mContAssignEnd;    ///< continuous assignment の末尾の次
+  };
+
+  /// @brief 宣言要素を表すレコード
+  struct Decl
+  {
+    std::uint32_t mName;      ///< 名前
+    std::uint32_t mScope;     ///< 親のスコープ
+    std::uint32_t mTag;       ///< タグ(vpiNet など)
+    std::uint32_t mType;      ///< VpiObjType
+    std::int32_t  mLeft;      ///< 範囲の MSB
+    std::int32_t  mRight;     ///< 範囲の LSB
+    std::uint32_t mBitSize;   ///< ビット幅
+    std::uint32_t mFlags;     ///< 符号付きなら bit0，範囲を持つなら bit1
+    std::uint32_t mArraySize; ///< 配列の要素数(配列でない場合は 0)
+    std::uint32_t mInitValue; ///< 初期値の式(NONE の場合あり)
+  };
+
+  /// @brief primitive インスタンスを表すレコード
+  struct Prim
+  {
+    std::uint32_t mName;      ///< 名前(NONE の場合あり)
+    std::uint32_t mScope;     ///< 親のスコープ
+    std::uint32_t mPrimType;  ///< VpiPrimType
+    std::uint32_t mDefName;   ///< 定義名
+    std::uint32_t mUdp;       ///< UDP 定義の番号(NONE の場合あり)
+    std::uint32_t mTermBegin; ///< 端子の先頭
+    std::uint32_t mTermEnd;   ///< 端子の末尾の次
+  };
+
+  /// @brief primitive の端子を表すレコード
+  struct PrimTerm
+  {
+    std::uint32_t mDir;       ///< VpiDir
+    std::uint32_t mExpr;      ///< 接続している式
+  };
+
+  /// @brief continuous assignment を表すレコード
+  struct ContAssign
+  {
+    std::uint32_t mScope;     ///< 親のスコープ
+    std::uint32_t mLhs;       ///< 左辺式
+    std::uint32_t mRhs;       ///< 右辺式
+  };
+
+  /// @brief UDP 定義を表すレコード
+  struct Udp
+  {
+    std::uint32_t mName;      ///< 定義名
+    std::uint32_t mPrimType;  ///< VpiPrimType
+    std::uint32_t mPortNum;   ///< ポート数
+    std::uint32_t mInitVal;   ///< 初期値を表す文字列
+    std::uint32_t mRowBegin;  ///< table entry の先頭
+    std::uint32_t mRowEnd;    ///< table entry の末尾の次
+  };
+
+  /// @brief 読み込んだファイルを表すレコード
+  struct Dep
+  {
+    std::uint32_t mName;      ///< パス名
+    std::uint32_t mReserved;  ///< 未使用(0)
+    std::uint64_t mHash;      ///< 読み込んだ時点の内容のハッシュ値
+  };
+
+  /// @brief 属性の付加されている要素の種類
+  enum ObjKind : std::uint32_t {
+    kScope,
+    kDecl,
+    kPrim,
+    kContAssign
+  };
+
+  /// @brief 属性を表すレコード
+  struct Attr
+  {
+    std::uint32_t mObjKind;   ///< 対象の要素の種類(ObjKind)
+    std::uint32_t mObjId;     ///< 対象の要素の番号
+    std::uint32_t mName;      ///< 名前
+    std::uint32_t mExpr;      ///< 値の式(NONE の場合あり)
+    std::uint32_t mDef;       ///< 定義側の属性なら 1
+  };
+
+
+public:
+
+  /// @brief コンストラクタ
+  VlSnapshot() = default;
+
+  /// @brief コピーは禁止
+  VlSnapshot(const VlSnapshot&) = delete;
+
+  /// @brief コピー代入は禁止
+  VlSnapshot&
+  operator=(const VlSnapshot&) = delete;
+
+  /// @brief デストラクタ
+  ~VlSnapshot();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 読み込みと書き込み
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルの内容からハッシュ値を求める．
+  ///
+  /// 読めないファイルの場合も失敗はせずに特別な値を返す．
+  static
+  std::uint64_t
+  file_hash(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief セルライブラリのハッシュ値を求める．
+  ///
+  /// セル名とピン名，ピンの向きを用いる．
+  static
+  std::uint64_t
+  library_hash(
+    const ClibCellLibrary& cell_library ///< [in] セルライブラリ
+  );
+
+  /// @brief 入力ファイルの内容とセルライブラリからハッシュ値を求める．
+  ///
+  /// ファイル名と file_hash() の値を順に用いる．
+  /// 読めないファイルがあっても異なる値になるだけで失敗はしない．
+  static
+  std::uint64_t
+  input_hash(
+    const vector<string>& filename_list,  ///< [in] 入力ファイル名のリスト
+    const ClibCellLibrary& cell_library   ///< [in] セルライブラリ
+    = ClibCellLibrary()
+  );
+
+  /// @brief 求めておいたファイルごとのハッシュ値からハッシュ値を求める．
+  ///
+  /// 各ファイルの file_hash() を与えれば
+  /// input_hash(filename_list, cell_library) と同じ値になる．
+  static
+  std::uint64_t
+  input_hash(
+    const vector<pair<string, std::uint64_t>>& file_hash_list, ///< [in] ファイル名とハッシュ値のリスト
+    const ClibCellLibrary& cell_library                        ///< [in] セルライブラリ
+  );
+
+  /// @brief エラボレーション結果をファイルに書き出す．
+  /// @retval true 成功した．
+  /// @retval false 書き込みに失敗した．
+  ///
+  /// 通常は VlMgr::save_elaborated() を用いる．
+  static
+  bool
+  save(
+    const VlMgr& mgr,          ///< [in] エラボレーション結果
+    const string& path,        ///< [in] 出力先のファイル名
+    std::uint64_t input_hash,  ///< [in] 入力ファイルのハッシュ値
+    const vector<pair<string, std::uint64_t>>& dep_list
+    = {}                       ///< [in] 読み込んだファイルと
+                               ///<      その時点のハッシュ値のリスト
+  );
+
+  /// @brief ファイルを開く．
+  /// @retval true 成功した．
+  /// @retval false ファイルが読めないか，形式が異なるか，
+  ///               ハッシュ値が異なるか，読み込んだファイルの
+  ///               内容が変わっている．
+  ///
+  /// すでに開いているファイルは閉じられる．
+  bool
+  open(
+    const string& path,        ///< [in] ファイル名
+    std::uint64_t input_hash   ///< [in] 期待する入力ファイルのハッシュ値
+  );
+
+  /// @brief ファイルを閉じる．
+  void
+  close();
+
+  /// @brief ファイルを開いている時 true を返す．
+  bool
+  is_open() const
+  {
+    return mData != nullptr;
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 内容を取り出す関数
+  //
+  // いずれも open() が成功している場合のみ意味を持つ．
+  // 結果は close() が呼ばれるまで有効である．
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 文字列を返す．
+  ///
+  /// id が NONE の場合には空文字列を返す．
+  std::string_view
+  str(
+    std::uint32_t id ///< [in] 文字列の番号
+  ) const;
+
+  /// @brief スコープのリストを返す．
+  VlSpan<Scope>
+  scope_list() const;
+
+  /// @brief 宣言要素のリストを返す．
+  VlSpan<Decl>
+  decl_list() const;
+
+  /// @brief スコープに属する宣言要素のリストを返す．
+  VlSpan<Decl>
+  decl_list(
+    std::uint32_t scope ///< [in] スコープの番号
+  ) const;
+
+  /// @brief primitive のリストを返す．
+  VlSpan<Prim>
+  prim_list() const;
+
+  /// @brief スコープに属する primitive のリストを返す．
+  VlSpan<Prim>
+  prim_list(
+    std::uint32_t scope ///< [in] スコープの番号
+  ) const;
+
+  /// @brief primitive の端子のリストを返す．
+  VlSpan<PrimTerm>
+  prim_term_list(
+    std::uint32_t prim ///< [in] primitive の番号
+  ) const;
+
+  /// @brief continuous assignment のリストを返す．
+  VlSpan<ContAssign>
+  contassign_list() const;
+
+  /// @brief スコープに属する continuous assignment のリストを返す．
+  VlSpan<ContAssign>
+  contassign_list(
+    std::uint32_t scope ///< [in] スコープの番号
+  ) const;
+
+  /// @brief UDP 定義のリストを返す．
+  VlSpan<Udp>
+  udp_list() const;
+
+  /// @brief UDP 定義の table entry のリストを返す．
+  /// @return 各行の文字列の番号のリストを返す．
+  VlSpan<std::uint32_t>
+  udp_table(
+    std::uint32_t udp ///< [in] UDP 定義の番号
+  ) const;
+
+  /// @brief 属性のリストを返す．
+  VlSpan<Attr>
+  attr_list() const;
+
+  /// @brief 読み込んだファイルのリストを返す．
+  VlSpan<Dep>
+  dep_list() const;
+
+  /// @brief スコープの階層名を返す．
+  string
+  scope_full_name(
+    std::uint32_t scope ///< [in] スコープの番号
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief セクションの先頭と末尾を返す．
+  template<typename T>
+  VlSpan<T>
+  section(
+    SizeType id ///< [in] セクション番号
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // マップした領域の先頭
+  const char* mData{nullptr};
+
+  // マップした領域のサイズ
+  SizeType mSize{0};
+
+};
+
+END_NAMESPACE_YM_VERILOG
+
+#endif // YM_VLSNAPSHOT_H
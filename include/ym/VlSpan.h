@@ -0,0 +1,127 @@
+﻿#ifndef YM_VLSPAN_H
+#define YM_VLSPAN_H
+
+/// @file ym/VlSpan.h
+/// @brief VlSpan のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/verilog.h"
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+/// @class VlSpan VlSpan.h "ym/VlSpan.h"
+/// @brief 連続した要素の配列を参照するビュー
+///
+/// 要素をコピーせずに先頭と末尾のポインタだけを持つ．
+/// 参照先の配列を所有しないので，参照先が変更・破棄されると無効になる．
+/// VlMgr の find_xxx_span() の結果はエラボレーション結果に要素が
+/// 追加されるか VlMgr::clear() が呼ばれるまで有効である．
+//////////////////////////////////////////////////////////////////////
+template<typename T>
+class VlSpan
+{
+public:
+
+  using value_type = T;
+  using const_iterator = const T*;
+
+public:
+
+  /// @brief 空のコンストラクタ
+  ///
+  /// 空の配列を表す．
+  VlSpan() = default;
+
+  /// @brief 範囲を指定したコンストラクタ
+  VlSpan(
+    const T* begin, ///< [in] 先頭のポインタ
+    const T* end    ///< [in] 末尾の次のポインタ
+  ) : mBegin{begin},
+      mEnd{end}
+  {
+  }
+
+  /// @brief vector の内容を参照するコンストラクタ
+  VlSpan(
+    const vector<T>& src ///< [in] 参照元の配列
+  ) : mBegin{src.data()},
+      mEnd{src.data() + src.size()}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~VlSpan() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 要素数を返す．
+  SizeType
+  size() const
+  {
+    return mEnd - mBegin;
+  }
+
+  /// @brief 空の時 true を返す．
+  bool
+  empty() const
+  {
+    return mBegin == mEnd;
+  }
+
+  /// @brief 要素を返す．
+  const T&
+  operator[](
+    SizeType pos ///< [in] 位置 ( 0 <= pos < size() )
+  ) const
+  {
+    ASSERT_COND( pos < size() );
+    return mBegin[pos];
+  }
+
+  /// @brief 先頭の反復子を返す．
+  const_iterator
+  begin() const
+  {
+    return mBegin;
+  }
+
+  /// @brief 末尾の反復子を返す．
+  const_iterator
+  end() const
+  {
+    return mEnd;
+  }
+
+  /// @brief 内容をコピーした vector を返す．
+  vector<T>
+  to_vector() const
+  {
+    return vector<T>(mBegin, mEnd);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 先頭のポインタ
+  const T* mBegin{nullptr};
+
+  // 末尾の次のポインタ
+  const T* mEnd{nullptr};
+
+};
+
+END_NAMESPACE_YM_VERILOG
+
+#endif // YM_VLSPAN_H
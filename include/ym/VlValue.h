@@ -132,8 +132,12 @@ public:
 /// @class VlValue VlValue.h "ym/VlValue.h"
 /// @brief 値を表すクラス
 ///
-/// 型に応じた VlValueRep の派生クラスが実際の値を保持する．
-/// このクラスはそのオブジェクとへの shared_ptr を持つ．
+/// 整数，符号なし整数，スカラー，実数，time 型の値は
+/// このクラスの中に直接保持する．
+/// ビットベクタ型の値も BitVector がヒープ領域を使わない長さ
+/// (INLINE_BITS ビット)以下ならばこのクラスの中に直接保持する．
+/// それより長いビットベクタ型の場合のみ VlValueRep の派生クラスが
+/// 実際の値を保持し，このクラスはそのオブジェクトへの shared_ptr を持つ．
 //////////////////////////////////////////////////////////////////////
 class VlValue
 {
@@ -278,7 +282,7 @@ public:
 
   /// @brief 型を返す．
   Type
-  type() const { return mRep->type(); }
+  type() const { return mType; }
 
   /// @brief 整数型の時に true を返す．
   bool
@@ -310,23 +314,23 @@ public:
 
   /// @brief 整数型に変換可能な時に true を返す．
   bool
-  is_int_compat() const { return mRep->is_int_compat(); }
+  is_int_compat() const;
 
   /// @brief unsigned uint 型に変換可能な時に true を返す．
   bool
-  is_uint_compat() const { return mRep->is_uint_compat(); }
+  is_uint_compat() const;
 
   /// @brief 実数型に変換可能な時に true を返す．
   bool
-  is_real_compat() const { return mRep->is_real_compat(); }
+  is_real_compat() const;
 
   /// @brief time 型に変換可能な時に true を返す．
   bool
-  is_time_compat() const { return mRep->is_time_compat(); }
+  is_time_compat() const;
 
   /// @brief ビットベクタ型に変換可能な時に true を返す．
   bool
-  is_bitvector_compat() const { return mRep->is_bitvector_compat(); }
+  is_bitvector_compat() const;
 
   /// @brief 符号付きの型の時に true を返す．
   bool
@@ -411,40 +415,70 @@ public:
   /// @brief 整数型の値を返す．
   /// @note 値が整数型に変換できない時の値は不定
   int
-  int_value() const { return mRep->int_value(); }
+  int_value() const;
 
   /// @brief unsigned int 型の値を返す．
   /// @note 値が整数型に変換できない時の値は不定
   unsigned int
-  uint_value() const { return mRep->uint_value(); }
+  uint_value() const;
 
   /// @brief スカラー型の値を返す．
   /// @note スカラー型には常に変換可能
   VlScalarVal
-  scalar_value() const { return mRep->scalar_value(); }
+  scalar_value() const;
 
   /// @brief 論理型の値を返す．
   VlScalarVal
-  logic_value() const { return mRep->logic_value(); }
+  logic_value() const;
 
   /// @brief 実数型の値を返す．
   /// @note 値が実数型に変換できない時の値は不定
   double
-  real_value() const { return mRep->real_value(); }
+  real_value() const;
 
   /// @brief time 型の値を返す．
   /// @note 値が time 型に変換できない時の値は不定
   VlTime
-  time_value() const { return mRep->time_value(); }
+  time_value() const;
 
   /// @brief ビットベクタ型の値を返す．
   BitVector
   bitvector_value(
     const VlValueType& req_type = {} ///< [in] 要求されるデータの型
-  ) const
-  {
-    return mRep->bitvector_value(req_type);
-  }
+  ) const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // その他の関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ハッシュ値を返す．
+  SizeType
+  hash() const;
+
+  /// @brief 型と値が全く等しい時に true を返す．
+  ///
+  /// eq() や operator== と異なり，型が異なれば等しくないと見なし，
+  /// x/z も値として比較する．
+  /// 値をキーとする辞書で用いる．
+  bool
+  is_identical(
+    const VlValue& right ///< [in] 比較対象
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 型変換を行いながら値を設定する．
+  void
+  set_with_type(
+    const VlValue& src,           ///< [in] 元の値
+    const VlValueType& value_type ///< [in] 型
+  );
 
 
 private:
@@ -452,7 +486,30 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 値を持つ実体
+  // 値の型
+  Type mType{Type::ERROR};
+
+  // ビットベクタ型以外の値
+  // mType に対応したメンバのみが意味を持つ．
+  union {
+    int mInt{0};
+    unsigned int mUint;
+    VlScalarVal mScalar;
+    double mReal;
+    VlTime mTime;
+  };
+
+  // 直接保持するビットベクタの最大長
+  // BitVector が内部の配列に持てる2ワード分
+  static
+  const SizeType INLINE_BITS = 128;
+
+  // INLINE_BITS 以下のビットベクタ型の値
+  // mRep が nullptr の時のみ意味を持つ．
+  BitVector mBitVector;
+
+  // INLINE_BITS を越えるビットベクタ型の値を持つ実体
+  // それ以外の時は nullptr
   shared_ptr<VlValueRep> mRep;
 
 };
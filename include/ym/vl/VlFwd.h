@@ -23,6 +23,9 @@ class VlNamedObj;
 // in VlScope.h
 class VlScope;
 
+// in VlHierName.h
+class VlHierName;
+
 // in VlDeclBase.h
 class VlDeclBase;
 
@@ -96,6 +99,7 @@ BEGIN_NAMESPACE_YM
 using nsVerilog::VlObj;
 using nsVerilog::VlNamedObj;
 using nsVerilog::VlScope;
+using nsVerilog::VlHierName;
 using nsVerilog::VlDeclBase;
 using nsVerilog::VlDecl;
 using nsVerilog::VlDeclArray;
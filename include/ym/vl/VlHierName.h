@@ -0,0 +1,185 @@
+#ifndef YM_VL_VLHIERNAME_H
+#define YM_VL_VLHIERNAME_H
+
+/// @file ym/vl/VlHierName.h
+/// @brief VlHierName のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/vl/VlNamedObj.h"
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+/// @class VlHierName VlHierName.h "ym/vl/VlHierName.h"
+/// @brief 階層名を表すハンドル
+///
+/// エラボレーション結果の中では同じ階層名を持つ要素は一つしかないので
+/// 要素へのポインタをそのまま階層名の識別子として用いる．
+/// そのため文字列を作らずに等価比較やハッシュ値の計算ができる．
+/// 文字列が必要になった時点で str() や write() で取り出す．
+//////////////////////////////////////////////////////////////////////
+class VlHierName
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// 引数を省略した場合には不正値となる．
+  VlHierName(
+    const VlNamedObj* obj = nullptr ///< [in] 対象の要素
+  ) : mObj{obj}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~VlHierName() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 適正な値を持っている時 true を返す．
+  bool
+  is_valid() const
+  {
+    return mObj != nullptr;
+  }
+
+  /// @brief 対象の要素を返す．
+  const VlNamedObj*
+  obj() const
+  {
+    return mObj;
+  }
+
+  /// @brief 親の階層名を返す．
+  VlHierName
+  parent() const;
+
+  /// @brief 階層の深さを返す．
+  ///
+  /// 名前を持たない toplevel は数えない．
+  SizeType
+  depth() const;
+
+  /// @brief 階層名の文字列を返す．
+  ///
+  /// VlNamedObj::full_name() と同じ内容を返す．
+  string
+  str() const
+  {
+    if ( mObj == nullptr ) {
+      return string();
+    }
+    return mObj->full_name();
+  }
+
+  /// @brief 階層名をストリームに書き出す．
+  void
+  write(
+    ostream& s ///< [in] 出力先のストリーム
+  ) const
+  {
+    if ( mObj != nullptr ) {
+      mObj->write_full_name(s);
+    }
+  }
+
+  /// @brief 階層名の比較
+  /// @retval -1 this < right
+  /// @retval  0 this == right
+  /// @retval  1 this > right
+  ///
+  /// 上位の階層から順に要素名を文字列として比較する．
+  /// 名前が全て等しい異なる要素(名前を持たない要素など)は
+  /// ポインタの順で並べるので，0 を返すのは同じ要素の場合のみで
+  /// operator==() と一致する．
+  int
+  compare(
+    const VlHierName& right ///< [in] 比較対象
+  ) const;
+
+  /// @brief 等価比較
+  bool
+  operator==(
+    const VlHierName& right ///< [in] 比較対象
+  ) const
+  {
+    return mObj == right.mObj;
+  }
+
+  /// @brief 非等価比較
+  bool
+  operator!=(
+    const VlHierName& right ///< [in] 比較対象
+  ) const
+  {
+    return !operator==(right);
+  }
+
+  /// @brief 小なり比較
+  ///
+  /// compare() の結果に従う．
+  bool
+  operator<(
+    const VlHierName& right ///< [in] 比較対象
+  ) const
+  {
+    return compare(right) < 0;
+  }
+
+  /// @brief ハッシュ値を返す．
+  SizeType
+  hash() const
+  {
+    auto tmp = reinterpret_cast<PtrIntType>(mObj) / sizeof(void*);
+    return static_cast<SizeType>(tmp);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象の要素
+  const VlNamedObj* mObj;
+
+};
+
+/// @brief ストリーム出力演算子
+inline
+ostream&
+operator<<(
+  ostream& s,             ///< [in] 出力先のストリーム
+  const VlHierName& name  ///< [in] 階層名
+)
+{
+  name.write(s);
+  return s;
+}
+
+END_NAMESPACE_YM_VERILOG
+
+BEGIN_NAMESPACE_STD
+
+// VlHierName をキーにしたハッシュ関数クラスの定義
+template <>
+struct hash<YM_NAMESPACE::nsVerilog::VlHierName>
+{
+  SizeType
+  operator()(const YM_NAMESPACE::nsVerilog::VlHierName& name) const
+  {
+    return name.hash();
+  }
+};
+
+END_NAMESPACE_STD
+
+#endif // YM_VL_VLHIERNAME_H
@@ -48,6 +48,15 @@ public:
   string
   full_name() const;
 
+  /// @brief fullname をストリームに書き出す．
+  ///
+  /// full_name() と同じ内容を中間の文字列を作らずに出力する．
+  virtual
+  void
+  write_full_name(
+    ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
 };
 
 END_NAMESPACE_YM_VERILOG
@@ -10,6 +10,7 @@
 
 #include "ym/vl/VlNamedObj.h"
 #include "ym/vl/VlFwd.h"
+#include <mutex>
 
 
 BEGIN_NAMESPACE_YM_VERILOG
@@ -19,10 +20,52 @@ BEGIN_NAMESPACE_YM_VERILOG
 /// @brief スコープを表すクラス
 ///
 /// 実は VlNamedObj と同一のクラス
+///
+/// ただし，スコープの fullname は配下の全ての要素の fullname の
+/// 接頭辞となるので最初に求めた時にキャッシュしておく．
+/// キャッシュの作成は std::call_once() で保護されているので
+/// 複数のスレッドから同時に full_name() を呼んでも良い．
 //////////////////////////////////////////////////////////////////////
 class VlScope :
   public VlNamedObj
 {
+public:
+  //////////////////////////////////////////////////////////////////////
+  // VlNamedObj の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief fullname の取得
+  string
+  full_name() const override;
+
+  /// @brief fullname をストリームに書き出す．
+  void
+  write_full_name(
+    ostream& s ///< [in] 出力先のストリーム
+  ) const override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief キャッシュされた fullname を返す．
+  const string&
+  cached_full_name() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // fullname のキャッシュ
+  mutable string mFullName;
+
+  // mFullName を一度だけ作るためのフラグ
+  mutable std::once_flag mFullNameFlag;
+
 };
 
 END_NAMESPACE_YM_VERILOG
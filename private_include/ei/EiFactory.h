@@ -340,21 +340,21 @@ public:
   /// @brief セルプリミティブインスタンスを生成する．
   ElbPrimitive*
   new_CellPrimitive(
-    ElbPrimHead* head,    ///< [in] ヘッダ
-    const ClibCell& cell, ///< [in] セル
-    const PtInst* pt_inst ///< [in] インスタンス定義
+    ElbPrimHead* head,              ///< [in] ヘッダ
+    const vector<VpiDir>& dir_list, ///< [in] ピンの向きのリスト
+    const PtInst* pt_inst           ///< [in] インスタンス定義
   ) override;
 
   /// @brief セルプリミティブ配列インスタンスを生成する．
   ElbPrimArray*
   new_CellPrimitiveArray(
-    ElbPrimHead* head,     ///< [in] ヘッダ
-    const ClibCell& cell,  ///< [in] セル
-    const PtInst* pt_inst, ///< [in] インスタンス定義
-    const PtExpr* left,    ///< [in] 範囲の MSB の式
-    const PtExpr* right,   ///< [in] 範囲の LSB の式
-    int left_val,          ///< [in] 範囲の MSB の値
-    int right_val          ///< [in] 範囲の LSB の値
+    ElbPrimHead* head,              ///< [in] ヘッダ
+    const vector<VpiDir>& dir_list, ///< [in] ピンの向きのリスト
+    const PtInst* pt_inst,          ///< [in] インスタンス定義
+    const PtExpr* left,             ///< [in] 範囲の MSB の式
+    const PtExpr* right,            ///< [in] 範囲の LSB の式
+    int left_val,                   ///< [in] 範囲の MSB の値
+    int right_val                   ///< [in] 範囲の LSB の値
   ) override;
 
   /// @brief function を生成する．
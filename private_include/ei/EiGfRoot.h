@@ -70,6 +70,12 @@ public:
   // ElbGfRoot の仮想関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 子供のスコープの数の見積もりを設定する．
+  void
+  reserve(
+    SizeType num
+  ) override;
+
   /// @brief 子供のスコープを追加する．
   void
   add(
@@ -95,7 +101,18 @@ private:
   // 対応するパース木の要素
   const PtItem* mPtItem;
 
-  // 子供のスコープのハッシュ表
+  // インデックスが等差数列になっている場合の先頭のインデックス
+  int mOffset{0};
+
+  // インデックスが等差数列になっている場合の公差
+  int mStride{0};
+
+  // インデックスが等差数列になっている場合の子供のスコープの配列
+  // mStride * i + mOffset 番目の要素が i 番目に入る．
+  vector<const VlScope*> mArray;
+
+  // インデックスが等差数列でない場合の子供のスコープのハッシュ表
+  // 空でない時にはこちらを使う．
   unordered_map<SizeType, const VlScope*> mTable;
 
 };
@@ -400,11 +400,10 @@ protected:
     SizeType port_num ///< [in] ポート数
   );
 
-  /// @brief ポート配列を初期化する．
+  /// @brief セルのポート配列を初期化する．
   void
   init_port(
-    SizeType port_num,   ///< [in] ポート数
-    const ClibCell& cell ///< [in] セル
+    const vector<VpiDir>& dir_list ///< [in] ピンの向きのリスト
   );
 
 
@@ -459,13 +458,12 @@ public:
     SizeType port_num        ///< [in] 端子数
   );
 
-  /// @brief 初期設定を行う．
+  /// @brief セルの要素として初期設定を行う．
   void
   init(
-    EiPrimArray* prim_array, ///< [in] 親の配列
-    SizeType index,          ///< [in] インデックス番号
-    SizeType port_num,       ///< [in] 端子数
-    const ClibCell& cell     ///< [in] セル
+    EiPrimArray* prim_array,       ///< [in] 親の配列
+    SizeType index,                ///< [in] インデックス番号
+    const vector<VpiDir>& dir_list ///< [in] ピンの向きのリスト
   );
 
 
@@ -524,9 +522,9 @@ public:
 
   /// @brief コンストラクタ
   EiPrimitive2(
-    ElbPrimHead* head,    ///< [in] ヘッダ
-    const ClibCell& cell, ///< [in] セル
-    const PtInst* pt_inst ///< [in] インスタンス定義
+    ElbPrimHead* head,              ///< [in] ヘッダ
+    const vector<VpiDir>& dir_list, ///< [in] ピンの向きのリスト
+    const PtInst* pt_inst           ///< [in] インスタンス定義
   );
 
   /// @brief デストラクタ
@@ -589,10 +587,10 @@ public:
 
   /// @brief コンストラクタ
   EiPrimArray(
-    ElbPrimHead* head,       ///< [in] ヘッダ
-    const ClibCell& cell,    ///< [in] セル
-    const PtInst* pt_inst,   ///< [in] インスタンス定義
-    const EiRangeImpl& range ///< [in] 範囲
+    ElbPrimHead* head,              ///< [in] ヘッダ
+    const vector<VpiDir>& dir_list, ///< [in] ピンの向きのリスト
+    const PtInst* pt_inst,          ///< [in] インスタンス定義
+    const EiRangeImpl& range        ///< [in] 範囲
   );
 
   /// @brief デストラクタ
@@ -58,6 +58,14 @@ public:
   string
   full_name() const override;
 
+  /// @brief fullname をストリームに書き出す．
+  ///
+  /// このクラスでは何も出力しない．
+  void
+  write_full_name(
+    ostream& s ///< [in] 出力先のストリーム
+  ) const override;
+
 };
 
 END_NAMESPACE_YM_VERILOG
@@ -36,6 +36,8 @@ class ExprGen;
 class ExprEval;
 class AttrGen;
 class DefParamStub;
+class CellCache;
+class CellInfo;
 
 //////////////////////////////////////////////////////////////////////
 /// @class Elaborator Elaborator.h "Elaborator.h"
@@ -52,8 +54,10 @@ public:
 
   /// @brief コンストラクタ
   Elaborator(
-    ElbMgr& elb_mgr,                    ///< [in] Elbオブジェクトを管理するクラス
-    const ClibCellLibrary& cell_library ///< [in] セルライブラリ
+    ElbMgr& elb_mgr,                     ///< [in] Elbオブジェクトを管理するクラス
+    const ClibCellLibrary& cell_library, ///< [in] セルライブラリ
+    bool info_msg = true,                ///< [in] 情報メッセージを出力する時 true
+    bool lazy = false                    ///< [in] phase3 を遅延させる時 true
   );
 
   /// @brief デストラクタ
@@ -71,12 +75,60 @@ public:
     const PtMgr& pt_mgr ///< [in] パース木を管理するクラス
   );
 
+  /// @brief 読み直したモジュール定義に関係する部分だけを作り直す．
+  /// @retval true 作り直しが行えた．
+  /// @retval false 全体をエラボレーションし直す必要がある．
+  ///
+  /// module_set は読み直す前のモジュール定義の集合で，そのインスタンスと
+  /// それらの要素を参照しているインスタンスを ElbMgr から削除した後，
+  /// pt_mgr の新しいモジュール定義を用いて同じ場所に作り直す．
+  /// モジュール名の集合とトップモジュールが変わっていないことと，
+  /// 前回のエラボレーションでエラーが起きていないことは
+  /// 呼び出し側で確認しておくこと．
+  /// false の場合の ElbMgr の内容は正しくないので clear() してから
+  /// 新たな Elaborator でエラボレーションし直すこと．
+  bool
+  rebuild(
+    const PtMgr& pt_mgr,                             ///< [in] パース木を管理するクラス
+    const unordered_set<const PtModule*>& module_set ///< [in] 読み直したモジュール定義の集合
+  );
+
+  /// @brief スコープに記述された要素の phase3 の処理を行う．
+  ///
+  /// 遅延モードの場合のみ意味を持つ．
+  /// scope を含むモジュールまでの外側のスコープの処理も行う．
+  /// 処理済みの場合には何もしない．
+  void
+  elaborate_scope(
+    const VlScope* scope ///< [in] 対象のスコープ
+  );
+
+  /// @brief 残っている phase3 の処理をすべて行う．
+  ///
+  /// 遅延モードの場合のみ意味を持つ．
+  void
+  elaborate_all();
+
+  /// @brief 未処理の phase3 の処理が残っている時 true を返す．
+  bool
+  has_pending_stub() const
+  {
+    return !mLazyStubDict.empty();
+  }
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // elaboration で用いられる下請け関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief トップモジュールの骨組みを作った後の残りの処理を行う．
+  ///
+  /// defparam 文の適用と phase1 の処理を繰り返した後，
+  /// phase2 と phase3 の処理を行う．
+  void
+  elaborate_rest();
+
   /// @brief 後で処理する defparam 文を登録する．
   void
   add_defparamstub(
@@ -84,6 +136,16 @@ private:
     const PtItem* header    ///< [in] defparam 文のテンプレート
   );
 
+  /// @brief 適用可能な defparam 文を適用する．
+  void
+  instantiate_defparam();
+
+  /// @brief name を階層名に含む未解決の defparam 文を処理待ちにする．
+  void
+  wake_defparam(
+    const string& name ///< [in] 要素名
+  );
+
   /// @brief phase1 で行う処理を登録する．
   void
   add_phase1stub(
@@ -99,7 +161,8 @@ private:
   /// @brief phase3 で行う処理を登録する．
   void
   add_phase3stub(
-    ElbStub* stub ///< [in] phase3 で行う処理を表すスタブ
+    const VlScope* scope, ///< [in] 処理する要素の記述されたスコープ
+    ElbStub* stub         ///< [in] phase3 で行う処理を表すスタブ
   );
 
 
@@ -133,13 +196,14 @@ private:
   ) const;
 
   /// @brief セルの探索
-  /// @return name という名のセルを返す．
+  /// @return name という名のセルの情報を返す．
   ///
-  /// なければ不正値を返す．
-  ClibCell
+  /// なければ nullptr を返す．
+  /// 結果はセル名ごとにキャッシュされる．
+  const CellInfo*
   find_cell(
     const string& name ///< [in] セル名
-  ) const;
+  );
 
 
 public:
@@ -172,12 +236,18 @@ private:
   // エラボレーションを行ったことを示すフラグ
   bool mDone;
 
+  // phase3 をスコープごとに遅延させる時 true にするフラグ
+  bool mLazy;
+
   // 生成したオブジェクトを管理するクラス
   ElbMgr& mMgr;
 
   // セルライブラリ
   ClibCellLibrary mCellLibrary;
 
+  // セルの情報のキャッシュ
+  unique_ptr<CellCache> mCellCache;
+
   // UDP 生成用のオブジェクト
   unique_ptr<UdpGen> mUdpGen;
 
@@ -215,7 +285,17 @@ private:
   AttrDict mAttrDict;
 
   // defparam 文の元のリスト
-  list<DefParamStub> mDefParamStubList;
+  vector<DefParamStub> mDefParamStubList;
+
+  // mDefParamStubList の各要素が適用済みの時 true となる配列
+  vector<bool> mDefParamDone;
+
+  // 次に適用を試みる defparam 文の番号のリスト
+  vector<SizeType> mDefParamQueue;
+
+  // 階層名に含まれる要素名をキーにして defparam 文の番号のリストを
+  // 保持する辞書
+  unordered_map<string, vector<SizeType>> mDefParamIndex;
 
   // phase1 で生成するオブジェクトを追加するリスト
   ElbStubList mPhase1StubList1;
@@ -229,6 +309,13 @@ private:
   // phase3 で link するオブジェクトを入れたリスト
   ElbStubList mPhase3StubList;
 
+  // 遅延モードの phase3 の処理をスコープごとに保持する辞書
+  unordered_map<const VlScope*, ElbStubList> mLazyStubDict;
+
+  // mLazyStubDict に登録されたスコープのリスト
+  // 登録順に並んでいる．処理済みのものも含む．
+  vector<const VlScope*> mLazyScopeList;
+
 
 protected:
   //////////////////////////////////////////////////////////////////////
@@ -238,6 +325,9 @@ protected:
   // IOに範囲がなく宣言のみに範囲を持つ場合を許すとき true
   bool mAllowEmptyIORange;
 
+  // 情報メッセージ(MsgType::Info)を出力するとき true
+  bool mInfoMsg;
+
 };
 
 END_NAMESPACE_YM_VERILOG
@@ -384,22 +384,22 @@ public:
   virtual
   ElbPrimitive*
   new_CellPrimitive(
-    ElbPrimHead* head,    ///< [in] ヘッダ
-    const ClibCell& cell, ///< [in] セル
-    const PtInst* pt_inst ///< [in] インスタンス定義
+    ElbPrimHead* head,              ///< [in] ヘッダ
+    const vector<VpiDir>& dir_list, ///< [in] ピンの向きのリスト
+    const PtInst* pt_inst           ///< [in] インスタンス定義
   ) = 0;
 
   /// @brief セルプリミティブ配列インスタンスを生成する．
   virtual
   ElbPrimArray*
   new_CellPrimitiveArray(
-    ElbPrimHead* head,     ///< [in] ヘッダ
-    const ClibCell& cell,  ///< [in] セル
-    const PtInst* pt_inst, ///< [in] インスタンス定義
-    const PtExpr* left,    ///< [in] 範囲の MSB の式
-    const PtExpr* right,   ///< [in] 範囲の LSB の式
-    int left_val,          ///< [in] 範囲の MSB の値
-    int right_val          ///< [in] 範囲の LSB の値
+    ElbPrimHead* head,              ///< [in] ヘッダ
+    const vector<VpiDir>& dir_list, ///< [in] ピンの向きのリスト
+    const PtInst* pt_inst,          ///< [in] インスタンス定義
+    const PtExpr* left,             ///< [in] 範囲の MSB の式
+    const PtExpr* right,            ///< [in] 範囲の LSB の式
+    int left_val,                   ///< [in] 範囲の MSB の値
+    int right_val                   ///< [in] 範囲の LSB の値
   ) = 0;
 
   /// @brief function を生成する．
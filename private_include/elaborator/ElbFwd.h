@@ -74,6 +74,9 @@ class ElbGfRoot;
 // in ElbGenvar.h
 class ElbGenvar;
 
+// in ElbUnit.h
+struct ElbUnit;
+
 // in ElbAttribute.h
 class ElbAttribute;
 class ElbAttrList;
@@ -26,6 +26,15 @@ public:
   // ElbGfRoot の関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 子供のスコープの数の見積もりを設定する．
+  ///
+  /// 以降の add() のための領域をまとめて確保する．
+  virtual
+  void
+  reserve(
+    SizeType num ///< [in] 子供のスコープの数
+  ) = 0;
+
   /// @brief 子供のスコープを追加する．
   virtual
   void
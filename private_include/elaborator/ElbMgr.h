@@ -17,8 +17,10 @@
 #include "elaborator/ModDefDict.h"
 #include "elaborator/TagDict.h"
 #include "elaborator/AttrHash.h"
+#include "elaborator/ElbUnit.h"
 
 #include "parser/PtiFwd.h"
+#include <functional>
 
 
 BEGIN_NAMESPACE_YM_VERILOG
@@ -26,11 +28,21 @@ BEGIN_NAMESPACE_YM_VERILOG
 //////////////////////////////////////////////////////////////////////
 /// @class ElbMgr ElbMgr.h "ElbMgr.h"
 /// @brief ElbMgr の実装クラス
+///
+/// 生成した要素はモジュールインスタンスごとのユニット(ElbUnit)が
+/// 所有する．編集されたファイルを読み直した時には，そのファイルで
+/// 定義されたモジュールのユニットと，それを参照しているユニットだけを
+/// remove_units() で削除して作り直すことができる．
+/// 作り直した要素は all_xxx_list() などの末尾に加わるので，
+/// 並び順は全体をエラボレーションし直した場合と異なることがある．
 //////////////////////////////////////////////////////////////////////
 class ElbMgr
 {
 public:
 
+  /// @brief find_by_path() で辿るスコープに適用する関数の型
+  using ScopeFunc = std::function<void(const VlScope*)>;
+
   /// @brief コンストラクタ
   ElbMgr();
 
@@ -44,6 +56,29 @@ public:
   void
   clear();
 
+  /// @brief スコープごとの要素の表を作る．
+  ///
+  /// エラボレーションの終了時に呼ばれる．
+  /// 以降の find_xxx_list() は同じスコープの要素が連続して並んだ
+  /// 表を参照するようになる．
+  void
+  make_scope_table();
+
+  /// @brief 遅延して作られる内部の状態をすべて確定させる．
+  ///
+  /// これ以降は const なメンバ関数と，取り出した要素の
+  /// const なメンバ関数を複数のスレッドから同時に呼んでも良い．
+  /// clear() が呼ばれるまで要素を追加してはいけない．
+  void
+  freeze();
+
+  /// @brief freeze() が呼ばれている時 true を返す．
+  bool
+  is_frozen() const
+  {
+    return mFrozen;
+  }
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -75,7 +110,7 @@ public:
   /// @brief スコープに属する internal scope のリストを取り出す．
   /// @param[in] parent 検索対象のスコープ
   /// @return 結果のリストを返す．
-  vector<const VlScope*>
+  VlSpan<const VlScope*>
   find_internalscope_list(const VlScope* parent) const;
 
   /// @brief スコープとタグから宣言要素を取り出す．
@@ -84,7 +119,7 @@ public:
   /// @return 結果のリストを返す．
   ///
   /// parent のスコープ内の tag というタグを持つ要素のリストを返す．
-  vector<const VlDecl*>
+  VlSpan<const VlDecl*>
   find_decl_list(const VlScope* parent,
 		 int tag) const;
 
@@ -94,70 +129,159 @@ public:
   /// @retrun 結果のリストを返す．
   ///
   /// parent というスコープ内の tag というタグを持つ要素のリストを返す．
-  vector<const VlDeclArray*>
+  VlSpan<const VlDeclArray*>
   find_declarray_list(const VlScope* parent,
 		      int tag) const;
 
   /// @brief スコープに属する defparam のリストを取り出す．
   /// @param[in] parent 検索対象のスコープ
   /// @return 結果のリストを返す．
-  vector<const VlDefParam*>
+  VlSpan<const VlDefParam*>
   find_defparam_list(const VlScope* parent) const;
 
   /// @brief スコープに属する param assign のリストを取り出す．
   /// @param[in] parent 検索対象のスコープ
   /// @return 結果のリストを返す．
-  vector<const VlParamAssign*>
+  VlSpan<const VlParamAssign*>
   find_paramassign_list(const VlScope* parent) const;
 
   /// @brief スコープに属する module のリストを取り出す．
   /// @param[in] parent 検索対象のスコープ
   /// @return 結果のリストを返す．
-  vector<const VlModule*>
+  VlSpan<const VlModule*>
   find_module_list(const VlScope* parent) const;
 
   /// @brief スコープに属する module arrayのリストを取り出す．
   /// @param[in] parent 検索対象のスコープ
   /// @return 結果のリストを返す．
-  vector<const VlModuleArray*>
+  VlSpan<const VlModuleArray*>
   find_modulearray_list(const VlScope* parent) const;
 
   /// @brief スコープに属する primitive のリストを取り出す．
   /// @param[in] parent 検索対象のスコープ
   /// @return 結果のリストを返す．
-  vector<const VlPrimitive*>
+  VlSpan<const VlPrimitive*>
   find_primitive_list(const VlScope* parent) const;
 
   /// @brief スコープに属する primitive array のリストを取り出す．
   /// @param[in] parent 検索対象のスコープ
   /// @return 結果のリストを返す．
-  vector<const VlPrimArray*>
+  VlSpan<const VlPrimArray*>
   find_primarray_list(const VlScope* parent) const;
 
   /// @brief スコープに属する continuous assignment のリストを取り出す．
   /// @param[in] parent 検索対象のスコープ
   /// @return 結果のリストを返す．
-  vector<const VlContAssign*>
+  VlSpan<const VlContAssign*>
   find_contassign_list(const VlScope* parent) const;
 
   /// @brief スコープに属するタスクのリストを取り出す．
   /// @param[in] parent 検索対象のスコープ
   /// @return 結果のリストを返す．
-  vector<const VlTaskFunc*>
+  VlSpan<const VlTaskFunc*>
   find_task_list(const VlScope* parent) const;
 
   /// @brief スコープに属する関数のリストを取り出す．
   /// @param[in] parent 検索対象のスコープ
   /// @return 結果のリストを返す．
-  vector<const VlTaskFunc*>
+  VlSpan<const VlTaskFunc*>
   find_function_list(const VlScope* parent) const;
 
   /// @brief スコープに属する process のリストを取り出す．
   /// @param[in] parent 検索対象のスコープ
   /// @return 結果のリストを返す．
-  vector<const VlProcess*>
+  VlSpan<const VlProcess*>
   find_process_list(const VlScope* parent) const;
 
+  /// @brief 設計中のすべての internal scope のリストを返す．
+  ///
+  /// 生成順に並んでいる．以下の all_xxx_list() も同様．
+  VlSpan<const VlScope*>
+  all_internalscope_list() const
+  {
+    return mAllInternalScopeList;
+  }
+
+  /// @brief 設計中の tag というタグを持つすべての宣言要素のリストを返す．
+  /// @param[in] tag タグ
+  VlSpan<const VlDecl*>
+  all_decl_list(int tag) const;
+
+  /// @brief 設計中の tag というタグを持つすべての宣言要素の配列のリストを返す．
+  /// @param[in] tag タグ
+  VlSpan<const VlDeclArray*>
+  all_declarray_list(int tag) const;
+
+  /// @brief 設計中のすべての defparam のリストを返す．
+  VlSpan<const VlDefParam*>
+  all_defparam_list() const
+  {
+    return mAllDefParamList;
+  }
+
+  /// @brief 設計中のすべての param assign のリストを返す．
+  VlSpan<const VlParamAssign*>
+  all_paramassign_list() const
+  {
+    return mAllParamAssignList;
+  }
+
+  /// @brief 設計中のすべての module のリストを返す．
+  VlSpan<const VlModule*>
+  all_module_list() const
+  {
+    return mAllModuleList;
+  }
+
+  /// @brief 設計中のすべての module array のリストを返す．
+  VlSpan<const VlModuleArray*>
+  all_modulearray_list() const
+  {
+    return mAllModuleArrayList;
+  }
+
+  /// @brief 設計中のすべての primitive のリストを返す．
+  VlSpan<const VlPrimitive*>
+  all_primitive_list() const
+  {
+    return mAllPrimitiveList;
+  }
+
+  /// @brief 設計中のすべての primitive array のリストを返す．
+  VlSpan<const VlPrimArray*>
+  all_primarray_list() const
+  {
+    return mAllPrimArrayList;
+  }
+
+  /// @brief 設計中のすべての continuous assignment のリストを返す．
+  VlSpan<const VlContAssign*>
+  all_contassign_list() const
+  {
+    return mAllContAssignList;
+  }
+
+  /// @brief 設計中のすべてのタスクのリストを返す．
+  VlSpan<const VlTaskFunc*>
+  all_task_list() const
+  {
+    return mAllTaskList;
+  }
+
+  /// @brief 設計中のすべての関数のリストを返す．
+  VlSpan<const VlTaskFunc*>
+  all_function_list() const
+  {
+    return mAllFunctionList;
+  }
+
+  /// @brief 設計中のすべての process のリストを返す．
+  VlSpan<const VlProcess*>
+  all_process_list() const
+  {
+    return mAllProcessList;
+  }
+
   /// @brief スコープと名前から名前付き要素を取り出す．
   /// @param[in] parent 検索対象のスコープ
   /// @param[in] name 名前
@@ -165,7 +289,7 @@ public:
   /// @return なければ nullptr を返す．
   ObjHandle*
   find_obj(const VlScope* parent,
-	   const string& name) const;
+	   string_view name) const;
 
   /// @brief スコープと名前からスコープを取り出す．
   /// @param[in] parent 検索対象のスコープ
@@ -174,7 +298,7 @@ public:
   /// @return なければ nullptr を返す．
   const VlScope*
   find_namedobj(const VlScope* parent,
-		const string& name) const;
+		string_view name) const;
 
   /// @brief スコープと階層名から要素を取り出す．
   /// @param[in] base_scope 起点となるスコープ
@@ -187,6 +311,34 @@ public:
 	      const PtHierNamedBase* pt_obj,
 	      const VlScope* ulimit);
 
+  /// @brief 階層名から要素を取り出す．
+  /// @param[in] path 階層名 (例: "top.u_core.u_alu.sum[3]")
+  /// @return 見付かった要素を返す．
+  /// @return なければ nullptr を返す．
+  ///
+  /// 先頭の要素はトップモジュールの名前とする．
+  /// インデックスは module array, generate for, primitive array の
+  /// 要素を表す．宣言要素に対するインデックスはビット選択か配列要素
+  /// を表すが，これらは要素として存在しないので宣言要素自身を返す．
+  /// 名前が '\' で始まる場合は空白までを escaped identifier とする．
+  ///
+  /// prepare が空でなければ，スコープの中の名前を探す前と
+  /// 結果がスコープの場合にそのスコープを引数として呼び出す．
+  const VlObj*
+  find_by_path(string_view path,
+	       const ScopeFunc& prepare = ScopeFunc{}) const;
+
+  /// @brief 複数の階層名から要素を取り出す．
+  /// @param[in] path_list 階層名のリスト
+  /// @return path_list と同じ順に結果を並べたリストを返す．
+  ///
+  /// 各要素の意味は find_by_path() と同じ．
+  /// 階層名を整列して順に処理し，直前の階層名と共通の部分は
+  /// 解決済みのスコープを再利用する．
+  vector<const VlObj*>
+  find_by_paths(const vector<string>& path_list,
+		const ScopeFunc& prepare = ScopeFunc{}) const;
+
   /// @brief 名前からモジュール定義を取り出す．
   /// @param[in] name 名前
   /// @return name という名のモジュール定義
@@ -600,16 +752,16 @@ public:
 
   /// @brief セルプリミティブインスタンスを生成する．
   /// @param[in] head ヘッダ
-  /// @param[in] cell セル
+  /// @param[in] dir_list ピンの向きのリスト
   /// @param[in] pt_inst インスタンス定義
   ElbPrimitive*
   new_CellPrimitive(ElbPrimHead* head,
-		    const ClibCell& cell,
+		    const vector<VpiDir>& dir_list,
 		    const PtInst* pt_inst);
 
   /// @brief セルプリミティブ配列インスタンスを生成する．
   /// @param[in] head ヘッダ
-  /// @param[in] cell セル
+  /// @param[in] dir_list ピンの向きのリスト
   /// @param[in] pt_inst インスタンス定義
   /// @param[in] left 範囲の MSB の式
   /// @param[in] right 範囲の LSB の式
@@ -617,7 +769,7 @@ public:
   /// @param[in] right_val 範囲の LSB の値
   ElbPrimArray*
   new_CellPrimitiveArray(ElbPrimHead* head,
-			 const ClibCell& cell,
+			 const vector<VpiDir>& dir_list,
 			 const PtInst* pt_inst,
 			 const PtExpr* left,
 			 const PtExpr* right,
@@ -1218,11 +1370,124 @@ public:
 		bool def = false);
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  // ユニットに関する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief モジュールインスタンスのユニットを作る．
+  ///
+  /// 親のユニットは parent を含むユニットとなる．
+  /// parent が nullptr の時はどのインスタンスにも属さないユニットの
+  /// 子供となる．
+  /// 現在のユニットは変更しない．
+  ElbUnit*
+  new_unit(
+    const VlScope* parent,     ///< [in] インスタンスが置かれるスコープ
+    const PtModule* pt_module, ///< [in] モジュール定義
+    const PtItem* pt_head,     ///< [in] インスタンス記述のヘッダ
+    const PtInst* pt_inst      ///< [in] インスタンス記述
+  );
+
+  /// @brief 以降に生成する要素を所有するユニットを返す．
+  ElbUnit*
+  cur_unit() const
+  {
+    return mCurUnit;
+  }
+
+  /// @brief 以降に生成する要素を所有するユニットを設定する．
+  /// @return 直前のユニットを返す．
+  ///
+  /// unit が nullptr の時はどのインスタンスにも属さないユニットとなる．
+  ElbUnit*
+  set_cur_unit(
+    ElbUnit* unit ///< [in] ユニット
+  );
+
+  /// @brief スコープを含むユニットを返す．
+  ElbUnit*
+  unit_of(
+    const VlScope* scope ///< [in] スコープ
+  ) const;
+
+  /// @brief defparam 文で他のスコープのパラメータを書き換えたことを記録する．
+  ///
+  /// 書き換えたユニットと書き換えられたユニットは互いに依存する．
+  void
+  reg_override(
+    const VlScope* scope ///< [in] 書き換えたパラメータのスコープ
+  );
+
+  /// @brief ファイルの再読み込みで作り直す必要のあるユニットを求める．
+  /// @return 作り直すユニットのリストを返す．
+  ///
+  /// module_set に含まれるモジュール定義のユニットとその子孫，
+  /// および，それらの要素を参照しているユニットとその子孫を返す．
+  /// 親のユニットは子供のユニットより前に並ぶ．
+  vector<ElbUnit*>
+  invalid_unit_list(
+    const unordered_set<const PtModule*>& module_set ///< [in] 読み直したモジュール定義の集合
+  ) const;
+
+  /// @brief ユニットとその要素を削除する．
+  ///
+  /// unit_list は invalid_unit_list() の結果のように子孫のユニットも
+  /// すべて含んでいなければならない．
+  /// 世代番号を一つ進めるので，以降に作られたユニットは削除した
+  /// ユニットの作り直しとみなされる．
+  /// freeze() の状態は解除される．
+  void
+  remove_units(
+    const vector<ElbUnit*>& unit_list ///< [in] 削除するユニットのリスト
+  );
+
+  /// @brief 最後の remove_units() 以前に作られたユニットのパラメータを
+  /// defparam 文で書き換えた時 true を返す．
+  ///
+  /// その場合は部分的な作り直しの結果は正しくない．
+  bool
+  has_stale_override() const
+  {
+    return mStaleOverride;
+  }
+
+  /// @brief topmodule のリストをモジュール定義の順に並べ直す．
+  void
+  sort_topmodule_list(
+    const vector<const PtModule*>& pt_module_list ///< [in] モジュール定義のリスト
+  );
+
+
 public:
   //////////////////////////////////////////////////////////////////////
   // その他の関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 新たに生成された要素のリストを返す．
+  ///
+  /// 前回 clear_new_obj_list() を呼んでから生成されたもので，
+  /// defparam 文の階層名の解決結果に影響を与えるもの
+  /// (スコープ，モジュール配列，generate for のルート，パラメータ)
+  /// が入っている．
+  /// set_new_obj_recording(false) の後に生成されたものは入らない．
+  const vector<const VlNamedObj*>&
+  new_obj_list() const;
+
+  /// @brief new_obj_list() の内容をクリアする．
+  void
+  clear_new_obj_list();
+
+  /// @brief new_obj_list() への登録を行うかどうか設定する．
+  ///
+  /// defparam 文の解決が終わった後は不要なので登録を止める．
+  /// どちらの場合も内容はクリアされる．
+  /// clear() で登録を行う状態に戻る．
+  void
+  set_new_obj_recording(
+    bool flag ///< [in] 登録を行う時 true
+  );
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -1233,6 +1498,76 @@ private:
   ElbFactory&
   factory();
 
+  /// @brief 新たに生成された要素を new_obj_list() に登録する．
+  void
+  add_new_obj(
+    const VlNamedObj* obj ///< [in] 生成された要素
+  );
+
+  /// @brief 生成した要素を現在のユニットに登録する．
+  void
+  reg_obj(
+    const VlObj* obj ///< [in] 生成された要素
+  )
+  {
+    mCurUnit->mObjList.push_back(obj);
+  }
+
+  /// @brief 生成したヘッダを現在のユニットに登録する．
+  void
+  reg_head(
+    const ElbHead* head ///< [in] 生成されたヘッダ
+  )
+  {
+    mCurUnit->mHeadList.push_back(head);
+  }
+
+  /// @brief 生成したスコープを現在のユニットに登録する．
+  void
+  reg_scope(
+    const VlScope* scope ///< [in] 生成されたスコープ
+  )
+  {
+    mCurUnit->mScopeList.push_back(scope);
+  }
+
+  /// @brief 生成したモジュールを現在のユニットに登録する．
+  void
+  reg_module_unit(
+    const VlModule* module ///< [in] 生成されたモジュール
+  );
+
+  /// @brief 生成したモジュール配列を現在のユニットに登録する．
+  ///
+  /// 配列の要素も登録する．
+  void
+  reg_module_unit(
+    const VlModuleArray* module_array ///< [in] 生成されたモジュール配列
+  );
+
+  /// @brief 検索結果の要素を所有するユニットを返す．
+  ElbUnit*
+  unit_of(
+    ObjHandle* handle ///< [in] 検索結果
+  ) const;
+
+  /// @brief user が used の要素を参照したことを記録する．
+  ///
+  /// used が user 自身かその祖先の場合には記録しない．
+  void
+  add_dependency(
+    ElbUnit* user, ///< [in] 参照したユニット
+    ElbUnit* used  ///< [in] 参照されたユニット
+  );
+
+  /// @brief ユニットとその要素を破壊する．
+  ///
+  /// 子孫のユニットは破壊しない．
+  void
+  delete_unit(
+    ElbUnit* unit ///< [in] 対象のユニット
+  );
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -1260,21 +1595,88 @@ private:
   // UserSystf の辞書
   unordered_map<string, const VlUserSystf*> mSystfHash;
 
-  // ヘッダのリスト
-  vector<const ElbHead*> mHeadList;
+  // どのインスタンスにも属さない要素を所有するユニット
+  // 他のユニットはこれを根とする木を作る．
+  ElbUnit* mRootUnit{nullptr};
+
+  // 生成した要素を所有するユニット
+  ElbUnit* mCurUnit{nullptr};
+
+  // モジュール，モジュール配列およびその要素をキーにして
+  // それを所有するユニットを持つ辞書
+  unordered_map<const VlObj*, ElbUnit*> mUnitDict;
 
-  // 全てのオブジェクトのリスト
-  vector<const VlObj*> mObjList;
+  // モジュール定義をキーにしてそのインスタンスのユニットの
+  // リストを持つ辞書
+  unordered_map<const PtModule*, vector<ElbUnit*>> mModuleUnitDict;
+
+  // 世代番号
+  // remove_units() のたびに一つ増える．
+  SizeType mGeneration{0};
+
+  // 古い世代のユニットのパラメータを書き換えた時 true
+  bool mStaleOverride{false};
 
   // タグをキーにした各スコープごとのオブジェクトのリストの辞書
   TagDict mTagDict;
 
+  // 以下は種類ごとの設計中の全要素のリスト
+  // mTagDict と同じ要素を生成順に持つ．
+
+  // internal scope のリスト
+  vector<const VlScope*> mAllInternalScopeList;
+
+  // タグをキーにした宣言要素のリストの辞書
+  unordered_map<int, vector<const VlDecl*>> mAllDeclListDict;
+
+  // タグをキーにした宣言要素の配列のリストの辞書
+  unordered_map<int, vector<const VlDeclArray*>> mAllDeclArrayListDict;
+
+  // defparam のリスト
+  vector<const VlDefParam*> mAllDefParamList;
+
+  // param assign のリスト
+  vector<const VlParamAssign*> mAllParamAssignList;
+
+  // module のリスト
+  vector<const VlModule*> mAllModuleList;
+
+  // module array のリスト
+  vector<const VlModuleArray*> mAllModuleArrayList;
+
+  // primitive のリスト
+  vector<const VlPrimitive*> mAllPrimitiveList;
+
+  // primitive array のリスト
+  vector<const VlPrimArray*> mAllPrimArrayList;
+
+  // continuous assignment のリスト
+  vector<const VlContAssign*> mAllContAssignList;
+
+  // タスクのリスト
+  vector<const VlTaskFunc*> mAllTaskList;
+
+  // 関数のリスト
+  vector<const VlTaskFunc*> mAllFunctionList;
+
+  // process のリスト
+  vector<const VlProcess*> mAllProcessList;
+
   // 属性リストの辞書
   unordered_map<const VlObj*, vector<const VlAttribute*>> mAttrHash;
 
   // トップレベルスコープ
   const VlScope* mTopLevel;
 
+  // 新たに生成された要素のリスト
+  vector<const VlNamedObj*> mNewObjList;
+
+  // mNewObjList に登録する時 true
+  bool mRecordNewObj{true};
+
+  // freeze() が呼ばれている時 true
+  bool mFrozen{false};
+
 };
 
 
@@ -1286,7 +1688,7 @@ private:
 // @param[in] parent 検索対象のスコープ
 // @return 結果のリストを返す．
 inline
-vector<const VlScope*>
+VlSpan<const VlScope*>
 ElbMgr::find_internalscope_list(const VlScope* parent) const
 {
   return mTagDict.find_internalscope_list(parent);
@@ -1299,7 +1701,7 @@ ElbMgr::find_internalscope_list(const VlScope* parent) const
 //
 // parent のスコープ内の tag というタグを持つ要素のリストを返す．
 inline
-vector<const VlDecl*>
+VlSpan<const VlDecl*>
 ElbMgr::find_decl_list(const VlScope* parent,
 		       int tag) const
 {
@@ -1313,7 +1715,7 @@ ElbMgr::find_decl_list(const VlScope* parent,
 //
 // parent というスコープ内の tag というタグを持つ要素のリストを返す．
 inline
-vector<const VlDeclArray*>
+VlSpan<const VlDeclArray*>
 ElbMgr::find_declarray_list(const VlScope* parent,
 			    int tag) const
 {
@@ -1328,7 +1730,7 @@ ElbMgr::find_declarray_list(const VlScope* parent,
 // @param[in] parent 検索対象のスコープ
 // @return 結果のリストを返す．
 inline
-vector<const VlDefParam*>
+VlSpan<const VlDefParam*>
 ElbMgr::find_defparam_list(const VlScope* parent) const
 {
   return mTagDict.find_defparam_list(parent);
@@ -1338,7 +1740,7 @@ ElbMgr::find_defparam_list(const VlScope* parent) const
 // @param[in] parent 検索対象のスコープ
 // @return 結果のリストを返す．
 inline
-vector<const VlParamAssign*>
+VlSpan<const VlParamAssign*>
 ElbMgr::find_paramassign_list(const VlScope* parent) const
 {
   return mTagDict.find_paramassign_list(parent);
@@ -1348,7 +1750,7 @@ ElbMgr::find_paramassign_list(const VlScope* parent) const
 // @param[in] parent 検索対象のスコープ
 // @return 結果のリストを返す．
 inline
-vector<const VlModule*>
+VlSpan<const VlModule*>
 ElbMgr::find_module_list(const VlScope* parent) const
 {
   return mTagDict.find_module_list(parent);
@@ -1358,7 +1760,7 @@ ElbMgr::find_module_list(const VlScope* parent) const
 // @param[in] parent 検索対象のスコープ
 // @return 結果のリストを返す．
 inline
-vector<const VlModuleArray*>
+VlSpan<const VlModuleArray*>
 ElbMgr::find_modulearray_list(const VlScope* parent) const
 {
   return mTagDict.find_modulearray_list(parent);
@@ -1368,7 +1770,7 @@ ElbMgr::find_modulearray_list(const VlScope* parent) const
 // @param[in] parent 検索対象のスコープ
 // @return 結果のリストを返す．
 inline
-vector<const VlPrimitive*>
+VlSpan<const VlPrimitive*>
 ElbMgr::find_primitive_list(const VlScope* parent) const
 {
   return mTagDict.find_primitive_list(parent);
@@ -1378,7 +1780,7 @@ ElbMgr::find_primitive_list(const VlScope* parent) const
 // @param[in] parent 検索対象のスコープ
 // @return 結果のリストを返す．
 inline
-vector<const VlPrimArray*>
+VlSpan<const VlPrimArray*>
 ElbMgr::find_primarray_list(const VlScope* parent) const
 {
   return mTagDict.find_primarray_list(parent);
@@ -1388,7 +1790,7 @@ ElbMgr::find_primarray_list(const VlScope* parent) const
 // @param[in] parent 検索対象のスコープ
 // @return 結果のリストを返す．
 inline
-vector<const VlContAssign*>
+VlSpan<const VlContAssign*>
 ElbMgr::find_contassign_list(const VlScope* parent) const
 {
   return mTagDict.find_contassign_list(parent);
@@ -1398,7 +1800,7 @@ ElbMgr::find_contassign_list(const VlScope* parent) const
 // @param[in] parent 検索対象のスコープ
 // @return 結果のリストを返す．
 inline
-vector<const VlTaskFunc*>
+VlSpan<const VlTaskFunc*>
 ElbMgr::find_task_list(const VlScope* parent) const
 {
   return mTagDict.find_task_list(parent);
@@ -1408,7 +1810,7 @@ ElbMgr::find_task_list(const VlScope* parent) const
 // @param[in] parent 検索対象のスコープ
 // @return 結果のリストを返す．
 inline
-vector<const VlTaskFunc*>
+VlSpan<const VlTaskFunc*>
 ElbMgr::find_function_list(const VlScope* parent) const
 {
   return mTagDict.find_function_list(parent);
@@ -1418,7 +1820,7 @@ ElbMgr::find_function_list(const VlScope* parent) const
 // @param[in] parent 検索対象のスコープ
 // @return 結果のリストを返す．
 inline
-vector<const VlProcess*>
+VlSpan<const VlProcess*>
 ElbMgr::find_process_list(const VlScope* parent) const
 {
   return mTagDict.find_process_list(parent);
@@ -1438,6 +1840,45 @@ ElbMgr::find_attr(const VlObj* obj) const
   }
 }
 
+// @brief 新たに生成された要素のリストを返す．
+inline
+const vector<const VlNamedObj*>&
+ElbMgr::new_obj_list() const
+{
+  return mNewObjList;
+}
+
+// @brief new_obj_list() の内容をクリアする．
+inline
+void
+ElbMgr::clear_new_obj_list()
+{
+  mNewObjList.clear();
+}
+
+// @brief new_obj_list() への登録を行うかどうか設定する．
+inline
+void
+ElbMgr::set_new_obj_recording(
+  bool flag
+)
+{
+  mRecordNewObj = flag;
+  mNewObjList.clear();
+}
+
+// @brief 新たに生成された要素を new_obj_list() に登録する．
+inline
+void
+ElbMgr::add_new_obj(
+  const VlNamedObj* obj
+)
+{
+  if ( mRecordNewObj ) {
+    mNewObjList.push_back(obj);
+  }
+}
+
 // @brief Elbオブジェクト用のファクトリを返す．
 inline
 ElbFactory&
@@ -9,15 +9,20 @@
 /// All rights reserved.
 
 #include "ym/verilog.h"
+#include "ElbFwd.h"
 
 
 BEGIN_NAMESPACE_YM_VERILOG
 
 class ElbStub;
+class ElbMgr;
 
 //////////////////////////////////////////////////////////////////////
 /// @class ElbStubList ElbStub.h "ElbStub.h"
 /// @brief ElbStub のリストを表すクラス
+///
+/// 各 stub はそれを登録した時点で ElbMgr の要素を所有していた
+/// ユニット(ElbUnit)とともに保持し，そのユニットのもとで評価する．
 //////////////////////////////////////////////////////////////////////
 class ElbStubList
 {
@@ -57,7 +62,8 @@ public:
   /// @brief 末尾に要素を追加する．
   void
   push_back(
-    ElbStub* elem ///< [in] 追加する要素
+    ElbStub* elem, ///< [in] 追加する要素
+    ElbUnit* unit  ///< [in] 生成した要素を所有するユニット
   );
 
   /// @brief 空の時 true を返す．
@@ -68,7 +74,15 @@ public:
   ///
   /// 結果としてリストは空になる．
   void
-  eval();
+  eval(
+    ElbMgr& mgr ///< [in] 生成した要素を登録する ElbMgr
+  );
+
+  /// @brief unit_set に含まれるユニットの stub を削除する．
+  void
+  remove(
+    const unordered_set<const ElbUnit*>& unit_set ///< [in] 削除するユニットの集合
+  );
 
 
 private:
@@ -83,8 +97,18 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
+  // 要素
+  struct Elem
+  {
+    // stub
+    ElbStub* mStub;
+
+    // 生成した要素を所有するユニット
+    ElbUnit* mUnit;
+  };
+
   // リストの本体
-  vector<ElbStub*> mList;
+  vector<Elem> mList;
 
 };
 
@@ -0,0 +1,90 @@
+#ifndef ELBUNIT_H
+#define ELBUNIT_H
+
+/// @file ElbUnit.h
+/// @brief ElbUnit のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/verilog.h"
+#include "ym/pt/PtP.h"
+#include "ym/vl/VlFwd.h"
+#include "ElbFwd.h"
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+/// @class ElbUnit ElbUnit.h "ElbUnit.h"
+/// @brief 部分的に作り直す単位となるモジュールインスタンス
+///
+/// トップモジュール，単一のモジュールインスタンス，モジュール配列
+/// ごとに一つ作られ，その処理中に生成された要素を所有する．
+/// 子供のインスタンスは別のユニットとなる．
+/// トップレベルのスコープや UDP などはどのインスタンスにも
+/// 属さないユニットが所有する．
+///
+/// 他のユニットの要素を参照したユニットは参照先の mDependentSet に
+/// 登録される．参照先を作り直す時には参照元も作り直す必要がある．
+/// defparam 文で他のユニットのパラメータを書き換えた場合は
+/// 互いに依存するものとする．
+//////////////////////////////////////////////////////////////////////
+struct ElbUnit
+{
+
+  /// @brief 親のユニット
+  ///
+  /// どのインスタンスにも属さないユニットの場合は nullptr
+  ElbUnit* mParent{nullptr};
+
+  /// @brief インスタンスが置かれているスコープ
+  const VlScope* mParentScope{nullptr};
+
+  /// @brief モジュール定義
+  const PtModule* mPtModule{nullptr};
+
+  /// @brief インスタンス記述のヘッダ
+  ///
+  /// トップモジュールの場合は nullptr
+  const PtItem* mPtHead{nullptr};
+
+  /// @brief インスタンス記述
+  ///
+  /// トップモジュールの場合は nullptr
+  const PtInst* mPtInst{nullptr};
+
+  /// @brief 作られた時の ElbMgr の世代番号
+  SizeType mGeneration{0};
+
+  /// @brief 子供のユニットのリスト
+  vector<ElbUnit*> mChildList;
+
+  /// @brief 生成した要素のリスト
+  vector<const VlObj*> mObjList;
+
+  /// @brief 生成したヘッダのリスト
+  vector<const ElbHead*> mHeadList;
+
+  /// @brief 生成したスコープのリスト
+  ///
+  /// mObjList に含まれないモジュール配列の要素も含む．
+  vector<const VlScope*> mScopeList;
+
+  /// @brief 生成したモジュールのリスト
+  ///
+  /// モジュール配列の要素は含まない．
+  vector<const VlModule*> mModuleList;
+
+  /// @brief このユニットの要素を参照しているユニットの集合
+  unordered_set<ElbUnit*> mDependentSet;
+
+  /// @brief このユニットが参照しているユニットの集合
+  unordered_set<ElbUnit*> mDependSet;
+
+};
+
+END_NAMESPACE_YM_VERILOG
+
+#endif // ELBUNIT_H
@@ -21,7 +21,9 @@ BEGIN_NAMESPACE_YM_VERILOG
 ///
 /// ObjDict と似たような辞書だがオブジェクト名ではなくモジュールの定義名
 /// を用いるところが異なる．さらに同じモジュール定義名を持つモジュール
-/// が複数ある場合にはそのエントリを削除する．
+/// が複数ある場合にはそのエントリは見つからないものとする．
+/// 部分的な作り直しで要素を削除できるように同名のモジュールも
+/// すべて保持しておく．
 //////////////////////////////////////////////////////////////////////
 class ModDefDict
 {
@@ -48,21 +50,32 @@ public:
 
   /// @brief 要素を追加する．
   ///
-  /// 同名のモジュールが登録されていたらそのエントリを無効化する．
+  /// 同名のモジュールが登録されていたらそのエントリは無効となる．
   void
   add(
     const VlModule* obj ///< [in] モジュール
   )
   {
     Key key{obj->parent_scope(), obj->def_name()};
-    if ( mHash.count(key) > 0 ) {
-      // 同じモジュールがすでに登録されていた．
-      // そのエントリを無効化する．
-      mHash.emplace(key, nullptr);
+    mHash[key].push_back(obj);
+  }
+
+  /// @brief 要素を削除する．
+  void
+  remove(
+    const VlModule* obj ///< [in] モジュール
+  )
+  {
+    Key key{obj->parent_scope(), obj->def_name()};
+    auto p = mHash.find(key);
+    if ( p == mHash.end() ) {
+      return;
     }
-    else {
-      // 登録する．
-      mHash.emplace(key, obj);
+    auto& obj_list = p->second;
+    obj_list.erase(std::remove(obj_list.begin(), obj_list.end(), obj),
+		   obj_list.end());
+    if ( obj_list.empty() ) {
+      mHash.erase(p);
     }
   }
 
@@ -74,10 +87,12 @@ public:
   ) const
   {
     Key key{parent, name};
-    if ( mHash.count(key) > 0 ) {
-      return mHash.at(key);
+    auto p = mHash.find(key);
+    if ( p != mHash.end() && p->second.size() == 1 ) {
+      return p->second.front();
     }
     else {
+      // 未登録か同名のモジュールが複数ある．
       return nullptr;
     }
   }
@@ -122,8 +137,8 @@ private:
     }
   };
 
-  // const VlModule* を納めるハッシュ表
-  unordered_map<Key, const VlModule*, KeyHash, KeyEq> mHash;
+  // const VlModule* のリストを納めるハッシュ表
+  unordered_map<Key, vector<const VlModule*>, KeyHash, KeyEq> mHash;
 
 };
 
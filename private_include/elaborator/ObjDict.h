@@ -10,13 +10,29 @@
 
 #include "ym/verilog.h"
 #include "ObjHandle.h"
+#include <deque>
+#include <string_view>
 
 
 BEGIN_NAMESPACE_YM_VERILOG
 
 //////////////////////////////////////////////////////////////////////
 /// @class ObjDict ObjDict.h "ObjDict.h"
-/// @brief VlNamedObj を格納するハッシュ表
+/// @brief VlNamedObj を格納する辞書
+///
+/// 全体を一つのハッシュ表で管理するのではなく，親のスコープごとに
+/// 小さな表を持つ．
+/// 名前は重複を除いて一箇所に格納(intern)し，スコープごとの表は
+/// その格納場所のアドレスをキーにした開番地法のハッシュ表とする．
+/// 要素数の少ないスコープは表を作らずに線形探索を行う．
+/// 要素数がしきい値を越えた時点でそれまでの要素から表をまとめて作り，
+/// 以降の追加では表に直接加える．
+/// そのため要素の追加と検索が交互に行われても検索のたびに
+/// 表を作り直すことはなく，find() は内部の状態を変更しない．
+///
+/// 同じ名前のインスタンスが大量にある場合でも文字列は一つしか持たない．
+///
+/// freeze() を呼ぶと以降の要素の追加を禁止する．
 //////////////////////////////////////////////////////////////////////
 class ObjDict
 {
@@ -35,9 +51,26 @@ public:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 内容を空にする．
+  ///
+  /// freeze() の状態も解除される．
   void
   clear();
 
+  /// @brief 以降の変更を禁止する．
+  ///
+  /// find() は内部の状態を変更しないので add() と同時でなければ
+  /// 複数のスレッドから同時に呼んでも良い．
+  /// freeze() はこれを保証するために用いる．
+  void
+  freeze();
+
+  /// @brief freeze() が呼ばれている時 true を返す．
+  bool
+  is_frozen() const
+  {
+    return mFrozen;
+  }
+
   /// @brief スコープを追加する．
   void
   add(
@@ -104,12 +137,27 @@ public:
     ElbGenvar* obj
   );
 
+  /// @brief 要素を削除する．
+  ///
+  /// scope_set に含まれるスコープの要素はすべて削除し，
+  /// parent_set に含まれるスコープからは obj_set に含まれる要素を削除する．
+  /// 名前の登録は残る．
+  /// freeze() の状態も解除される．
+  void
+  remove(
+    const unordered_set<const VlScope*>& scope_set,  ///< [in] 削除するスコープの集合
+    const unordered_set<const VlScope*>& parent_set, ///< [in] 削除する要素を含むスコープの集合
+    const unordered_set<const VlObj*>& obj_set       ///< [in] 削除する要素の集合
+  );
+
   /// @brief 名前から該当する要素を検索する．
   /// @note なければ nullptr を返す．
+  ///
+  /// 同名の要素がある場合には先に追加されたものを返す．
   ObjHandle*
   find(
     const VlScope* parent,
-    const string& name
+    string_view name
   ) const;
 
 
@@ -124,14 +172,138 @@ private:
     ObjHandle* handle
   );
 
+  /// @brief 名前を登録して格納場所を返す．
+  ///
+  /// すでに登録されていればその格納場所を返す．
+  const char*
+  intern(
+    const string& name
+  );
+
+  /// @brief 登録されている名前の格納場所を返す．
+  /// @note 登録されていなければ nullptr を返す．
+  const char*
+  find_name(
+    string_view name
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 一つのスコープに属する要素の表
+  class ScopeTable
+  {
+  public:
+
+    /// @brief 要素を追加する．
+    void
+    add(
+      const char* name,  ///< [in] 登録済みの名前
+      ObjHandle* handle  ///< [in] ハンドル
+    );
+
+    /// @brief obj_set に含まれる要素を削除する．
+    ///
+    /// 削除した要素のハンドルは破壊する．
+    void
+    remove(
+      const unordered_set<const VlObj*>& obj_set ///< [in] 削除する要素の集合
+    );
+
+    /// @brief 名前から該当する要素を検索する．
+    /// @note なければ nullptr を返す．
+    ObjHandle*
+    find(
+      const char* name ///< [in] 登録済みの名前
+    ) const;
+
+    /// @brief 追加された要素数を返す．
+    SizeType
+    elem_num() const
+    {
+      return mList.size();
+    }
+
+    /// @brief 要素のハンドルを返す．
+    ObjHandle*
+    elem(
+      SizeType pos ///< [in] 位置 ( 0 <= pos < elem_num() )
+    ) const
+    {
+      return mList[pos].mHandle;
+    }
+
+
+  private:
+
+    /// @brief 名前のハッシュ値を返す．
+    SizeType
+    hash_pos(
+      const char* name
+    ) const
+    {
+      // 名前の格納場所は 8 の倍数にそろっていることが多いので
+      // 下位ビットを捨ててから掛ける．
+      auto h = (reinterpret_cast<PtrIntType>(name) >> 3) * 0x9E3779B97F4A7C15ULL;
+      return static_cast<SizeType>(h >> 32) & (mTable.size() - 1);
+    }
+
+    /// @brief 表の大きさを size にして全要素を入れ直す．
+    void
+    build(
+      SizeType size ///< [in] 表の大きさ (2のべき乗)
+    );
+
+    /// @brief mList の pos 番目の要素を表に入れる．
+    void
+    insert(
+      SizeType pos
+    );
+
+
+  private:
+
+    // 要素
+    struct Elem
+    {
+      // 登録済みの名前
+      const char* mName;
+
+      // ハンドル
+      ObjHandle* mHandle;
+    };
+
+    // 追加順の要素のリスト
+    vector<Elem> mList;
+
+    // mList 中の位置 + 1 を持つ開番地法のハッシュ表
+    // 0 は空きを表す．
+    // 要素数が少ない時は空のままにして線形探索を行う．
+    vector<SizeType> mTable;
+
+  };
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // ObjHandle を納めるハッシュ表
-  unordered_set<ObjHandle*, ObjHandleHash, ObjHandleEq> mHash;
+  // 親のスコープをキーにして ScopeTable を納める辞書
+  unordered_map<const VlScope*, ScopeTable> mTableDict;
+
+  // 名前の実体
+  // deque は末尾への追加で既存の要素を移動しない．
+  std::deque<string> mNamePool;
+
+  // mNamePool 中の名前の辞書
+  unordered_set<string_view> mNameSet;
+
+  // freeze() が呼ばれている時 true
+  bool mFrozen{false};
 
 };
 
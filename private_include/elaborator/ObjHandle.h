@@ -61,6 +61,11 @@ public:
   string
   full_name() const = 0;
 
+  /// @brief 対象のオブジェクトを返す．
+  virtual
+  const VlNamedObj*
+  namedobj() const = 0;
+
   /// @brief VlScope を返す．
   ///
   /// このクラスでは nullptr を返す．
@@ -147,31 +152,6 @@ public:
   ElbGenvar*
   genvar() const;
 
-  /// @brief ハッシュ値を返す．
-  SizeType
-  hash() const;
-
-};
-
-/// @brief ObjHandle のハッシュ関数クラス
-struct ObjHandleHash
-{
-  SizeType
-  operator()(const ObjHandle* h) const
-  {
-    return h->hash();
-  }
-};
-
-/// @brief ObjHandle の等価比較関数クラス
-struct ObjHandleEq
-{
-  bool
-  operator()(const ObjHandle* h1,
-	     const ObjHandle* h2) const
-  {
-    return h1->parent_scope() == h2->parent_scope() && h1->name() == h2->name();
-  }
 };
 
 END_NAMESPACE_YM_VERILOG
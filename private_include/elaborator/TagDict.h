@@ -10,12 +10,60 @@
 
 #include "ym/verilog.h"
 #include "ym/vl/VlFwd.h"
+#include "ym/VlSpan.h"
 
 
 BEGIN_NAMESPACE_YM_VERILOG
 
 class TagDictCell;
 
+//////////////////////////////////////////////////////////////////////
+/// @class TagDictTable TagDict.h "TagDict.h"
+/// @brief TagDict::make_table() で作られる要素の種類ごとの配列
+///
+/// 同じスコープの要素は連続した位置に並んでいる．
+//////////////////////////////////////////////////////////////////////
+struct TagDictTable
+{
+  /// @brief internal scope の配列
+  vector<const VlScope*> mInternalScopeArray;
+
+  /// @brief 宣言要素の配列
+  vector<const VlDecl*> mDeclArray;
+
+  /// @brief 宣言要素の配列の配列
+  vector<const VlDeclArray*> mDeclArrayArray;
+
+  /// @brief defparam の配列
+  vector<const VlDefParam*> mDefParamArray;
+
+  /// @brief param assign の配列
+  vector<const VlParamAssign*> mParamAssignArray;
+
+  /// @brief module array の配列
+  vector<const VlModuleArray*> mModuleArrayArray;
+
+  /// @brief module の配列
+  vector<const VlModule*> mModuleArray;
+
+  /// @brief primitive array の配列
+  vector<const VlPrimArray*> mPrimArrayArray;
+
+  /// @brief primitive の配列
+  vector<const VlPrimitive*> mPrimitiveArray;
+
+  /// @brief タスク/関数の配列
+  vector<const VlTaskFunc*> mTaskFuncArray;
+
+  /// @brief continuous assignment の配列
+  vector<const VlContAssign*> mContAssignArray;
+
+  /// @brief process の配列
+  vector<const VlProcess*> mProcessArray;
+
+};
+
+
 //////////////////////////////////////////////////////////////////////
 /// @class TagDict TagDict.h "TagDict.h"
 /// @brief 各スコープの構成要素リストを格納するハッシュ表
@@ -37,6 +85,34 @@ public:
   void
   clear();
 
+  /// @brief スコープごとの要素の表を作る．
+  ///
+  /// エラボレーションの終了時に呼ばれる．
+  /// これ以降の find_xxx_list() はハッシュ表と各セルをたどる代わりに
+  /// 同じスコープの要素が連続して並んだ表を参照する．
+  /// 要素が追加されると表は破棄される．
+  void
+  make_table();
+
+  /// @brief make_table() で作った表が有効な時 true を返す．
+  bool
+  has_table() const
+  {
+    return mHasTable;
+  }
+
+  /// @brief 要素を削除する．
+  ///
+  /// scope_set に含まれるスコープの要素はすべて削除し，
+  /// parent_set に含まれるスコープからは obj_set に含まれる要素を削除する．
+  /// make_table() で作った表は破棄される．
+  void
+  remove(
+    const unordered_set<const VlScope*>& scope_set,  ///< [in] 削除するスコープの集合
+    const unordered_set<const VlScope*>& parent_set, ///< [in] 削除する要素を含むスコープの集合
+    const unordered_set<const VlObj*>& obj_set       ///< [in] 削除する要素の集合
+  );
+
   /// @brief internal scope を追加する．
   void
   add_internalscope(
@@ -45,7 +121,7 @@ public:
 
   /// @brief internal scope のリストを取り出す．
   /// @return 結果のリストを返す．
-  vector<const VlScope*>
+  VlSpan<const VlScope*>
   find_internalscope_list(
     const VlScope* parent ///< [in] 親のスコープ
   ) const;
@@ -61,7 +137,7 @@ public:
   /// @return 結果のリストを返す．
   ///
   /// parent のスコープ内の tag というタグを持つ要素のリストを返す．
-  vector<const VlDecl*>
+  VlSpan<const VlDecl*>
   find_decl_list(
     const VlScope* parent, ///< [in] 親のスコープ
     int tag                ///< [in] 要素の型を表すタグ (vpi_user.h 参照)
@@ -78,7 +154,7 @@ public:
   /// @retrun 結果のリストを返す．
   ///
   /// parent というスコープ内の tag というタグを持つ要素のリストを返す．
-  vector<const VlDeclArray*>
+  VlSpan<const VlDeclArray*>
   find_declarray_list(
     const VlScope* parent, ///< [in] 親のスコープ
     int tag                ///< [in] 要素の型を表すタグ (vpi_user.h 参照)
@@ -92,7 +168,7 @@ public:
 
   /// @brief defparam のリストを取り出す．
   /// @return 結果のリストを返す．
-  vector<const VlDefParam*>
+  VlSpan<const VlDefParam*>
   find_defparam_list(
     const VlScope* parent ///< [in] 親のスコープ
   ) const;
@@ -105,7 +181,7 @@ public:
 
   /// @brief param assign のリストを取り出す．
   /// @return 結果のリストを返す．
-  vector<const VlParamAssign*>
+  VlSpan<const VlParamAssign*>
   find_paramassign_list(
     const VlScope* parent ///< [in] 親のスコープ
   ) const;
@@ -118,7 +194,7 @@ public:
 
   /// @brief module array のリストを取り出す．
   /// @return 結果のリストを返す．
-  vector<const VlModuleArray*>
+  VlSpan<const VlModuleArray*>
   find_modulearray_list(
     const VlScope* parent ///< [in] 親のスコープ
   ) const;
@@ -131,7 +207,7 @@ public:
 
   /// @brief module のリストを取り出す．
   /// @return 結果のリストを返す．
-  vector<const VlModule*>
+  VlSpan<const VlModule*>
   find_module_list(
     const VlScope* parent ///< [in] 親のスコープ
   ) const;
@@ -144,7 +220,7 @@ public:
 
   /// @brief primitive array のリストを取り出す．
   /// @return 結果のリストを返す．
-  vector<const VlPrimArray*>
+  VlSpan<const VlPrimArray*>
   find_primarray_list(
     const VlScope* parent ///< [in] 親のスコープ
   ) const;
@@ -157,7 +233,7 @@ public:
 
   /// @brief primitive のリストを取り出す．
   /// @return 結果のリストを返す．
-  vector<const VlPrimitive*>
+  VlSpan<const VlPrimitive*>
   find_primitive_list(
     const VlScope* parent ///< [in] 親のスコープ
   ) const;
@@ -170,7 +246,7 @@ public:
 
   /// @brief タスクのリストを取り出す．
   /// @return 結果のリストを返す．
-  vector<const VlTaskFunc*>
+  VlSpan<const VlTaskFunc*>
   find_task_list(
     const VlScope* parent ///< [in] 親のスコープ
   ) const;
@@ -183,7 +259,7 @@ public:
 
   /// @brief 関数のリストを取り出す．
   /// @return 結果のリストを返す．
-  vector<const VlTaskFunc*>
+  VlSpan<const VlTaskFunc*>
   find_function_list(
     const VlScope* parent ///< [in] 親のスコープ
   ) const;
@@ -196,7 +272,7 @@ public:
 
   /// @brief continuous assignment のリストを取り出す．
   /// @return 結果のリストを返す．
-  vector<const VlContAssign*>
+  VlSpan<const VlContAssign*>
   find_contassign_list(
     const VlScope* parent ///< [in] 親のスコープ
   ) const;
@@ -209,7 +285,7 @@ public:
 
   /// @brief process のリストを取り出す．
   /// @return 結果のリストを返す．
-  vector<const VlProcess*>
+  VlSpan<const VlProcess*>
   find_process_list(
     const VlScope* parent ///< [in] 親のスコープ
   ) const;
@@ -235,6 +311,43 @@ private:
     int tag                ///< [in] 要素の型を表すタグ (vpi_user.h 参照)
   ) const;
 
+  /// @brief 要素を追加するために Cell を探す．
+  ///
+  /// make_table() で作った表は破棄される．
+  TagDictCell*
+  find_cell_for_add(
+    const VlScope* parent, ///< [in] 親のスコープ
+    int tag                ///< [in] 要素の型を表すタグ (vpi_user.h 参照)
+  );
+
+  /// @brief make_table() で作った表を破棄する．
+  void
+  clear_table();
+
+  /// @brief make_table() で作った表から要素の範囲を探す．
+  template<typename T>
+  VlSpan<T>
+  find_span(
+    const VlScope* parent,   ///< [in] 親のスコープ
+    int tag,                 ///< [in] 要素の型を表すタグ (vpi_user.h 参照)
+    const vector<T>& array   ///< [in] 要素の種類ごとの配列
+  ) const
+  {
+    auto p = mScopeTable.find(parent);
+    if ( p == mScopeTable.end() ) {
+      return VlSpan<T>{};
+    }
+    // 一つのスコープのタグの種類は高々十数個なので線形探索でよい．
+    for ( SizeType i = p->second.mBegin; i < p->second.mEnd; ++ i ) {
+      auto& range = mRangeArray[i];
+      if ( range.mTag == tag ) {
+	return VlSpan<T>{array.data() + range.mBegin,
+			 array.data() + range.mEnd};
+      }
+    }
+    return VlSpan<T>{};
+  }
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -264,6 +377,31 @@ private:
     }
   };
 
+  // 一つのタグの要素の mTable 中の範囲
+  struct TagRange
+  {
+    // タグ
+    int mTag;
+
+    // 先頭の位置
+    SizeType mBegin;
+
+    // 末尾の次の位置
+    SizeType mEnd;
+
+  };
+
+  // 一つのスコープの TagRange の mRangeArray 中の範囲
+  struct ScopeRange
+  {
+    // 先頭の位置
+    SizeType mBegin;
+
+    // 末尾の次の位置
+    SizeType mEnd;
+
+  };
+
   // Key の等価比較関数クラス
   struct Eq
   {
@@ -286,6 +424,22 @@ private:
   // ハッシュ表
   unordered_map<Key, TagDictCell*, Hash, Eq> mHash;
 
+  // 親のスコープをキーにして mHash に登録されているタグの
+  // リストを持つ辞書
+  unordered_map<const VlScope*, vector<int>> mTagListDict;
+
+  // make_table() で作られた表が有効な時 true
+  bool mHasTable{false};
+
+  // 要素の種類ごとの配列
+  TagDictTable mTable;
+
+  // mTable 中のタグごとの範囲のリスト
+  vector<TagRange> mRangeArray;
+
+  // スコープごとの mRangeArray 中の範囲を保持する辞書
+  unordered_map<const VlScope*, ScopeRange> mScopeTable;
+
 };
 
 END_NAMESPACE_YM_VERILOG
@@ -57,6 +57,12 @@ public:
     const vector<VlLineWatcher*>& watcher_list ///< [in] 行番号ウオッチャーのリスト
   );
 
+  /// @brief read_file() でオープンしたファイルのリストを返す．
+  ///
+  /// インクルードされたファイルも含む．
+  const vector<string>&
+  opened_file_list();
+
 
 public:
   //////////////////////////////////////////////////////////////////////
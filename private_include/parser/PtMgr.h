@@ -78,6 +78,30 @@ public:
   vector<const PtiAttrInfo>
   all_attr_list() const;
 
+  /// @brief ファイル中で定義されたモジュールのリストを返す．
+  ///
+  /// 読み込んでいないファイルの場合は空のリストを返す．
+  vector<const PtModule*>
+  file_module_list(
+    const string& filename ///< [in] ファイル名
+  ) const;
+
+  /// @brief ファイル中で定義された UDP のリストを返す．
+  ///
+  /// 読み込んでいないファイルの場合は空のリストを返す．
+  vector<const PtUdp*>
+  file_udp_list(
+    const string& filename ///< [in] ファイル名
+  ) const;
+
+  /// @brief ファイル中のインスタンス記述で用いられている名前のリストを返す．
+  ///
+  /// 読み込んでいないファイルの場合は空のリストを返す．
+  vector<string>
+  file_defname_list(
+    const string& filename ///< [in] ファイル名
+  ) const;
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -88,6 +112,39 @@ public:
   void
   clear();
 
+  /// @brief ファイルの読み込みを開始する．
+  ///
+  /// これ以降 end_file() までに登録された要素は filename で
+  /// 定義されたものとして記録される．
+  /// remove_file() で削除したファイルの場合は元の位置に読み込まれる．
+  /// 構文木の要素はファイルごとに用意したアロケーターから確保する．
+  void
+  begin_file(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief ファイルの読み込みを終了する．
+  ///
+  /// モジュールと UDP のリストをファイルの順に並べ直す．
+  void
+  end_file();
+
+  /// @brief ファイル中で定義された要素の登録を取り消す．
+  ///
+  /// 構文木の要素そのものは release_removed() か clear() まで
+  /// 破壊されない．
+  void
+  remove_file(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief remove_file() で登録を取り消した構文木の要素を破壊する．
+  ///
+  /// 取り消した要素を参照しているエラボレーション結果が
+  /// なくなってから呼ぶこと．
+  void
+  release_removed();
+
   /// @brief UDP 定義を追加する．
   ///
   /// 内部で reg_pt() を呼んでいる．
@@ -144,8 +201,18 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
+  // 読み込み中のファイルのアロケーターに処理を委ねるアロケーター
+  class FileAlloc;
+
   // メモリアロケーター
-  unique_ptr<Alloc> mAlloc;
+  // Parser はこれを用いる．
+  unique_ptr<FileAlloc> mAlloc;
+
+  // ファイルの読み込み中以外に用いるアロケーター
+  unique_ptr<Alloc> mDefaultAlloc;
+
+  // remove_file() で登録を取り消したファイルのアロケーターのリスト
+  vector<unique_ptr<Alloc>> mRemovedAllocList;
 
   // UDP 定義のリスト
   vector<const PtUdp*> mUdpList;
@@ -153,9 +220,55 @@ private:
   // モジュール定義のリスト
   vector<const PtModule*> mModuleList;
 
-  // インスタンス記述で用いられている名前
+  // インスタンス記述で用いられている名前をキーにして
+  // 用いられている回数を保持する辞書
   // たぶんモジュール名か UDP名のはず
-  unordered_set<string> mDefNames;
+  unordered_map<string, SizeType> mDefNames;
+
+  // ファイルごとの登録内容
+  struct FileDef
+  {
+    // コンストラクタ
+    explicit
+    FileDef(
+      const string& filename
+    ) : mFileName{filename}
+    {
+    }
+
+    // ファイル名
+    string mFileName;
+
+    // remove_file() で削除された時 true にする．
+    bool mRemoved{false};
+
+    // UDP 定義のリスト
+    vector<const PtUdp*> mUdpList;
+
+    // モジュール定義のリスト
+    vector<const PtModule*> mModuleList;
+
+    // インスタンス記述で用いられている名前のリスト
+    vector<string> mDefNameList;
+
+    // 属性リストを持つ要素のリスト
+    vector<const PtBase*> mAttrObjList;
+
+    // 構文木の要素を確保したアロケーター
+    unique_ptr<Alloc> mAlloc;
+  };
+
+  // ファイルごとの登録内容のリスト
+  // 読み込んだ順に並んでいる．
+  vector<FileDef> mFileDefList;
+
+  // ファイル名をキーにして mFileDefList 中の位置を保持する辞書
+  // 同じファイルを複数回読み込んだ場合は最後のものを持つ．
+  unordered_map<string, SizeType> mFileDefDict;
+
+  // 読み込み中のファイルの mFileDefList 中の位置
+  // 読み込み中でない場合は mFileDefList.size() 以上の値を持つ．
+  SizeType mCurFile{static_cast<SizeType>(-1)};
 
   // 文字列の辞書
   unordered_set<string> mStringPool;
@@ -96,6 +96,12 @@ public:
     const string& filename ///< [in] ファイル名
   );
 
+  /// @brief これまでにオープンしたファイルのリストを返す．
+  ///
+  /// インクルードされたファイルも含む．
+  const vector<string>&
+  opened_file_list() const;
+
   /// @}
   //////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,212 @@
+
+/// @file bvbench.cc
+/// @brief BvKernel のマイクロベンチマーク
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 64 ビットから 64K ビットまでの幅について，スカラー版と
+/// 実行環境で使える AVX2/AVX-512 版のカーネルの実行時間を比較する．
+/// 各カーネルの結果がスカラー版と一致することも確かめる．
+///
+/// 使い方: bvbench [<最大ビット幅>]
+/// 引数を与えた場合にはその幅までを測る．
+
+#include "BvKernel.h"
+#include <chrono>
+#include <random>
+#include <cstdlib>
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+BEGIN_NONAMESPACE
+
+using uword = BvKernel::uword;
+
+// 一回の計測で処理する総ワード数の目安
+const SizeType TOTAL_WORDS = 1 << 26;
+
+// 計測対象のデータ
+struct BenchData
+{
+  vector<uword> mVal0;
+  vector<uword> mVal1;
+  vector<uword> mSrc0;
+  vector<uword> mSrc1;
+};
+
+// ランダムな 0/1 の値を作る．
+//
+// x/z を含むとリダクション系の関数がすぐに終わってしまうので
+// 含めない．
+void
+make_data(
+  SizeType n,
+  std::mt19937_64& rg,
+  BenchData& data
+)
+{
+  data.mVal0.resize(n);
+  data.mVal1.resize(n);
+  data.mSrc0.resize(n);
+  data.mSrc1.resize(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    uword v1 = rg();
+    data.mVal0[i] = ~v1;
+    data.mVal1[i] = v1;
+    uword v2 = rg();
+    data.mSrc0[i] = ~v2;
+    data.mSrc1[i] = v2;
+  }
+}
+
+// func を rep 回実行した時間(ナノ秒)の一回あたりの値を返す．
+template<typename Func>
+double
+measure(
+  SizeType rep,
+  Func func
+)
+{
+  auto start = std::chrono::steady_clock::now();
+  for ( SizeType i = 0; i < rep; ++ i ) {
+    func();
+  }
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::nano> d = end - start;
+  return d.count() / rep;
+}
+
+// 各カーネルの結果がスカラー版と一致するか調べる．
+bool
+check(
+  const BvKernel& kernel,
+  const BenchData& data
+)
+{
+  auto& ref = BvKernel::scalar();
+  SizeType n = data.mVal0.size();
+  for ( auto op: { &BvKernel::mAnd, &BvKernel::mOr, &BvKernel::mXor } ) {
+    auto a0 = data.mVal0;
+    auto a1 = data.mVal1;
+    auto b0 = data.mVal0;
+    auto b1 = data.mVal1;
+    (kernel.*op)(a0.data(), a1.data(), data.mSrc0.data(), data.mSrc1.data(), n);
+    (ref.*op)(b0.data(), b1.data(), data.mSrc0.data(), data.mSrc1.data(), n);
+    if ( a0 != b0 || a1 != b1 ) {
+      return false;
+    }
+  }
+  {
+    auto a0 = data.mVal0;
+    auto a1 = data.mVal1;
+    auto b0 = data.mVal0;
+    auto b1 = data.mVal1;
+    kernel.mNegate(a0.data(), a1.data(), n);
+    ref.mNegate(b0.data(), b1.data(), n);
+    if ( a0 != b0 || a1 != b1 ) {
+      return false;
+    }
+  }
+  // 最後のワードに x を一つ入れて探させる．
+  auto v0 = data.mVal0;
+  auto v1 = data.mVal1;
+  v0[n - 1] |= 1;
+  v1[n - 1] |= 1;
+  if ( kernel.mAny(v0.data(), v1.data(), 0, 0, n) !=
+       ref.mAny(v0.data(), v1.data(), 0, 0, n) ) {
+    return false;
+  }
+  if ( kernel.mAnyXZ(v0.data(), v1.data(), n) !=
+       ref.mAnyXZ(v0.data(), v1.data(), n) ) {
+    return false;
+  }
+  if ( kernel.mParity(data.mVal1.data(), n) !=
+       ref.mParity(data.mVal1.data(), n) ) {
+    return false;
+  }
+  return true;
+}
+
+// 一つの幅について計測する．
+void
+bench(
+  SizeType width,
+  const vector<const BvKernel*>& kernel_list,
+  std::mt19937_64& rg
+)
+{
+  SizeType n = (width + 63) / 64;
+  BenchData data;
+  make_data(n, rg, data);
+  SizeType rep = TOTAL_WORDS / n;
+
+  for ( auto kernel_p: kernel_list ) {
+    auto& kernel = *kernel_p;
+    if ( !check(kernel, data) ) {
+      cout << "error: " << kernel.mName
+	   << " differs from scalar at width " << width << endl;
+    }
+
+    auto val0 = data.mVal0;
+    auto val1 = data.mVal1;
+    auto src0 = data.mSrc0.data();
+    auto src1 = data.mSrc1.data();
+    auto p0 = val0.data();
+    auto p1 = val1.data();
+    // 結果を捨てられないようにするための変数
+    volatile bool sink = false;
+
+    double t_neg = measure(rep, [&]() { kernel.mNegate(p0, p1, n); });
+    double t_and = measure(rep, [&]() { kernel.mAnd(p0, p1, src0, src1, n); });
+    double t_or  = measure(rep, [&]() { kernel.mOr(p0, p1, src0, src1, n); });
+    double t_xor = measure(rep, [&]() { kernel.mXor(p0, p1, src0, src1, n); });
+    // 確定値なので x は見つからず全ワードを走査する．
+    double t_any = measure(rep, [&]() {
+      sink = kernel.mAny(src0, src1, 0, 0, n); });
+    double t_xz  = measure(rep, [&]() {
+      sink = kernel.mAnyXZ(src0, src1, n); });
+    double t_par = measure(rep, [&]() {
+      sink = kernel.mParity(src1, n); });
+
+    printf("%6lu %-8s %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+	   width, kernel.mName,
+	   t_neg, t_and, t_or, t_xor, t_any, t_xz, t_par);
+  }
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM_VERILOG
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  using namespace nsYm;
+  using namespace nsYm::nsVerilog;
+
+  auto kernel_list = BvKernel::available_list();
+  cout << "selected kernel: " << BvKernel::get().mName << endl;
+  cout << "time per call [ns]" << endl;
+  printf("%6s %-8s %10s %10s %10s %10s %10s %10s %10s\n",
+	 "width", "kernel",
+	 "negate", "and", "or", "xor", "has_x", "has_xz", "parity");
+
+  SizeType max_width = 64 * 1024;
+  if ( argc > 1 ) {
+    max_width = atoi(argv[1]);
+  }
+
+  std::mt19937_64 rg{1};
+  for ( SizeType width = 64; width <= max_width; width *= 2 ) {
+    bench(width, kernel_list, rg);
+  }
+
+  return 0;
+}
@@ -0,0 +1,123 @@
+
+/// @file functest.cc
+/// @brief constant function の評価結果のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 同じモジュールの異なるインスタンスから constant function を
+/// 呼び出した結果を調べる．
+/// 関数の入出力のビット幅がパラメータに依存する場合には，
+/// 本体がパラメータを参照していなくてもインスタンスごとに
+/// 結果が異なる．
+///
+/// 使い方: functest [<作業用のファイル名>]
+/// 正しければ 0 を，誤りがあれば 1 を返す．
+
+#include "ym/VlMgr.h"
+#include "ym/vl/VlDecl.h"
+#include "ym/MsgMgr.h"
+#include "ym/StreamMsgHandler.h"
+#include <fstream>
+#include <cstdio>
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+BEGIN_NONAMESPACE
+
+// テスト用の記述
+//
+// f(0) の結果は W ビットの全て 1 なので w のビット幅は 2^W となる．
+const char* source =
+  "module child #(parameter W = 4) ();\n"
+  "  function [W-1:0] f(input [W-1:0] x);\n"
+  "    f = ~x;\n"
+  "  endfunction\n"
+  "  wire [f(0):0] w;\n"
+  "endmodule\n"
+  "\n"
+  "module top;\n"
+  "  child #(.W(4)) u4();\n"
+  "  child #(.W(8)) u8();\n"
+  "  child #(.W(4)) u4b();\n"
+  "endmodule\n";
+
+// path の宣言要素のビット幅が size か調べる．
+bool
+check_size(
+  const VlMgr& mgr,
+  const string& path,
+  SizeType size
+)
+{
+  auto obj = mgr.find_by_path(path);
+  if ( obj == nullptr || obj->type() != VpiObjType::Net ) {
+    cerr << path << ": not found" << endl;
+    return false;
+  }
+  auto decl = static_cast<const VlDecl*>(obj);
+  if ( decl->bit_size() != size ) {
+    cerr << path << ": bit_size() = " << decl->bit_size()
+	 << ", expected " << size << endl;
+    return false;
+  }
+  return true;
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM_VERILOG
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  using namespace nsYm;
+  using namespace nsYm::nsVerilog;
+
+  string filename = "functest.v";
+  if ( argc > 1 ) {
+    filename = argv[1];
+  }
+  {
+    ofstream ofs{filename};
+    if ( !ofs ) {
+      cerr << filename << ": could not create" << endl;
+      return 1;
+    }
+    ofs << source;
+  }
+
+  MsgHandler* tmh = new StreamMsgHandler(cerr);
+  tmh->set_mask(kMsgMaskAll);
+  tmh->delete_mask(MsgType::Info);
+  tmh->delete_mask(MsgType::Debug);
+  MsgMgr::attach_handler(tmh);
+
+  VlMgr mgr;
+  mgr.set_info_msg(false);
+  mgr.read_file(filename);
+  std::remove(filename.c_str());
+  if ( MsgMgr::error_num() > 0 ) {
+    return 1;
+  }
+  mgr.elaborate();
+  if ( MsgMgr::error_num() > 0 ) {
+    return 1;
+  }
+
+  bool ok = true;
+  ok &= check_size(mgr, "top.u4.w", 16);
+  ok &= check_size(mgr, "top.u8.w", 256);
+  ok &= check_size(mgr, "top.u4b.w", 16);
+  if ( !ok ) {
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
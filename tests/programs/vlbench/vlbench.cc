@@ -0,0 +1,329 @@
+
+/// @file vlbench.cc
+/// @brief BitVector と VlValue のベンチマーク
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 値のビット幅と x/z の密度を変えながら以下の処理の
+/// 1回あたりの実行時間(ns/op)とメモリ確保の回数(allocs/op)を測る．
+/// - Verilog 形式の文字列からの変換
+/// - 算術演算，ビット演算，比較，シフト
+/// - Verilog 形式/10進数の文字列への変換
+/// - VlValue との変換
+///
+/// 使い方: vlbench [<演算名の一部>]
+/// 引数を与えた場合にはその文字列を名前に含む演算のみを測る．
+
+#include "ym/BitVector.h"
+#include "ym/VlValue.h"
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+
+//////////////////////////////////////////////////////////////////////
+// メモリ確保の回数を数えるために operator new を置き換える．
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+SizeType alloc_count = 0;
+
+}
+
+void*
+operator new(
+  std::size_t size
+)
+{
+  ++ alloc_count;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if ( p == nullptr ) {
+    throw std::bad_alloc{};
+  }
+  return p;
+}
+
+void
+operator delete(
+  void* p
+) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete(
+  void* p,
+  std::size_t
+) noexcept
+{
+  std::free(p);
+}
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+BEGIN_NONAMESPACE
+
+// 一つの項目の計測に費やす時間の目安(ナノ秒)
+const double TARGET_NS = 2.0e7;
+
+// 結果を捨てられないようにするための変数
+volatile SizeType sink = 0;
+
+// 計測対象の名前のフィルタ
+const char* filter = nullptr;
+
+// func の1回あたりの実行時間とメモリ確保の回数を測って出力する．
+template<typename Func>
+void
+measure(
+  const char* name,
+  SizeType width,
+  double density,
+  Func func
+)
+{
+  if ( filter != nullptr && strstr(name, filter) == nullptr ) {
+    return;
+  }
+
+  // 1回あたりの時間を大まかに見積もってから繰り返し数を決める．
+  SizeType rep = 1;
+  double ns = 0.0;
+  for ( ; ; ) {
+    auto start = std::chrono::steady_clock::now();
+    for ( SizeType i = 0; i < rep; ++ i ) {
+      func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    ns = std::chrono::duration<double, std::nano>(end - start).count();
+    if ( ns >= TARGET_NS / 10 || rep >= (1 << 24) ) {
+      break;
+    }
+    rep *= 10;
+  }
+  if ( ns < TARGET_NS ) {
+    rep = static_cast<SizeType>(rep * TARGET_NS / (ns + 1.0)) + 1;
+  }
+
+  SizeType alloc0 = alloc_count;
+  auto start = std::chrono::steady_clock::now();
+  for ( SizeType i = 0; i < rep; ++ i ) {
+    func();
+  }
+  auto end = std::chrono::steady_clock::now();
+  SizeType allocs = alloc_count - alloc0;
+  ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+  printf("%-16s %6lu %5.2f %12.1f %10.2f\n",
+	 name, width, density,
+	 ns / rep, static_cast<double>(allocs) / rep);
+}
+
+// 2進数の数字を一つ作る．
+char
+bin_digit(
+  double density,
+  std::mt19937& rg
+)
+{
+  std::uniform_real_distribution<double> rd{0.0, 1.0};
+  if ( rd(rg) < density ) {
+    return (rg() & 1) ? 'x' : 'z';
+  }
+  return (rg() & 1) ? '1' : '0';
+}
+
+// Verilog 形式の2進数の文字列を作る．
+string
+make_binstr(
+  SizeType width,
+  double density,
+  std::mt19937& rg
+)
+{
+  ostringstream buf;
+  buf << width << "'b";
+  for ( SizeType i = 0; i < width; ++ i ) {
+    buf << bin_digit(density, rg);
+  }
+  return buf.str();
+}
+
+// 16進数の数字列を作る．
+//
+// x/z の密度は桁単位で適用する．
+string
+make_hexdigits(
+  SizeType width,
+  double density,
+  std::mt19937& rg
+)
+{
+  static const char* hexchars = "0123456789abcdef";
+  std::uniform_real_distribution<double> rd{0.0, 1.0};
+  string ans;
+  SizeType nd = (width + 3) / 4;
+  for ( SizeType i = 0; i < nd; ++ i ) {
+    if ( rd(rg) < density ) {
+      ans += (rg() & 1) ? 'x' : 'z';
+    }
+    else {
+      ans += hexchars[rg() % 16];
+    }
+  }
+  return ans;
+}
+
+// 一つのビット幅と x/z の密度について計測する．
+void
+bench(
+  SizeType width,
+  double density,
+  std::mt19937& rg
+)
+{
+  string binstr1 = make_binstr(width, density, rg);
+  string binstr2 = make_binstr(width, density, rg);
+  string hexdigits = make_hexdigits(width, density, rg);
+  string hexstr = std::to_string(width) + "'h" + hexdigits;
+
+  BitVector a;
+  a.set_from_verilog_string(binstr1);
+  BitVector b;
+  b.set_from_verilog_string(binstr2);
+  // 除数は0にならないように最下位ビットを1にしておく．
+  BitVector d{b};
+  d.bit_select_op(0, VlScalarVal::one());
+
+  // 文字列からの変換
+  measure("parse_bin", width, density, [&]() {
+    BitVector bv;
+    bv.set_from_verilog_string(binstr1);
+    sink += bv.size();
+  });
+  measure("parse_hex", width, density, [&]() {
+    BitVector bv;
+    bv.set_from_verilog_string(hexstr);
+    sink += bv.size();
+  });
+  measure("parse_hexdigits", width, density, [&]() {
+    BitVector bv{width, false, 16, hexdigits};
+    sink += bv.size();
+  });
+
+  // 算術演算
+  measure("add", width, density, [&]() {
+    sink += (a + b).size();
+  });
+  measure("sub", width, density, [&]() {
+    sink += (a - b).size();
+  });
+  measure("mul", width, density, [&]() {
+    sink += (a * b).size();
+  });
+  measure("div", width, density, [&]() {
+    sink += (a / d).size();
+  });
+
+  // ビット演算
+  measure("and", width, density, [&]() {
+    sink += (a & b).size();
+  });
+  measure("or", width, density, [&]() {
+    sink += (a | b).size();
+  });
+  measure("xor", width, density, [&]() {
+    sink += (a ^ b).size();
+  });
+  measure("negate", width, density, [&]() {
+    sink += (~a).size();
+  });
+  measure("reduction_xor", width, density, [&]() {
+    sink += a.reduction_xor().is_one();
+  });
+
+  // 比較
+  measure("lt", width, density, [&]() {
+    sink += lt(a, b).is_one();
+  });
+  measure("eq", width, density, [&]() {
+    sink += eq(a, b).is_one();
+  });
+  measure("eq_with_x", width, density, [&]() {
+    sink += eq_with_x(a, b);
+  });
+
+  // シフト
+  measure("lshift", width, density, [&]() {
+    sink += (a << 3).size();
+  });
+  measure("rshift", width, density, [&]() {
+    sink += (a >> 3).size();
+  });
+
+  // 文字列への変換
+  measure("verilog_string", width, density, [&]() {
+    sink += a.verilog_string().size();
+  });
+  measure("dec_str", width, density, [&]() {
+    sink += a.dec_str().size();
+  });
+
+  // VlValue との変換
+  VlValue va{a};
+  VlValueType int_type = VlValueType::int_type();
+  VlValueType bv_type{false, true, width};
+  measure("to_vlvalue", width, density, [&]() {
+    VlValue v{a};
+    sink += v.is_bitvector();
+  });
+  measure("vlvalue_to_bv", width, density, [&]() {
+    sink += va.bitvector_value(bv_type).size();
+  });
+  measure("vlvalue_to_int", width, density, [&]() {
+    VlValue v{va, int_type};
+    sink += v.is_int();
+  });
+  measure("vlvalue_add", width, density, [&]() {
+    VlValue v{va + va};
+    sink += v.is_bitvector();
+  });
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM_VERILOG
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  using namespace nsYm;
+  using namespace nsYm::nsVerilog;
+
+  if ( argc > 1 ) {
+    filter = argv[1];
+  }
+
+  printf("%-16s %6s %5s %12s %10s\n",
+	 "op", "width", "xz", "ns/op", "allocs/op");
+
+  std::mt19937 rg{1};
+  for ( SizeType width: { 8, 32, 64, 128, 256, 1024, 4096 } ) {
+    for ( double density: { 0.0, 0.01, 0.5 } ) {
+      bench(width, density, rg);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,247 @@
+
+/// @file vlstress.cc
+/// @brief VlMgr::freeze() 後の並列な検索のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2021 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// Verilog ファイルを読み込んでエラボレーションし，freeze() した後に
+/// 複数のスレッドから乱数で選んだ find_xxx() 系の検索を行う．
+/// 同じ乱数の種で一つのスレッドで行った結果と一致することを確かめる．
+/// データ競合を調べる場合には -fsanitize=thread 付きでライブラリごと
+/// コンパイルして実行する．
+///
+/// 使い方: vlstress [-t <スレッド数>] [-n <検索回数>] <ファイル名> ...
+
+#include "ym/VlMgr.h"
+#include "ym/vl/VlDecl.h"
+#include "ym/vl/VlModule.h"
+#include "ym/vl/VlTaskFunc.h"
+#include "ym/MsgMgr.h"
+#include "ym/StreamMsgHandler.h"
+#include <random>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+BEGIN_NONAMESPACE
+
+// 結果のハッシュ値に値を加える．
+inline
+void
+mix(
+  SizeType& h,
+  SizeType v
+)
+{
+  h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+}
+
+// ポインタを結果のハッシュ値に加える．
+inline
+void
+mix(
+  SizeType& h,
+  const void* p
+)
+{
+  mix(h, reinterpret_cast<PtrIntType>(p));
+}
+
+// span を結果のハッシュ値に加える．
+template<typename T>
+void
+mix_span(
+  SizeType& h,
+  VlSpan<T> span
+)
+{
+  mix(h, span.size());
+  if ( !span.empty() ) {
+    mix(h, span[0]);
+  }
+}
+
+// seed から決まる num 回の検索を行い，結果のハッシュ値を返す．
+SizeType
+run_queries(
+  const VlMgr& mgr,
+  const vector<const VlScope*>& scope_list,
+  SizeType seed,
+  SizeType num
+)
+{
+  std::mt19937 rg{static_cast<std::mt19937::result_type>(seed)};
+  std::uniform_int_distribution<SizeType> rd_scope{0, scope_list.size() - 1};
+  std::uniform_int_distribution<int> rd_kind{0, 9};
+  const int decl_tags[] = { vpiNet, vpiReg, vpiVariables, vpiParameter };
+  SizeType h = 0;
+  for ( SizeType i = 0; i < num; ++ i ) {
+    auto scope = scope_list[rd_scope(rg)];
+    switch ( rd_kind(rg) ) {
+    case 0:
+      mix_span(h, mgr.find_internalscope_span(scope));
+      break;
+    case 1:
+      for ( int tag: decl_tags ) {
+	mix_span(h, mgr.find_decl_span(scope, tag));
+	mix_span(h, mgr.find_declarray_span(scope, tag));
+      }
+      break;
+    case 2:
+      mix_span(h, mgr.find_module_span(scope));
+      mix_span(h, mgr.find_modulearray_span(scope));
+      break;
+    case 3:
+      mix_span(h, mgr.find_primitive_span(scope));
+      mix_span(h, mgr.find_primarray_span(scope));
+      break;
+    case 4:
+      mix_span(h, mgr.find_contassign_span(scope));
+      mix_span(h, mgr.find_process_span(scope));
+      break;
+    case 5:
+      mix_span(h, mgr.find_task_span(scope));
+      mix_span(h, mgr.find_function_span(scope));
+      break;
+    case 6:
+      mix_span(h, mgr.find_defparam_span(scope));
+      mix_span(h, mgr.find_paramassign_span(scope));
+      break;
+    case 7:
+      // スコープの fullname のキャッシュを参照する．
+      mix(h, std::hash<string>{}(scope->full_name()));
+      break;
+    case 8:
+      // 階層名で自分自身を検索する．
+      mix(h, mgr.find_by_path(scope->full_name()));
+      break;
+    case 9:
+      mix(h, mgr.find_attr(scope).size());
+      for ( auto decl: mgr.find_decl_span(scope, vpiNet) ) {
+	mix(h, mgr.find_by_path(decl->full_name()));
+      }
+      break;
+    }
+  }
+  return h;
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM_VERILOG
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  using namespace nsYm;
+  using namespace nsYm::nsVerilog;
+
+  SizeType thread_num = 8;
+  SizeType query_num = 100000;
+  vector<string> filename_list;
+  for ( int i = 1; i < argc; ++ i ) {
+    if ( strcmp(argv[i], "-t") == 0 && i + 1 < argc ) {
+      ++ i;
+      thread_num = atoi(argv[i]);
+    }
+    else if ( strcmp(argv[i], "-n") == 0 && i + 1 < argc ) {
+      ++ i;
+      query_num = atoi(argv[i]);
+    }
+    else {
+      filename_list.push_back(argv[i]);
+    }
+  }
+  if ( filename_list.empty() || thread_num == 0 ) {
+    cerr << "Usage: " << argv[0]
+	 << " [-t <thread-num>] [-n <query-num>] <file> ..." << endl;
+    return 1;
+  }
+
+  MsgHandler* tmh = new StreamMsgHandler(cerr);
+  tmh->set_mask(kMsgMaskAll);
+  tmh->delete_mask(MsgType::Info);
+  tmh->delete_mask(MsgType::Debug);
+  MsgMgr::attach_handler(tmh);
+
+  VlMgr mgr;
+  mgr.set_info_msg(false);
+  for ( auto& name: filename_list ) {
+    mgr.read_file(name);
+  }
+  if ( MsgMgr::error_num() > 0 ) {
+    return 1;
+  }
+  mgr.elaborate();
+  if ( MsgMgr::error_num() > 0 ) {
+    return 1;
+  }
+  mgr.freeze();
+
+  // 検索の起点となるスコープを集める．
+  // ここでは fullname を参照しない．
+  vector<const VlScope*> scope_list;
+  for ( auto module: mgr.topmodule_list() ) {
+    scope_list.push_back(module);
+  }
+  for ( auto scope: mgr.all_internalscope_span() ) {
+    scope_list.push_back(scope);
+  }
+  for ( auto module: mgr.all_module_span() ) {
+    scope_list.push_back(module);
+  }
+  for ( auto module_array: mgr.all_modulearray_span() ) {
+    SizeType n = module_array->elem_num();
+    for ( SizeType i = 0; i < n; ++ i ) {
+      scope_list.push_back(module_array->elem_by_offset(i));
+    }
+  }
+  for ( auto task: mgr.all_task_span() ) {
+    scope_list.push_back(task);
+  }
+  for ( auto func: mgr.all_function_span() ) {
+    scope_list.push_back(func);
+  }
+  if ( scope_list.empty() ) {
+    cerr << "No scopes" << endl;
+    return 1;
+  }
+
+  // 並列に実行する．
+  vector<SizeType> par_result(thread_num);
+  vector<std::thread> thread_list;
+  for ( SizeType i = 0; i < thread_num; ++ i ) {
+    thread_list.emplace_back([&, i]() {
+      par_result[i] = run_queries(mgr, scope_list, i + 1, query_num);
+    });
+  }
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+
+  // 同じ種で一つずつ実行した結果と比較する．
+  SizeType error_num = 0;
+  for ( SizeType i = 0; i < thread_num; ++ i ) {
+    auto seq_result = run_queries(mgr, scope_list, i + 1, query_num);
+    if ( seq_result != par_result[i] ) {
+      cerr << "Error: thread#" << i << " mismatch" << endl;
+      ++ error_num;
+    }
+  }
+
+  cout << scope_list.size() << " scopes, "
+       << thread_num << " threads x "
+       << query_num << " queries: "
+       << (error_num == 0 ? "OK" : "NG") << endl;
+
+  return error_num == 0 ? 0 : 1;
+}
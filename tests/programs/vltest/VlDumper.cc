@@ -93,6 +93,41 @@ VlDumper::bitexpand_mode() const
   return mImpl->bitexpand_mode();
 }
 
+// @brief JSON-lines 形式で出力する．
+void
+VlDumper::enable_jsonl_mode()
+{
+  mImpl->enable_jsonl_mode();
+}
+
+// @brief マーカ形式で出力する．
+void
+VlDumper::disable_jsonl_mode()
+{
+  mImpl->disable_jsonl_mode();
+}
+
+// @brief JSON-lines 形式の時 true を返す．
+bool
+VlDumper::jsonl_mode() const
+{
+  return mImpl->jsonl_mode();
+}
+
+// @brief モジュールの整形に用いるスレッド数を設定する．
+void
+VlDumper::set_thread_num(SizeType thread_num)
+{
+  mImpl->set_thread_num(thread_num);
+}
+
+// @brief スレッド数を返す．
+SizeType
+VlDumper::thread_num() const
+{
+  return mImpl->thread_num();
+}
+
 // @brief VlMgr の持っている内容を出力する
 // @param[in] mgr VlMgr
 void
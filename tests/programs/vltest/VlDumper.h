@@ -86,6 +86,32 @@ public:
   bool
   bitexpand_mode() const;
 
+  /// @brief JSON-lines 形式で出力する．
+  ///
+  /// トップレベルの要素ごとに1行の JSON オブジェクトを出力する．
+  void
+  enable_jsonl_mode();
+
+  /// @brief マーカ形式で出力する．
+  void
+  disable_jsonl_mode();
+
+  /// @brief JSON-lines 形式の時 true を返す．
+  bool
+  jsonl_mode() const;
+
+  /// @brief モジュールの整形に用いるスレッド数を設定する．
+  ///
+  /// 0 の場合はハードウェアのスレッド数を用いる．
+  /// 複数のスレッドを用いるのは VlMgr::freeze() が呼ばれている
+  /// 場合のみである．
+  void
+  set_thread_num(SizeType thread_num);
+
+  /// @brief スレッド数を返す．
+  SizeType
+  thread_num() const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
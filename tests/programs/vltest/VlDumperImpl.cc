@@ -11,6 +11,7 @@
 
 #include "ym/FileRegion.h"
 #include "ym/VlMgr.h"
+#include "ym/VlParallel.h"
 #include "ym/VlValue.h"
 #include "ym/vl/VlModule.h"
 #include "ym/vl/VlUdp.h"
@@ -20,6 +21,44 @@
 
 BEGIN_NAMESPACE_YM_VERILOG
 
+BEGIN_NONAMESPACE
+
+// 整形済みの内容をまとめて書き出す大きさ
+const SizeType FLUSH_SIZE = 1 << 20;
+
+// 一度に並列で整形するモジュール数のスレッドあたりの値
+// 整形結果はこの単位で書き出されるので使用メモリ量の上限にもなる．
+const SizeType MODULES_PER_THREAD = 16;
+
+// str を JSON の文字列として dst に追加する．
+void
+append_json_string(string& dst,
+		   const string& str)
+{
+  static const char hex[] = "0123456789abcdef";
+  dst += '"';
+  for ( unsigned char c: str ) {
+    switch ( c ) {
+    case '"':  dst += "\\\""; break;
+    case '\\': dst += "\\\\"; break;
+    case '\n': dst += "\\n"; break;
+    case '\t': dst += "\\t"; break;
+    default:
+      if ( c < 0x20 ) {
+	dst += "\\u00";
+	dst += hex[c >> 4];
+	dst += hex[c & 15];
+      }
+      else {
+	dst += static_cast<char>(c);
+      }
+    }
+  }
+  dst += '"';
+}
+
+END_NONAMESPACE
+
 //////////////////////////////////////////////////////////////////////
 // VlObj の出力用クラス
 //////////////////////////////////////////////////////////////////////
@@ -27,11 +66,14 @@ BEGIN_NAMESPACE_YM_VERILOG
 // @brief コンストラクタ
 // @param[in] s 出力ストリーム
 VlDumperImpl::VlDumperImpl(ostream& s) :
-  mStream(s),
+  mOut(s),
+  mStream(mBuf),
   mIndent(0),
   mFileLocMode(false),
   mNullptrSuppressMode(true),
-  mBitExpandMode(false)
+  mBitExpandMode(false),
+  mJsonlMode(false),
+  mThreadNum(1)
 {
 }
 
@@ -103,8 +145,87 @@ VlDumperImpl::bitexpand_mode() const
   return mBitExpandMode;
 }
 
+// @brief JSON-lines 形式で出力する．
+void
+VlDumperImpl::enable_jsonl_mode()
+{
+  mJsonlMode = true;
+}
+
+// @brief マーカ形式で出力する．
+void
+VlDumperImpl::disable_jsonl_mode()
+{
+  mJsonlMode = false;
+}
+
+// @brief JSON-lines 形式の時 true を返す．
+bool
+VlDumperImpl::jsonl_mode() const
+{
+  return mJsonlMode;
+}
+
+// @brief モジュールの整形に用いるスレッド数を設定する．
+void
+VlDumperImpl::set_thread_num(SizeType thread_num)
+{
+  mThreadNum = thread_num;
+}
+
+// @brief スレッド数を返す．
+SizeType
+VlDumperImpl::thread_num() const
+{
+  return mThreadNum;
+}
+
+// @brief モードを src と同じにする．
+void
+VlDumperImpl::copy_mode(const VlDumperImpl& src)
+{
+  mFileLocMode = src.mFileLocMode;
+  mNullptrSuppressMode = src.mNullptrSuppressMode;
+  mBitExpandMode = src.mBitExpandMode;
+  mJsonlMode = src.mJsonlMode;
+}
+
+// @brief 整形済みの内容を取り出す．
+string
+VlDumperImpl::take_output()
+{
+  string ans;
+  if ( mJsonlMode ) {
+    ans.swap(mJson);
+  }
+  else {
+    ans = mBuf.str();
+    mBuf.str(string{});
+  }
+  return ans;
+}
+
+// @brief 整形済みの内容を出力先に書き出す．
+// @param[in] force false の時はある程度溜まるまで書き出さない．
+void
+VlDumperImpl::flush_output(bool force)
+{
+  if ( !force ) {
+    SizeType size = mJsonlMode ? mJson.size() : static_cast<SizeType>(mBuf.tellp());
+    if ( size < FLUSH_SIZE ) {
+      return;
+    }
+  }
+  auto text = take_output();
+  mOut.write(text.data(), text.size());
+}
+
 // @brief VlMgr の持っている内容を出力する
 // @param[in] mgr VlMgr
+//
+// モジュールごとの整形は互いに独立なので，VlMgr::freeze() が
+// 呼ばれている場合には複数のスレッドで行う．
+// 整形結果は元の順番に並べてからまとめて書き出す．
 void
 VlDumperImpl::put(const VlMgr& mgr)
 {
@@ -112,8 +233,10 @@ VlDumperImpl::put(const VlMgr& mgr)
   for ( auto udp: mgr.udp_list() ) {
     put_udp_defn("UDP", mgr, udp);
   }
+  flush_output(true);
 
-  // トップモジュールから順にモジュールを出力する．
+  // トップモジュールから順に出力するモジュールのリストを作る．
+  vector<const VlModule*> dump_list;
   std::queue<const VlModule*> tmp_queue;
   for ( auto module: mgr.topmodule_list() ) {
     tmp_queue.push(module);
@@ -121,13 +244,13 @@ VlDumperImpl::put(const VlMgr& mgr)
   while ( !tmp_queue.empty() ) {
     const VlModule* module = tmp_queue.front();
     tmp_queue.pop();
-    put_module("MODULE", mgr, module);
+    dump_list.push_back(module);
 
-    vector<const VlModule*> module_list = mgr.find_module_list(module);
+    auto module_list = mgr.find_module_span(module);
     for ( auto module1: module_list ) {
       tmp_queue.push(module1);
     }
-    vector<const VlModuleArray*> modulearray_list = mgr.find_modulearray_list(module);
+    auto modulearray_list = mgr.find_modulearray_span(module);
     for ( auto module_array: modulearray_list ) {
       SizeType n = module_array->elem_num();
       for ( SizeType i = 0; i < n; ++ i ) {
@@ -136,6 +259,42 @@ VlDumperImpl::put(const VlMgr& mgr)
       }
     }
   }
+
+  SizeType thread_num = mgr.is_frozen() ? vl_thread_num(mThreadNum) : 1;
+  if ( thread_num == 1 ) {
+    for ( auto module: dump_list ) {
+      put_module("MODULE", mgr, module);
+      flush_output(false);
+    }
+    flush_output(true);
+    mOut.flush();
+    return;
+  }
+
+  SizeType n = dump_list.size();
+  SizeType batch = thread_num * MODULES_PER_THREAD;
+  vector<string> text_list;
+  for ( SizeType base = 0; base < n; base += batch ) {
+    SizeType m = std::min(batch, n - base);
+    text_list.clear();
+    text_list.resize(m);
+    vl_parallel_for_chunk(m,
+			  [&](SizeType begin,
+			      SizeType end) {
+			    // スレッドごとに専用のバッファを持つ．
+			    VlDumperImpl dumper(mOut);
+			    dumper.copy_mode(*this);
+			    for ( SizeType i = begin; i < end; ++ i ) {
+			      dumper.put_module("MODULE", mgr, dump_list[base + i]);
+			      text_list[i] = dumper.take_output();
+			    }
+			  },
+			  thread_num, 1);
+    for ( const auto& text: text_list ) {
+      mOut.write(text.data(), text.size());
+    }
+  }
+  mOut.flush();
 }
 
 #if 0
@@ -777,12 +936,32 @@ VlDumperImpl::begin_marker(const char* label,
 			   const string& type,
 			   bool need_cr)
 {
+  if ( mJsonlMode ) {
+    if ( !mJsonStack.empty() ) {
+      flush_json_text();
+      if ( mJsonStack.back() ) {
+	mJson += ',';
+      }
+      else {
+	mJson += ",\"children\":[";
+	mJsonStack.back() = true;
+      }
+    }
+    mJson += "{\"label\":";
+    append_json_string(mJson, label);
+    mJson += ",\"type\":";
+    append_json_string(mJson, type);
+    mJsonStack.push_back(false);
+    return;
+  }
+
   for (int i = 0; i < mIndent; ++ i) {
     mStream << "  ";
   }
   mStream << "<" << label << " type = \"" << type << "\">";
   if ( need_cr ) {
-    mStream << endl;
+    // endl は毎回フラッシュするので用いない．
+    mStream << '\n';
   }
   mDoCR.push_back(need_cr);
   ++ mIndent;
@@ -793,6 +972,19 @@ VlDumperImpl::begin_marker(const char* label,
 void
 VlDumperImpl::end_marker(const char* label)
 {
+  if ( mJsonlMode ) {
+    flush_json_text();
+    if ( mJsonStack.back() ) {
+      mJson += ']';
+    }
+    mJson += '}';
+    mJsonStack.pop_back();
+    if ( mJsonStack.empty() ) {
+      mJson += '\n';
+    }
+    return;
+  }
+
   -- mIndent;
   if ( mDoCR.back() ) {
     for (int i = 0; i < mIndent; ++ i) {
@@ -800,7 +992,27 @@ VlDumperImpl::end_marker(const char* label)
     }
   }
   mDoCR.pop_back();
-  mStream << "</" << label << ">" << endl;
+  mStream << "</" << label << ">" << '\n';
+}
+
+// @brief JSON-lines 形式で溜まっている内容を "value" として出力する．
+//
+// 子供のマーカの後ろに現れた内容は "children" の文字列の要素とする．
+void
+VlDumperImpl::flush_json_text()
+{
+  if ( mBuf.tellp() == 0 || mJsonStack.empty() ) {
+    return;
+  }
+  auto text = mBuf.str();
+  mBuf.str(string{});
+  if ( mJsonStack.back() ) {
+    mJson += ',';
+  }
+  else {
+    mJson += ",\"value\":";
+  }
+  append_json_string(mJson, text);
 }
 
 
@@ -11,7 +11,9 @@
 
 #include "ym/verilog.h"
 #include "ym/vl/VlFwd.h"
+#include "ym/VlSpan.h"
 #include "ym/FileRegion.h"
+#include <sstream>
 
 
 BEGIN_NAMESPACE_YM_VERILOG
@@ -87,6 +89,36 @@ public:
   bool
   bitexpand_mode() const;
 
+  /// @brief JSON-lines 形式で出力する．
+  ///
+  /// トップレベルの要素(UDP とモジュール)ごとに1行の JSON オブジェクトを
+  /// 出力する．各マーカは
+  /// {"label":ラベル,"type":属性,"value":内容,"children":[子供のマーカ]}
+  /// の形になる．"value" と "children" は空の場合には省略される．
+  void
+  enable_jsonl_mode();
+
+  /// @brief マーカ形式で出力する．
+  void
+  disable_jsonl_mode();
+
+  /// @brief JSON-lines 形式の時 true を返す．
+  bool
+  jsonl_mode() const;
+
+  /// @brief モジュールの整形に用いるスレッド数を設定する．
+  ///
+  /// 0 の場合はハードウェアのスレッド数を用いる．
+  /// 複数のスレッドを用いるのは VlMgr::freeze() が呼ばれている
+  /// 場合のみで，それ以外は1つのスレッドで処理する．
+  /// 出力内容はスレッド数によらない．
+  void
+  set_thread_num(SizeType thread_num);
+
+  /// @brief スレッド数を返す．
+  SizeType
+  thread_num() const;
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -114,7 +146,7 @@ public:
   void
   put_modulearray_list(const char* label,
 		       const VlMgr& mgr,
-		       const vector<const VlModuleArray*>& module_array_list);
+		       VlSpan<const VlModuleArray*> module_array_list);
 
   /// @brief scope の内容を出力する関数
   /// @param[in] mgr VlMgr
@@ -159,31 +191,31 @@ public:
   void
   put_decl_list(const char* label,
 		const VlMgr& mgr,
-		const vector<const VlDecl*>& decl_list);
+		VlSpan<const VlDecl*> decl_list);
 
   /// @brief 宣言要素のリストの内容を出力する関数
   void
   put_declarray_list(const char* label,
 		     const VlMgr& mgr,
-		     const vector<const VlDeclArray*>& decl_list);
+		     VlSpan<const VlDeclArray*> decl_list);
 
   /// @brief def param のリストの内容を出力する関数
   void
   put_defparam_list(const char* label,
 		    const VlMgr& mgr,
-		    const vector<const VlDefParam*>& defparam_list);
+		    VlSpan<const VlDefParam*> defparam_list);
 
   /// @brief param assign のリストの内容を出力する関数
   void
   put_paramassign_list(const char* label,
 		       const VlMgr& mgr,
-		       const vector<const VlParamAssign*>& paramassign_list);
+		       VlSpan<const VlParamAssign*> paramassign_list);
 
   /// @brief primitive array のリストの内容を出力する関数
   void
   put_primarray_list(const char* label,
 		     const VlMgr& mgr,
-		     const vector<const VlPrimArray*>& primarray_list);
+		     VlSpan<const VlPrimArray*> primarray_list);
 
   /// @brief primitive の内容を出力する関数
   void
@@ -195,7 +227,7 @@ public:
   void
   put_primitive_list(const char* label,
 		     const VlMgr& mgr,
-		     const vector<const VlPrimitive*>& primitive_list);
+		     VlSpan<const VlPrimitive*> primitive_list);
 
   /// @brief prim term の内容を出力する関数
   void
@@ -238,7 +270,7 @@ public:
   void
   put_contassign_list(const char* label,
 		      const VlMgr& mgr,
-		      const vector<const VlContAssign*>& ca_list);
+		      VlSpan<const VlContAssign*> ca_list);
 
   /// @brief initial/always の内容を出力する関数
   void
@@ -250,7 +282,7 @@ public:
   void
   put_process_list(const char* label,
 		   const VlMgr& mgr,
-		   const vector<const VlProcess*>& process_list);
+		   VlSpan<const VlProcess*> process_list);
 
   /// @brief statement の内容を出力する関数
   void
@@ -503,14 +535,52 @@ public:
   put_parent_file(const FileLoc& file_loc);
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief モードを src と同じにする．
+  void
+  copy_mode(const VlDumperImpl& src);
+
+  /// @brief 整形済みの内容を取り出す．
+  ///
+  /// 内部のバッファは空になる．
+  string
+  take_output();
+
+  /// @brief 整形済みの内容を出力先に書き出す．
+  /// @param[in] force false の時はある程度溜まるまで書き出さない．
+  void
+  flush_output(bool force);
+
+  /// @brief JSON-lines 形式で溜まっている内容を "value" として出力する．
+  void
+  flush_json_text();
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 出力ストリーム
+  // 最終的な出力先
+  ostream& mOut;
+
+  // 整形用のバッファ
+  // JSON-lines 形式の場合はマーカの内容のみを溜める．
+  ostringstream mBuf;
+
+  // 各関数が書き込むストリーム(mBuf を指す)
   ostream& mStream;
 
+  // JSON-lines 形式の整形結果
+  string mJson;
+
+  // JSON-lines 形式で開いているマーカごとに子供を出力済みかを表すフラグ
+  vector<bool> mJsonStack;
+
   // マーカ出力後に改行していないことを示すフラグ
   list<bool> mDoCR;
 
@@ -526,6 +596,12 @@ private:
   // bit 展開フラグ
   bool mBitExpandMode;
 
+  // JSON-lines 形式フラグ
+  bool mJsonlMode;
+
+  // スレッド数
+  SizeType mThreadNum;
+
 };
 
 
@@ -383,7 +383,7 @@ VlDumperImpl::put_declarray(const char* label,
 void
 VlDumperImpl::put_decl_list(const char* label,
 			    const VlMgr& mgr,
-			    const vector<const VlDecl*>& decl_list)
+			    VlSpan<const VlDecl*> decl_list)
 {
   VlDumpHeader x(this, label, "DeclList");
 
@@ -396,7 +396,7 @@ VlDumperImpl::put_decl_list(const char* label,
 void
 VlDumperImpl::put_declarray_list(const char* label,
 				 const VlMgr& mgr,
-				 const vector<const VlDeclArray*>& declarray_list)
+				 VlSpan<const VlDeclArray*> declarray_list)
 {
   VlDumpHeader x(this, label, "DeclArrayList");
 
@@ -409,7 +409,7 @@ VlDumperImpl::put_declarray_list(const char* label,
 void
 VlDumperImpl::put_defparam_list(const char* label,
 				const VlMgr& mgr,
-				const vector<const VlDefParam*>& defparam_list)
+				VlSpan<const VlDefParam*> defparam_list)
 {
   VlDumpHeader x(this, label, "DefParamList");
 
@@ -431,7 +431,7 @@ VlDumperImpl::put_defparam_list(const char* label,
 void
 VlDumperImpl::put_paramassign_list(const char* label,
 				   const VlMgr& mgr,
-				   const vector<const VlParamAssign*>& pa_list)
+				   VlSpan<const VlParamAssign*> pa_list)
 {
   VlDumpHeader x(this, label, "ParamAssignList");
 
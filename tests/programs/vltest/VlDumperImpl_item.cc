@@ -24,7 +24,7 @@ BEGIN_NAMESPACE_YM_VERILOG
 void
 VlDumperImpl::put_primarray_list(const char* label,
 				 const VlMgr& mgr,
-				 const vector<const VlPrimArray*>& primarray_list)
+				 VlSpan<const VlPrimArray*> primarray_list)
 {
   VlDumpHeader x(this, label, "PrimitiveArrayList");
 
@@ -111,7 +111,7 @@ VlDumperImpl::put_primitive(const char* label,
 void
 VlDumperImpl::put_primitive_list(const char* label,
 				 const VlMgr& mgr,
-				 const vector<const VlPrimitive*>& primitive_list)
+				 VlSpan<const VlPrimitive*> primitive_list)
 {
   VlDumpHeader x(this, label, "PrimitiveList");
 
@@ -280,7 +280,7 @@ VlDumperImpl::put_contassign(const char* label,
 void
 VlDumperImpl::put_contassign_list(const char* label,
 				  const VlMgr& mgr,
-				  const vector<const VlContAssign*>& ca_list)
+				  VlSpan<const VlContAssign*> ca_list)
 {
   VlDumpHeader x(this, label, "ContAssignList");
 
@@ -113,7 +113,7 @@ VlDumperImpl::put_module(const char* label,
 
   put_scope_sub(mgr, module);
 
-  vector<const VlProcess*> process_list = mgr.find_process_list(module);
+  auto process_list = mgr.find_process_span(module);
   put_process_list("vpiProcess", mgr, process_list);
 }
 
@@ -146,7 +146,7 @@ VlDumperImpl::put_modulearray(const char* label,
 void
 VlDumperImpl::put_modulearray_list(const char* label,
 				   const VlMgr& mgr,
-				   const vector<const VlModuleArray*>& ma_list)
+				   VlSpan<const VlModuleArray*> ma_list)
 {
   VlDumpHeader x(this, label, "ModuleArrayList");
 
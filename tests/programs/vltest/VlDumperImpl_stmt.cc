@@ -50,7 +50,7 @@ void
 VlDumperImpl::put_process_list(
   const char* label,
   const VlMgr& mgr,
-  const vector<const VlProcess*>& process_list
+  VlSpan<const VlProcess*> process_list
 )
 {
   VlDumpHeader x(this, label, "ProcessList");
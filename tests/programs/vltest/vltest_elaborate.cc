@@ -29,7 +29,9 @@ elaborate_mode(const vector<string>& filename_list,
 	       bool verbose,
 	       bool profile,
 	       int loop,
-	       bool dump_vpi)
+	       bool dump_vpi,
+	       bool dump_jsonl,
+	       SizeType thread_num)
 {
   MsgHandler* tmh = new StreamMsgHandler(cerr);
   if ( all_msg ) {
@@ -61,6 +63,8 @@ elaborate_mode(const vector<string>& filename_list,
       Timer timer;
       timer.start();
       VlMgr vlmgr;
+      // 表示しない情報メッセージは生成自体を省略する．
+      vlmgr.set_info_msg(all_msg);
       for ( auto name: filename_list ) {
 	if ( verbose ) {
 	  cerr << "Reading " << name;
@@ -91,8 +95,25 @@ elaborate_mode(const vector<string>& filename_list,
 	}
 
 	if ( MsgMgr::error_num() == 0 && dump_vpi ) {
+	  Timer timer;
+	  timer.start();
+
 	  VlDumper dumper(cout);
+	  if ( dump_jsonl ) {
+	    dumper.enable_jsonl_mode();
+	  }
+	  if ( thread_num != 1 ) {
+	    // 複数のスレッドで出力するには読み出し専用にする必要がある．
+	    vlmgr.freeze();
+	    dumper.set_thread_num(thread_num);
+	  }
 	  dumper(vlmgr);
+
+	  timer.stop();
+	  auto time = timer.get_time();
+	  if ( verbose ) {
+	    cerr << "Dumping time: " << time << endl;
+	  }
 	}
       }
       switch ( MsgMgr::error_num() ) {
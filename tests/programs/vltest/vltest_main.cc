@@ -34,7 +34,9 @@ elaborate_mode(
   bool verbose,
   bool profile,
   int loop,
-  bool dump_vpi
+  bool dump_vpi,
+  bool dump_jsonl,
+  SizeType thread_num
 );
 
 END_NAMESPACE_YM_VERILOG
@@ -59,6 +61,8 @@ main(
   int loop = 0;
   int use_cpt = false;
   int profile = 0;
+  int dump_jsonl = 0;
+  int thread_num = 1;
   const char* liberty_name = nullptr;
   const char* mislib_name = nullptr;
 
@@ -75,6 +79,8 @@ main(
   PoptNone popt_prof("profile", 'q', "show memory profile");
   PoptStr popt_dotlib("liberty", 0, "specify liberty library", "\"file name\"");
   PoptStr popt_mislib("mislib", 0, "specify mislib library", "\"file name\"");
+  PoptNone popt_jsonl("jsonl", 0, "dump in JSON-lines format");
+  PoptInt popt_threads("threads", 0, "number of threads used for dumping (0 for auto)", "thread count");
 
   popt.add_option(&popt_verbose);
   popt.add_option(&popt_yacc);
@@ -87,6 +93,8 @@ main(
   popt.add_option(&popt_prof);
   popt.add_option(&popt_dotlib);
   popt.add_option(&popt_mislib);
+  popt.add_option(&popt_jsonl);
+  popt.add_option(&popt_threads);
 
   popt.set_other_option_help("[OPTIONS]* <file-name> ...");
 
@@ -137,6 +145,15 @@ main(
   if ( popt_mislib.is_specified() ) {
     mislib_name = popt_mislib.val().c_str();
   }
+  if ( popt_jsonl.is_specified() ) {
+    dump_jsonl = 1;
+  }
+  if ( popt_threads.is_specified() ) {
+    thread_num = popt_threads.val();
+    if ( thread_num < 0 ) {
+      thread_num = 0;
+    }
+  }
 
 #if 0
 #if HAVE_POPT
@@ -300,7 +317,9 @@ main(
 		   verbose,
 		   profile,
 		   loop,
-		   dump);
+		   dump,
+		   dump_jsonl,
+		   thread_num);
     break;
   }
   return 0;